@@ -43,9 +43,11 @@
 #include "DecApp.h"
 #include "DecoderLib/AnnexBread.h"
 #include "DecoderLib/NALread.h"
+#include "DecoderLib/DecStream.h"
 #if RExt__DECODER_DEBUG_STATISTICS
 #include "CommonLib/CodingStatistics.h"
 #endif
+#include "CommonLib/StageProfiler.h"
 #include "CommonLib/dtrace_codingstruct.h"
 
 
@@ -75,7 +77,6 @@ DecApp::DecApp()
  */
 uint32_t DecApp::decode()
 {
-  int                 poc;
   PicList* pcListPic = NULL;
 
   ifstream bitstreamFile(m_bitstreamFileName.c_str(), ifstream::in | ifstream::binary);
@@ -157,7 +158,7 @@ uint32_t DecApp::decode()
             (nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL ||
              nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP))
         {
-          xFlushOutput(pcListPic, nalu.m_nuhLayerId);
+          m_cDecLib.flushOutput( pcListPic, nalu.m_nuhLayerId, m_iPOCLastDisplay, this );
         }
 
         // parse NAL unit syntax if within target decoding layer
@@ -196,28 +197,7 @@ uint32_t DecApp::decode()
       }
     }
 
-    if ((bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS) && !m_cDecLib.getFirstSliceInSequence(nalu.m_nuhLayerId) && !bPicSkipped)
-    {
-      if (!loopFiltered[nalu.m_nuhLayerId] || bitstreamFile)
-      {
-        m_cDecLib.executeLoopFilters();
-        m_cDecLib.finishPicture( poc, pcListPic );
-      }
-      loopFiltered[nalu.m_nuhLayerId] = (nalu.m_nalUnitType == NAL_UNIT_EOS);
-      if (nalu.m_nalUnitType == NAL_UNIT_EOS)
-      {
-        m_cDecLib.setFirstSliceInSequence(true, nalu.m_nuhLayerId);
-      }
-
-      m_cDecLib.updateAssociatedIRAP();
-      m_cDecLib.updatePrevGDRInSameLayer();
-      m_cDecLib.updatePrevIRAPAndGDRSubpic();
-    }
-    else if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
-      m_cDecLib.getFirstSliceInSequence(nalu.m_nuhLayerId))
-    {
-      m_cDecLib.setFirstSliceInPicture (true);
-    }
+    m_cDecLib.finishPictureUnit( nalu, bNewPicture, !bitstreamFile, bPicSkipped, loopFiltered, pcListPic );
 
     if( pcListPic )
     {
@@ -255,52 +235,13 @@ uint32_t DecApp::decode()
           m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].open( reconFileName, true, m_outputBitDepth, m_outputBitDepth, bitDepths.recon ); // write mode
         }
       }
-      // write reconstruction to file
-      if( bNewPicture )
-      {
-        xWriteOutput( pcListPic, nalu.m_temporalId );
-      }
-      if (nalu.m_nalUnitType == NAL_UNIT_EOS)
-      {
-        xWriteOutput( pcListPic, nalu.m_temporalId );
-        m_cDecLib.setFirstSliceInPicture (false);
-      }
-      // write reconstruction to file -- for additional bumping as defined in C.5.2.3
-      if (!bNewPicture && ((nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_TRAIL && nalu.m_nalUnitType <= NAL_UNIT_RESERVED_IRAP_VCL_12)
-        || (nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_IDR_W_RADL && nalu.m_nalUnitType <= NAL_UNIT_CODED_SLICE_GDR)))
-      {
-        xWriteOutput( pcListPic, nalu.m_temporalId );
-      }
-    }
-    if( bNewPicture )
-    {
-      m_cDecLib.checkSeiInPictureUnit();
-      m_cDecLib.resetPictureSeiNalus();
-    }
-    if (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS)
-    {
-      m_cDecLib.checkAPSInPictureUnit();
-      m_cDecLib.resetPictureUnitNals();
-    }
-    if (bNewAccessUnit || !bitstreamFile)
-    {
-      m_cDecLib.CheckNoOutputPriorPicFlagsInAccessUnit();
-      m_cDecLib.resetAccessUnitNoOutputPriorPicFlags();
-    }
-    if(bNewAccessUnit)
-    {
-      m_cDecLib.isCvsStart();
-      m_cDecLib.checkTidLayerIdInAccessUnit();
-      m_cDecLib.resetAccessUnitSeiTids();
-      m_cDecLib.checkSEIInAccessUnit();
-      m_cDecLib.resetAccessUnitSeiPayLoadTypes();
-      m_cDecLib.resetAccessUnitNals();
-      m_cDecLib.resetAccessUnitApsNals();
-      m_cDecLib.resetAccessUnitPicInfo();
     }
+    // write reconstruction to file
+    m_cDecLib.bumpPictures( nalu, bNewPicture, pcListPic, m_iMaxTemporalLayer, m_iPOCLastDisplay, this );
+    m_cDecLib.finishAccessUnit( nalu, bNewPicture, bNewAccessUnit, !bitstreamFile );
   }
 
-  xFlushOutput( pcListPic );
+  m_cDecLib.flushOutput( pcListPic, NOT_VALID, m_iPOCLastDisplay, this );
 
   // get the number of checksum errors
   uint32_t nRet = m_cDecLib.getNumberOfChecksumErrorsDetected();
@@ -310,6 +251,11 @@ uint32_t DecApp::decode()
   // destroy internal classes
   xDestroyDecLib();
 
+  if( m_checkDecStream )
+  {
+    nRet += xCheckDecStream();
+  }
+
 #if RExt__DECODER_DEBUG_STATISTICS
   CodingStatistics::DestroyInstance();
 #endif
@@ -361,6 +307,9 @@ void DecApp::xCreateDecLib()
   }
   m_cDecLib.m_targetSubPicIdx = this->m_targetSubPicIdx;
   m_cDecLib.initScalingList();
+#if ENABLE_STAGE_PROFILING
+  StageProfiler::setEnabled( !m_profilingFileName.empty() );
+#endif
 }
 
 void DecApp::xDestroyDecLib()
@@ -373,326 +322,155 @@ void DecApp::xDestroyDecLib()
     }
   }
 
+#if ENABLE_STAGE_PROFILING
+  if( StageProfiler::isEnabled() )
+  {
+    g_stageProfiler.finish();
+    if( !g_stageProfiler.writeFile( m_profilingFileName ) )
+    {
+      msg( WARNING, "\nWarning: Failed to write profiling file %s\n", m_profilingFileName.c_str() );
+    }
+    StageProfiler::setEnabled( false );
+  }
+#endif
+
   // destroy decoder class
   m_cDecLib.destroy();
 }
 
 
-/** \param pcListPic list of pictures to be written to file
-    \param tId       temporal sub-layer ID
+/** \param pcPic frame bumped out of the DPB
  */
-void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
+void DecApp::writePicture( Picture* pcPic )
 {
-  if (pcListPic->empty())
-  {
-    return;
-  }
-
-  PicList::iterator iterPic   = pcListPic->begin();
-  int numPicsNotYetDisplayed = 0;
-  int dpbFullness = 0;
-  const SPS* activeSPS = (pcListPic->front()->cs->sps);
-  uint32_t numReorderPicsHighestTid;
-  uint32_t maxDecPicBufferingHighestTid;
-  uint32_t maxNrSublayers = activeSPS->getMaxTLayers();
-
-  const VPS* referredVPS = pcListPic->front()->cs->vps;
-  const int temporalId = ( m_iMaxTemporalLayer == -1 || m_iMaxTemporalLayer >= maxNrSublayers ) ? maxNrSublayers - 1 : m_iMaxTemporalLayer;
-
-  if( referredVPS == nullptr || referredVPS->m_numLayersInOls[referredVPS->m_targetOlsIdx] == 1 )
-  {
-    numReorderPicsHighestTid = activeSPS->getNumReorderPics( temporalId );
-    maxDecPicBufferingHighestTid = activeSPS->getMaxDecPicBuffering( temporalId );
-  }
-  else
+  if (!m_reconFileName.empty())
   {
-    numReorderPicsHighestTid = referredVPS->getNumReorderPics( temporalId );
-    maxDecPicBufferingHighestTid = referredVPS->getMaxDecPicBuffering( temporalId );
-  }
-
-  while (iterPic != pcListPic->end())
-  {
-    Picture* pcPic = *(iterPic);
-    if(pcPic->neededForOutput && pcPic->getPOC() > m_iPOCLastDisplay)
+    const Window &conf = pcPic->getConformanceWindow();
+    const SPS* sps = pcPic->cs->sps;
+    ChromaFormat chromaFormatIDC = sps->getChromaFormatIdc();
+    if( m_upscaledOutput )
     {
-       numPicsNotYetDisplayed++;
-      dpbFullness++;
+      m_cVideoIOYuvReconFile[pcPic->layerId].writeUpscaledPicture( *sps, *pcPic->cs->pps, pcPic->getRecoBuf(), m_outputColourSpaceConvert, m_packedYUVMode, m_upscaledOutput, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
     }
-    else if(pcPic->referenced)
+    else
     {
-      dpbFullness++;
+      m_cVideoIOYuvReconFile[pcPic->layerId].write( pcPic->getRecoBuf().get( COMPONENT_Y ).width, pcPic->getRecoBuf().get( COMPONENT_Y ).height, pcPic->getRecoBuf(),
+                                  m_outputColourSpaceConvert,
+                                  m_packedYUVMode,
+                                  conf.getWindowLeftOffset() * SPS::getWinUnitX( chromaFormatIDC ),
+                                  conf.getWindowRightOffset() * SPS::getWinUnitX( chromaFormatIDC ),
+                                  conf.getWindowTopOffset() * SPS::getWinUnitY( chromaFormatIDC ),
+                                  conf.getWindowBottomOffset() * SPS::getWinUnitY( chromaFormatIDC ),
+                                  NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
     }
-    iterPic++;
   }
-
-  iterPic = pcListPic->begin();
-
-  if (numPicsNotYetDisplayed>2)
+  writeLineToOutputLog(pcPic);
+  if( m_checkDecStream )
   {
-    iterPic++;
+    xAddOutputPicDigest( pcPic );
   }
+}
 
-  Picture* pcPic = *(iterPic);
-  if( numPicsNotYetDisplayed>2 && pcPic->fieldPic ) //Field Decoding
+/** \param pcPicTop    top field bumped out of the DPB
+    \param pcPicBottom bottom field bumped out of the DPB
+ */
+void DecApp::writeFieldPair( Picture* pcPicTop, Picture* pcPicBottom )
+{
+  if ( !m_reconFileName.empty() )
   {
-    PicList::iterator endPic   = pcListPic->end();
-    endPic--;
-    iterPic   = pcListPic->begin();
-    while (iterPic != endPic)
-    {
-      Picture* pcPicTop = *(iterPic);
-      iterPic++;
-      Picture* pcPicBottom = *(iterPic);
-
-      if ( pcPicTop->neededForOutput && pcPicBottom->neededForOutput &&
-          (numPicsNotYetDisplayed >  numReorderPicsHighestTid || dpbFullness > maxDecPicBufferingHighestTid) &&
-          (!(pcPicTop->getPOC()%2) && pcPicBottom->getPOC() == pcPicTop->getPOC()+1) &&
-          (pcPicTop->getPOC() == m_iPOCLastDisplay+1 || m_iPOCLastDisplay < 0))
-      {
-        // write to file
-        numPicsNotYetDisplayed = numPicsNotYetDisplayed-2;
-        if ( !m_reconFileName.empty() )
-        {
-          const Window &conf = pcPicTop->cs->pps->getConformanceWindow();
-          const bool isTff = pcPicTop->topField;
-
-          bool display = true;
-
-          if (display)
-          {
-            m_cVideoIOYuvReconFile[pcPicTop->layerId].write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
-                                          m_outputColourSpaceConvert,
-                                          false, // TODO: m_packedYUVMode,
-                                          conf.getWindowLeftOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                          conf.getWindowRightOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                          conf.getWindowTopOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                          conf.getWindowBottomOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                          NUM_CHROMA_FORMAT, isTff );
-          }
-        }
-        writeLineToOutputLog(pcPicTop);
-        writeLineToOutputLog(pcPicBottom);
-
-        // update POC of display order
-        m_iPOCLastDisplay = pcPicBottom->getPOC();
-
-        // erase non-referenced picture in the reference picture list after display
-        if ( ! pcPicTop->referenced && pcPicTop->reconstructed )
-        {
-          pcPicTop->reconstructed = false;
-        }
-        if ( ! pcPicBottom->referenced && pcPicBottom->reconstructed )
-        {
-          pcPicBottom->reconstructed = false;
-        }
-        pcPicTop->neededForOutput = false;
-        pcPicBottom->neededForOutput = false;
-      }
-    }
+    const Window &conf = pcPicTop->cs->pps->getConformanceWindow();
+    const bool    isTff   = pcPicTop->topField;
+
+    m_cVideoIOYuvReconFile[pcPicTop->layerId].write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
+                                  m_outputColourSpaceConvert,
+                                  false, // TODO: m_packedYUVMode,
+                                  conf.getWindowLeftOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() ),
+                                  conf.getWindowRightOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() ),
+                                  conf.getWindowTopOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() ),
+                                  conf.getWindowBottomOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() ),
+                                  NUM_CHROMA_FORMAT, isTff );
   }
-  else if( !pcPic->fieldPic ) //Frame Decoding
+  writeLineToOutputLog(pcPicTop);
+  writeLineToOutputLog(pcPicBottom);
+  if( m_checkDecStream )
   {
-    iterPic = pcListPic->begin();
-
-    while (iterPic != pcListPic->end())
-    {
-      pcPic = *(iterPic);
-
-      if(pcPic->neededForOutput && pcPic->getPOC() > m_iPOCLastDisplay &&
-        (numPicsNotYetDisplayed >  numReorderPicsHighestTid || dpbFullness > maxDecPicBufferingHighestTid))
-      {
-        // write to file
-        numPicsNotYetDisplayed--;
-        if (!pcPic->referenced)
-        {
-          dpbFullness--;
-        }
-
-
-        if (!m_reconFileName.empty())
-        {
-          const Window &conf = pcPic->getConformanceWindow();
-          const SPS* sps = pcPic->cs->sps;
-          ChromaFormat chromaFormatIDC = sps->getChromaFormatIdc();
-          if( m_upscaledOutput )
-          {
-            m_cVideoIOYuvReconFile[pcPic->layerId].writeUpscaledPicture( *sps, *pcPic->cs->pps, pcPic->getRecoBuf(), m_outputColourSpaceConvert, m_packedYUVMode, m_upscaledOutput, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
-          }
-          else
-          {
-            m_cVideoIOYuvReconFile[pcPic->layerId].write( pcPic->getRecoBuf().get( COMPONENT_Y ).width, pcPic->getRecoBuf().get( COMPONENT_Y ).height, pcPic->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        m_packedYUVMode,
-                                        conf.getWindowLeftOffset() * SPS::getWinUnitX( chromaFormatIDC ),
-                                        conf.getWindowRightOffset() * SPS::getWinUnitX( chromaFormatIDC ),
-                                        conf.getWindowTopOffset() * SPS::getWinUnitY( chromaFormatIDC ),
-                                        conf.getWindowBottomOffset() * SPS::getWinUnitY( chromaFormatIDC ),
-                                        NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
-            }
-        }
-        writeLineToOutputLog(pcPic);
-
-        // update POC of display order
-        m_iPOCLastDisplay = pcPic->getPOC();
-
-        // erase non-referenced picture in the reference picture list after display
-        if (!pcPic->referenced && pcPic->reconstructed)
-        {
-          pcPic->reconstructed = false;
-        }
-        pcPic->neededForOutput = false;
-      }
-
-      iterPic++;
-    }
+    xAddOutputPicDigest( pcPicTop );
+    xAddOutputPicDigest( pcPicBottom );
   }
 }
 
-/** \param pcListPic list of pictures to be written to file
- */
-void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
+static std::string getOutputPicDigest( const Picture& pic, const CPelUnitBuf& buf )
 {
-  if(!pcListPic || pcListPic->empty())
-  {
-    return;
-  }
-  PicList::iterator iterPic   = pcListPic->begin();
-
-  iterPic   = pcListPic->begin();
-  Picture* pcPic = *(iterPic);
+  PictureHash digest;
+  const uint32_t numChar = calcMD5( buf, digest, pic.cs->sps->getBitDepths() );
 
-  if (pcPic->fieldPic ) //Field Decoding
-  {
-    PicList::iterator endPic   = pcListPic->end();
-    endPic--;
-    Picture *pcPicTop, *pcPicBottom = NULL;
-    while (iterPic != endPic)
-    {
-      pcPicTop = *(iterPic);
-      iterPic++;
-      pcPicBottom = *(iterPic);
-
-      if( pcPicTop->layerId != layerId && layerId != NOT_VALID )
-      {
-        continue;
-      }
+  return std::to_string( pic.layerId ) + " " + std::to_string( pic.getPOC() ) + " " + hashToString( digest, numChar );
+}
 
-      if ( pcPicTop->neededForOutput && pcPicBottom->neededForOutput && !(pcPicTop->getPOC()%2) && (pcPicBottom->getPOC() == pcPicTop->getPOC()+1) )
-      {
-        // write to file
-        if ( !m_reconFileName.empty() )
-        {
-          const Window &conf = pcPicTop->cs->pps->getConformanceWindow();
-          const bool    isTff   = pcPicTop->topField;
-
-          m_cVideoIOYuvReconFile[pcPicTop->layerId].write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        false, // TODO: m_packedYUVMode,
-                                        conf.getWindowLeftOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                        conf.getWindowRightOffset() * SPS::getWinUnitX( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                        conf.getWindowTopOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                        conf.getWindowBottomOffset() * SPS::getWinUnitY( pcPicTop->cs->sps->getChromaFormatIdc() ),
-                                        NUM_CHROMA_FORMAT, isTff );
-        }
-        writeLineToOutputLog(pcPicTop);
-        writeLineToOutputLog(pcPicBottom);
-        // update POC of display order
-        m_iPOCLastDisplay = pcPicBottom->getPOC();
+void DecApp::xAddOutputPicDigest( Picture* pcPic )
+{
+  const Picture& pic = *pcPic;
+  m_outputPicDigests.push_back( getOutputPicDigest( pic, pic.getRecoBuf().subBuf( DecStream::getOutputArea( pic ) ) ) );
+}
 
-        // erase non-referenced picture in the reference picture list after display
-        if( ! pcPicTop->referenced && pcPicTop->reconstructed )
-        {
-          pcPicTop->reconstructed = false;
-        }
-        if( ! pcPicBottom->referenced && pcPicBottom->reconstructed )
-        {
-          pcPicBottom->reconstructed = false;
-        }
-        pcPicTop->neededForOutput = false;
-        pcPicBottom->neededForOutput = false;
+/// compares the pictures output by DecStream with the digests recorded by DecApp
+class DecStreamOutputCheck : public DecPicOutputIf
+{
+public:
+  DecStreamOutputCheck( const std::vector<std::string>& digests ) : m_digests( digests ), m_numPictures( 0 ), m_numMismatches( 0 ) {}
 
-        if(pcPicTop)
-        {
-          pcPicTop->destroy();
-          delete pcPicTop;
-          pcPicTop = NULL;
-        }
-      }
-    }
-    if(pcPicBottom)
+  void outputPicture( const Picture& pic, const CPelUnitBuf& buf )
+  {
+    if( m_numPictures >= m_digests.size() || m_digests[m_numPictures] != getOutputPicDigest( pic, buf ) )
     {
-      pcPicBottom->destroy();
-      delete pcPicBottom;
-      pcPicBottom = NULL;
+      msg( ERROR, "DecStream output picture %d (layer %d POC %d) differs from the decoder output\n", int( m_numPictures ), pic.layerId, pic.getPOC() );
+      m_numMismatches++;
     }
+    m_numPictures++;
   }
-  else //Frame decoding
-  {
-    while (iterPic != pcListPic->end())
-    {
-      pcPic = *(iterPic);
-
-      if( pcPic->layerId != layerId && layerId != NOT_VALID )
-      {
-        iterPic++;
-        continue;
-      }
-
-      if (pcPic->neededForOutput)
-      {
-        // write to file
-
-        if (!m_reconFileName.empty())
-        {
-          const Window &conf = pcPic->getConformanceWindow();
-          const SPS* sps = pcPic->cs->sps;
-          ChromaFormat chromaFormatIDC = sps->getChromaFormatIdc();
-          if( m_upscaledOutput )
-          {
-            m_cVideoIOYuvReconFile[pcPic->layerId].writeUpscaledPicture( *sps, *pcPic->cs->pps, pcPic->getRecoBuf(), m_outputColourSpaceConvert, m_packedYUVMode, m_upscaledOutput, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
-          }
-          else
-          {
-            m_cVideoIOYuvReconFile[pcPic->layerId].write( pcPic->getRecoBuf().get( COMPONENT_Y ).width, pcPic->getRecoBuf().get( COMPONENT_Y ).height, pcPic->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        m_packedYUVMode,
-                                        conf.getWindowLeftOffset() * SPS::getWinUnitX( chromaFormatIDC ),
-                                        conf.getWindowRightOffset() * SPS::getWinUnitX( chromaFormatIDC ),
-                                        conf.getWindowTopOffset() * SPS::getWinUnitY( chromaFormatIDC ),
-                                        conf.getWindowBottomOffset() * SPS::getWinUnitY( chromaFormatIDC ),
-                                        NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
-            }
-        }
-        writeLineToOutputLog(pcPic);
 
-        // update POC of display order
-        m_iPOCLastDisplay = pcPic->getPOC();
+  size_t   getNumPictures  () const { return m_numPictures; }
+  uint32_t getNumMismatches() const { return m_numMismatches + uint32_t( m_digests.size() > m_numPictures ? m_digests.size() - m_numPictures : 0 ); }
 
-        // erase non-referenced picture in the reference picture list after display
-        if (!pcPic->referenced && pcPic->reconstructed)
-        {
-          pcPic->reconstructed = false;
-        }
-        pcPic->neededForOutput = false;
-      }
-      if(pcPic != NULL)
-      {
-        pcPic->destroy();
-        delete pcPic;
-        pcPic = NULL;
-        *iterPic = nullptr;
-      }
-      iterPic++;
-    }
-  }
+private:
+  const std::vector<std::string>& m_digests;
+  size_t                          m_numPictures;
+  uint32_t                        m_numMismatches;
+};
 
-  if( layerId != NOT_VALID )
+/**
+ - decode the bitstream a second time from memory with DecStream, pushed in chunks that are not aligned to NAL units
+ - returns the number of output pictures that differ from the ones of the file based decoder
+ */
+uint32_t DecApp::xCheckDecStream()
+{
+  std::ifstream bitstreamFile( m_bitstreamFileName.c_str(), std::ifstream::in | std::ifstream::binary );
+  const std::vector<uint8_t> data( ( std::istreambuf_iterator<char>( bitstreamFile ) ), std::istreambuf_iterator<char>() );
+
+  DecStreamOutputCheck outputCheck( m_outputPicDigests );
+
+  // the decoder is too large for the stack
+  DecStream* decStream = new DecStream;
+  decStream->setMaxTemporalLayer( m_iMaxTemporalLayer );
+  decStream->setTargetOlsIdx( m_targetOlsIdx );
+  decStream->setDecodedPictureHashSEIEnabled( m_decodedPictureHashSEIEnabled );
+  decStream->setOutputCallback( &outputCheck );
+  decStream->create();
+  decStream->getDecLib().m_targetSubPicIdx = m_targetSubPicIdx;
+
+  const size_t chunkSize = 4093;
+  for( size_t pos = 0; pos < data.size(); pos += chunkSize )
   {
-    pcListPic->remove_if([](Picture* p) { return p == nullptr; });
+    decStream->pushData( data.data() + pos, std::min( chunkSize, data.size() - pos ) );
   }
-  else
-  pcListPic->clear();
-  m_iPOCLastDisplay = -MAX_INT;
+  decStream->flush();
+  decStream->destroy();
+  delete decStream;
+
+  const uint32_t numMismatches = outputCheck.getNumMismatches();
+  msg( INFO, "\nDecStream check: %d mismatches, %d of %d pictures output\n", numMismatches, int( outputCheck.getNumPictures() ), int( m_outputPicDigests.size() ) );
+
+  return numMismatches;
 }
 
 /** \param nalu Input nalu to check whether its LayerId is within targetDecLayerIdSet
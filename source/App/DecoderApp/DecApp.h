@@ -55,7 +55,7 @@
 // ====================================================================================================================
 
 /// decoder application class
-class DecApp : public DecAppCfg
+class DecApp : public DecAppCfg, public DecPicWriterIf
 {
 private:
   // class interface
@@ -68,6 +68,8 @@ private:
 
   std::ofstream   m_oplFileStream;                ///< Used to output log file for confomance testing
 
+  std::vector<std::string> m_outputPicDigests;    ///< MD5 of the output pictures, for CheckDecStream
+
 
 
 private:
@@ -80,15 +82,18 @@ public:
 
   uint32_t  decode            (); ///< main decoding function
 
+  void  writePicture      ( Picture* pcPic );                             ///< write YUV of a bumped frame to file
+  void  writeFieldPair    ( Picture* pcPicTop, Picture* pcPicBottom );    ///< write YUV of a bumped field pair to file
+
 private:
   void  xCreateDecLib     (); ///< create internal classes
   void  xDestroyDecLib    (); ///< destroy internal classes
-  void  xWriteOutput      ( PicList* pcListPic , uint32_t tId); ///< write YUV to file
-  void  xFlushOutput( PicList* pcListPic, const int layerId = NOT_VALID ); ///< flush all remaining decoded pictures to file
   bool  isNewPicture(ifstream *bitstreamFile, class InputByteStream *bytestream);  ///< check if next NAL unit will be the first NAL unit from a new picture
   bool  isNewAccessUnit(bool newPicture, ifstream *bitstreamFile, class InputByteStream *bytestream);  ///< check if next NAL unit will be the first NAL unit from a new access unit
 
   void  writeLineToOutputLog(Picture * pcPic);
+  void  xAddOutputPicDigest ( Picture* pcPic );   ///< record the MD5 of an output picture for CheckDecStream
+  uint32_t xCheckDecStream  ();                   ///< decode with DecStream and compare, returns the number of mismatches
 
 };
 
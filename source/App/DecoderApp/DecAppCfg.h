@@ -72,6 +72,9 @@ protected:
   std::string   m_colourRemapSEIFileName;             ///< output Colour Remapping file name
   std::vector<int> m_targetDecLayerIdSet;             ///< set of LayerIds to be included in the sub-bitstream extraction process.
   std::string   m_outputDecodedSEIMessagesFilename;   ///< filename to output decoded SEI messages to. If '-', then use stdout. If empty, do not output details.
+#if ENABLE_STAGE_PROFILING
+  std::string   m_profilingFileName;                  ///< filename to output decoder timing statistics to. If empty, profiling is disabled.
+#endif
 
 
   bool          m_bClipOutputVideoToRec709Range;      ///< If true, clip the output video to the Rec 709 range on saving.
@@ -82,6 +85,7 @@ protected:
 
   int          m_upscaledOutput;                     ////< Output upscaled (2), decoded but in full resolution buffer (1) or decoded cropped (0, default) picture for RPR.
   int           m_targetSubPicIdx;                    ///< Specify which subpicture shall be write to output, using subpicture index
+  bool          m_checkDecStream;                     ///< decode the bitstream a second time with DecStream and compare the output pictures
 public:
   DecAppCfg();
   virtual ~DecAppCfg();
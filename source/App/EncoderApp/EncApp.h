@@ -82,7 +82,6 @@ private:
 private:
   // initialization
   void xCreateLib( std::list<PelUnitBuf*>& recBufList, const int layerId );         ///< create files & encoder class
-  void xInitLibCfg ();                           ///< initialize internal variables
   void xInitLib    (bool isFieldCoding);         ///< initialize encoder class
   void xDestroyLib ();                           ///< destroy encoder class
 
@@ -115,6 +114,9 @@ public:
 
   void  outputAU( const AccessUnit& au );
 
+  bool  getCheckEncStream() const { return m_checkEncStream; }
+  bool  checkEncStream();                       ///< encode again with EncStream and compare with the written bitstream
+
 #if JVET_O0756_CALCULATE_HDRMETRICS
   std::chrono::duration<long long, ratio<1, 1000000000>> getMetricTime()    const { return m_metricTime; };
 #endif
@@ -47,6 +47,7 @@
 #include "Utilities/program_options_lite.h"
 #include "CommonLib/Rom.h"
 #include "EncoderLib/RateCtrl.h"
+#include "EncoderLib/EncLib.h"
 
 #include "CommonLib/dtrace_next.h"
 
@@ -756,6 +757,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("PrintHexPSNR",                                    m_printHexPsnr,                                   false, "0 (default) don't emit hexadecimal PSNR for each frame, 1 = also emit hexadecimal PSNR values")
   ("PrintFrameMSE",                                   m_printFrameMSE,                                  false, "0 (default) emit only bit count and PSNRs for each frame, 1 = also emit MSE values")
   ("PrintSequenceMSE",                                m_printSequenceMSE,                               false, "0 (default) emit only bit rate and PSNRs for the whole sequence, 1 = also emit MSE values")
+  ("MetricThreads",                                   m_metricThreads,                                      1, "Number of threads used to compute the PSNR of the colour components of a picture")
+  ("AsyncMetrics",                                    m_asyncMetrics,                                   false, "0 (default) compute the PSNR of a picture right after it is coded, 1 = compute it in a worker thread while the next picture is coded and print the report of the picture afterwards")
   ("CabacZeroWordPaddingEnabled",                     m_cabacZeroWordPaddingEnabled,                     true, "0 do not add conforming cabac-zero-words to bit streams, 1 (default) = add cabac-zero-words as required")
   ("ChromaFormatIDC,-cf",                             tmpChromaFormat,                                      0, "ChromaFormatIDC (400|420|422|444 or set 0 (default) for same as InputChromaFormat)")
   ("ConformanceMode",                                 m_conformanceWindowMode,                              0, "Deprecated alias of ConformanceWindowMode")
@@ -782,6 +785,10 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
   ("SummaryPicFilenameBase",                          m_summaryPicFilenameBase,                      string(), "Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended. If empty, do not produce a file.")
   ("SummaryVerboseness",                              m_summaryVerboseness,                                0u, "Specifies the level of the verboseness of the text output")
+#if ENABLE_STAGE_PROFILING
+  ("ProfilingFile",                                   m_profilingFileName,                           string(), "Filename for per-stage timing statistics per picture, per temporal layer and per sequence (CSV, or JSON if the name ends with .json). If empty, profiling is disabled.")
+#endif
+  ("CheckEncStream",                                  m_checkEncStream,                                 false, "Encode the input a second time from memory with EncStream and compare the access units with the written bitstream")
   ("Verbosity,v",                                     m_verbosity,                               (int)VERBOSE, "Specifies the level of the verboseness")
 
 #if JVET_O0756_CONFIG_HDRMETRICS || JVET_O0756_CALCULATE_HDRMETRICS
@@ -904,6 +911,9 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("CIIP",                                            m_ciip,                                           false, "Enable CIIP mode")
   ("Geo",                                             m_Geo,                                            false, "Enable geometric partitioning mode (0:off, 1:on)")
   ("HashME",                                          m_HashME,                                         false, "Enable hash motion estimation (0:off, 1:on)")
+  ("HashMEThreads",                                   m_hashMEThreads,                                      1, "Number of threads used to build the hash motion estimation tables")
+  ("HierarchicalME",                                  m_hierarchicalME,                                 false, "Seed the TZ search with a motion field estimated on downsampled luma before the CTUs are coded (0:off, 1:on)")
+  ("HierarchicalMEThreads",                           m_hierarchicalMEThreads,                              1, "Number of threads used by the hierarchical motion estimation")
 
   ("AllowDisFracMMVD",                                m_allowDisFracMMVD,                               false, "Disable fractional MVD in MMVD mode adaptively")
   ("AffineAmvr",                                      m_AffineAmvr,                                     false, "Eanble AMVR for affine inter mode")
@@ -923,6 +933,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
 
   ("WrapAround",                                      m_wrapAround,                                     false, "Enable horizontal wrap-around motion compensation for inter prediction (0:off, 1:on)  [default: off]")
   ("WrapAroundOffset",                                m_wrapAroundOffset,                                  0u, "Offset in luma samples used for computing the horizontal wrap-around position")
+  ("BorderExtThreads",                                m_borderExtThreads,                                   1, "Number of threads used to extend the borders of reference pictures")
 
   // ADD_NEW_TOOL : (encoder app) add parsing parameters here
   ( "VirtualBoundariesPresentInSPSFlag",              m_virtualBoundariesPresentFlag,                    true, "Virtual Boundary position information is signalled in SPS or PH (1:SPS, 0:PH)  [default: on]" )
@@ -946,6 +957,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("AMaxBT",                                          m_useAMaxBT,                                      false, "Adaptive maximal BT-size")
   ("E0023FastEnc",                                    m_e0023FastEnc,                                    true, "Fast encoding setting for QTBT (proposal E0023)")
   ("ContentBasedFastQtbt",                            m_contentBasedFastQtbt,                           false, "Signal based QTBT speed-up")
+  ("FastPartition",                                   m_fastPartition,                                     0u, "Content adaptive early termination of the split tests (0: off, 1: conservative, 2: medium, 3: aggressive)")
+  ("TemporalCuReuse",                                 m_temporalCuReuse,                                false, "Reuse the CU depths and skip decisions of the closest reference picture of the same temporal layer")
   ("UseNonLinearAlfLuma",                             m_useNonLinearAlfLuma,                             true, "Non-linear adaptive loop filters for Luma Channel")
   ("UseNonLinearAlfChroma",                           m_useNonLinearAlfChroma,                           true, "Non-linear adaptive loop filters for Chroma Channels")
   ("MaxNumAlfAlternativesChroma",                     m_maxNumAlfAlternativesChroma,
@@ -954,6 +967,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("MIP",                                             m_MIP,                                             true,  "Enable MIP (matrix-based intra prediction)")
   ("FastMIP",                                         m_useFastMIP,                                     false,  "Fast encoder search for MIP (matrix-based intra prediction)")
   ("FastLocalDualTreeMode",                           m_fastLocalDualTreeMode,                              0,  "Fast intra pass coding for local dual-tree in intra coding region, 0: off, 1: use threshold, 2: one intra mode only")
+  ("FastResidualRate",                                m_useFastResidualRate,                            false, "Estimate the residual rates of the mode decision from the context states at the start of each CTU, without context updates")
   // Unit definition parameters
   ("MaxCUWidth",                                      m_uiMaxCUWidth,                                     64u)
   ("MaxCUHeight",                                     m_uiMaxCUHeight,                                    64u)
@@ -1146,6 +1160,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("FDM",                                             m_useFastDecisionForMerge,                         true, "Fast decision for Merge RD Cost")
   ("CFM",                                             m_bUseCbfFastMode,                                false, "Cbf fast mode setting")
   ("ESD",                                             m_useEarlySkipDetection,                          false, "Early SKIP detection setting")
+  ( "LookAhead",                                      m_lookAhead,                                      false, "Analyse the buffered pictures ahead of the GOP encoder for scene cuts and rate control complexity estimates" )
+  ( "SceneCutThreshold",                              m_sceneCutThreshold,                                 40, "Look-ahead: scene cut sensitivity in percent, 0 disables the insertion of intra pictures at scene cuts" )
   ( "RateControl",                                    m_RCEnableRateControl,                            false, "Rate control: enable rate control" )
   ( "TargetBitrate",                                  m_RCTargetBitrate,                                    0, "Rate control: target bit-rate" )
   ( "KeepHierarchicalBit",                            m_RCKeepHierarchicalBit,                              0, "Rate control: 0: equal bit allocation; 1: fixed ratio bit allocation; 2: adaptive ratio bit allocation" )
@@ -1153,6 +1169,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ( "RCLCUSeparateModel",                             m_RCUseLCUSeparateModel,                           true, "Rate control: use CTU level separate R-lambda model" )
   ( "InitialQP",                                      m_RCInitialQP,                                        0, "Rate control: initial QP" )
   ( "RCForceIntraQP",                                 m_RCForceIntraQP,                                 false, "Rate control: force intra QP to be equal to initial QP" )
+  ( "RCPass",                                         m_RCPass,                                             0, "Rate control: 0: single pass; 1: fast first pass writing statistics to RCStatsFile; 2: second pass allocating bits from RCStatsFile" )
+  ( "RCStatsFile",                                    m_RCStatsFileName,                           string(""), "Rate control: file of the first pass statistics" )
 #if U0132_TARGET_BITS_SATURATION
   ( "RCCpbSaturation",                                m_RCCpbSaturationEnabled,                         false, "Rate control: enable target bits saturation to avoid CPB overflow and underflow" )
   ( "RCCpbSize",                                      m_RCCpbSize,                                         0u, "Rate control: CPB size" )
@@ -1355,6 +1373,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ( "ScalingRatioVer",                                m_scalingRatioVer,                          1.0, "Scaling ratio in ver direction" )
   ( "FractionNumFrames",                              m_fractionOfFrames,                         1.0, "Encode a fraction of the specified in FramesToBeEncoded frames" )
   ( "SwitchPocPeriod",                                m_switchPocPeriod,                            0, "Switch POC period for RPR" )
+  ( "RPRThreads",                                     m_rprThreads,                                 1, "Number of threads used to resample pictures for RPR" )
   ( "UpscaledOutput",                                 m_upscaledOutput,                             0, "Output upscaled (2), decoded but in full resolution buffer (1) or decoded cropped (0, default) picture for RPR" )
   ( "MaxLayers",                                      m_maxLayers,                                  1, "Max number of layers" )
   ( "TargetOutputLayerSet,p",                         m_targetOlsIdx,                              -1, "Target output layer set index" )
@@ -2322,6 +2341,814 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
 }
 
 
+/**
+ - configure an encoder library and its VPS from the parsed configuration, used by the encoder application and to set
+   up an EncStream in the same way
+ */
+void EncAppCfg::initEncLibCfg( EncLib& encLib )
+{
+  VPS& vps = *encLib.getVPS();
+  vps.m_targetOlsIdx = m_targetOlsIdx;
+
+  vps.setMaxLayers( m_maxLayers );
+
+  if (vps.getMaxLayers() > 1)
+  {
+    vps.setVPSId(1);  //JVET_P0205 vps_video_parameter_set_id shall be greater than 0 for multi-layer coding
+  }
+  else
+  {
+    vps.setVPSId(0);
+    vps.setEachLayerIsAnOlsFlag(1); // If vps_max_layers_minus1 is equal to 0,
+                                    // the value of each_layer_is_an_ols_flag is inferred to be equal to 1.
+                                    // Otherwise, when vps_all_independent_layers_flag is equal to 0,
+                                    // the value of each_layer_is_an_ols_flag is inferred to be equal to 0.
+  }
+  vps.setMaxSubLayers(m_maxSublayers);
+  if (vps.getMaxLayers() > 1 && vps.getMaxSubLayers() > 1)
+  {
+    vps.setAllLayersSameNumSublayersFlag(m_allLayersSameNumSublayersFlag);
+  }
+  if (vps.getMaxLayers() > 1)
+  {
+    vps.setAllIndependentLayersFlag(m_allIndependentLayersFlag);
+    if (!vps.getAllIndependentLayersFlag())
+    {
+      vps.setEachLayerIsAnOlsFlag(0);
+      for (int i = 0; i < m_maxTempLayer; i++)
+      {
+        vps.setPredDirection(i, 0);
+      }
+      for (int i = 0; i < m_predDirectionArray.size(); i++)
+      {
+        if (m_predDirectionArray[i] != ' ')
+        {
+          vps.setPredDirection(i >> 1, int(m_predDirectionArray[i] - 48));
+        }
+      }
+    }
+  }
+
+  for (int i = 0; i < vps.getMaxLayers(); i++)
+  {
+    vps.setGeneralLayerIdx( m_layerId[i], i );
+    vps.setLayerId(i, m_layerId[i]);
+
+    if (i > 0 && !vps.getAllIndependentLayersFlag())
+    {
+      vps.setIndependentLayerFlag( i, m_numRefLayers[i] ? false : true );
+
+      if (!vps.getIndependentLayerFlag(i))
+      {
+        for (int j = 0, k = 0; j < i; j++)
+        {
+          if (m_refLayerIdxStr[i].find(to_string(j)) != std::string::npos)
+          {
+            vps.setDirectRefLayerFlag(i, j, true);
+            vps.setInterLayerRefIdc( i, j, k );
+            vps.setDirectRefLayerIdx(i, k++, j);
+          }
+          else
+          {
+            vps.setDirectRefLayerFlag(i, j, false);
+          }
+        }
+      }
+    }
+  }
+
+
+  if (vps.getMaxLayers() > 1)
+  {
+    if (vps.getAllIndependentLayersFlag())
+    {
+      vps.setEachLayerIsAnOlsFlag(m_eachLayerIsAnOlsFlag);
+      if (vps.getEachLayerIsAnOlsFlag() == 0)
+      {
+        vps.setOlsModeIdc(2); // When vps_all_independent_layers_flag is equal to 1 and each_layer_is_an_ols_flag is equal to 0, the value of ols_mode_idc is inferred to be equal to 2
+      }
+    }
+    if (!vps.getEachLayerIsAnOlsFlag())
+    {
+      if (!vps.getAllIndependentLayersFlag())
+      {
+        vps.setOlsModeIdc(m_olsModeIdc);
+      }
+      if (vps.getOlsModeIdc() == 2)
+      {
+        vps.setNumOutputLayerSets(m_numOutputLayerSets);
+        for (int i = 1; i < vps.getNumOutputLayerSets(); i++)
+        {
+          for (int j = 0; j < vps.getMaxLayers(); j++)
+          {
+            if (m_olsOutputLayerStr[i].find(to_string(j)) != std::string::npos)
+            {
+              vps.setOlsOutputLayerFlag(i, j, 1);
+            }
+            else
+            {
+              vps.setOlsOutputLayerFlag(i, j, 0);
+            }
+          }
+        }
+      }
+    }
+  }
+  CHECK( m_numPtlsInVps == 0, "There has to be at least one PTL structure in the VPS." );
+  vps.setNumPtls                                                 ( m_numPtlsInVps );
+  vps.setPtPresentFlag                                           (0, 1);
+  for (int i = 0; i < vps.getNumPtls(); i++)
+  {
+    if( i > 0 )
+      vps.setPtPresentFlag                                         (i, 0);
+    vps.setPtlMaxTemporalId                                      (i, vps.getMaxSubLayers() - 1);
+  }
+  for (int i = 0; i < vps.getNumOutputLayerSets(); i++)
+  {
+    vps.setOlsPtlIdx                                             (i, m_olsPtlIdx[i]);
+  }
+  std::vector<ProfileTierLevel> ptls;
+  ptls.resize(vps.getNumPtls());
+  // PTL0 shall be the same as the one signalled in the SPS
+  ptls[0].setLevelIdc                                            ( m_level );
+  ptls[0].setProfileIdc                                          ( m_profile);
+  ptls[0].setTierFlag                                            ( m_levelTier );
+  ptls[0].setNumSubProfile                                       ( m_numSubProfile );
+  for (int i = 0; i < m_numSubProfile; i++)
+  {
+    ptls[0].setSubProfileIdc                                   (i, m_subProfile[i]);
+  }
+  for(int i = 1; i < vps.getNumPtls(); i++)
+  {
+    ptls[i].setLevelIdc                                          (m_levelPtl[i]);
+  }
+  vps.setProfileTierLevel(ptls);
+  vps.setVPSExtensionFlag                                        ( false );
+  encLib.setProfile                                           ( m_profile);
+  encLib.setLevel                                             ( m_levelTier, m_level);
+  encLib.setNumSubProfile                                     ( m_numSubProfile );
+  for (int i = 0; i < m_numSubProfile; i++)
+  {
+    encLib.setSubProfile(i, m_subProfile[i]);
+  }
+  encLib.setNonPackedConstraintFlag                           ( m_nonPackedConstraintFlag);
+  encLib.setNonProjectedConstraintFlag                        ( m_nonProjectedConstraintFlag );
+  encLib.setSingleLayerConstraintFlag                         ( m_singleLayerConstraintFlag );
+  encLib.setAllLayersIndependentConstraintFlag                ( m_allLayersIndependentConstraintFlag );
+  encLib.setNoResChangeInClvsConstraintFlag                   ( m_noResChangeInClvsConstraintFlag );
+  encLib.setOneTilePerPicConstraintFlag                       ( m_oneTilePerPicConstraintFlag );
+  encLib.setPicHeaderInSliceHeaderConstraintFlag              ( m_picHeaderInSliceHeaderConstraintFlag );
+  encLib.setOneSlicePerPicConstraintFlag                      ( m_oneSlicePerPicConstraintFlag );
+  encLib.setOneSubpicPerPicConstraintFlag                     ( m_oneSubpicPerPicConstraintFlag );
+  encLib.setFrameOnlyConstraintFlag                           ( m_frameOnlyConstraintFlag);
+  encLib.setIntraConstraintFlag                               ( m_intraConstraintFlag );
+
+  encLib.setPrintMSEBasedSequencePSNR                         ( m_printMSEBasedSequencePSNR);
+  encLib.setPrintFrameMSE                                     ( m_printFrameMSE);
+  encLib.setPrintHexPsnr(m_printHexPsnr);
+  encLib.setPrintSequenceMSE                                  ( m_printSequenceMSE);
+  encLib.setMetricThreads                                     ( m_metricThreads );
+  encLib.setAsyncMetrics                                      ( m_asyncMetrics );
+  encLib.setCabacZeroWordPaddingEnabled                       ( m_cabacZeroWordPaddingEnabled );
+
+  encLib.setFrameRate                                         ( m_iFrameRate );
+  encLib.setFrameSkip                                         ( m_FrameSkip );
+  encLib.setTemporalSubsampleRatio                            ( m_temporalSubsampleRatio );
+  encLib.setSourceWidth                                       ( m_iSourceWidth );
+  encLib.setSourceHeight                                      ( m_iSourceHeight );
+  encLib.setConformanceWindow                                 ( m_confWinLeft / SPS::getWinUnitX( m_InputChromaFormatIDC ), m_confWinRight / SPS::getWinUnitX( m_InputChromaFormatIDC ), m_confWinTop / SPS::getWinUnitY( m_InputChromaFormatIDC ), m_confWinBottom / SPS::getWinUnitY( m_InputChromaFormatIDC ) );
+  encLib.setScalingRatio                                      ( m_scalingRatioHor, m_scalingRatioVer );
+  encLib.setResChangeInClvsEnabled                            ( m_resChangeInClvsEnabled );
+  encLib.setSwitchPocPeriod                                   ( m_switchPocPeriod );
+  encLib.setRprThreads                                        ( m_rprThreads );
+  encLib.setUpscaledOutput                                    ( m_upscaledOutput );
+  encLib.setFramesToBeEncoded                                 ( m_framesToBeEncoded );
+
+  encLib.setAvoidIntraInDepLayer                              ( m_avoidIntraInDepLayer );
+
+  //====== SPS constraint flags =======
+  encLib.setOnePictureOnlyConstraintFlag                      ( m_onePictureOnlyConstraintFlag );
+  encLib.setIntraOnlyConstraintFlag                           ( m_intraConstraintFlag );  // NOTE: This setting is not used, and is confused with setIntraConstraintFlag
+  encLib.setMaxBitDepthConstraintIdc                          ( m_bitDepthConstraint - 8 );
+  encLib.setMaxChromaFormatConstraintIdc                      ( m_chromaFormatConstraint );
+  encLib.setFrameConstraintFlag                               ( m_bFrameConstraintFlag ); // NOTE: This setting is neither used nor setup, and is confused with setFrameOnlyConstraintFlag
+  encLib.setNoQtbttDualTreeIntraConstraintFlag                ( !m_dualTree );
+  encLib.setNoPartitionConstraintsOverrideConstraintFlag      ( !m_SplitConsOverrideEnabledFlag );
+  encLib.setNoSaoConstraintFlag                               ( !m_bUseSAO );
+  encLib.setNoAlfConstraintFlag                               ( !m_alf );
+  encLib.setNoCCAlfConstraintFlag                             ( !m_ccalf );
+  encLib.setNoRefWraparoundConstraintFlag                     ( m_bNoRefWraparoundConstraintFlag );
+  encLib.setNoTemporalMvpConstraintFlag                       ( m_TMVPModeId ? false : true );
+  encLib.setNoSbtmvpConstraintFlag                            ( m_SubPuMvpMode ? false : true );
+  encLib.setNoAmvrConstraintFlag                              ( m_bNoAmvrConstraintFlag );
+  encLib.setNoBdofConstraintFlag                              ( !m_BIO );
+  encLib.setNoDmvrConstraintFlag                              ( !m_DMVR );
+  encLib.setNoCclmConstraintFlag                              ( m_LMChroma ? false : true );
+  encLib.setNoMtsConstraintFlag                               ( (m_MTS || m_MTSImplicit) ? false : true );
+  encLib.setNoSbtConstraintFlag                               ( !m_SBT );
+  encLib.setNoAffineMotionConstraintFlag                      ( !m_Affine );
+  encLib.setNoBcwConstraintFlag                               ( !m_bcw );
+  encLib.setNoIbcConstraintFlag                               ( m_IBCMode ? false : true );
+  encLib.setNoCiipConstraintFlag                           ( !m_ciip );
+  encLib.setNoGeoConstraintFlag                               ( !m_Geo );
+  encLib.setNoLadfConstraintFlag                              ( !m_LadfEnabed );
+  encLib.setNoTransformSkipConstraintFlag                     ( !m_useTransformSkip );
+  encLib.setNoBDPCMConstraintFlag                             ( !m_useBDPCM );
+  encLib.setNoJointCbCrConstraintFlag                         (!m_JointCbCrMode);
+  encLib.setNoQpDeltaConstraintFlag                           ( m_bNoQpDeltaConstraintFlag );
+  encLib.setNoDepQuantConstraintFlag                          ( !m_depQuantEnabledFlag);
+  encLib.setNoSignDataHidingConstraintFlag                    ( !m_signDataHidingEnabledFlag );
+  encLib.setNoTrailConstraintFlag                             ( m_iIntraPeriod == 1 );
+  encLib.setNoStsaConstraintFlag                              ( m_iIntraPeriod == 1 || !xHasNonZeroTemporalID() );
+  encLib.setNoRaslConstraintFlag                              ( m_iIntraPeriod == 1 || !xHasLeadingPicture() );
+  encLib.setNoRadlConstraintFlag                              ( m_iIntraPeriod == 1 || !xHasLeadingPicture() );
+  encLib.setNoIdrConstraintFlag                               ( false ); // Not yet possible to encode bitstream starting with a GDR picture
+  encLib.setNoCraConstraintFlag                               ( m_iDecodingRefreshType != 1 );
+  encLib.setNoGdrConstraintFlag                               ( false ); // Not yet possible to encode GDR using config parameters
+  encLib.setNoApsConstraintFlag                               ( !m_alf && !m_lmcsEnabled && m_useScalingListId == SCALING_LIST_OFF);
+  encLib.setNoMrlConstraintFlag                               ( !m_MRL );
+  encLib.setNoIspConstraintFlag                               ( !m_ISP );
+  encLib.setNoMipConstraintFlag                               ( !m_MIP );
+  encLib.setNoLfnstConstraintFlag                             ( !m_LFNST );
+  encLib.setNoMmvdConstraintFlag                              ( !m_MMVD );
+  encLib.setNoSmvdConstraintFlag                              ( !m_SMVD );
+  encLib.setNoProfConstraintFlag                              ( !m_PROF );
+  encLib.setNoPaletteConstraintFlag                           ( m_PLTMode == 1 ? false : true );
+  encLib.setNoActConstraintFlag                               ( !m_useColorTrans );
+  encLib.setNoLmcsConstraintFlag                              ( !m_lmcsEnabled );
+
+
+  //====== Coding Structure ========
+  encLib.setIntraPeriod                                       ( m_iIntraPeriod );
+  encLib.setDecodingRefreshType                               ( m_iDecodingRefreshType );
+  encLib.setGOPSize                                           ( m_iGOPSize );
+  encLib.setDrapPeriod                                        ( m_drapPeriod );
+  encLib.setReWriteParamSets                                  ( m_rewriteParamSets );
+  encLib.setRPLList0                                          ( m_RPLList0);
+  encLib.setRPLList1                                          ( m_RPLList1);
+  encLib.setIDRRefParamListPresent                            ( m_idrRefParamList );
+  encLib.setGopList                                           ( m_GOPList );
+
+  for(int i = 0; i < MAX_TLAYER; i++)
+  {
+    encLib.setNumReorderPics                                  ( m_numReorderPics[i], i );
+    encLib.setMaxDecPicBuffering                              ( m_maxDecPicBuffering[i], i );
+  }
+  for( uint32_t uiLoop = 0; uiLoop < MAX_TLAYER; ++uiLoop )
+  {
+    encLib.setLambdaModifier                                  ( uiLoop, m_adLambdaModifier[ uiLoop ] );
+  }
+  encLib.setIntraLambdaModifier                               ( m_adIntraLambdaModifier );
+  encLib.setIntraQpFactor                                     ( m_dIntraQpFactor );
+
+  encLib.setBaseQP                                            ( m_iQP );
+
+#if X0038_LAMBDA_FROM_QP_CAPABILITY
+  encLib.setIntraQPOffset                                     ( m_intraQPOffset );
+  encLib.setLambdaFromQPEnable                                ( m_lambdaFromQPEnable );
+#endif
+  encLib.setChromaQpMappingTableParams                         (m_chromaQpMappingTableParams);
+
+  encLib.setPad                                               ( m_aiPad );
+
+  encLib.setAccessUnitDelimiter                               ( m_AccessUnitDelimiter );
+  encLib.setEnablePictureHeaderInSliceHeader                  ( m_enablePictureHeaderInSliceHeader );
+
+  encLib.setMaxTempLayer                                      ( m_maxTempLayer );
+
+  //===== Slice ========
+
+  //====== Loop/Deblock Filter ========
+  encLib.setLoopFilterDisable                                 ( m_bLoopFilterDisable       );
+  encLib.setLoopFilterOffsetInPPS                             ( m_loopFilterOffsetInPPS );
+  encLib.setLoopFilterBetaOffset                              ( m_loopFilterBetaOffsetDiv2  );
+  encLib.setLoopFilterTcOffset                                ( m_loopFilterTcOffsetDiv2    );
+  encLib.setLoopFilterCbBetaOffset                            ( m_loopFilterCbBetaOffsetDiv2  );
+  encLib.setLoopFilterCbTcOffset                              ( m_loopFilterCbTcOffsetDiv2    );
+  encLib.setLoopFilterCrBetaOffset                            ( m_loopFilterCrBetaOffsetDiv2  );
+  encLib.setLoopFilterCrTcOffset                              ( m_loopFilterCrTcOffsetDiv2    );
+#if W0038_DB_OPT
+  encLib.setDeblockingFilterMetric                            ( m_deblockingFilterMetric );
+#else
+  encLib.setDeblockingFilterMetric                            ( m_DeblockingFilterMetric );
+#endif
+
+  //====== Motion search ========
+  encLib.setDisableIntraPUsInInterSlices                      ( m_bDisableIntraPUsInInterSlices );
+  encLib.setMotionEstimationSearchMethod                      ( m_motionEstimationSearchMethod  );
+  encLib.setSearchRange                                       ( m_iSearchRange );
+  encLib.setBipredSearchRange                                 ( m_bipredSearchRange );
+  encLib.setClipForBiPredMeEnabled                            ( m_bClipForBiPredMeEnabled );
+  encLib.setFastMEAssumingSmootherMVEnabled                   ( m_bFastMEAssumingSmootherMVEnabled );
+  encLib.setMinSearchWindow                                   ( m_minSearchWindow );
+  encLib.setRestrictMESampling                                ( m_bRestrictMESampling );
+
+  //====== Quality control ========
+  encLib.setMaxDeltaQP                                        ( m_iMaxDeltaQP  );
+  encLib.setCuQpDeltaSubdiv                                   ( m_cuQpDeltaSubdiv );
+  encLib.setCuChromaQpOffsetSubdiv                            ( m_cuChromaQpOffsetSubdiv );
+  encLib.setChromaCbQpOffset                                  ( m_cbQpOffset     );
+  encLib.setChromaCrQpOffset                                  ( m_crQpOffset  );
+  encLib.setChromaCbQpOffsetDualTree                          ( m_cbQpOffsetDualTree );
+  encLib.setChromaCrQpOffsetDualTree                          ( m_crQpOffsetDualTree );
+  encLib.setChromaCbCrQpOffset                                ( m_cbCrQpOffset         );
+  encLib.setChromaCbCrQpOffsetDualTree                        ( m_cbCrQpOffsetDualTree );
+#if ER_CHROMA_QP_WCG_PPS
+  encLib.setWCGChromaQpControl                                ( m_wcgChromaQpControl );
+#endif
+#if W0038_CQP_ADJ
+  encLib.setSliceChromaOffsetQpIntraOrPeriodic                ( m_sliceChromaQpOffsetPeriodicity, m_sliceChromaQpOffsetIntraOrPeriodic );
+#endif
+  encLib.setChromaFormatIdc                                   ( m_chromaFormatIDC  );
+  encLib.setUseAdaptiveQP                                     ( m_bUseAdaptiveQP  );
+  encLib.setQPAdaptationRange                                 ( m_iQPAdaptationRange );
+#if ENABLE_QPA
+  encLib.setUsePerceptQPA                                     ( m_bUsePerceptQPA && !m_bUseAdaptiveQP );
+  encLib.setUseWPSNR                                          ( m_bUseWPSNR );
+#endif
+  encLib.setExtendedPrecisionProcessingFlag                   ( m_extendedPrecisionProcessingFlag );
+  encLib.setHighPrecisionOffsetsEnabledFlag                   ( m_highPrecisionOffsetsEnabledFlag );
+
+  encLib.setWeightedPredictionMethod( m_weightedPredictionMethod );
+
+  //====== Tool list ========
+#if SHARP_LUMA_DELTA_QP
+  encLib.setLumaLevelToDeltaQPControls                        ( m_lumaLevelToDeltaQPMapping );
+#endif
+#if X0038_LAMBDA_FROM_QP_CAPABILITY
+  encLib.setDeltaQpRD( (m_costMode==COST_LOSSLESS_CODING) ? 0 : m_uiDeltaQpRD );
+#else
+  encLib.setDeltaQpRD                                         ( m_uiDeltaQpRD  );
+#endif
+  encLib.setFastDeltaQp                                       ( m_bFastDeltaQP  );
+  encLib.setUseASR                                            ( m_bUseASR      );
+  encLib.setUseHADME                                          ( m_bUseHADME    );
+  encLib.setdQPs                                              ( m_aidQP        );
+  encLib.setUseRDOQ                                           ( m_useRDOQ     );
+  encLib.setUseRDOQTS                                         ( m_useRDOQTS   );
+#if T0196_SELECTIVE_RDOQ
+  encLib.setUseSelectiveRDOQ                                  ( m_useSelectiveRDOQ );
+#endif
+  encLib.setRDpenalty                                         ( m_rdPenalty );
+  encLib.setCTUSize                                           ( m_uiCTUSize );
+  encLib.setSubPicInfoPresentFlag                             ( m_subPicInfoPresentFlag );
+  if(m_subPicInfoPresentFlag)
+  {
+    encLib.setNumSubPics                                      ( m_numSubPics );
+    encLib.setSubPicCtuTopLeftX                               ( m_subPicCtuTopLeftX );
+    encLib.setSubPicCtuTopLeftY                               ( m_subPicCtuTopLeftY );
+    encLib.setSubPicWidth                                     ( m_subPicWidth );
+    encLib.setSubPicHeight                                    ( m_subPicHeight );
+    encLib.setSubPicTreatedAsPicFlag                          ( m_subPicTreatedAsPicFlag );
+    encLib.setLoopFilterAcrossSubpicEnabledFlag               ( m_loopFilterAcrossSubpicEnabledFlag );
+    encLib.setSubPicIdMappingInSpsFlag                        ( m_subPicIdMappingInSpsFlag );
+    encLib.setSubPicIdLen                                     ( m_subPicIdLen );
+    encLib.setSubPicIdMappingExplicitlySignalledFlag          ( m_subPicIdMappingExplicitlySignalledFlag );
+    if (m_subPicIdMappingExplicitlySignalledFlag)
+    {
+      encLib.setSubPicId                                      ( m_subPicId );
+    }
+  }
+  else
+  {
+    encLib.setNumSubPics                                      ( 1 );
+    encLib.setSubPicIdMappingExplicitlySignalledFlag          ( false );
+  }
+
+  encLib.setUseSplitConsOverride                              ( m_SplitConsOverrideEnabledFlag );
+  encLib.setMinQTSizes                                        ( m_uiMinQT );
+  encLib.setMaxMTTHierarchyDepth                              ( m_uiMaxMTTHierarchyDepth, m_uiMaxMTTHierarchyDepthI, m_uiMaxMTTHierarchyDepthIChroma );
+  encLib.setMaxBTSizes                                        ( m_uiMaxBT );
+  encLib.setMaxTTSizes                                        ( m_uiMaxTT );
+  encLib.setDualITree                                         ( m_dualTree );
+  encLib.setLFNST                                             ( m_LFNST );
+  encLib.setUseFastLFNST                                      ( m_useFastLFNST );
+  encLib.setSubPuMvpMode                                      ( m_SubPuMvpMode );
+  encLib.setAffine                                            ( m_Affine );
+  encLib.setAffineType                                        ( m_AffineType );
+  encLib.setPROF                                              ( m_PROF );
+  encLib.setBIO                                               (m_BIO);
+  encLib.setUseLMChroma                                       ( m_LMChroma );
+  encLib.setHorCollocatedChromaFlag                           ( m_horCollocatedChromaFlag );
+  encLib.setVerCollocatedChromaFlag                           ( m_verCollocatedChromaFlag );
+  encLib.setIntraMTS                                          ( m_MTS & 1 );
+  encLib.setInterMTS                                          ( ( m_MTS >> 1 ) & 1 );
+  encLib.setMTSIntraMaxCand                                   ( m_MTSIntraMaxCand );
+  encLib.setMTSInterMaxCand                                   ( m_MTSInterMaxCand );
+  encLib.setImplicitMTS                                       ( m_MTSImplicit );
+  encLib.setUseSBT                                            ( m_SBT );
+  encLib.setSBTFast64WidthTh                                  ( m_SBTFast64WidthTh );
+  encLib.setUseCompositeRef                                   ( m_compositeRefEnabled );
+  encLib.setUseSMVD                                           ( m_SMVD );
+  encLib.setUseBcw                                            ( m_bcw );
+  encLib.setUseBcwFast                                        ( m_BcwFast );
+#if LUMA_ADAPTIVE_DEBLOCKING_FILTER_QP_OFFSET
+  encLib.setUseLadf                                           ( m_LadfEnabed );
+  if ( m_LadfEnabed )
+  {
+    encLib.setLadfNumIntervals                                ( m_LadfNumIntervals);
+    for ( int k = 0; k < m_LadfNumIntervals; k++ )
+    {
+      encLib.setLadfQpOffset( m_LadfQpOffset[k], k );
+      encLib.setLadfIntervalLowerBound(m_LadfIntervalLowerBound[k], k);
+    }
+  }
+#endif
+  encLib.setUseCiip                                        ( m_ciip );
+  encLib.setUseGeo                                            ( m_Geo );
+  encLib.setUseHashME                                         ( m_HashME );
+  encLib.setHashMEThreads                                     ( m_hashMEThreads );
+  encLib.setUseHierarchicalME                                 ( m_hierarchicalME );
+  encLib.setHierarchicalMEThreads                             ( m_hierarchicalMEThreads );
+
+  encLib.setAllowDisFracMMVD                                  ( m_allowDisFracMMVD );
+  encLib.setUseAffineAmvr                                     ( m_AffineAmvr );
+  encLib.setUseAffineAmvrEncOpt                               ( m_AffineAmvrEncOpt );
+  encLib.setDMVR                                              ( m_DMVR );
+  encLib.setMMVD                                              ( m_MMVD );
+  encLib.setMmvdDisNum                                        (m_MmvdDisNum);
+  encLib.setRGBFormatFlag(m_rgbFormat);
+  encLib.setUseColorTrans(m_useColorTrans);
+  encLib.setPLTMode                                           ( m_PLTMode );
+  encLib.setJointCbCr                                         ( m_JointCbCrMode );
+  encLib.setIBCMode                                           ( m_IBCMode );
+  encLib.setIBCLocalSearchRangeX                              ( m_IBCLocalSearchRangeX );
+  encLib.setIBCLocalSearchRangeY                              ( m_IBCLocalSearchRangeY );
+  encLib.setIBCHashSearch                                     ( m_IBCHashSearch );
+  encLib.setIBCHashSearchMaxCand                              ( m_IBCHashSearchMaxCand );
+  encLib.setIBCHashSearchRange4SmallBlk                       ( m_IBCHashSearchRange4SmallBlk );
+  encLib.setIBCFastMethod                                     ( m_IBCFastMethod );
+
+  encLib.setUseWrapAround                                     ( m_wrapAround );
+  encLib.setWrapAroundOffset                                  ( m_wrapAroundOffset );
+  encLib.setBorderExtThreads                                  ( m_borderExtThreads );
+
+  // ADD_NEW_TOOL : (encoder app) add setting of tool enabling flags and associated parameters here
+  encLib.setVirtualBoundariesEnabledFlag                      ( m_virtualBoundariesEnabledFlag );
+  if( encLib.getVirtualBoundariesEnabledFlag() )
+  {
+    encLib.setVirtualBoundariesPresentFlag                      ( m_virtualBoundariesPresentFlag );
+    encLib.setNumVerVirtualBoundaries                           ( m_numVerVirtualBoundaries );
+    encLib.setNumHorVirtualBoundaries                           ( m_numHorVirtualBoundaries );
+    for( unsigned i = 0; i < m_numVerVirtualBoundaries; i++ )
+    {
+      encLib.setVirtualBoundariesPosX                           ( m_virtualBoundariesPosX[ i ], i );
+    }
+    for( unsigned i = 0; i < m_numHorVirtualBoundaries; i++ )
+    {
+      encLib.setVirtualBoundariesPosY                           ( m_virtualBoundariesPosY[ i ], i );
+    }
+  }
+
+  encLib.setMaxCUWidth                                        ( m_uiCTUSize );
+  encLib.setMaxCUHeight                                       ( m_uiCTUSize );
+  encLib.setLog2MinCodingBlockSize                            ( m_log2MinCuSize );
+  encLib.setLog2MaxTbSize                                     ( m_log2MaxTbSize );
+  encLib.setUseEncDbOpt(m_encDbOpt);
+  encLib.setUseFastLCTU                                       ( m_useFastLCTU );
+  encLib.setFastInterSearchMode                               ( m_fastInterSearchMode );
+  encLib.setUseEarlyCU                                        ( m_bUseEarlyCU  );
+  encLib.setUseFastDecisionForMerge                           ( m_useFastDecisionForMerge  );
+  encLib.setUseCbfFastMode                                    ( m_bUseCbfFastMode  );
+  encLib.setUseEarlySkipDetection                             ( m_useEarlySkipDetection );
+  encLib.setUseFastMerge                                      ( m_useFastMrg );
+  encLib.setUsePbIntraFast                                    ( m_usePbIntraFast );
+  encLib.setUseAMaxBT                                         ( m_useAMaxBT );
+  encLib.setUseE0023FastEnc                                   ( m_e0023FastEnc );
+  encLib.setUseContentBasedFastQtbt                           ( m_contentBasedFastQtbt );
+  encLib.setFastPartition                                     ( m_fastPartition );
+  encLib.setTemporalCuReuse                                   ( m_temporalCuReuse );
+  encLib.setUseNonLinearAlfLuma                               ( m_useNonLinearAlfLuma );
+  encLib.setUseNonLinearAlfChroma                             ( m_useNonLinearAlfChroma );
+  encLib.setMaxNumAlfAlternativesChroma                       ( m_maxNumAlfAlternativesChroma );
+  encLib.setUseMRL                                            ( m_MRL );
+  encLib.setUseMIP                                            ( m_MIP );
+  encLib.setUseFastMIP                                        ( m_useFastMIP );
+  encLib.setFastLocalDualTreeMode                             ( m_fastLocalDualTreeMode );
+  encLib.setUseFastResidualRate                               ( m_useFastResidualRate );
+  encLib.setUseReconBasedCrossCPredictionEstimate             ( m_reconBasedCrossCPredictionEstimate );
+  encLib.setUseTransformSkip                                  ( m_useTransformSkip      );
+  encLib.setUseTransformSkipFast                              ( m_useTransformSkipFast  );
+  encLib.setUseChromaTS                                       ( m_useChromaTS && m_useTransformSkip);
+  encLib.setUseBDPCM                                          ( m_useBDPCM );
+  encLib.setTransformSkipRotationEnabledFlag                  ( m_transformSkipRotationEnabledFlag );
+  encLib.setTransformSkipContextEnabledFlag                   ( m_transformSkipContextEnabledFlag   );
+  encLib.setPersistentRiceAdaptationEnabledFlag               ( m_persistentRiceAdaptationEnabledFlag );
+  encLib.setCabacBypassAlignmentEnabledFlag                   ( m_cabacBypassAlignmentEnabledFlag );
+  encLib.setLog2MaxTransformSkipBlockSize                     ( m_log2MaxTransformSkipBlockSize  );
+  for (uint32_t signallingModeIndex = 0; signallingModeIndex < NUMBER_OF_RDPCM_SIGNALLING_MODES; signallingModeIndex++)
+  {
+    encLib.setRdpcmEnabledFlag                                ( RDPCMSignallingMode(signallingModeIndex), m_rdpcmEnabledFlag[signallingModeIndex]);
+  }
+  encLib.setFastUDIUseMPMEnabled                              ( m_bFastUDIUseMPMEnabled );
+  encLib.setFastMEForGenBLowDelayEnabled                      ( m_bFastMEForGenBLowDelayEnabled );
+  encLib.setUseBLambdaForNonKeyLowDelayPictures               ( m_bUseBLambdaForNonKeyLowDelayPictures );
+  encLib.setUseISP                                            ( m_ISP );
+  encLib.setUseFastISP                                        ( m_useFastISP );
+
+  // set internal bit-depth and constants
+  for (uint32_t channelType = 0; channelType < MAX_NUM_CHANNEL_TYPE; channelType++)
+  {
+    encLib.setBitDepth((ChannelType)channelType, m_internalBitDepth[channelType]);
+    encLib.setInputBitDepth((ChannelType)channelType, m_inputBitDepth[channelType]);
+  }
+
+  encLib.setMaxNumMergeCand                                   ( m_maxNumMergeCand );
+  encLib.setMaxNumAffineMergeCand                             ( m_maxNumAffineMergeCand );
+  encLib.setMaxNumGeoCand                                     ( m_maxNumGeoCand );
+  encLib.setMaxNumIBCMergeCand                                ( m_maxNumIBCMergeCand );
+
+  //====== Weighted Prediction ========
+  encLib.setUseWP                                             ( m_useWeightedPred     );
+  encLib.setWPBiPred                                          ( m_useWeightedBiPred   );
+
+  //====== Parallel Merge Estimation ========
+  encLib.setLog2ParallelMergeLevelMinus2(m_log2ParallelMergeLevel - 2);
+  encLib.setMixedLossyLossless(m_mixedLossyLossless);
+  encLib.setSliceLosslessArray(m_sliceLosslessArray);
+
+  //====== Tiles and Slices ========
+  encLib.setNoPicPartitionFlag( !m_picPartitionFlag );
+  if( m_picPartitionFlag )
+  {
+    encLib.setTileColWidths( m_tileColumnWidth );
+    encLib.setTileRowHeights( m_tileRowHeight );
+    encLib.setRectSliceFlag( !m_rasterSliceFlag );
+    encLib.setNumSlicesInPic( m_numSlicesInPic );
+    encLib.setTileIdxDeltaPresentFlag( m_tileIdxDeltaPresentFlag );
+    encLib.setRectSlices( m_rectSlices );
+    encLib.setRasterSliceSizes( m_rasterSliceSize );
+    encLib.setLFCrossTileBoundaryFlag( !m_disableLFCrossTileBoundaryFlag );
+    encLib.setLFCrossSliceBoundaryFlag( !m_disableLFCrossSliceBoundaryFlag );
+  }
+  else
+  {
+    encLib.setRectSliceFlag( true );
+    encLib.setNumSlicesInPic( 1 );
+    encLib.setTileIdxDeltaPresentFlag( 0 );
+    encLib.setLFCrossTileBoundaryFlag( true );
+    encLib.setLFCrossSliceBoundaryFlag( true );
+  }
+
+  //====== Sub-picture and Slices ========
+  encLib.setSingleSlicePerSubPicFlagFlag                      ( m_singleSlicePerSubPicFlag );
+  encLib.setUseSAO                                            ( m_bUseSAO );
+  encLib.setTestSAODisableAtPictureLevel                      ( m_bTestSAODisableAtPictureLevel );
+  encLib.setSaoEncodingRate                                   ( m_saoEncodingRate );
+  encLib.setSaoEncodingRateChroma                             ( m_saoEncodingRateChroma );
+  encLib.setMaxNumOffsetsPerPic                               ( m_maxNumOffsetsPerPic);
+
+  encLib.setSaoCtuBoundary                                    ( m_saoCtuBoundary);
+
+  encLib.setSaoGreedyMergeEnc                                 ( m_saoGreedyMergeEnc);
+  encLib.setIntraSmoothingDisabledFlag                        (!m_enableIntraReferenceSmoothing );
+  encLib.setDecodedPictureHashSEIType                         ( m_decodedPictureHashSEIType );
+  encLib.setDependentRAPIndicationSEIEnabled                  ( m_drapPeriod > 0 );
+  encLib.setBufferingPeriodSEIEnabled                         ( m_bufferingPeriodSEIEnabled );
+  encLib.setPictureTimingSEIEnabled                           ( m_pictureTimingSEIEnabled );
+  encLib.setFrameFieldInfoSEIEnabled                          ( m_frameFieldInfoSEIEnabled );
+   encLib.setBpDeltasGOPStructure                             ( m_bpDeltasGOPStructure );
+  encLib.setDecodingUnitInfoSEIEnabled                        ( m_decodingUnitInfoSEIEnabled );
+  encLib.setScalableNestingSEIEnabled                         ( m_scalableNestingSEIEnabled );
+  encLib.setHrdParametersPresentFlag                          ( m_hrdParametersPresentFlag );
+  encLib.setFramePackingArrangementSEIEnabled                 ( m_framePackingSEIEnabled );
+  encLib.setFramePackingArrangementSEIType                    ( m_framePackingSEIType );
+  encLib.setFramePackingArrangementSEIId                      ( m_framePackingSEIId );
+  encLib.setFramePackingArrangementSEIQuincunx                ( m_framePackingSEIQuincunx );
+  encLib.setFramePackingArrangementSEIInterpretation          ( m_framePackingSEIInterpretation );
+  encLib.setParameterSetsInclusionIndicationSEIEnabled        (m_parameterSetsInclusionIndicationSEIEnabled);
+  encLib.setSelfContainedClvsFlag                             (m_selfContainedClvsFlag);
+  encLib.setErpSEIEnabled                                     ( m_erpSEIEnabled );
+  encLib.setErpSEICancelFlag                                  ( m_erpSEICancelFlag );
+  encLib.setErpSEIPersistenceFlag                             ( m_erpSEIPersistenceFlag );
+  encLib.setErpSEIGuardBandFlag                               ( m_erpSEIGuardBandFlag );
+  encLib.setErpSEIGuardBandType                               ( m_erpSEIGuardBandType );
+  encLib.setErpSEILeftGuardBandWidth                          ( m_erpSEILeftGuardBandWidth );
+  encLib.setErpSEIRightGuardBandWidth                         ( m_erpSEIRightGuardBandWidth );
+  encLib.setSphereRotationSEIEnabled                          ( m_sphereRotationSEIEnabled );
+  encLib.setSphereRotationSEICancelFlag                       ( m_sphereRotationSEICancelFlag );
+  encLib.setSphereRotationSEIPersistenceFlag                  ( m_sphereRotationSEIPersistenceFlag );
+  encLib.setSphereRotationSEIYaw                              ( m_sphereRotationSEIYaw );
+  encLib.setSphereRotationSEIPitch                            ( m_sphereRotationSEIPitch );
+  encLib.setSphereRotationSEIRoll                             ( m_sphereRotationSEIRoll );
+  encLib.setOmniViewportSEIEnabled                            ( m_omniViewportSEIEnabled );
+  encLib.setOmniViewportSEIId                                 ( m_omniViewportSEIId );
+  encLib.setOmniViewportSEICancelFlag                         ( m_omniViewportSEICancelFlag );
+  encLib.setOmniViewportSEIPersistenceFlag                    ( m_omniViewportSEIPersistenceFlag );
+  encLib.setOmniViewportSEICntMinus1                          ( m_omniViewportSEICntMinus1 );
+  encLib.setOmniViewportSEIAzimuthCentre                      ( m_omniViewportSEIAzimuthCentre );
+  encLib.setOmniViewportSEIElevationCentre                    ( m_omniViewportSEIElevationCentre );
+  encLib.setOmniViewportSEITiltCentre                         ( m_omniViewportSEITiltCentre );
+  encLib.setOmniViewportSEIHorRange                           ( m_omniViewportSEIHorRange );
+  encLib.setOmniViewportSEIVerRange                           ( m_omniViewportSEIVerRange );
+  encLib.setRwpSEIEnabled                                     (m_rwpSEIEnabled);
+  encLib.setRwpSEIRwpCancelFlag                               (m_rwpSEIRwpCancelFlag);
+  encLib.setRwpSEIRwpPersistenceFlag                          (m_rwpSEIRwpPersistenceFlag);
+  encLib.setRwpSEIConstituentPictureMatchingFlag              (m_rwpSEIConstituentPictureMatchingFlag);
+  encLib.setRwpSEINumPackedRegions                            (m_rwpSEINumPackedRegions);
+  encLib.setRwpSEIProjPictureWidth                            (m_rwpSEIProjPictureWidth);
+  encLib.setRwpSEIProjPictureHeight                           (m_rwpSEIProjPictureHeight);
+  encLib.setRwpSEIPackedPictureWidth                          (m_rwpSEIPackedPictureWidth);
+  encLib.setRwpSEIPackedPictureHeight                         (m_rwpSEIPackedPictureHeight);
+  encLib.setRwpSEIRwpTransformType                            (m_rwpSEIRwpTransformType);
+  encLib.setRwpSEIRwpGuardBandFlag                            (m_rwpSEIRwpGuardBandFlag);
+  encLib.setRwpSEIProjRegionWidth                             (m_rwpSEIProjRegionWidth);
+  encLib.setRwpSEIProjRegionHeight                            (m_rwpSEIProjRegionHeight);
+  encLib.setRwpSEIRwpSEIProjRegionTop                         (m_rwpSEIRwpSEIProjRegionTop);
+  encLib.setRwpSEIProjRegionLeft                              (m_rwpSEIProjRegionLeft);
+  encLib.setRwpSEIPackedRegionWidth                           (m_rwpSEIPackedRegionWidth);
+  encLib.setRwpSEIPackedRegionHeight                          (m_rwpSEIPackedRegionHeight);
+  encLib.setRwpSEIPackedRegionTop                             (m_rwpSEIPackedRegionTop);
+  encLib.setRwpSEIPackedRegionLeft                            (m_rwpSEIPackedRegionLeft);
+  encLib.setRwpSEIRwpLeftGuardBandWidth                       (m_rwpSEIRwpLeftGuardBandWidth);
+  encLib.setRwpSEIRwpRightGuardBandWidth                      (m_rwpSEIRwpRightGuardBandWidth);
+  encLib.setRwpSEIRwpTopGuardBandHeight                       (m_rwpSEIRwpTopGuardBandHeight);
+  encLib.setRwpSEIRwpBottomGuardBandHeight                    (m_rwpSEIRwpBottomGuardBandHeight);
+  encLib.setRwpSEIRwpGuardBandNotUsedForPredFlag              (m_rwpSEIRwpGuardBandNotUsedForPredFlag);
+  encLib.setRwpSEIRwpGuardBandType                            (m_rwpSEIRwpGuardBandType);
+  encLib.setGcmpSEIEnabled                                    ( m_gcmpSEIEnabled );
+  encLib.setGcmpSEICancelFlag                                 ( m_gcmpSEICancelFlag );
+  encLib.setGcmpSEIPersistenceFlag                            ( m_gcmpSEIPersistenceFlag );
+  encLib.setGcmpSEIPackingType                                ( (uint8_t)m_gcmpSEIPackingType );
+  encLib.setGcmpSEIMappingFunctionType                        ( (uint8_t)m_gcmpSEIMappingFunctionType );
+  encLib.setGcmpSEIFaceIndex                                  ( m_gcmpSEIFaceIndex );
+  encLib.setGcmpSEIFaceRotation                               ( m_gcmpSEIFaceRotation );
+  encLib.setGcmpSEIFunctionCoeffU                             ( m_gcmpSEIFunctionCoeffU );
+  encLib.setGcmpSEIFunctionUAffectedByVFlag                   ( m_gcmpSEIFunctionUAffectedByVFlag );
+  encLib.setGcmpSEIFunctionCoeffV                             ( m_gcmpSEIFunctionCoeffV );
+  encLib.setGcmpSEIFunctionVAffectedByUFlag                   ( m_gcmpSEIFunctionVAffectedByUFlag );
+  encLib.setGcmpSEIGuardBandFlag                              ( m_gcmpSEIGuardBandFlag );
+  encLib.setGcmpSEIGuardBandType                              ( m_gcmpSEIGuardBandType );
+  encLib.setGcmpSEIGuardBandBoundaryExteriorFlag              ( m_gcmpSEIGuardBandBoundaryExteriorFlag );
+  encLib.setGcmpSEIGuardBandSamplesMinus1                     ( (uint8_t)m_gcmpSEIGuardBandSamplesMinus1 );
+  encLib.setSubpicureLevelInfoSEICfg                          (m_cfgSubpictureLevelInfoSEI);
+  encLib.setSampleAspectRatioInfoSEIEnabled                   (m_sampleAspectRatioInfoSEIEnabled);
+  encLib.setSariCancelFlag                                    (m_sariCancelFlag);
+  encLib.setSariPersistenceFlag                               (m_sariPersistenceFlag);
+  encLib.setSariAspectRatioIdc                                (m_sariAspectRatioIdc);
+  encLib.setSariSarWidth                                      (m_sariSarWidth);
+  encLib.setSariSarHeight                                     (m_sariSarHeight);
+  encLib.setMCTSEncConstraint                                 ( m_MCTSEncConstraint);
+  encLib.setMasteringDisplaySEI                               ( m_masteringDisplay );
+#if U0033_ALTERNATIVE_TRANSFER_CHARACTERISTICS_SEI
+  encLib.setSEIAlternativeTransferCharacteristicsSEIEnable    ( m_preferredTransferCharacteristics>=0     );
+  encLib.setSEIPreferredTransferCharacteristics               ( uint8_t(m_preferredTransferCharacteristics) );
+#endif
+  // film grain charcteristics
+  encLib.setFilmGrainCharactersticsSEIEnabled                 (m_fgcSEIEnabled);
+  encLib.setFilmGrainCharactersticsSEICancelFlag              (m_fgcSEICancelFlag);
+  encLib.setFilmGrainCharactersticsSEIPersistenceFlag         (m_fgcSEIPersistenceFlag);
+  encLib.setFilmGrainCharactersticsSEIModelID                 ((uint8_t)m_fgcSEIModelID);
+  encLib.setFilmGrainCharactersticsSEISepColourDescPresent    (m_fgcSEISepColourDescPresentFlag);
+  encLib.setFilmGrainCharactersticsSEIBlendingModeID          ((uint8_t)m_fgcSEIBlendingModeID);
+  encLib.setFilmGrainCharactersticsSEILog2ScaleFactor         ((uint8_t)m_fgcSEILog2ScaleFactor);
+  for (int i = 0; i < MAX_NUM_COMPONENT; i++) {
+    encLib.setFGCSEICompModelPresent                          (m_fgcSEICompModelPresent[i], i);
+  }
+  // content light level
+  encLib.setCLLSEIEnabled                                     (m_cllSEIEnabled);
+  encLib.setCLLSEIMaxContentLightLevel                        ((uint16_t)m_cllSEIMaxContentLevel);
+  encLib.setCLLSEIMaxPicAvgLightLevel                         ((uint16_t)m_cllSEIMaxPicAvgLevel);
+  // ambient viewing enviornment
+  encLib.setAmbientViewingEnvironmentSEIEnabled               (m_aveSEIEnabled);
+  encLib.setAmbientViewingEnvironmentSEIIlluminance           (m_aveSEIAmbientIlluminance);
+  encLib.setAmbientViewingEnvironmentSEIAmbientLightX         ((uint16_t)m_aveSEIAmbientLightX);
+  encLib.setAmbientViewingEnvironmentSEIAmbientLightY         ((uint16_t)m_aveSEIAmbientLightY);
+  // content colour volume SEI
+  encLib.setCcvSEIEnabled                                     (m_ccvSEIEnabled);
+  encLib.setCcvSEICancelFlag                                  (m_ccvSEICancelFlag);
+  encLib.setCcvSEIPersistenceFlag                             (m_ccvSEIPersistenceFlag);
+  encLib.setCcvSEIEnabled                                     (m_ccvSEIEnabled);
+  encLib.setCcvSEICancelFlag                                  (m_ccvSEICancelFlag);
+  encLib.setCcvSEIPersistenceFlag                             (m_ccvSEIPersistenceFlag);
+  encLib.setCcvSEIPrimariesPresentFlag                        (m_ccvSEIPrimariesPresentFlag);
+  encLib.setCcvSEIMinLuminanceValuePresentFlag                (m_ccvSEIMinLuminanceValuePresentFlag);
+  encLib.setCcvSEIMaxLuminanceValuePresentFlag                (m_ccvSEIMaxLuminanceValuePresentFlag);
+  encLib.setCcvSEIAvgLuminanceValuePresentFlag                (m_ccvSEIAvgLuminanceValuePresentFlag);
+  for(int i = 0; i < MAX_NUM_COMPONENT; i++) {
+    encLib.setCcvSEIPrimariesX                                (m_ccvSEIPrimariesX[i], i);
+    encLib.setCcvSEIPrimariesY                                (m_ccvSEIPrimariesY[i], i);
+  }
+  encLib.setCcvSEIMinLuminanceValue                           (m_ccvSEIMinLuminanceValue);
+  encLib.setCcvSEIMaxLuminanceValue                           (m_ccvSEIMaxLuminanceValue);
+  encLib.setCcvSEIAvgLuminanceValue                           (m_ccvSEIAvgLuminanceValue);
+  encLib.setEntropyCodingSyncEnabledFlag                      ( m_entropyCodingSyncEnabledFlag );
+  encLib.setEntryPointPresentFlag                             ( m_entryPointPresentFlag );
+  encLib.setTMVPModeId                                        ( m_TMVPModeId );
+  encLib.setSliceLevelRpl                                     ( m_sliceLevelRpl  );
+  encLib.setSliceLevelDblk                                    ( m_sliceLevelDblk );
+  encLib.setSliceLevelSao                                     ( m_sliceLevelSao  );
+  encLib.setSliceLevelWp                                      ( m_sliceLevelWp );
+  encLib.setSliceLevelDeltaQp                                 ( m_sliceLevelDeltaQp );
+  encLib.setSliceLevelAlf                                     ( m_sliceLevelAlf  );
+  encLib.setUseScalingListId                                  ( m_useScalingListId  );
+  encLib.setScalingListFileName                               ( m_scalingListFileName );
+  encLib.setDisableScalingMatrixForLfnstBlks                  ( m_disableScalingMatrixForLfnstBlks);
+  if ( encLib.getUseColorTrans() && encLib.getUseScalingListId() )
+  {
+    encLib.setDisableScalingMatrixForAlternativeColourSpace(m_disableScalingMatrixForAlternativeColourSpace);
+  }
+  if ( encLib.getDisableScalingMatrixForAlternativeColourSpace() )
+  {
+    encLib.setScalingMatrixDesignatedColourSpace(m_scalingMatrixDesignatedColourSpace);
+  }
+  encLib.setDepQuantEnabledFlag                               ( m_depQuantEnabledFlag);
+  encLib.setSignDataHidingEnabledFlag                         ( m_signDataHidingEnabledFlag);
+  encLib.setLookAhead                                         ( m_lookAhead );
+  encLib.setSceneCutThreshold                                 ( m_sceneCutThreshold );
+  encLib.setUseRateCtrl                                       ( m_RCEnableRateControl );
+  encLib.setTargetBitrate                                     ( m_RCTargetBitrate );
+  encLib.setKeepHierBit                                       ( m_RCKeepHierarchicalBit );
+  encLib.setLCULevelRC                                        ( m_RCLCULevelRC );
+  encLib.setUseLCUSeparateModel                               ( m_RCUseLCUSeparateModel );
+  encLib.setInitialQP                                         ( m_RCInitialQP );
+  encLib.setForceIntraQP                                      ( m_RCForceIntraQP );
+  encLib.setRCPass                                            ( m_RCPass );
+  encLib.setRCStatsFileName                                   ( m_RCStatsFileName );
+#if U0132_TARGET_BITS_SATURATION
+  encLib.setCpbSaturationEnabled                              ( m_RCCpbSaturationEnabled );
+  encLib.setCpbSize                                           ( m_RCCpbSize );
+  encLib.setInitialCpbFullness                                ( m_RCInitialCpbFullness );
+#endif
+  encLib.setCostMode                                          ( m_costMode );
+  encLib.setTSRCdisableLL                                     ( m_TSRCdisableLL );
+  encLib.setUseRecalculateQPAccordingToLambda                 ( m_recalculateQPAccordingToLambda );
+  encLib.setDCIEnabled                                        ( m_DCIEnabled );
+  encLib.setVuiParametersPresentFlag                          ( m_vuiParametersPresentFlag );
+  encLib.setSamePicTimingInAllOLS                             (m_samePicTimingInAllOLS);
+  encLib.setAspectRatioInfoPresentFlag                        ( m_aspectRatioInfoPresentFlag);
+  encLib.setAspectRatioIdc                                    ( m_aspectRatioIdc );
+  encLib.setSarWidth                                          ( m_sarWidth );
+  encLib.setSarHeight                                         ( m_sarHeight );
+  encLib.setColourDescriptionPresentFlag                      ( m_colourDescriptionPresentFlag );
+  encLib.setColourPrimaries                                   ( m_colourPrimaries );
+  encLib.setTransferCharacteristics                           ( m_transferCharacteristics );
+  encLib.setMatrixCoefficients                                ( m_matrixCoefficients );
+  encLib.setProgressiveSourceFlag                             ( m_progressiveSourceFlag);
+  encLib.setInterlacedSourceFlag                              ( m_interlacedSourceFlag);
+  encLib.setChromaLocInfoPresentFlag                          ( m_chromaLocInfoPresentFlag );
+  encLib.setChromaSampleLocTypeTopField                       ( m_chromaSampleLocTypeTopField );
+  encLib.setChromaSampleLocTypeBottomField                    ( m_chromaSampleLocTypeBottomField );
+  encLib.setChromaSampleLocType                               ( m_chromaSampleLocType );
+  encLib.setOverscanInfoPresentFlag                           ( m_overscanInfoPresentFlag );
+  encLib.setOverscanAppropriateFlag                           ( m_overscanAppropriateFlag );
+  encLib.setVideoFullRangeFlag                                ( m_videoFullRangeFlag );
+  encLib.setEfficientFieldIRAPEnabled                         ( m_bEfficientFieldIRAPEnabled );
+  encLib.setHarmonizeGopFirstFieldCoupleEnabled               ( m_bHarmonizeGopFirstFieldCoupleEnabled );
+  encLib.setSummaryOutFilename                                ( m_summaryOutFilename );
+  encLib.setSummaryPicFilenameBase                            ( m_summaryPicFilenameBase );
+  encLib.setSummaryVerboseness                                ( m_summaryVerboseness );
+  encLib.setIMV                                               ( m_ImvMode );
+  encLib.setIMV4PelFast                                       ( m_Imv4PelFast );
+  encLib.setDecodeBitstream                                   ( 0, m_decodeBitstreams[0] );
+  encLib.setDecodeBitstream                                   ( 1, m_decodeBitstreams[1] );
+  encLib.setSwitchPOC                                         ( m_switchPOC );
+  encLib.setSwitchDQP                                         ( m_switchDQP );
+  encLib.setFastForwardToPOC                                  ( m_fastForwardToPOC );
+  encLib.setForceDecodeBitstream1                             ( m_forceDecodeBitstream1 );
+  encLib.setStopAfterFFtoPOC                                  ( m_stopAfterFFtoPOC );
+  encLib.setBs2ModPOCAndType                                  ( m_bs2ModPOCAndType );
+  encLib.setDebugCTU                                          ( m_debugCTU );
+#if ENABLE_SPLIT_PARALLELISM
+  encLib.setNumSplitThreads                                   ( m_numSplitThreads );
+  encLib.setForceSingleSplitThread                            ( m_forceSplitSequential );
+#endif
+  encLib.setUseALF                                            ( m_alf );
+  encLib.setUseCCALF                                          ( m_ccalf );
+  encLib.setCCALFQpThreshold                                  ( m_ccalfQpThreshold );
+  encLib.setLmcs                                              ( m_lmcsEnabled );
+  encLib.setReshapeSignalType                                 ( m_reshapeSignalType );
+  encLib.setReshapeIntraCMD                                   ( m_intraCMD );
+  encLib.setReshapeCW                                         ( m_reshapeCW );
+  encLib.setReshapeCSoffset                                   ( m_CSoffset );
+
+#if JVET_O0756_CALCULATE_HDRMETRICS
+  for (int i=0; i<hdrtoolslib::NB_REF_WHITE; i++)
+  {
+    encLib.setWhitePointDeltaE                                (i, m_whitePointDeltaE[i] );
+  }
+  encLib.setMaxSampleValue                                    (m_maxSampleValue);
+  encLib.setSampleRange                                       (m_sampleRange);
+  encLib.setColorPrimaries                                    (m_colorPrimaries);
+  encLib.setEnableTFunctionLUT                                (m_enableTFunctionLUT);
+  for (int i=0; i<2; i++)
+  {
+    encLib.setChromaLocation                                    (i, m_chromaLocation);
+    encLib.setChromaUPFilter                                    (m_chromaUPFilter);
+  }
+  encLib.setCropOffsetLeft                                    (m_cropOffsetLeft);
+  encLib.setCropOffsetTop                                     (m_cropOffsetTop);
+  encLib.setCropOffsetRight                                   (m_cropOffsetRight);
+  encLib.setCropOffsetBottom                                  (m_cropOffsetBottom);
+  encLib.setCalculateHdrMetrics                               (m_calculateHdrMetrics);
+#endif
+  encLib.setGopBasedTemporalFilterEnabled(m_gopBasedTemporalFilterEnabled);
+  encLib.setNumRefLayers                                       ( m_numRefLayers );
+
+  encLib.setVPSParameters(m_cfgVPSParameters);
+}
+
+
 // ====================================================================================================================
 // Private member functions
 // ====================================================================================================================
@@ -2396,6 +3223,12 @@ bool EncAppCfg::xCheckParameter()
     xConfirmPara( m_wrapAroundOffset % minCUSize != 0, "Wrap-around offset must be an integer multiple of the specified minimum CU size" );
   }
 
+  xConfirmPara( m_hashMEThreads < 1, "Number of hash ME threads cannot be smaller than 1" );
+  xConfirmPara( m_hierarchicalMEThreads < 1, "Number of hierarchical ME threads cannot be smaller than 1" );
+  xConfirmPara( m_rprThreads < 1, "Number of RPR threads cannot be smaller than 1" );
+  xConfirmPara( m_borderExtThreads < 1, "Number of border extension threads cannot be smaller than 1" );
+  xConfirmPara( m_metricThreads < 1, "Number of metric threads cannot be smaller than 1" );
+
 #if ENABLE_SPLIT_PARALLELISM
   xConfirmPara( m_numSplitThreads < 1, "Number of used threads cannot be smaller than 1" );
   xConfirmPara( m_numSplitThreads > PARL_SPLIT_MAX_NUM_THREADS, "Number of used threads cannot be higher than the number of actual jobs" );
@@ -2421,6 +3254,7 @@ bool EncAppCfg::xCheckParameter()
 
 
   xConfirmPara( m_useAMaxBT && !m_SplitConsOverrideEnabledFlag, "AMaxBt can only be used with PartitionConstriantsOverride enabled" );
+  xConfirmPara( m_fastPartition > 3, "FastPartition must be in the range of 0 to 3" );
 
 
   xConfirmPara(m_bitstreamFileName.empty(), "A bitstream file name must be specified (BitstreamFile)");
@@ -3433,6 +4267,30 @@ bool EncAppCfg::xCheckParameter()
 
   xConfirmPara( m_sariAspectRatioIdc < 0 || m_sariAspectRatioIdc > 255, "SEISARISampleAspectRatioIdc must be in the range of 0 to 255");
 
+  xConfirmPara( m_sceneCutThreshold < 0 || m_sceneCutThreshold > 100, "SceneCutThreshold must be in the range of 0 to 100" );
+
+  xConfirmPara( m_RCPass < 0 || m_RCPass > 2, "RCPass must be in the range of 0 to 2" );
+  if ( m_RCPass > 0 )
+  {
+    xConfirmPara( !m_RCEnableRateControl, "RCPass requires RateControl to be enabled" );
+    xConfirmPara( m_RCStatsFileName.empty(), "RCPass requires RCStatsFile to be specified" );
+  }
+  if ( m_RCPass == 1 )
+  {
+    // the first pass only measures the relative cost of the pictures and CTUs: code at constant QP with a reduced search
+    msg( WARNING, "\nRate control first pass: coding at constant QP %d without RDOQ, dependent quantization and with a multi-type tree depth of at most 1\n", m_iQP );
+    m_RCEnableRateControl    = false;
+#if U0132_TARGET_BITS_SATURATION
+    m_RCCpbSaturationEnabled = false;
+#endif
+    m_useRDOQ                = false;
+    m_useRDOQTS              = false;
+    m_depQuantEnabledFlag    = false;
+    m_uiMaxMTTHierarchyDepth        = std::min( m_uiMaxMTTHierarchyDepth,        1u );
+    m_uiMaxMTTHierarchyDepthI       = std::min( m_uiMaxMTTHierarchyDepthI,       1u );
+    m_uiMaxMTTHierarchyDepthIChroma = std::min( m_uiMaxMTTHierarchyDepthIChroma, 1u );
+  }
+
   if ( m_RCEnableRateControl )
   {
     if ( m_RCForceIntraQP )
@@ -3529,6 +4387,12 @@ bool EncAppCfg::xCheckParameter()
   {
     xConfirmPara(m_temporalSubsampleRatio != 1, "GOP Based Temporal Filter only support Temporal sub-sample ratio 1");
   }
+  if (m_checkEncStream)
+  {
+    xConfirmPara(m_maxLayers > 1, "CheckEncStream does not support multi-layer coding");
+    xConfirmPara(m_isField, "CheckEncStream does not support field coding");
+    xConfirmPara(m_gopBasedTemporalFilterEnabled, "CheckEncStream does not support the GOP based temporal filter");
+  }
 #if EXTENSION_360_VIDEO
   check_failed |= m_ext360.verifyParameters();
 #endif
@@ -3571,6 +4435,7 @@ void EncAppCfg::xPrintParameter()
   msg( DETAILS, "Hexadecimal PSNR output                : %s\n", ( m_printHexPsnr ? "Enabled" : "Disabled" ) );
   msg( DETAILS, "Sequence MSE output                    : %s\n", ( m_printSequenceMSE ? "Enabled" : "Disabled" ) );
   msg( DETAILS, "Frame MSE output                       : %s\n", ( m_printFrameMSE ? "Enabled" : "Disabled" ) );
+  msg( DETAILS, "Metric computation                     : %d thread(s), %s\n", m_metricThreads, ( m_asyncMetrics ? "asynchronous" : "synchronous" ) );
   msg( DETAILS, "Cabac-zero-word-padding                : %s\n", ( m_cabacZeroWordPaddingEnabled ? "Enabled" : "Disabled" ) );
   if (m_isField)
   {
@@ -3660,6 +4525,11 @@ void EncAppCfg::xPrintParameter()
     default:                                msg( DETAILS, "Cost function:                         : Unknown\n"); break;
   }
 
+  msg( DETAILS, "LookAhead                              : %d\n", m_lookAhead );
+  if( m_lookAhead )
+  {
+    msg( DETAILS, "SceneCutThreshold                      : %d\n", m_sceneCutThreshold );
+  }
   msg( DETAILS, "RateControl                            : %d\n", m_RCEnableRateControl );
   msg( DETAILS, "WeightedPredMethod                     : %d\n", int(m_weightedPredictionMethod));
 
@@ -3671,6 +4541,7 @@ void EncAppCfg::xPrintParameter()
     msg( DETAILS, "UseLCUSeparateModel                    : %d\n", m_RCUseLCUSeparateModel );
     msg( DETAILS, "InitialQP                              : %d\n", m_RCInitialQP );
     msg( DETAILS, "ForceIntraQP                           : %d\n", m_RCForceIntraQP );
+    msg( DETAILS, "RCPass                                 : %d\n", m_RCPass );
 #if U0132_TARGET_BITS_SATURATION
     msg( DETAILS, "CpbSaturation                          : %d\n", m_RCCpbSaturationEnabled );
     if (m_RCCpbSaturationEnabled)
@@ -3772,11 +4643,21 @@ void EncAppCfg::xPrintParameter()
     msg(VERBOSE, "PLT:%d ", m_PLTMode);
     msg(VERBOSE, "IBC:%d ", m_IBCMode);
   msg( VERBOSE, "HashME:%d ", m_HashME );
+  if( m_HashME )
+  {
+    msg( VERBOSE, "HashMEThreads:%d ", m_hashMEThreads );
+  }
+  msg( VERBOSE, "HierarchicalME:%d ", m_hierarchicalME );
+  if( m_hierarchicalME )
+  {
+    msg( VERBOSE, "HierarchicalMEThreads:%d ", m_hierarchicalMEThreads );
+  }
   msg( VERBOSE, "WrapAround:%d ", m_wrapAround);
   if( m_wrapAround )
   {
     msg( VERBOSE, "WrapAroundOffset:%d ", m_wrapAroundOffset );
   }
+  msg( VERBOSE, "BorderExtThreads:%d ", m_borderExtThreads );
   // ADD_NEW_TOOL (add some output indicating the usage of tools)
   msg( VERBOSE, "VirtualBoundariesEnabledFlag:%d ", m_virtualBoundariesEnabledFlag );
   msg( VERBOSE, "VirtualBoundariesPresentInSPSFlag:%d ", m_virtualBoundariesPresentFlag );
@@ -3817,11 +4698,14 @@ void EncAppCfg::xPrintParameter()
   msg( VERBOSE, "AMaxBT:%d ", m_useAMaxBT );
   msg( VERBOSE, "E0023FastEnc:%d ", m_e0023FastEnc );
   msg( VERBOSE, "ContentBasedFastQtbt:%d ", m_contentBasedFastQtbt );
+  msg( VERBOSE, "FastPartition:%d ", m_fastPartition );
+  msg( VERBOSE, "TemporalCuReuse:%d ", m_temporalCuReuse );
   msg( VERBOSE, "UseNonLinearAlfLuma:%d ", m_useNonLinearAlfLuma );
   msg( VERBOSE, "UseNonLinearAlfChroma:%d ", m_useNonLinearAlfChroma );
   msg( VERBOSE, "MaxNumAlfAlternativesChroma:%d ", m_maxNumAlfAlternativesChroma );
   if( m_MIP ) msg(VERBOSE, "FastMIP:%d ", m_useFastMIP);
   msg( VERBOSE, "FastLocalDualTree:%d ", m_fastLocalDualTreeMode );
+  msg( VERBOSE, "FastResidualRate:%d ", m_useFastResidualRate );
 
   msg( VERBOSE, "NumSplitThreads:%d ", m_numSplitThreads );
   if( m_numSplitThreads > 1 )
@@ -3833,7 +4717,7 @@ void EncAppCfg::xPrintParameter()
 
   if (m_resChangeInClvsEnabled)
   {
-    msg( VERBOSE, "RPR:(%1.2lfx, %1.2lfx)|%d ", m_scalingRatioHor, m_scalingRatioVer, m_switchPocPeriod );
+    msg( VERBOSE, "RPR:(%1.2lfx, %1.2lfx)|%d RPRThreads:%d ", m_scalingRatioHor, m_scalingRatioVer, m_switchPocPeriod, m_rprThreads );
   }
   else
   {
@@ -57,6 +57,8 @@ static inline std::istream& operator >> (std::istream &in, std::map<T1, T2> &map
 #endif
 namespace po = df::program_options_lite;
 
+class EncLib;
+
 #include <sstream>
 #include <vector>
 //! \ingroup EncoderApp
@@ -126,6 +128,8 @@ protected:
   bool      m_printHexPsnr;
   bool      m_printFrameMSE;
   bool      m_printSequenceMSE;
+  int       m_metricThreads;
+  bool      m_asyncMetrics;
   bool      m_cabacZeroWordPaddingEnabled;
   bool      m_bClipInputVideoToRec709Range;
   bool      m_bClipOutputVideoToRec709Range;
@@ -326,6 +330,9 @@ protected:
   bool      m_ciip;
   bool      m_Geo;
   bool      m_HashME;
+  int       m_hashMEThreads;
+  bool      m_hierarchicalME;                                 ///< coarse motion estimation on downsampled luma before the CTUs are coded
+  int       m_hierarchicalMEThreads;
   bool      m_allowDisFracMMVD;
   bool      m_AffineAmvr;
   bool      m_AffineAmvrEncOpt;
@@ -347,6 +354,7 @@ protected:
 
   bool      m_wrapAround;
   unsigned  m_wrapAroundOffset;
+  int       m_borderExtThreads;
 
   // ADD_NEW_TOOL : (encoder app) add tool enabling flags and associated parameters here
   bool      m_virtualBoundariesEnabledFlag;
@@ -374,6 +382,8 @@ protected:
   bool      m_useFastMrg;
   bool      m_e0023FastEnc;
   bool      m_contentBasedFastQtbt;
+  unsigned  m_fastPartition;                                  ///< preset of the content adaptive split decisions, 0: off
+  bool      m_temporalCuReuse;                                ///< reuse the CU decisions of the closest reference picture of the same temporal layer
   bool      m_useNonLinearAlfLuma;
   bool      m_useNonLinearAlfChroma;
   unsigned  m_maxNumAlfAlternativesChroma;
@@ -381,6 +391,7 @@ protected:
   bool      m_MIP;
   bool      m_useFastMIP;
   int       m_fastLocalDualTreeMode;
+  bool      m_useFastResidualRate;
 
 
   int       m_numSplitThreads;
@@ -621,6 +632,8 @@ protected:
   int       m_TMVPModeId;
   bool      m_depQuantEnabledFlag;
   bool      m_signDataHidingEnabledFlag;
+  bool      m_lookAhead;                          ///< analyse the buffered pictures ahead of the GOP encoder
+  int       m_sceneCutThreshold;                  ///< scene cut sensitivity of the look-ahead, 0: off
   bool      m_RCEnableRateControl;                ///< enable rate control or not
   int       m_RCTargetBitrate;                    ///< target bitrate when rate control is enabled
   int       m_RCKeepHierarchicalBit;              ///< 0: equal bit allocation; 1: fixed ratio bit allocation; 2: adaptive ratio bit allocation
@@ -628,6 +641,8 @@ protected:
   bool      m_RCUseLCUSeparateModel;              ///< use separate R-lambda model at LCU level                        NOTE: code-tidy - rename to m_RCUseCtuSeparateModel
   int       m_RCInitialQP;                        ///< inital QP for rate control
   bool      m_RCForceIntraQP;                     ///< force all intra picture to use initial QP or not
+  int       m_RCPass;                             ///< 0: single pass; 1: first pass writing statistics; 2: second pass reading statistics
+  std::string m_RCStatsFileName;                  ///< file of the first pass statistics
 #if U0132_TARGET_BITS_SATURATION
   bool      m_RCCpbSaturationEnabled;             ///< enable target bits saturation to avoid CPB overflow and underflow
   uint32_t      m_RCCpbSize;                          ///< CPB size
@@ -670,6 +685,10 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   uint32_t        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+#if ENABLE_STAGE_PROFILING
+  std::string m_profilingFileName;                            ///< filename for per-stage timing statistics, profiling is disabled if empty
+#endif
+  bool        m_checkEncStream;                               ///< encode the input a second time with EncStream and compare the bitstreams
 
   int         m_verbosity;
 
@@ -691,6 +710,7 @@ protected:
   bool        m_resChangeInClvsEnabled;
   double      m_fractionOfFrames;                             ///< encode a fraction of the frames as specified in FramesToBeEncoded
   int         m_switchPocPeriod;
+  int         m_rprThreads;                                   ////< Number of threads used to resample pictures for RPR
   int         m_upscaledOutput;                               ////< Output upscaled (2), decoded cropped but in full resolution buffer (1) or decoded cropped (0, default) picture for RPR.
   bool        m_avoidIntraInDepLayer;
 
@@ -761,6 +781,7 @@ public:
   void  create    ();                                         ///< create option handling class
   void  destroy   ();                                         ///< destroy option handling class
   bool  parseCfg  ( int argc, char* argv[] );                ///< parse configuration file to fill member variables
+  void  initEncLibCfg( EncLib& encLib );                      ///< configure an encoder library from the configuration
 
 };// END CLASS DEFINITION EncAppCfg
 
@@ -308,10 +308,16 @@ int main(int argc, char* argv[])
   auto encTime = std::chrono::duration_cast<std::chrono::milliseconds>( endTime - startTime).count();
 #endif
 
+  bool encStreamMismatch = false;
   for( auto & encApp : pcEncApp )
   {
     encApp->destroyLib();
 
+    if( encApp->getCheckEncStream() && !encApp->checkEncStream() )
+    {
+      encStreamMismatch = true;
+    }
+
     // destroy application encoder class per layer
     encApp->destroy();
 
@@ -337,7 +343,7 @@ int main(int argc, char* argv[])
          encTime / 1000.0);
 #endif
 
-  return 0;
+  return encStreamMismatch ? EXIT_FAILURE : 0;
 }
 
 //! \}
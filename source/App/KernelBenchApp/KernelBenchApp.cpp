@@ -0,0 +1,1218 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchApp.cpp
+    \brief    CommonLib kernel benchmark application class
+*/
+
+#include "KernelBenchApp.h"
+
+#include "CommonLib/AdaptiveLoopFilter.h"
+#include "CommonLib/Buffer.h"
+#include "CommonLib/CodingStructure.h"
+#include "CommonLib/IbcHashMap.h"
+#include "CommonLib/InterpolationFilter.h"
+#include "CommonLib/Quant.h"
+#include "CommonLib/RdCost.h"
+#include "CommonLib/Reshape.h"
+#include "CommonLib/TrQuant.h"
+#include "CommonLib/TrQuant_EMT.h"
+#include "Utilities/program_options_lite.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <random>
+
+using namespace std;
+namespace po = df::program_options_lite;
+
+//! \ingroup KernelBenchApp
+//! \{
+
+template<typename T>
+static void fillRandom( std::vector<T>& buf, int minVal, int maxVal, std::mt19937& rng )
+{
+  std::uniform_int_distribution<int> dist( minVal, maxVal );
+  for( auto& val : buf )
+  {
+    val = T( dist( rng ) );
+  }
+}
+
+static std::string sizeName( int width, int height )
+{
+  return std::to_string( width ) + "x" + std::to_string( height );
+}
+
+// ====================================================================================================================
+// Level specific initialization
+// ====================================================================================================================
+
+#ifdef TARGET_SIMD_X86
+#if ENABLE_SIMD_OPT_MCIF
+static void initLevel( InterpolationFilter& filter, X86_VEXT level )
+{
+  switch( level )
+  {
+  case SSE41:  filter._initInterpolationFilterX86<SSE41 >(); break;
+  case AVX:    filter._initInterpolationFilterX86<AVX   >(); break;
+  case AVX2:   filter._initInterpolationFilterX86<AVX2  >(); break;
+  case AVX512: filter._initInterpolationFilterX86<AVX512>(); break;
+  default:     break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_DIST
+static void initLevel( RdCost& rdCost, X86_VEXT level )
+{
+  switch( level )
+  {
+  case SSE41:  rdCost._initRdCostX86<SSE41 >(); break;
+  case AVX:    rdCost._initRdCostX86<AVX   >(); break;
+  case AVX2:   rdCost._initRdCostX86<AVX2  >(); break;
+  case AVX512: rdCost._initRdCostX86<AVX512>(); break;
+  default:     break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_BUFFER
+static void initLevel( PelBufferOps& ops, X86_VEXT level )
+{
+  switch( level )
+  {
+  case SSE41:  ops._initPelBufOpsX86<SSE41 >(); break;
+  case AVX:    ops._initPelBufOpsX86<AVX   >(); break;
+  case AVX2:   ops._initPelBufOpsX86<AVX2  >(); break;
+  case AVX512: ops._initPelBufOpsX86<AVX512>(); break;
+  default:     break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_ALF
+static void initLevel( AdaptiveLoopFilter& alf, X86_VEXT level )
+{
+  switch( level )
+  {
+  case SSE41:  alf._initAdaptiveLoopFilterX86<SSE41 >(); break;
+  case AVX:    alf._initAdaptiveLoopFilterX86<AVX   >(); break;
+  case AVX2:   alf._initAdaptiveLoopFilterX86<AVX2  >(); break;
+  case AVX512: alf._initAdaptiveLoopFilterX86<AVX512>(); break;
+  default:     break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_LFNST
+static void initLevel( TrQuant& trQuant, X86_VEXT level )
+{
+  switch( level )
+  {
+  case SSE41:  trQuant._initTrQuantX86<SSE41 >(); break;
+  case AVX:    trQuant._initTrQuantX86<AVX   >(); break;
+  case AVX2:   trQuant._initTrQuantX86<AVX2  >(); break;
+  case AVX512: trQuant._initTrQuantX86<AVX512>(); break;
+  default:     break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_QUANT
+static void initLevel( Quant& quant, X86_VEXT level )
+{
+  switch( level )
+  {
+  case SSE41:  quant._initQuantX86<SSE41 >(); break;
+  case AVX:    quant._initQuantX86<AVX   >(); break;
+  case AVX2:   quant._initQuantX86<AVX2  >(); break;
+  case AVX512: quant._initQuantX86<AVX512>(); break;
+  default:     break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_IBC
+static void initLevel( IbcHashMap& hashMap, X86_VEXT level )
+{
+  switch( level )
+  {
+  case SSE42: hashMap._initIbcHashMapX86<SSE42>(); break;
+  default:    break;
+  }
+}
+#endif
+#endif
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+KernelBenchApp::KernelBenchApp()
+  : m_minTime( 50 )
+  , m_bitDepth( 10 )
+  , m_maxLevel( SCALAR )
+  , m_numMismatches( 0 )
+{
+}
+
+/** \param argc number of arguments
+    \param argv array of arguments
+ */
+bool KernelBenchApp::parseCfg( int argc, char* argv[] )
+{
+  bool do_help = false;
+
+  po::Options opts;
+  opts.addOptions()
+
+  ("help",                      do_help,                               false,      "this help text")
+  ("Kernel,k",                  m_kernelFilter,                        string(""), "only run kernels whose name contains the given string (e.g. sad, interp, alf)")
+  ("MinTime,t",                 m_minTime,                             50,         "minimum measuring time per kernel, block size and SIMD level in ms")
+  ("BitDepth,d",                m_bitDepth,                            10,         "sample bit depth of the test data")
+  ("CsvFile,o",                 m_csvFileName,                         string(""), "when non empty, write the results to the indicated CSV file")
+  ;
+
+  po::setDefaults( opts );
+  po::ErrorReporter err;
+  const list<const char*>& argv_unhandled = po::scanArgv( opts, argc, ( const char** ) argv, err );
+
+  for( list<const char*>::const_iterator it = argv_unhandled.begin(); it != argv_unhandled.end(); it++ )
+  {
+    msg( ERROR, "Unhandled argument ignored: `%s'\n", *it );
+  }
+
+  if( do_help )
+  {
+    po::doHelp( cout, opts );
+    return false;
+  }
+
+  if( err.is_errored )
+  {
+    return false;
+  }
+
+  if( m_bitDepth < 8 || m_bitDepth > 12 )
+  {
+    msg( ERROR, "BitDepth must be in the range 8..12\n" );
+    return false;
+  }
+
+  if( m_minTime < 1 )
+  {
+    msg( ERROR, "MinTime must be at least 1 ms\n" );
+    return false;
+  }
+
+  return true;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+int KernelBenchApp::run()
+{
+#ifdef TARGET_SIMD_X86
+  // all generic init functions (initRdCost, AdaptiveLoopFilter constructor, ...) select the scalar implementation,
+  // the SIMD levels are selected explicitly per kernel
+  read_x86_extension_flags( "SCALAR" );
+  m_maxLevel = _get_x86_extensions();
+#endif
+
+  msg( INFO, "highest SIMD level supported by the CPU: %s\n\n", xGetLevelName( m_maxLevel ) );
+  msg( INFO, "%-16s %-8s %-6s %14s %9s  %s\n", "kernel", "size", "level", "time/call", "speedup", "bit-exact" );
+
+  xBenchInterpolation();
+  xBenchDistortion();
+  xBenchPelBufOps();
+  xBenchAlf();
+  xBenchTransform();
+  xBenchLfnst();
+  xBenchQuant();
+  xBenchIbcHash();
+  xBenchResampling();
+  xBenchLmcs();
+
+  if( !m_csvFileName.empty() && !xWriteCsv() )
+  {
+    msg( ERROR, "\nFailed to write CSV file %s\n", m_csvFileName.c_str() );
+  }
+
+  if( m_numMismatches )
+  {
+    msg( ERROR, "\n%d kernel results differ from the scalar implementation\n", m_numMismatches );
+  }
+
+  return m_numMismatches;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+const char* KernelBenchApp::xGetLevelName( X86_VEXT level )
+{
+#ifdef TARGET_SIMD_X86
+  switch( level )
+  {
+  case SSE41:  return "SSE41";
+  case SSE42:  return "SSE42";
+  case AVX:    return "AVX";
+  case AVX2:   return "AVX2";
+  case AVX512: return "AVX512";
+  default:     break;
+  }
+#endif
+  return "C";
+}
+
+bool KernelBenchApp::xIsSelected( const std::string& kernel ) const
+{
+  return m_kernelFilter.empty() || kernel.find( m_kernelFilter ) != std::string::npos;
+}
+
+/// scalar level followed by those of the given SIMD levels which are supported by the CPU
+std::vector<X86_VEXT> KernelBenchApp::xGetLevels( const std::vector<X86_VEXT>& simdLevels ) const
+{
+  std::vector<X86_VEXT> levels( 1, SCALAR );
+  for( X86_VEXT level : simdLevels )
+  {
+    if( level <= m_maxLevel )
+    {
+      levels.push_back( level );
+    }
+  }
+  return levels;
+}
+
+/// average time of one call in ns, the kernel is called repeatedly for at least m_minTime ms
+double KernelBenchApp::xTime( const KernelCall& call ) const
+{
+  const auto minTime = std::chrono::milliseconds( m_minTime );
+  const auto start   = std::chrono::steady_clock::now();
+  auto       elapsed = std::chrono::steady_clock::duration::zero();
+  int64_t    calls   = 0;
+  int        batch   = 1;
+
+  while( elapsed < minTime )
+  {
+    for( int i = 0; i < batch; i++ )
+    {
+      call();
+    }
+    calls  += batch;
+    batch   = std::min( batch * 2, 1 << 16 );
+    elapsed = std::chrono::steady_clock::now() - start;
+  }
+
+  return std::chrono::duration<double, std::nano>( elapsed ).count() / calls;
+}
+
+/** \param kernel  kernel name
+    \param size    block size name
+    \param levels  levels to run, the first one is the reference for the bit-exactness check
+    \param setup   prepares the kernel for a level and returns the call to be measured
+    \param out     output of the kernel, compared between the levels
+    \param outSize size of the output in bytes
+ */
+void KernelBenchApp::xRun( const std::string& kernel, const std::string& size, const std::vector<X86_VEXT>& levels,
+                           const KernelSetup& setup, void* out, size_t outSize )
+{
+  std::vector<uint8_t> refOut;
+  double               refTime = 0;
+
+  for( X86_VEXT level : levels )
+  {
+    KernelCall call = setup( level );
+
+    memset( out, 0, outSize );
+    call();
+
+    bool exact = true;
+    if( refOut.empty() )
+    {
+      refOut.assign( ( const uint8_t* ) out, ( const uint8_t* ) out + outSize );
+    }
+    else
+    {
+      exact = memcmp( refOut.data(), out, outSize ) == 0;
+    }
+
+    BenchResult result;
+    result.kernel    = kernel;
+    result.size      = size;
+    result.level     = level;
+    result.nsPerCall = xTime( call );
+    result.exact     = exact;
+    if( level == levels.front() )
+    {
+      refTime = result.nsPerCall;
+    }
+    result.speedup   = refTime / result.nsPerCall;
+
+    m_numMismatches += exact ? 0 : 1;
+    m_results.push_back( result );
+
+    msg( INFO, "%-16s %-8s %-6s %11.1f ns %8.2fx  %s\n", kernel.c_str(), size.c_str(), xGetLevelName( level ), result.nsPerCall, result.speedup, exact ? "yes" : "NO" );
+  }
+}
+
+void KernelBenchApp::xBenchInterpolation()
+{
+  if( !xIsSelected( "interp_hor8" ) && !xIsSelected( "interp_ver8" ) && !xIsSelected( "interp_hor4" ) && !xIsSelected( "interp_ver4" ) )
+  {
+    return;
+  }
+
+#if ENABLE_SIMD_OPT_MCIF && defined( TARGET_SIMD_X86 )
+  const std::vector<X86_VEXT> levels = xGetLevels( { SSE41, AVX, AVX2, AVX512 } );
+#else
+  const std::vector<X86_VEXT> levels = xGetLevels( {} );
+#endif
+
+  const int    margin = 8;
+  const int    stride = MAX_CU_SIZE + 2 * margin;
+  const ClpRng clpRng = { 0, ( 1 << m_bitDepth ) - 1, m_bitDepth, 0 };
+
+  std::mt19937     rng( 1 );
+  std::vector<Pel> src( stride * stride ), tmp( stride * stride ), dst( stride * stride );
+  fillRandom( src, 0, clpRng.max, rng );
+
+  const int offset = margin * stride + margin;
+
+  for( int tapIdx = 0; tapIdx < 2; tapIdx++ )
+  {
+    const std::string   taps  = tapIdx == 0 ? "8" : "4";
+    const TFilterCoeff* coeff = tapIdx == 0 ? InterpolationFilter::m_lumaFilter[LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS >> 1]
+                                            : InterpolationFilter::m_chromaFilter[CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS >> 1];
+
+    // intermediate samples of the first (horizontal) stage as input of the vertical stage
+    InterpolationFilter refFilter;
+    refFilter.m_filterHor[tapIdx][1][0]( clpRng, &src[margin], stride, &tmp[margin], stride, MAX_CU_SIZE, stride, coeff, false );
+
+    for( int dir = 0; dir < 2; dir++ )
+    {
+      const std::string kernel = std::string( dir == 0 ? "interp_hor" : "interp_ver" ) + taps;
+      if( !xIsSelected( kernel ) )
+      {
+        continue;
+      }
+
+      for( int size = 4; size <= MAX_CU_SIZE; size <<= 1 )
+      {
+        InterpolationFilter filter;
+
+        KernelSetup setup = [&]( X86_VEXT level ) -> KernelCall
+        {
+          filter = InterpolationFilter();
+#if ENABLE_SIMD_OPT_MCIF && defined( TARGET_SIMD_X86 )
+          initLevel( filter, level );
+#endif
+          if( dir == 0 )
+          {
+            return [&, size]() { filter.m_filterHor[tapIdx][1][0]( clpRng, &src[offset], stride, &dst[offset], stride, size, size, coeff, false ); };
+          }
+          return [&, size]() { filter.m_filterVer[tapIdx][0][1]( clpRng, &tmp[offset], stride, &dst[offset], stride, size, size, coeff, false ); };
+        };
+
+        xRun( kernel, sizeName( size, size ), levels, setup, dst.data(), dst.size() * sizeof( Pel ) );
+      }
+    }
+  }
+}
+
+void KernelBenchApp::xBenchDistortion()
+{
+#if ENABLE_SIMD_OPT_DIST && defined( TARGET_SIMD_X86 )
+  const std::vector<X86_VEXT> levels = xGetLevels( { SSE41, AVX, AVX2, AVX512 } );
+#else
+  const std::vector<X86_VEXT> levels = xGetLevels( {} );
+#endif
+
+  std::mt19937     rng( 2 );
+  std::vector<Pel> org( MAX_CU_SIZE * MAX_CU_SIZE ), cur( MAX_CU_SIZE * MAX_CU_SIZE );
+  fillRandom( org, 0, ( 1 << m_bitDepth ) - 1, rng );
+  fillRandom( cur, 0, ( 1 << m_bitDepth ) - 1, rng );
+
+  RdCost     rdCost;
+  Distortion dist = 0;
+
+  for( int hadamard = 0; hadamard < 2; hadamard++ )
+  {
+    const std::string kernel = hadamard ? "satd" : "sad";
+    if( !xIsSelected( kernel ) )
+    {
+      continue;
+    }
+
+    for( int size = 4; size <= MAX_CU_SIZE; size <<= 1 )
+    {
+      const CPelBuf orgBuf( org.data(), MAX_CU_SIZE, size, size );
+      const CPelBuf curBuf( cur.data(), MAX_CU_SIZE, size, size );
+
+      KernelSetup setup = [&]( X86_VEXT level ) -> KernelCall
+      {
+        // the distortion function table is shared by all RdCost instances
+        rdCost.init();
+#if ENABLE_SIMD_OPT_DIST && defined( TARGET_SIMD_X86 )
+        initLevel( rdCost, level );
+#endif
+        DistParam distParam;
+        rdCost.setDistParam( distParam, orgBuf, curBuf, m_bitDepth, COMPONENT_Y, hadamard != 0 );
+        return [&dist, distParam]() { dist = distParam.distFunc( distParam ); };
+      };
+
+      xRun( kernel, sizeName( size, size ), levels, setup, &dist, sizeof( dist ) );
+    }
+  }
+}
+
+void KernelBenchApp::xBenchPelBufOps()
+{
+#if ENABLE_SIMD_OPT_BUFFER && defined( TARGET_SIMD_X86 )
+  const std::vector<X86_VEXT> levels = xGetLevels( { SSE41, AVX, AVX2, AVX512 } );
+#else
+  const std::vector<X86_VEXT> levels = xGetLevels( {} );
+#endif
+
+  const int    stride = MAX_CU_SIZE;
+  const ClpRng clpRng = { 0, ( 1 << m_bitDepth ) - 1, m_bitDepth, 0 };
+
+  std::mt19937     rng( 3 );
+  std::vector<Pel> pred0( stride * stride ), pred1( stride * stride ), reco( stride * stride ), resi( stride * stride ), dst( stride * stride );
+  // predictions in the intermediate domain of the interpolation filter
+  const int predShift = IF_INTERNAL_PREC - m_bitDepth;
+  fillRandom( pred0, -IF_INTERNAL_OFFS, ( clpRng.max << predShift ) - IF_INTERNAL_OFFS, rng );
+  fillRandom( pred1, -IF_INTERNAL_OFFS, ( clpRng.max << predShift ) - IF_INTERNAL_OFFS, rng );
+  fillRandom( reco, 0, clpRng.max, rng );
+  fillRandom( resi, -clpRng.max, clpRng.max, rng );
+
+  const int avgShift  = IF_INTERNAL_PREC + 1 - m_bitDepth;
+  const int avgOffset = ( 1 << ( avgShift - 1 ) ) + 2 * IF_INTERNAL_OFFS;
+
+  // explicit weighted prediction with a log2 weight denominator of 6
+  const int wpShift    = 6 + IF_INTERNAL_PREC - m_bitDepth;
+  const int wpBiOffset = ( 70 - 13 ) * IF_INTERNAL_OFFS + ( 1 << wpShift ) + 3 * ( 1 << wpShift );
+  const int wpUniRound = 70 * IF_INTERNAL_OFFS + ( 1 << ( wpShift - 1 ) );
+
+  static const char* kernels[] = { "add_avg", "reco", "lin_tf", "copy_buffer", "wp_bi", "wp_uni" };
+
+  for( int k = 0; k < 6; k++ )
+  {
+    if( !xIsSelected( kernels[k] ) )
+    {
+      continue;
+    }
+
+    for( int size = 4; size <= MAX_CU_SIZE; size <<= 1 )
+    {
+      PelBufferOps ops;
+
+      KernelSetup setup = [&]( X86_VEXT level ) -> KernelCall
+      {
+        ops = PelBufferOps();
+#if ENABLE_SIMD_OPT_BUFFER && defined( TARGET_SIMD_X86 )
+        initLevel( ops, level );
+#endif
+        const bool mul8 = ( size & 7 ) == 0;
+        switch( k )
+        {
+        case 0:
+          return [&, size, mul8]() { ( mul8 ? ops.addAvg8 : ops.addAvg4 )( pred0.data(), stride, pred1.data(), stride, dst.data(), stride, size, size, avgShift, avgOffset, clpRng ); };
+        case 1:
+          return [&, size, mul8]() { ( mul8 ? ops.reco8 : ops.reco4 )( reco.data(), stride, resi.data(), stride, dst.data(), stride, size, size, clpRng ); };
+        case 2:
+          return [&, size, mul8]() { ( mul8 ? ops.linTf8 : ops.linTf4 )( reco.data(), stride, dst.data(), stride, size, size, 37, 5, 3, clpRng, true ); };
+        case 3:
+          return [&, size]() { ops.copyBuffer( reco.data(), stride, dst.data(), stride, size, size ); };
+        case 4:
+          return [&, size]() { ops.weightBi( pred0.data(), stride, pred1.data(), stride, dst.data(), stride, size, size, 70, -13, wpShift + 1, wpBiOffset, clpRng ); };
+        default:
+          return [&, size]() { ops.weightUni( pred0.data(), stride, dst.data(), stride, size, size, 70, wpUniRound, wpShift, -5, clpRng ); };
+        }
+      };
+
+      xRun( kernels[k], sizeName( size, size ), levels, setup, dst.data(), dst.size() * sizeof( Pel ) );
+    }
+  }
+
+  if( xIsSelected( "border_ext" ) )
+  {
+    // one stripe of rows of a 1080p picture, with the luma and chroma margins of 128x128 CTUs with and without RPR
+    const int width  = 1920;
+    const int height = BORDER_EXT_STRIPE_HEIGHT;
+
+    for( int margin : { 72, 144, 288 } )
+    {
+      const int        picStride = width + 2 * margin;
+      std::vector<Pel> pic( picStride * height );
+      PelBufferOps     ops;
+      fillRandom( pic, 0, clpRng.max, rng );
+
+      KernelSetup setup = [&]( X86_VEXT level ) -> KernelCall
+      {
+        ops = PelBufferOps();
+#if ENABLE_SIMD_OPT_BUFFER && defined( TARGET_SIMD_X86 )
+        initLevel( ops, level );
+#endif
+        return [&]() { ops.extendBorderHor( pic.data() + margin, picStride, width, height, margin ); };
+      };
+
+      xRun( "border_ext", sizeName( margin, height ), levels, setup, pic.data(), pic.size() * sizeof( Pel ) );
+    }
+  }
+
+  if( xIsSelected( "pic_sse" ) )
+  {
+    // rows of a 1080p luma and chroma plane; the result is stored in the output buffer for the comparison
+    for( int width : { 960, 1920 } )
+    {
+      const int        height = 64;
+      std::vector<Pel> org( width * height ), rec( width * height );
+      std::vector<uint64_t> sum( 1 );
+      PelBufferOps     ops;
+      fillRandom( org, 0, clpRng.max, rng );
+      fillRandom( rec, 0, clpRng.max, rng );
+
+      KernelSetup setup = [&]( X86_VEXT level ) -> KernelCall
+      {
+        ops = PelBufferOps();
+#if ENABLE_SIMD_OPT_BUFFER && defined( TARGET_SIMD_X86 )
+        initLevel( ops, level );
+#endif
+        return [&]() { sum[0] = ops.calcSSE( org.data(), width, rec.data(), width, width, height, m_bitDepth ); };
+      };
+
+      xRun( "pic_sse", sizeName( width, height ), levels, setup, sum.data(), sizeof( uint64_t ) );
+    }
+  }
+}
+
+void KernelBenchApp::xBenchAlf()
+{
+#if ENABLE_SIMD_OPT_ALF && defined( TARGET_SIMD_X86 )
+  const std::vector<X86_VEXT> levels = xGetLevels( { SSE41, AVX, AVX2, AVX512 } );
+#else
+  const std::vector<X86_VEXT> levels = xGetLevels( {} );
+#endif
+
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+  typedef Pel   AlfClip;
+#else
+  typedef short AlfClip;
+#endif
+
+  const int    margin = 8;
+  const int    stride = MAX_CU_SIZE + 2 * margin;
+  const int    offset = margin * stride + margin;
+  const ClpRng clpRng = { 0, ( 1 << m_bitDepth ) - 1, m_bitDepth, 0 };
+
+  // smooth content with a small noise; the filter sum of the scalar implementation may be limited to 16 bit
+  // (JVET_R0351_HIGH_BIT_DEPTH_SUPPORT), which white noise and random coefficients would overflow
+  std::mt19937     rng( 4 );
+  std::vector<Pel> src( stride * stride ), dst( stride * stride );
+  fillRandom( src, -8, 8, rng );
+  for( int y = 0; y < stride; y++ )
+  {
+    for( int x = 0; x < stride; x++ )
+    {
+      src[y * stride + x] += ( clpRng.max >> 2 ) + x + y;
+    }
+  }
+
+  std::vector<short>   coeff( MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF );
+  std::vector<AlfClip> clip ( MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF );
+  fillRandom( coeff, -16, 16, rng );
+  std::uniform_int_distribution<int> clipIdx( 0, 3 );
+  for( auto& val : clip )
+  {
+    // clipping values of the four clipping indices
+    val = AlfClip( 1 << ( m_bitDepth - ( m_bitDepth * clipIdx( rng ) ) / 4 ) );
+  }
+
+  // one class and transpose index per 4x4 block
+  std::vector<AlfClassifier>  classes( MAX_CU_SIZE * MAX_CU_SIZE );
+  std::vector<AlfClassifier*> classifier( MAX_CU_SIZE );
+  std::uniform_int_distribution<int> classIdx( 0, MAX_NUM_ALF_CLASSES - 1 ), transposeIdx( 0, 3 );
+  for( int y = 0; y < MAX_CU_SIZE; y++ )
+  {
+    classifier[y] = &classes[y * MAX_CU_SIZE];
+    for( int x = 0; x < MAX_CU_SIZE; x++ )
+    {
+      classes[y * MAX_CU_SIZE + x] = ( ( x | y ) & 3 ) ? classes[( y & ~3 ) * MAX_CU_SIZE + ( x & ~3 )] : AlfClassifier( classIdx( rng ), transposeIdx( rng ) );
+    }
+  }
+
+  const CPelBuf     srcBuf( &src[offset], stride, MAX_CU_SIZE, MAX_CU_SIZE );
+  const PelBuf      dstBuf( &dst[offset], stride, MAX_CU_SIZE, MAX_CU_SIZE );
+  const CPelUnitBuf srcUnitBuf( CHROMA_420, srcBuf, srcBuf, srcBuf );
+  const PelUnitBuf  dstUnitBuf( CHROMA_420, dstBuf, dstBuf, dstBuf );
+
+  CUCache         cuCache;
+  PUCache         puCache;
+  TUCache         tuCache;
+  CodingStructure cs( cuCache, puCache, tuCache );
+
+  for( int luma = 1; luma >= 0; luma-- )
+  {
+    const std::string kernel = luma ? "alf_7x7" : "alf_5x5";
+    if( !xIsSelected( kernel ) )
+    {
+      continue;
+    }
+
+    // luma CTUs of 128x128 and 4:2:0 chroma
+    const int         maxSize     = luma ? MAX_CU_SIZE : MAX_CU_SIZE >> 1;
+    const int         vbCTUHeight = maxSize;
+    const int         vbPos       = maxSize - ( luma ? ALF_VB_POS_ABOVE_CTUROW_LUMA : ALF_VB_POS_ABOVE_CTUROW_CHMA );
+    const ComponentID compID      = luma ? COMPONENT_Y : COMPONENT_Cb;
+
+    for( int size = maxSize >> 2; size <= maxSize; size <<= 1 )
+    {
+      AdaptiveLoopFilter alf;
+      const Area         blk( 0, 0, size, size );
+
+      KernelSetup setup = [&]( X86_VEXT level ) -> KernelCall
+      {
+        alf.m_filter5x5Blk = AdaptiveLoopFilter::filterBlk<ALF_FILTER_5>;
+        alf.m_filter7x7Blk = AdaptiveLoopFilter::filterBlk<ALF_FILTER_7>;
+#if ENABLE_SIMD_OPT_ALF && defined( TARGET_SIMD_X86 )
+        initLevel( alf, level );
+#endif
+        if( luma )
+        {
+          return [&]() { alf.m_filter7x7Blk( classifier.data(), dstUnitBuf, srcUnitBuf, blk, blk, compID, coeff.data(), clip.data(), clpRng, cs, vbCTUHeight, vbPos ); };
+        }
+        return [&]() { alf.m_filter5x5Blk( classifier.data(), dstUnitBuf, srcUnitBuf, blk, blk, compID, coeff.data(), clip.data(), clpRng, cs, vbCTUHeight, vbPos ); };
+      };
+
+      xRun( kernel, sizeName( size, size ), levels, setup, dst.data(), dst.size() * sizeof( Pel ) );
+    }
+  }
+}
+
+void KernelBenchApp::xBenchTransform()
+{
+  // there are no SIMD implementations of the transforms
+  const std::vector<X86_VEXT> levels = xGetLevels( {} );
+
+  typedef void FwdTrans( const TCoeff*, TCoeff*, int, int, int, int );
+  typedef void InvTrans( const TCoeff*, TCoeff*, int, int, int, int, const TCoeff, const TCoeff );
+
+  static FwdTrans* const fwdDCT2[] = { fastForwardDCT2_B4, fastForwardDCT2_B8, fastForwardDCT2_B16, fastForwardDCT2_B32, fastForwardDCT2_B64 };
+  static InvTrans* const invDCT2[] = { fastInverseDCT2_B4, fastInverseDCT2_B8, fastInverseDCT2_B16, fastInverseDCT2_B32, fastInverseDCT2_B64 };
+  static FwdTrans* const fwdDST7[] = { fastForwardDST7_B4, fastForwardDST7_B8, fastForwardDST7_B16, fastForwardDST7_B32 };
+  static InvTrans* const invDST7[] = { fastInverseDST7_B4, fastInverseDST7_B8, fastInverseDST7_B16, fastInverseDST7_B32 };
+
+  std::mt19937        rng( 5 );
+  std::vector<TCoeff> resi( MAX_TB_SIZEY * MAX_TB_SIZEY ), coeff( MAX_TB_SIZEY * MAX_TB_SIZEY ), dst( MAX_TB_SIZEY * MAX_TB_SIZEY );
+  fillRandom( resi, 1 - ( 1 << m_bitDepth ), ( 1 << m_bitDepth ) - 1, rng );
+  fillRandom( coeff, -( 1 << 15 ), ( 1 << 15 ) - 1, rng );
+
+  for( int type = 0; type < 4; type++ )
+  {
+    const bool        dst7    = type >= 2;
+    const bool        inverse = type & 1;
+    const std::string kernel  = std::string( inverse ? "inv_" : "fwd_" ) + ( dst7 ? "dst7" : "dct2" );
+    if( !xIsSelected( kernel ) )
+    {
+      continue;
+    }
+
+    const int numSizes = dst7 ? 4 : 5;
+    for( int sizeIdx = 0; sizeIdx < numSizes; sizeIdx++ )
+    {
+      const int size = 4 << sizeIdx;
+      // shifts of the first transform stage
+      const int fwdShift = floorLog2( size ) + m_bitDepth - 9;
+      const int invShift = 7;
+
+      KernelSetup setup = [&]( X86_VEXT level ) -> KernelCall
+      {
+        if( inverse )
+        {
+          InvTrans* invTrans = dst7 ? invDST7[sizeIdx] : invDCT2[sizeIdx];
+          return [&, invTrans, size]() { invTrans( coeff.data(), dst.data(), invShift, size, 0, 0, -( 1 << 15 ), ( 1 << 15 ) - 1 ); };
+        }
+        FwdTrans* fwdTrans = dst7 ? fwdDST7[sizeIdx] : fwdDCT2[sizeIdx];
+        return [&, fwdTrans, size]() { fwdTrans( resi.data(), dst.data(), fwdShift, size, 0, 0 ); };
+      };
+
+      xRun( kernel, sizeName( size, size ), levels, setup, dst.data(), dst.size() * sizeof( TCoeff ) );
+    }
+  }
+}
+
+void KernelBenchApp::xBenchLfnst()
+{
+#if ENABLE_SIMD_OPT_LFNST && defined( TARGET_SIMD_X86 )
+  const std::vector<X86_VEXT> levels = xGetLevels( { SSE41, AVX2, AVX512 } );
+#else
+  const std::vector<X86_VEXT> levels = xGetLevels( {} );
+#endif
+
+  std::mt19937        rng( 13 );
+  std::vector<TCoeff> src( 48 ), dst( 48 );
+  fillRandom( src, -( 1 << 15 ), ( 1 << 15 ) - 1, rng );
+
+  std::unique_ptr<TrQuant> trQuant( new TrQuant );
+
+  // one kernel per LFNST set, for the 4x4 and 8x8 kernels with and without the zero-out of the 4x4 and 8x8 blocks
+  for( int inverse = 0; inverse < 2; inverse++ )
+  {
+    for( uint32_t lfnstSet = 0; lfnstSet < 4; lfnstSet++ )
+    {
+      const std::string kernel = std::string( inverse ? "lfnst_inv_set" : "lfnst_fwd_set" ) + std::to_string( lfnstSet );
+      if( !xIsSelected( kernel ) )
+      {
+        continue;
+      }
+
+      for( uint32_t sbSize = 4; sbSize <= 8; sbSize <<= 1 )
+      {
+        for( int zeroOutSize = 16; zeroOutSize >= 8; zeroOutSize >>= 1 )
+        {
+          KernelSetup setup = [&]( X86_VEXT level ) -> KernelCall
+          {
+            trQuant->m_fwdLfnst = TrQuant::fwdLfnstCore;
+            trQuant->m_invLfnst = TrQuant::invLfnstCore;
+#if ENABLE_SIMD_OPT_LFNST && defined( TARGET_SIMD_X86 )
+            initLevel( *trQuant, level );
+#endif
+            if( inverse )
+            {
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+              return [&, sbSize, zeroOutSize]() { trQuant->invLfnstNxN( src.data(), dst.data(), lfnstSet, 0, sbSize, zeroOutSize, 15 ); };
+#else
+              return [&, sbSize, zeroOutSize]() { trQuant->invLfnstNxN( src.data(), dst.data(), lfnstSet, 0, sbSize, zeroOutSize ); };
+#endif
+            }
+            return [&, sbSize, zeroOutSize]() { trQuant->fwdLfnstNxN( src.data(), dst.data(), lfnstSet, 0, sbSize, zeroOutSize ); };
+          };
+
+          const std::string size = sizeName( sbSize, sbSize ) + ( zeroOutSize == 8 ? "z8" : "" );
+          xRun( kernel, size, levels, setup, dst.data(), dst.size() * sizeof( TCoeff ) );
+        }
+      }
+    }
+  }
+}
+
+void KernelBenchApp::xBenchQuant()
+{
+#if ENABLE_SIMD_OPT_QUANT && defined( TARGET_SIMD_X86 )
+  const std::vector<X86_VEXT> levels = xGetLevels( { SSE41, AVX2, AVX512 } );
+#else
+  const std::vector<X86_VEXT> levels = xGetLevels( {} );
+#endif
+
+  const int maxNumCoeff = MAX_TB_SIZEY * MAX_TB_SIZEY;
+
+  std::mt19937        rng( 17 );
+  std::vector<TCoeff> src( maxNumCoeff ), small( maxNumCoeff ), dst( 2 * maxNumCoeff + 1 );
+  std::vector<int>    scales( maxNumCoeff ), invScales( maxNumCoeff );
+  fillRandom( src, -( 1 << 15 ), ( 1 << 15 ) - 1, rng );
+  fillRandom( small, -8, 8, rng );
+  fillRandom( scales, 1 << 10, 1 << 16, rng );
+  fillRandom( invScales, 1 << 6, 1 << 11, rng );
+
+  std::unique_ptr<Quant> quant( new Quant( nullptr ) );
+
+  // qBits, rounding offset and scales of a 16x16 intra block at QP 32 with 10 bit samples
+  const int     qBits         = QUANT_SHIFT + 5 + 1;
+  const int64_t add           = int64_t( 171 ) << ( qBits - 9 );
+  const int     scale         = g_quantScales[0][2];
+  const int     invScale      = g_invQuantScales[0][2];
+  const int     dequantShift  = 5;
+  const TCoeff  coeffMin      = -( 1 << 15 );
+  const TCoeff  coeffMax      = ( 1 << 15 ) - 1;
+
+  for( int useScales = 0; useScales < 2; useScales++ )
+  {
+    const std::string suffix = useScales ? "_sl" : "";
+
+    for( int size = 4; size <= MAX_TB_SIZEY; size <<= 1 )
+    {
+      const int numCoeff = size * size;
+
+      auto setLevel = [&]( X86_VEXT level )
+      {
+        quant->m_dequantBlk  = Quant::dequantCore;
+        quant->m_quantBlk    = Quant::quantCore;
+        quant->m_isZeroQuant = Quant::isZeroQuantCore;
+#if ENABLE_SIMD_OPT_QUANT && defined( TARGET_SIMD_X86 )
+        initLevel( *quant, level );
+#endif
+      };
+
+      if( xIsSelected( "quant" + suffix ) )
+      {
+        KernelSetup setup = [&, numCoeff]( X86_VEXT level ) -> KernelCall
+        {
+          setLevel( level );
+          return [&, numCoeff]()
+          {
+            dst[2 * numCoeff] = quant->m_quantBlk( src.data(), dst.data(), dst.data() + numCoeff, numCoeff, scale, useScales ? scales.data() : nullptr,
+                                                   add, qBits, coeffMin, coeffMax );
+          };
+        };
+        xRun( "quant" + suffix, sizeName( size, size ), levels, setup, dst.data(), ( 2 * numCoeff + 1 ) * sizeof( TCoeff ) );
+      }
+
+      if( xIsSelected( "dequant" + suffix ) )
+      {
+        KernelSetup setup = [&, numCoeff]( X86_VEXT level ) -> KernelCall
+        {
+          setLevel( level );
+          return [&, numCoeff]()
+          {
+            quant->m_dequantBlk( src.data(), dst.data(), numCoeff, invScale, useScales ? invScales.data() : nullptr, dequantShift + ( useScales ? 4 : 0 ),
+                                 coeffMin, coeffMax, coeffMin, coeffMax );
+          };
+        };
+        xRun( "dequant" + suffix, sizeName( size, size ), levels, setup, dst.data(), numCoeff * sizeof( TCoeff ) );
+      }
+
+      // all coefficients are quantized to zero, such that the whole block is tested
+      if( xIsSelected( "quant_zero" + suffix ) )
+      {
+        KernelSetup setup = [&, size]( X86_VEXT level ) -> KernelCall
+        {
+          setLevel( level );
+          return [&, size]()
+          {
+            dst[0] = quant->m_isZeroQuant( small.data(), size, size, size, scale, useScales ? scales.data() : nullptr, int64_t( 1 ) << qBits ) ? 1 : 0;
+          };
+        };
+        xRun( "quant_zero" + suffix, sizeName( size, size ), levels, setup, dst.data(), sizeof( TCoeff ) );
+      }
+    }
+  }
+}
+
+void KernelBenchApp::xBenchIbcHash()
+{
+  if( !xIsSelected( "ibc_crc32c" ) && !xIsSelected( "ibc_block_crc32c" ) )
+  {
+    return;
+  }
+
+#if ENABLE_SIMD_OPT_IBC && defined( TARGET_SIMD_X86 )
+  const std::vector<X86_VEXT> levels = xGetLevels( { SSE42 } );
+#else
+  const std::vector<X86_VEXT> levels = xGetLevels( {} );
+#endif
+
+  std::mt19937     rng( 6 );
+  std::vector<Pel> src( MAX_CU_SIZE * MAX_CU_SIZE );
+  fillRandom( src, 0, ( 1 << m_bitDepth ) - 1, rng );
+
+  std::unique_ptr<IbcHashMap> hashMap;
+  uint32_t                    crc = 0;
+
+  for( int size = 4; size <= 64; size <<= 1 )
+  {
+    KernelSetup setup = [&]( X86_VEXT level ) -> KernelCall
+    {
+      hashMap.reset( new IbcHashMap );
+#if ENABLE_SIMD_OPT_IBC && defined( TARGET_SIMD_X86 )
+      initLevel( *hashMap, level );
+#endif
+      return [&, size]()
+      {
+        uint32_t blockCrc = 0xffffffff;
+        for( int y = 0; y < size; y++ )
+        {
+          for( int x = 0; x < size; x++ )
+          {
+            blockCrc = hashMap->m_computeCrc32c( blockCrc, src[y * MAX_CU_SIZE + x] );
+          }
+        }
+        crc = blockCrc;
+      };
+    };
+
+    if( xIsSelected( "ibc_crc32c" ) )
+    {
+      xRun( "ibc_crc32c", sizeName( size, size ), levels, setup, &crc, sizeof( crc ) );
+    }
+  }
+
+  for( int size = 2; size <= 64; size <<= 1 )
+  {
+    KernelSetup setup = [&]( X86_VEXT level ) -> KernelCall
+    {
+      hashMap.reset( new IbcHashMap );
+#if ENABLE_SIMD_OPT_IBC && defined( TARGET_SIMD_X86 )
+      initLevel( *hashMap, level );
+#endif
+      return [&, size]()
+      {
+        crc = hashMap->m_computeBlockCrc32c( 0xffffffff, src.data(), MAX_CU_SIZE, size, size );
+      };
+    };
+
+    if( xIsSelected( "ibc_block_crc32c" ) )
+    {
+      xRun( "ibc_block_crc32c", sizeName( size, size ), levels, setup, &crc, sizeof( crc ) );
+    }
+  }
+}
+
+void KernelBenchApp::xBenchResampling()
+{
+  const int    ratio  = 3;   ///< horizontal step in 1/2 samples, i.e. 1.5x
+  const int    margin = 16;
+  const ClpRng clpRng = { 0, ( 1 << m_bitDepth ) - 1, m_bitDepth, 0 };
+
+  std::mt19937 rng( 7 );
+
+  // motion compensation from a scaled reference picture, horizontal stage with one filter phase per column
+  if( xIsSelected( "interp_scaled" ) )
+  {
+#if ENABLE_SIMD_OPT_MCIF && defined( TARGET_SIMD_X86 )
+    const std::vector<X86_VEXT> levels = xGetLevels( { SSE41, AVX2 } );
+#else
+    const std::vector<X86_VEXT> levels = xGetLevels( {} );
+#endif
+
+    const int        stride = 2 * MAX_CU_SIZE + 2 * margin;
+    std::vector<Pel> src( stride * stride ), dst( MAX_CU_SIZE * ( MAX_CU_SIZE + 8 ) );
+    fillRandom( src, 0, clpRng.max, rng );
+
+    int colOffset[MAX_CU_SIZE];
+    int colFrac[MAX_CU_SIZE];
+    for( int col = 0; col < MAX_CU_SIZE; col++ )
+    {
+      colOffset[col] = ( col * ratio ) >> 1;
+      colFrac[col]   = ( col * ratio * 8 ) & 15;
+    }
+
+    for( int tapIdx = 0; tapIdx < 2; tapIdx++ )
+    {
+      const std::string kernel = tapIdx == 0 ? "interp_scaled8" : "interp_scaled4";
+      if( !xIsSelected( kernel ) )
+      {
+        continue;
+      }
+
+      for( int size = 4; size <= MAX_CU_SIZE; size <<= 1 )
+      {
+        InterpolationFilter filter;
+
+        KernelSetup setup = [&]( X86_VEXT level ) -> KernelCall
+        {
+          filter = InterpolationFilter();
+#if ENABLE_SIMD_OPT_MCIF && defined( TARGET_SIMD_X86 )
+          initLevel( filter, level );
+#endif
+          const ComponentID compID = tapIdx == 0 ? COMPONENT_Y : COMPONENT_Cb;
+          return [&, size, compID]() { filter.filterHorScaled( compID, &src[margin * stride + margin], stride, dst.data(), size, size, size + 7, colOffset, colFrac, CHROMA_444, clpRng, 3 ); };
+        };
+
+        xRun( kernel, sizeName( size, size ), levels, setup, dst.data(), dst.size() * sizeof( Pel ) );
+      }
+    }
+  }
+
+  // rows of the picture resampling of Picture::sampleRateConv, 12-tap downsampling and 8-tap upsampling filters
+  if( xIsSelected( "resample_hor" ) || xIsSelected( "resample_ver" ) )
+  {
+#if ENABLE_SIMD_OPT_BUFFER && defined( TARGET_SIMD_X86 )
+    const std::vector<X86_VEXT> levels = xGetLevels( { SSE41, AVX2 } );
+#else
+    const std::vector<X86_VEXT> levels = xGetLevels( {} );
+#endif
+
+    const int        width = 1920;
+    std::vector<Pel> line( 2 * width + 2 * margin ), dst( width );
+    std::vector<int> hor( width ), tmp( 12 * width );
+    std::vector<int> srcOffset( width ), phase( width );
+    fillRandom( line, 0, clpRng.max, rng );
+    fillRandom( tmp, 0, clpRng.max << 7, rng );
+
+    // the downsampling filters are local to Picture.cpp, random taps of a similar range are used instead
+    std::vector<TFilterCoeff> filter12( 16 * 12 );
+    fillRandom( filter12, -10, 23, rng );
+
+    const int* rows[12];
+    for( int k = 0; k < 12; k++ )
+    {
+      rows[k] = tmp.data() + k * width;
+    }
+
+    for( int filterLength = 8; filterLength <= 12; filterLength += 4 )
+    {
+      const TFilterCoeff* filter   = filterLength == 8 ? &InterpolationFilter::m_lumaFilter[0][0] : filter12.data();
+      const int           log2Norm = filterLength == 8 ? 12 : 14;
+
+      for( int i = 0; i < width; i++ )
+      {
+        srcOffset[i] = ( i * ratio ) >> 1;
+        phase[i]     = ( i * ratio * 8 ) & 15;
+      }
+
+      for( int dir = 0; dir < 2; dir++ )
+      {
+        const std::string kernel = std::string( dir == 0 ? "resample_hor" : "resample_ver" ) + std::to_string( filterLength );
+        if( !xIsSelected( kernel ) )
+        {
+          continue;
+        }
+
+        PelBufferOps ops;
+
+        KernelSetup setup = [&]( X86_VEXT level ) -> KernelCall
+        {
+          ops = PelBufferOps();
+#if ENABLE_SIMD_OPT_BUFFER && defined( TARGET_SIMD_X86 )
+          initLevel( ops, level );
+#endif
+          if( dir == 0 )
+          {
+            return [&]() { ops.sampleRateConvHor( line.data(), hor.data(), width, srcOffset.data(), phase.data(), filter, filterLength ); };
+          }
+          return [&]() { ops.sampleRateConvVer( rows, dst.data(), width, filter + 5 * filterLength, filterLength, log2Norm, clpRng.max ); };
+        };
+
+        if( dir == 0 )
+        {
+          xRun( kernel, sizeName( width, 1 ), levels, setup, hor.data(), hor.size() * sizeof( int ) );
+        }
+        else
+        {
+          xRun( kernel, sizeName( width, 1 ), levels, setup, dst.data(), dst.size() * sizeof( Pel ) );
+        }
+      }
+    }
+  }
+}
+
+void KernelBenchApp::xBenchLmcs()
+{
+  if( !xIsSelected( "lmcs_fwd" ) && !xIsSelected( "lmcs_inv" ) && !xIsSelected( "chroma_scale" ) )
+  {
+    return;
+  }
+
+#if ENABLE_SIMD_OPT_BUFFER && defined( TARGET_SIMD_X86 )
+  const std::vector<X86_VEXT> levels = xGetLevels( { SSE41, AVX2 } );
+#else
+  const std::vector<X86_VEXT> levels = xGetLevels( {} );
+#endif
+
+  const int    stride = MAX_CU_SIZE;
+  const ClpRng clpRng = { 0, ( 1 << m_bitDepth ) - 1, m_bitDepth, 0 };
+
+  std::mt19937 rng( 11 );
+
+  // model with random code words below the default ones, so that the mapped range fits into the sample range
+  Reshape reshape;
+  reshape.createDec( m_bitDepth );
+  SliceReshapeInfo& info = reshape.getSliceReshaperInfo();
+  const int initCW = ( 1 << m_bitDepth ) / PIC_CODE_CW_BINS;
+  info.reshaperModelMinBinIdx = 1;
+  info.reshaperModelMaxBinIdx = PIC_CODE_CW_BINS - 2;
+  info.chrResScalingOffset    = 0;
+  for( int i = 0; i < PIC_CODE_CW_BINS; i++ )
+  {
+    info.reshaperModelBinCWDelta[i] = int( rng() % ( initCW / 2 + initCW / 8 ) ) - initCW / 2;
+  }
+  reshape.constructReshaper();
+
+  std::vector<Pel> src( stride * stride ), resi( stride * stride ), dst( stride * stride );
+  fillRandom( src, 0, clpRng.max, rng );
+  fillRandom( resi, -clpRng.max, clpRng.max, rng );
+
+  static const char* kernels[] = { "lmcs_fwd", "lmcs_inv", "chroma_scale" };
+
+  for( int k = 0; k < 3; k++ )
+  {
+    if( !xIsSelected( kernels[k] ) )
+    {
+      continue;
+    }
+
+    // the mapping works in place, the measured time includes copying the input
+    const ReshapeLUT&       lut      = k == 0 ? reshape.getFwdLUT() : reshape.getInvLUT();
+    const std::vector<Pel>& input    = k == 2 ? resi : src;
+    const int               maxSize  = k == 2 ? MAX_CU_SIZE / 4 : MAX_CU_SIZE;
+    const int               scale    = reshape.calculateChromaAdj( clpRng.max / 3 );
+
+    for( int size = 4; size <= maxSize; size <<= 1 )
+    {
+      PelBufferOps ops;
+
+      KernelSetup setup = [&]( X86_VEXT level ) -> KernelCall
+      {
+        ops = PelBufferOps();
+#if ENABLE_SIMD_OPT_BUFFER && defined( TARGET_SIMD_X86 )
+        initLevel( ops, level );
+#endif
+        if( k == 2 )
+        {
+          return [&, size]() { ops.copyBuffer( ( Pel* ) input.data(), stride, dst.data(), stride, size, size ); ops.scaleSignalInv( dst.data(), stride, size, size, scale, clpRng.max ); };
+        }
+        return [&, size]() { ops.copyBuffer( ( Pel* ) input.data(), stride, dst.data(), stride, size, size ); ops.rspSignal( dst.data(), stride, size, size, lut ); };
+      };
+
+      xRun( kernels[k], sizeName( size, size ), levels, setup, dst.data(), dst.size() * sizeof( Pel ) );
+    }
+  }
+}
+
+bool KernelBenchApp::xWriteCsv() const
+{
+  std::ofstream os( m_csvFileName );
+  if( !os.is_open() )
+  {
+    return false;
+  }
+
+  os << "kernel,size,level,ns_per_call,speedup,bit_exact\n";
+  os << std::fixed << std::setprecision( 2 );
+  for( const BenchResult& result : m_results )
+  {
+    os << result.kernel << "," << result.size << "," << xGetLevelName( result.level ) << "," << result.nsPerCall << "," << result.speedup << "," << ( result.exact ? 1 : 0 ) << "\n";
+  }
+  return os.good();
+}
+
+//! \}
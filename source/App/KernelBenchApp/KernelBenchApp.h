@@ -0,0 +1,121 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     KernelBenchApp.h
+    \brief    CommonLib kernel benchmark application class (header)
+*/
+
+#ifndef __KERNELBENCHAPP__
+#define __KERNELBENCHAPP__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "CommonLib/CommonDef.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+//! \ingroup KernelBenchApp
+//! \{
+
+#ifndef TARGET_SIMD_X86
+typedef enum
+{
+  SCALAR = 0
+} X86_VEXT;
+#endif
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// benchmark of the CommonLib kernels for all block sizes and all available SIMD levels
+class KernelBenchApp
+{
+public:
+  KernelBenchApp();
+  virtual ~KernelBenchApp() {}
+
+  bool      parseCfg            ( int argc, char* argv[] );  ///< parse command line options
+  int       run                 ();                          ///< run all selected kernels, returns the number of mismatching results
+
+private:
+  struct BenchResult
+  {
+    std::string kernel;
+    std::string size;
+    X86_VEXT    level;
+    double      nsPerCall;
+    double      speedup;   ///< relative to the scalar implementation
+    bool        exact;     ///< output identical to the scalar implementation
+  };
+
+  typedef std::function<void()>                  KernelCall;
+  typedef std::function<KernelCall( X86_VEXT )>  KernelSetup;
+
+  bool      xIsSelected         ( const std::string& kernel ) const;
+  std::vector<X86_VEXT> xGetLevels( const std::vector<X86_VEXT>& simdLevels ) const;
+  double    xTime               ( const KernelCall& call ) const;
+  void      xRun                ( const std::string& kernel, const std::string& size, const std::vector<X86_VEXT>& levels,
+                                  const KernelSetup& setup, void* out, size_t outSize );
+
+  void      xBenchInterpolation ();
+  void      xBenchDistortion    ();
+  void      xBenchPelBufOps     ();
+  void      xBenchAlf           ();
+  void      xBenchTransform     ();
+  void      xBenchLfnst         ();
+  void      xBenchQuant         ();
+  void      xBenchIbcHash       ();
+  void      xBenchResampling    ();
+  void      xBenchLmcs          ();
+
+  bool      xWriteCsv           () const;
+
+  static const char* xGetLevelName( X86_VEXT level );
+
+  int                       m_minTime;        ///< minimum measuring time per kernel, size and level in ms
+  std::string               m_kernelFilter;   ///< only kernels containing this string are run
+  std::string               m_csvFileName;    ///< optional CSV output file
+  int                       m_bitDepth;
+  X86_VEXT                  m_maxLevel;       ///< highest SIMD level supported by the CPU
+  std::vector<BenchResult>  m_results;
+  int                       m_numMismatches;
+};
+
+//! \}
+
+#endif // __KERNELBENCHAPP__
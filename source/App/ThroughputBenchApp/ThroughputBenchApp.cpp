@@ -0,0 +1,608 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     ThroughputBenchApp.cpp
+    \brief    end-to-end encoder/decoder throughput benchmark application class
+*/
+
+#include "ThroughputBenchApp.h"
+
+#include "Utilities/program_options_lite.h"
+#include "MD5.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+extern char **environ;
+#endif
+
+using namespace std;
+namespace po = df::program_options_lite;
+
+//! \ingroup ThroughputBenchApp
+//! \{
+
+static const char* const BENCH_APP_NAME = "ThroughputBenchApp";
+
+/// returns the path of an application located next to this one, keeping the build suffix (e.g. EncoderAppStatic)
+static std::string getSiblingApp( const char* self, const char* name )
+{
+  std::string path = self;
+  const size_t pos = path.rfind( BENCH_APP_NAME );
+  if( pos == std::string::npos )
+  {
+    return name;
+  }
+  return path.replace( pos, strlen( BENCH_APP_NAME ), name );
+}
+
+static std::vector<std::string> splitString( const std::string& str, char delimiter )
+{
+  std::vector<std::string> tokens;
+  std::istringstream       is( str );
+  std::string              token;
+  while( std::getline( is, token, delimiter ) )
+  {
+    if( !token.empty() )
+    {
+      tokens.push_back( token );
+    }
+  }
+  return tokens;
+}
+
+static bool fileExists( const std::string& fileName )
+{
+  std::ifstream is( fileName );
+  return is.is_open();
+}
+
+static int64_t getFileSize( const std::string& fileName )
+{
+  std::ifstream is( fileName, std::ios::binary | std::ios::ate );
+  return is.is_open() ? int64_t( is.tellg() ) : -1;
+}
+
+static std::string getFileMd5( const std::string& fileName )
+{
+  std::ifstream is( fileName, std::ios::binary );
+  if( !is.is_open() )
+  {
+    return "";
+  }
+
+  MD5                        md5;
+  std::vector<unsigned char> buf( 1 << 16 );
+  while( is )
+  {
+    is.read( reinterpret_cast<char*>( buf.data() ), buf.size() );
+    if( is.gcount() > 0 )
+    {
+      md5.update( buf.data(), unsigned( is.gcount() ) );
+    }
+  }
+
+  unsigned char digest[MD5_DIGEST_STRING_LENGTH];
+  md5.finalize( digest );
+
+  std::ostringstream os;
+  for( int i = 0; i < MD5_DIGEST_STRING_LENGTH; i++ )
+  {
+    os << std::hex << std::setw( 2 ) << std::setfill( '0' ) << int( digest[i] );
+  }
+  return os.str();
+}
+
+/// triangle wave with values 0..period-1
+static int triangle( int val, int period )
+{
+  val = ( ( val % ( 2 * period ) ) + 2 * period ) % ( 2 * period );
+  return val < period ? val : 2 * period - 1 - val;
+}
+
+// ====================================================================================================================
+// Constructor / destructor / initialization
+// ====================================================================================================================
+
+ThroughputBenchApp::ThroughputBenchApp()
+  : m_framesToBeEncoded( 8 )
+  , m_frameRate( 30 )
+  , m_qp( 32 )
+  , m_keepFiles( false )
+{
+}
+
+const char* ThroughputBenchApp::xGetContentName( ContentType content )
+{
+  static const char* const names[NUM_CONTENT_TYPES] = { "gradient", "noise", "screen" };
+  return names[content];
+}
+
+bool ThroughputBenchApp::parseCfg( int argc, char* argv[] )
+{
+  bool do_help = false;
+  string presets;
+  string contents;
+  string sizes;
+
+  po::Options opts;
+  opts.addOptions()
+
+  ("help",                      do_help,                               false,      "this help text")
+  ("EncoderApp",                m_encoderApp,                          getSiblingApp( argv[0], "EncoderApp" ), "encoder executable")
+  ("DecoderApp",                m_decoderApp,                          getSiblingApp( argv[0], "DecoderApp" ), "decoder executable")
+  ("CfgDir,c",                  m_cfgDir,                              string("cfg"), "directory of the encoder_<preset>_vtm.cfg configuration files")
+  ("WorkDir,w",                 m_workDir,                             string("."),   "directory for the generated sequences, bitstreams and log files")
+  ("Presets,p",                 presets,                               string("randomaccess,lowdelay,intra"), "comma separated list of configuration presets")
+  ("Contents",                  contents,                              string("gradient,noise,screen"),       "comma separated list of synthetic contents (gradient, noise, screen)")
+  ("Sizes,s",                   sizes,                                 string("416x240,832x480"),             "comma separated list of picture sizes (<width>x<height>)")
+  ("FramesToBeEncoded,f",       m_framesToBeEncoded,                   8,          "number of frames per test point")
+  ("FrameRate,-fr",             m_frameRate,                           30,         "frame rate passed to the encoder")
+  ("QP,q",                      m_qp,                                  32,         "quantization parameter")
+  ("EncoderOptions",            m_encoderOptions,                      string(""), "additional encoder options, separated by spaces (e.g. \"--IntraPeriod=16 --SEIDecodedPictureHash=1\")")
+  ("OutputFile,o",              m_outputFileName,                      string(""), "when non empty, write the results to the indicated file (JSON for a .json extension, otherwise CSV)")
+  ("KeepFiles",                 m_keepFiles,                           false,      "keep the generated sequences, bitstreams, reconstructions and logs")
+  ;
+
+  po::setDefaults( opts );
+  po::ErrorReporter err;
+  const list<const char*>& argv_unhandled = po::scanArgv( opts, argc, ( const char** ) argv, err );
+
+  for( list<const char*>::const_iterator it = argv_unhandled.begin(); it != argv_unhandled.end(); it++ )
+  {
+    msg( ERROR, "Unhandled argument ignored: `%s'\n", *it );
+  }
+
+  if( do_help )
+  {
+    po::doHelp( cout, opts );
+    return false;
+  }
+
+  if( err.is_errored )
+  {
+    return false;
+  }
+
+  m_presets = splitString( presets, ',' );
+  for( const auto& preset : m_presets )
+  {
+    if( !fileExists( m_cfgDir + "/encoder_" + preset + "_vtm.cfg" ) )
+    {
+      msg( ERROR, "Configuration file %s/encoder_%s_vtm.cfg not found\n", m_cfgDir.c_str(), preset.c_str() );
+      return false;
+    }
+  }
+
+  for( const auto& name : splitString( contents, ',' ) )
+  {
+    int content = 0;
+    while( content < NUM_CONTENT_TYPES && name != xGetContentName( ContentType( content ) ) )
+    {
+      content++;
+    }
+    if( content == NUM_CONTENT_TYPES )
+    {
+      msg( ERROR, "Unknown content type `%s'\n", name.c_str() );
+      return false;
+    }
+    m_contents.push_back( ContentType( content ) );
+  }
+
+  for( const auto& size : splitString( sizes, ',' ) )
+  {
+    int width = 0, height = 0;
+    if( sscanf( size.c_str(), "%dx%d", &width, &height ) != 2 || width < 16 || height < 16 || width % 8 || height % 8 )
+    {
+      msg( ERROR, "Invalid picture size `%s', width and height must be multiples of 8 and at least 16\n", size.c_str() );
+      return false;
+    }
+    m_sizes.push_back( std::make_pair( width, height ) );
+  }
+
+  if( m_presets.empty() || m_contents.empty() || m_sizes.empty() )
+  {
+    msg( ERROR, "At least one preset, content and size must be given\n" );
+    return false;
+  }
+
+  if( m_framesToBeEncoded < 1 )
+  {
+    msg( ERROR, "FramesToBeEncoded must be at least 1\n" );
+    return false;
+  }
+
+  return true;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+int ThroughputBenchApp::run()
+{
+  int numFailures = 0;
+
+  printf( "\n%-14s %-9s %-10s %10s %12s %10s %12s %10s  %s\n", "preset", "content", "size", "enc fps", "enc RSS kB", "dec fps", "dec RSS kB", "bytes", "MD5" );
+
+  for( const auto& size : m_sizes )
+  {
+    for( ContentType content : m_contents )
+    {
+      const std::string inputFileName = m_workDir + "/" + xGetContentName( content ) + "_" + std::to_string( size.first ) + "x" + std::to_string( size.second ) + ".yuv";
+      if( !xGenerateSequence( content, size.first, size.second, inputFileName ) )
+      {
+        msg( ERROR, "Cannot write %s\n", inputFileName.c_str() );
+        return int( m_presets.size() * m_contents.size() * m_sizes.size() );
+      }
+
+      for( const auto& preset : m_presets )
+      {
+        TestResult result;
+        result.preset  = preset;
+        result.content = content;
+        result.width   = size.first;
+        result.height  = size.second;
+
+        const bool ok = xRunTest( inputFileName, result );
+        if( !ok || !result.md5Match )
+        {
+          numFailures++;
+        }
+        m_results.push_back( result );
+
+        printf( "%-14s %-9s %-10s %10.2f %12lld %10.2f %12lld %10lld  %s\n", preset.c_str(), xGetContentName( content ),
+                ( std::to_string( size.first ) + "x" + std::to_string( size.second ) ).c_str(),
+                result.enc.time > 0 ? m_framesToBeEncoded / result.enc.time : 0.0, ( long long ) result.enc.peakRss,
+                result.dec.time > 0 ? m_framesToBeEncoded / result.dec.time : 0.0, ( long long ) result.dec.peakRss,
+                ( long long ) result.bitstreamSize, !ok ? "FAILED" : result.md5Match ? "OK" : "MISMATCH" );
+        fflush( stdout );
+      }
+
+      if( !m_keepFiles )
+      {
+        remove( inputFileName.c_str() );
+      }
+    }
+  }
+
+  if( !m_outputFileName.empty() && !xWriteFile() )
+  {
+    msg( ERROR, "Cannot write %s\n", m_outputFileName.c_str() );
+  }
+
+  if( numFailures )
+  {
+    msg( ERROR, "\n%d test point(s) failed\n", numFailures );
+  }
+
+  return numFailures;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+/** writes an 8-bit 4:2:0 sequence of m_framesToBeEncoded frames
+ */
+bool ThroughputBenchApp::xGenerateSequence( ContentType content, int width, int height, const std::string& fileName ) const
+{
+  std::ofstream os( fileName, std::ios::binary );
+  if( !os.is_open() )
+  {
+    return false;
+  }
+
+  const int                  chromaWidth  = width >> 1;
+  const int                  chromaHeight = height >> 1;
+  std::vector<unsigned char> lumaPlane( width * height );
+  std::vector<unsigned char> cbPlane( chromaWidth * chromaHeight );
+  std::vector<unsigned char> crPlane( chromaWidth * chromaHeight );
+
+  std::mt19937                       rng( 1 );
+  std::uniform_int_distribution<int> lumaNoise( -12, 12 );
+  std::uniform_int_distribution<int> chromaNoise( -4, 4 );
+
+  // 8x8 glyphs of the screen content
+  static const int   numGlyphs = 32;
+  static const int   lineHeight = 12;
+  std::vector<uint64_t> glyphs( numGlyphs );
+  for( auto& glyph : glyphs )
+  {
+    glyph = ( uint64_t( rng() ) << 32 | rng() ) & ( uint64_t( rng() ) << 32 | rng() );   // about 25 % of the samples set
+  }
+
+  const int winWidth  = ( width / 3 ) & ~1;
+  const int winHeight = ( height / 3 ) & ~1;
+
+  for( int frame = 0; frame < m_framesToBeEncoded; frame++ )
+  {
+    if( content == CONTENT_SCREEN )
+    {
+      // text scrolling up by two lines per frame and a flat window moving to the right
+      const int winX = ( ( width / 6 + 4 * frame ) % ( width - winWidth ) ) & ~1;
+      const int winY = ( height / 3 ) & ~1;
+      for( int y = 0; y < height; y++ )
+      {
+        const int textY = y + 2 * frame;
+        const int line  = textY / lineHeight;
+        const int row   = textY % lineHeight;
+        for( int x = 0; x < width; x++ )
+        {
+          unsigned char val = 235;
+          if( row < 8 )
+          {
+            const int col   = x >> 3;
+            const int glyph = ( ( line * 7919 + col * 104729 ) ^ ( line >> 3 ) ) % ( numGlyphs + 8 );
+            if( glyph < numGlyphs && ( glyphs[glyph] >> ( row * 8 + ( x & 7 ) ) & 1 ) )
+            {
+              val = 16;
+            }
+          }
+          if( x >= winX && x < winX + winWidth && y >= winY && y < winY + winHeight )
+          {
+            const bool border = x < winX + 2 || x >= winX + winWidth - 2 || y < winY + 2 || y >= winY + winHeight - 2;
+            val = border ? 40 : 90;
+          }
+          lumaPlane[y * width + x] = val;
+        }
+      }
+      for( int y = 0; y < chromaHeight; y++ )
+      {
+        for( int x = 0; x < chromaWidth; x++ )
+        {
+          const bool inWindow = 2 * x >= winX && 2 * x < winX + winWidth && 2 * y >= winY && 2 * y < winY + winHeight;
+          cbPlane[y * chromaWidth + x] = inWindow ? 200 : 128;
+          crPlane[y * chromaWidth + x] = inWindow ? 80 : 128;
+        }
+      }
+    }
+    else
+    {
+      // diagonal gradients moving with different speeds in luma and chroma
+      const bool noise = content == CONTENT_NOISE;
+      for( int y = 0; y < height; y++ )
+      {
+        for( int x = 0; x < width; x++ )
+        {
+          const int val = 16 + triangle( x + ( y >> 1 ) + 3 * frame, 220 ) + ( noise ? lumaNoise( rng ) : 0 );
+          lumaPlane[y * width + x] = ( unsigned char ) Clip3( 0, 255, val );
+        }
+      }
+      for( int y = 0; y < chromaHeight; y++ )
+      {
+        for( int x = 0; x < chromaWidth; x++ )
+        {
+          const int cb = 96 + triangle( 2 * x - frame, 64 ) + ( noise ? chromaNoise( rng ) : 0 );
+          const int cr = 96 + triangle( 2 * y + frame, 64 ) + ( noise ? chromaNoise( rng ) : 0 );
+          cbPlane[y * chromaWidth + x] = ( unsigned char ) Clip3( 0, 255, cb );
+          crPlane[y * chromaWidth + x] = ( unsigned char ) Clip3( 0, 255, cr );
+        }
+      }
+    }
+
+    os.write( reinterpret_cast<const char*>( lumaPlane.data() ), lumaPlane.size() );
+    os.write( reinterpret_cast<const char*>( cbPlane.data() ), cbPlane.size() );
+    os.write( reinterpret_cast<const char*>( crPlane.data() ), crPlane.size() );
+  }
+
+  return os.good();
+}
+
+/** runs an external application with stdout and stderr redirected to a log file and measures its wall clock time
+    and peak memory usage
+ */
+bool ThroughputBenchApp::xRunProcess( const std::vector<std::string>& args, const std::string& logFileName, ProcessResult& result ) const
+{
+  std::vector<char*> argv;
+  for( const auto& arg : args )
+  {
+    argv.push_back( const_cast<char*>( arg.c_str() ) );
+  }
+  argv.push_back( nullptr );
+
+  result.ok      = false;
+  result.time    = 0;
+  result.peakRss = -1;
+
+  const auto start = std::chrono::steady_clock::now();
+#ifdef _WIN32
+  // the output is not redirected and the peak memory usage is not available
+  (void) logFileName;
+  const intptr_t status = _spawnv( _P_WAIT, argv[0], argv.data() );
+  if( status < 0 )
+  {
+    msg( ERROR, "Cannot start %s\n", argv[0] );
+    return false;
+  }
+  result.ok = status == 0;
+#else
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init( &actions );
+  posix_spawn_file_actions_addopen( &actions, STDOUT_FILENO, logFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+  posix_spawn_file_actions_adddup2( &actions, STDOUT_FILENO, STDERR_FILENO );
+
+  pid_t     pid;
+  const int spawnError = posix_spawnp( &pid, argv[0], &actions, nullptr, argv.data(), environ );
+  posix_spawn_file_actions_destroy( &actions );
+  if( spawnError )
+  {
+    msg( ERROR, "Cannot start %s: %s\n", argv[0], strerror( spawnError ) );
+    return false;
+  }
+
+  int           status;
+  struct rusage usage;
+  if( wait4( pid, &status, 0, &usage ) < 0 )
+  {
+    msg( ERROR, "Waiting for %s failed\n", argv[0] );
+    return false;
+  }
+  result.ok = WIFEXITED( status ) && WEXITSTATUS( status ) == 0;
+#ifdef __APPLE__
+  result.peakRss = int64_t( usage.ru_maxrss ) >> 10;   // bytes
+#else
+  result.peakRss = int64_t( usage.ru_maxrss );         // kB
+#endif
+#endif
+  result.time = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+  if( !result.ok )
+  {
+    msg( ERROR, "%s failed, see %s\n", argv[0], logFileName.c_str() );
+  }
+  return result.ok;
+}
+
+bool ThroughputBenchApp::xRunTest( const std::string& inputFileName, TestResult& result ) const
+{
+  const std::string baseName    = m_workDir + "/" + result.preset + "_" + xGetContentName( result.content ) + "_" + std::to_string( result.width ) + "x" + std::to_string( result.height );
+  const std::string bitstream   = baseName + ".bin";
+  const std::string recFileName = baseName + "_rec.yuv";
+  const std::string decFileName = baseName + "_dec.yuv";
+  const std::string encLog      = baseName + "_enc.log";
+  const std::string decLog      = baseName + "_dec.log";
+
+  result.dec           = ProcessResult{ false, 0, -1 };
+  result.bitstreamSize = -1;
+  result.md5Match      = false;
+
+  std::vector<std::string> encArgs = { m_encoderApp,
+                                       "-c", m_cfgDir + "/encoder_" + result.preset + "_vtm.cfg",
+                                       "-i", inputFileName,
+                                       "-b", bitstream,
+                                       "-o", recFileName,
+                                       "-wdt", std::to_string( result.width ),
+                                       "-hgt", std::to_string( result.height ),
+                                       "-fr", std::to_string( m_frameRate ),
+                                       "-f", std::to_string( m_framesToBeEncoded ),
+                                       "-q", std::to_string( m_qp ),
+                                       "--InputBitDepth=8" };
+  for( const auto& option : splitString( m_encoderOptions, ' ' ) )
+  {
+    encArgs.push_back( option );
+  }
+
+  bool ok = xRunProcess( encArgs, encLog, result.enc );
+  if( ok )
+  {
+    result.bitstreamSize = getFileSize( bitstream );
+    ok = xRunProcess( { m_decoderApp, "-b", bitstream, "-o", decFileName }, decLog, result.dec );
+  }
+  if( ok )
+  {
+    // both reconstructions are written with the internal bit depth
+    result.md5      = getFileMd5( decFileName );
+    result.md5Match = !result.md5.empty() && result.md5 == getFileMd5( recFileName );
+  }
+
+  if( !m_keepFiles )
+  {
+    remove( bitstream.c_str() );
+    remove( recFileName.c_str() );
+    remove( decFileName.c_str() );
+    if( ok )
+    {
+      remove( encLog.c_str() );
+      remove( decLog.c_str() );
+    }
+  }
+
+  return ok;
+}
+
+void ThroughputBenchApp::xWriteCsv( std::ostream& os ) const
+{
+  os << "preset,content,width,height,frames,qp,enc_time_s,enc_fps,enc_peak_rss_kb,bitstream_bytes,dec_time_s,dec_fps,dec_peak_rss_kb,md5,md5_match\n";
+  os << std::fixed << std::setprecision( 3 );
+  for( const auto& res : m_results )
+  {
+    os << res.preset << "," << xGetContentName( res.content ) << "," << res.width << "," << res.height << "," << m_framesToBeEncoded << "," << m_qp << ","
+       << res.enc.time << "," << ( res.enc.time > 0 ? m_framesToBeEncoded / res.enc.time : 0.0 ) << "," << res.enc.peakRss << "," << res.bitstreamSize << ","
+       << res.dec.time << "," << ( res.dec.time > 0 ? m_framesToBeEncoded / res.dec.time : 0.0 ) << "," << res.dec.peakRss << ","
+       << res.md5 << "," << ( res.md5Match ? 1 : 0 ) << "\n";
+  }
+}
+
+void ThroughputBenchApp::xWriteJson( std::ostream& os ) const
+{
+  os << std::fixed << std::setprecision( 3 );
+  os << "{\n  \"frames\": " << m_framesToBeEncoded << ",\n  \"qp\": " << m_qp << ",\n  \"results\": [";
+  for( size_t n = 0; n < m_results.size(); n++ )
+  {
+    const TestResult& res = m_results[n];
+    os << ( n ? ",\n" : "\n" ) << "    { \"preset\": \"" << res.preset << "\", \"content\": \"" << xGetContentName( res.content ) << "\", \"width\": " << res.width
+       << ", \"height\": " << res.height << ", \"encoder\": { \"time_s\": " << res.enc.time << ", \"fps\": " << ( res.enc.time > 0 ? m_framesToBeEncoded / res.enc.time : 0.0 )
+       << ", \"peak_rss_kb\": " << res.enc.peakRss << ", \"ok\": " << ( res.enc.ok ? "true" : "false" ) << " }, \"bitstream_bytes\": " << res.bitstreamSize
+       << ", \"decoder\": { \"time_s\": " << res.dec.time << ", \"fps\": " << ( res.dec.time > 0 ? m_framesToBeEncoded / res.dec.time : 0.0 )
+       << ", \"peak_rss_kb\": " << res.dec.peakRss << ", \"ok\": " << ( res.dec.ok ? "true" : "false" ) << " }, \"md5\": \"" << res.md5
+       << "\", \"md5_match\": " << ( res.md5Match ? "true" : "false" ) << " }";
+  }
+  os << "\n  ]\n}\n";
+}
+
+bool ThroughputBenchApp::xWriteFile() const
+{
+  std::ofstream os( m_outputFileName );
+  if( !os.is_open() )
+  {
+    return false;
+  }
+
+  const bool json = m_outputFileName.size() >= 5 && m_outputFileName.compare( m_outputFileName.size() - 5, 5, ".json" ) == 0;
+  if( json )
+  {
+    xWriteJson( os );
+  }
+  else
+  {
+    xWriteCsv( os );
+  }
+  return os.good();
+}
+
+//! \}
@@ -0,0 +1,126 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     ThroughputBenchApp.h
+    \brief    end-to-end encoder/decoder throughput benchmark application class (header)
+*/
+
+#ifndef __THROUGHPUTBENCHAPP__
+#define __THROUGHPUTBENCHAPP__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "CommonLib/CommonDef.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+//! \ingroup ThroughputBenchApp
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// encodes synthetic sequences with the configuration presets, decodes the bitstreams and reports the throughput
+class ThroughputBenchApp
+{
+public:
+  ThroughputBenchApp();
+  virtual ~ThroughputBenchApp() {}
+
+  bool      parseCfg            ( int argc, char* argv[] );  ///< parse command line options
+  int       run                 ();                          ///< run all test points, returns the number of failed test points
+
+private:
+  enum ContentType
+  {
+    CONTENT_GRADIENT = 0,   ///< moving smooth gradients
+    CONTENT_NOISE,          ///< moving gradients with additive noise
+    CONTENT_SCREEN,         ///< scrolling text-like patterns with a moving flat window
+    NUM_CONTENT_TYPES
+  };
+
+  struct ProcessResult
+  {
+    bool    ok;
+    double  time;      ///< wall clock time in seconds
+    int64_t peakRss;   ///< peak resident set size in kB, -1 when not available
+  };
+
+  struct TestResult
+  {
+    std::string   preset;
+    ContentType   content;
+    int           width;
+    int           height;
+    ProcessResult enc;
+    ProcessResult dec;
+    int64_t       bitstreamSize;
+    std::string   md5;        ///< MD5 of the decoded YUV file
+    bool          md5Match;   ///< decoded YUV file identical to the reconstruction of the encoder
+  };
+
+  bool      xGenerateSequence   ( ContentType content, int width, int height, const std::string& fileName ) const;
+  bool      xRunProcess         ( const std::vector<std::string>& args, const std::string& logFileName, ProcessResult& result ) const;
+  bool      xRunTest            ( const std::string& inputFileName, TestResult& result ) const;
+
+  void      xWriteCsv           ( std::ostream& os ) const;
+  void      xWriteJson          ( std::ostream& os ) const;
+  bool      xWriteFile          () const;
+
+  static const char* xGetContentName( ContentType content );
+
+  std::string               m_encoderApp;       ///< encoder executable
+  std::string               m_decoderApp;       ///< decoder executable
+  std::string               m_cfgDir;           ///< directory of the encoder_<preset>_vtm.cfg files
+  std::string               m_workDir;          ///< directory of the generated sequences, bitstreams and logs
+  std::vector<std::string>  m_presets;
+  std::vector<ContentType>  m_contents;
+  std::vector<std::pair<int, int>> m_sizes;
+  int                       m_framesToBeEncoded;
+  int                       m_frameRate;
+  int                       m_qp;
+  std::string               m_encoderOptions;   ///< additional encoder options, separated by spaces
+  std::string               m_outputFileName;   ///< CSV or JSON (.json) result file
+  bool                      m_keepFiles;        ///< keep the generated files after each test point
+  std::vector<TestResult>   m_results;
+};
+
+//! \}
+
+#endif // __THROUGHPUTBENCHAPP__
@@ -314,6 +314,12 @@ PelBufferOps::PelBufferOps()
 
   copyBuffer = copyBufferCore;
   padding = paddingCore;
+  extendBorderHor = extendBorderHorCore;
+  rspSignal       = rspSignalCore;
+  scaleSignalInv  = scaleSignalInvCore;
+  weightBi        = weightBiCore;
+  weightUni       = weightUniCore;
+  calcSSE         = calcSSECore;
 #if ENABLE_SIMD_OPT_BCW
   removeWeightHighFreq8 = removeWeightHighFreq;
   removeWeightHighFreq4 = removeWeightHighFreq;
@@ -324,6 +330,9 @@ PelBufferOps::PelBufferOps()
   profGradFilter = gradFilterCore <false>;
   applyPROF      = applyPROFCore;
   roundIntVector = nullptr;
+
+  sampleRateConvHor = sampleRateConvHorCore;
+  sampleRateConvVer = sampleRateConvVerCore;
 }
 
 PelBufferOps g_pelBufOP = PelBufferOps();
@@ -362,6 +371,136 @@ void paddingCore(Pel *ptr, int stride, int width, int height, int padSize)
     memcpy(ptrTemp2 + (i * stride), (ptrTemp2), numBytes);
   }
 }
+
+// left and right margins of height rows: the first and the last sample of each row are repeated margin times
+void extendBorderHorCore(Pel *ptr, int stride, int width, int height, int margin)
+{
+  for (int y = 0; y < height; y++)
+  {
+    const Pel left  = ptr[0];
+    const Pel right = ptr[width - 1];
+    for (int x = 0; x < margin; x++)
+    {
+      ptr[-margin + x] = left;
+      ptr[width + x]   = right;
+    }
+    ptr += stride;
+  }
+}
+
+// LMCS luma mapping through the table
+void rspSignalCore(Pel *ptr, int stride, int width, int height, const ReshapeLUT& lut)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      ptr[x] = lut[ptr[x]];
+    }
+    ptr += stride;
+  }
+}
+
+// inverse LMCS chroma residual scaling of residuals clipped to [-maxAbs-1, maxAbs]
+void scaleSignalInvCore(Pel *ptr, int stride, int width, int height, int scale, int maxAbs)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const int sign   = ptr[x] >= 0 ? 1 : -1;
+      const int absval = sign * Clip3(-maxAbs - 1, maxAbs, (int)ptr[x]);
+      const int val    = sign * ((absval * scale + (1 << (CSCALE_FP_PREC - 1))) >> CSCALE_FP_PREC);
+      ptr[x] = (Pel)Clip3<int>(-32768, 32767, val);
+    }
+    ptr += stride;
+  }
+}
+
+// explicit weighted bi-prediction; offset holds the rounding, the weighted prediction offset and the weighted
+// IF_INTERNAL_OFFS of both sources
+void weightBiCore(const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height, int w0, int w1, int shift, int offset, const ClpRng& clpRng)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      dst[x] = ClipPel((w0 * src0[x] + w1 * src1[x] + offset) >> shift, clpRng);
+    }
+    src0 += src0Stride;
+    src1 += src1Stride;
+    dst  += dstStride;
+  }
+}
+
+// explicit weighted uni-prediction; round holds the rounding and the weighted IF_INTERNAL_OFFS of the source
+void weightUniCore(const Pel* src, int srcStride, Pel *dst, int dstStride, int width, int height, int w0, int round, int shift, int offset, const ClpRng& clpRng)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      dst[x] = ClipPel(((w0 * src[x] + round) >> shift) + offset, clpRng);
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+// sum of the squared differences of two planes, e.g. for the PSNR of a picture
+uint64_t calcSSECore(const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int bitDepth)
+{
+  uint64_t sum = 0;
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const int diff = src0[x] - src1[x];
+      sum += uint64_t(diff * diff);
+    }
+    src0 += src0Stride;
+    src1 += src1Stride;
+  }
+  return sum;
+}
+
+// horizontal resampling of one row: output i is the unnormalized dot product of filterLength samples starting
+// at src[srcOffset[i]] with the filter of phase[i]; all taps have to be inside of the (padded) source row
+void sampleRateConvHorCore( const Pel* src, int* dst, int width, const int* srcOffset, const int* phase, const TFilterCoeff* filter, const int filterLength )
+{
+  for( int i = 0; i < width; i++ )
+  {
+    const Pel*          s = src + srcOffset[i];
+    const TFilterCoeff* f = filter + phase[i] * filterLength;
+    int sum = 0;
+
+    for( int k = 0; k < filterLength; k++ )
+    {
+      sum += f[k] * s[k];
+    }
+
+    dst[i] = sum;
+  }
+}
+
+// vertical resampling of one row: src holds the filterLength (already clipped) rows of horizontally filtered samples
+void sampleRateConvVerCore( const int* const* src, Pel* dst, int width, const TFilterCoeff* coeff, const int filterLength, const int shift, const int maxVal )
+{
+  const int offset = 1 << ( shift - 1 );
+
+  for( int i = 0; i < width; i++ )
+  {
+    int sum = 0;
+
+    for( int k = 0; k < filterLength; k++ )
+    {
+      sum += coeff[k] * src[k][i];
+    }
+
+    dst[i] = std::min<int>( std::max( 0, ( sum + offset ) >> shift ), maxVal );
+  }
+}
+
 template<>
 void AreaBuf<Pel>::addWeightedAvg(const AreaBuf<const Pel> &other1, const AreaBuf<const Pel> &other2, const ClpRng& clpRng, const int8_t bcwIdx)
 {
@@ -397,19 +536,9 @@ void AreaBuf<Pel>::addWeightedAvg(const AreaBuf<const Pel> &other1, const AreaBu
 }
 
 template<>
-void AreaBuf<Pel>::rspSignal(std::vector<Pel>& pLUT)
+void AreaBuf<Pel>::rspSignal(const ReshapeLUT& lut)
 {
-  Pel* dst = buf;
-  Pel* src = buf;
-    for (unsigned y = 0; y < height; y++)
-    {
-      for (unsigned x = 0; x < width; x++)
-      {
-        dst[x] = pLUT[src[x]];
-      }
-      dst += stride;
-      src += stride;
-    }
+  g_pelBufOP.rspSignal(buf, stride, width, height, lut);
 }
 
 template<>
@@ -443,23 +572,7 @@ void AreaBuf<Pel>::scaleSignal(const int scale, const bool dir, const ClpRng& cl
   }
   else // inverse
   {
-    for (unsigned y = 0; y < height; y++)
-    {
-      for (unsigned x = 0; x < width; x++)
-      {
-        src[x] = (Pel)Clip3((Pel)(-maxAbsclipBD - 1), (Pel)maxAbsclipBD, src[x]);
-        sign = src[x] >= 0 ? 1 : -1;
-        absval = sign * src[x];
-        int val = sign * ((absval * scale + (1 << (CSCALE_FP_PREC - 1))) >> CSCALE_FP_PREC);
-        if (sizeof(Pel) == 2) // avoid overflow when storing data
-        {
-           val = Clip3<int>(-32768, 32767, val);
-        }
-        dst[x] = (Pel)val;
-      }
-      dst += stride;
-      src += stride;
-    }
+    g_pelBufOP.scaleSignalInv(buf, stride, width, height, scale, maxAbsclipBD);
   }
 }
 
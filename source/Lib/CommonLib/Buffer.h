@@ -46,11 +46,24 @@
 #include <string.h>
 #include <type_traits>
 #include <typeinfo>
+#include <vector>
 
 // ---------------------------------------------------------------------------
 // AreaBuf struct
 // ---------------------------------------------------------------------------
 
+/// LMCS luma mapping table together with its piecewise linear description, which allows to apply it without gathers
+struct ReshapeLUT : public std::vector<Pel>
+{
+  ReshapeLUT() : pwlValid( false ), log2SegLen( 0 ), maxVal( 0 ) { }
+
+  bool    pwlValid;                           ///< the segments below describe the table, see Reshape::updateLutPwl
+  int     log2SegLen;                         ///< segment i covers the input samples [i << log2SegLen, (i + 1) << log2SegLen)
+  Pel     outBase[PIC_CODE_CW_BINS];
+  int16_t slope  [PIC_CODE_CW_BINS];          ///< outBase + ( ( slope * offset in segment + rounding ) >> FP_PREC )
+  Pel     maxVal;
+};
+
 struct PelBufferOps
 {
   PelBufferOps();
@@ -74,6 +87,12 @@ struct PelBufferOps
   void(*calcBlkGradient)(int sx, int sy, int    *arraysGx2, int     *arraysGxGy, int     *arraysGxdI, int     *arraysGy2, int     *arraysGydI, int     &sGx2, int     &sGy2, int     &sGxGy, int     &sGxdI, int     &sGydI, int width, int height, int unitSize);
   void(*copyBuffer)(Pel *src, int srcStride, Pel *dst, int dstStride, int width, int height);
   void(*padding)(Pel *dst, int stride, int width, int height, int padSize);
+  void(*extendBorderHor)(Pel *dst, int stride, int width, int height, int margin);
+  void(*rspSignal)(Pel *dst, int stride, int width, int height, const ReshapeLUT& lut);
+  void(*scaleSignalInv)(Pel *dst, int stride, int width, int height, int scale, int maxAbs);
+  void(*weightBi)(const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height, int w0, int w1, int shift, int offset, const ClpRng& clpRng);
+  void(*weightUni)(const Pel* src, int srcStride, Pel *dst, int dstStride, int width, int height, int w0, int round, int shift, int offset, const ClpRng& clpRng);
+  uint64_t(*calcSSE)(const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int bitDepth);
 #if ENABLE_SIMD_OPT_BCW
   void ( *removeWeightHighFreq8)  ( Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift, int bcwWeight);
   void ( *removeWeightHighFreq4)  ( Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift, int bcwWeight);
@@ -83,12 +102,22 @@ struct PelBufferOps
   void (*profGradFilter) (Pel* pSrc, int srcStride, int width, int height, int gradStride, Pel* gradX, Pel* gradY, const int bitDepth);
   void (*applyPROF)      (Pel* dst, int dstStride, const Pel* src, int srcStride, int width, int height, const Pel* gradX, const Pel* gradY, int gradStride, const int* dMvX, const int* dMvY, int dMvStride, const bool& bi, int shiftNum, Pel offset, const ClpRng& clpRng);
   void (*roundIntVector) (int* v, int size, unsigned int nShift, const int dmvLimit);
+  void (*sampleRateConvHor)( const Pel* src, int* dst, int width, const int* srcOffset, const int* phase, const TFilterCoeff* filter, const int filterLength );
+  void (*sampleRateConvVer)( const int* const* src, Pel* dst, int width, const TFilterCoeff* coeff, const int filterLength, const int shift, const int maxVal );
 };
 
 extern PelBufferOps g_pelBufOP;
 
 void paddingCore(Pel *ptr, int stride, int width, int height, int padSize);
+void extendBorderHorCore(Pel *ptr, int stride, int width, int height, int margin);
+void rspSignalCore(Pel *ptr, int stride, int width, int height, const ReshapeLUT& lut);
+void scaleSignalInvCore(Pel *ptr, int stride, int width, int height, int scale, int maxAbs);
+void weightBiCore(const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel *dst, int dstStride, int width, int height, int w0, int w1, int shift, int offset, const ClpRng& clpRng);
+void weightUniCore(const Pel* src, int srcStride, Pel *dst, int dstStride, int width, int height, int w0, int round, int shift, int offset, const ClpRng& clpRng);
+uint64_t calcSSECore(const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int bitDepth);
 void copyBufferCore(Pel *src, int srcStride, Pel *Dst, int dstStride, int width, int height);
+void sampleRateConvHorCore( const Pel* src, int* dst, int width, const int* srcOffset, const int* phase, const TFilterCoeff* filter, const int filterLength );
+void sampleRateConvVerCore( const int* const* src, Pel* dst, int width, const TFilterCoeff* coeff, const int filterLength, const int shift, const int maxVal );
 
 template<typename T>
 struct AreaBuf : public Size
@@ -135,7 +164,7 @@ struct AreaBuf : public Size
 
   void toLast               ( const ClpRng& clpRng );
 
-  void rspSignal            ( std::vector<Pel>& pLUT );
+  void rspSignal            ( const ReshapeLUT& lut );
   void scaleSignal          ( const int scale, const bool dir , const ClpRng& clpRng);
   T    computeAvg           ( ) const;
 
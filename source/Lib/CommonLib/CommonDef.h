@@ -315,6 +315,7 @@ static const int MAX_NUM_PARTS_IN_CTU =                         ( ( MAX_CU_SIZE
 static const int MAX_NUM_TUS =                                     16; ///< Maximum number of TUs within one CU. When max TB size is 32x32, up to 16 TUs within one CU (128x128) is supported
 static const int MAX_LOG2_DIFF_CU_TR_SIZE =                         3;
 static const int MAX_CU_TILING_PARTITIONS = 1 << ( MAX_LOG2_DIFF_CU_TR_SIZE << 1 );
+static const int MAX_NUM_SPLIT_PARTITIONS =                         4; ///< Maximum number of partitions created by a single split (QT, max TU tiling and ISP create up to 4)
 
 static const int JVET_C0024_ZERO_OUT_TH =                          32;
 
@@ -489,6 +490,7 @@ static const int  EPBIN_WEIGHT_FACTOR =                           4;
 static const int ENC_PPS_ID_RPR =                                 3;
 static const int SCALE_RATIO_BITS =                              14;
 static const int MAX_SCALING_RATIO =                              2;  // max downsampling ratio for RPR
+static const int BORDER_EXT_STRIPE_HEIGHT =                      64;  // rows of a picture border extension job
 static const std::pair<int, int> SCALE_1X = std::pair<int, int>( 1 << SCALE_RATIO_BITS, 1 << SCALE_RATIO_BITS );  // scale ratio 1x
 static const int DELTA_QP_ACT[4] =                  { -5, 1, 3, 1 };
 
@@ -624,6 +626,7 @@ typedef enum{
 #ifdef TARGET_SIMD_X86
 X86_VEXT read_x86_extension_flags(const std::string &extStrId = std::string());
 const char* read_x86_extension(const std::string &extStrId);
+X86_VEXT _get_x86_extensions(); ///< highest extension supported by the CPU, independent of the SIMD option
 #endif
 
 #endif //ENABLE_SIMD_OPT
@@ -38,6 +38,8 @@
 #include "Contexts.h"
 
 #include <algorithm>
+#include <atomic>
+#include <bitset>
 #include <cstring>
 #include <limits>
 
@@ -918,20 +920,69 @@ template <class BinProbModel>
 CtxStore<BinProbModel>::CtxStore()
   : m_CtxBuffer ()
   , m_Ctx       ( nullptr )
+  , m_Gen       ( xNewGen() )
+  , m_Dirty     ( 0 )
 {}
 
 template <class BinProbModel>
 CtxStore<BinProbModel>::CtxStore( bool dummy )
   : m_CtxBuffer ( ContextSetCfg::NumberOfContexts )
   , m_Ctx       ( m_CtxBuffer.data() )
-{}
+  , m_Gen       ( xNewGen() )
+  , m_Dirty     ( 0 )
+{
+  CHECK( ContextSetCfg::NumberOfContexts > ( 64u << PageLog2 ), "Too many contexts for the dirty page tracking" );
+}
 
 template <class BinProbModel>
 CtxStore<BinProbModel>::CtxStore( const CtxStore<BinProbModel>& ctxStore )
   : m_CtxBuffer ( ctxStore.m_CtxBuffer )
   , m_Ctx       ( m_CtxBuffer.data() )
+  , m_Gen       ( ctxStore.m_Gen )
+  , m_Dirty     ( ctxStore.m_Dirty )
 {}
 
+template <class BinProbModel>
+uint64_t CtxStore<BinProbModel>::xNewGen()
+{
+  static std::atomic<uint64_t> nextGen( 1 );
+  return nextGen.fetch_add( 1, std::memory_order_relaxed );
+}
+
+template <class BinProbModel>
+void CtxStore<BinProbModel>::copyFrom( const CtxStore<BinProbModel>& src )
+{
+  checkInit();
+  if( m_Gen != src.m_Gen )
+  {
+    ::memcpy( m_Ctx, src.m_Ctx, sizeof( BinProbModel ) * ContextSetCfg::NumberOfContexts );
+  }
+  else
+  {
+    const unsigned numCtx = ContextSetCfg::NumberOfContexts;
+    unsigned       first  = 0;
+    for( uint64_t pages = m_Dirty | src.m_Dirty; pages; pages >>= 1, first += 1 << PageLog2 )
+    {
+      if( pages & 1 )
+      {
+        ::memcpy( m_Ctx + first, src.m_Ctx + first, sizeof( BinProbModel ) * std::min( 1u << PageLog2, numCtx - first ) );
+      }
+    }
+  }
+#if !ENABLE_SPLIT_PARALLELISM
+  // once a quarter of the pages differ from the base generation, start a new one shared by both stores, so that the
+  // following copies between them are small again (the source may be read concurrently with split parallelism)
+  if( std::bitset<64>( src.m_Dirty ).count() > ( std::bitset<64>( xAllPages() ).count() >> 2 ) )
+  {
+    src.m_Gen   = m_Gen   = xNewGen();
+    src.m_Dirty = m_Dirty = 0;
+    return;
+  }
+#endif
+  m_Gen   = src.m_Gen;
+  m_Dirty = src.m_Dirty;
+}
+
 template <class BinProbModel>
 void CtxStore<BinProbModel>::init( int qp, int initId )
 {
@@ -948,6 +999,7 @@ void CtxStore<BinProbModel>::init( int qp, int initId )
     m_CtxBuffer[k].init( clippedQP, initTable[k] );
     m_CtxBuffer[k].setLog2WindowSize(rateInitTable[k]);
   }
+  xRebase();
 }
 
 template <class BinProbModel>
@@ -959,6 +1011,7 @@ void CtxStore<BinProbModel>::setWinSizes( const std::vector<uint8_t>& log2Window
   {
     m_CtxBuffer[k].setLog2WindowSize( log2WindowSizes[k] );
   }
+  xRebase();
 }
 
 template <class BinProbModel>
@@ -970,6 +1023,7 @@ void CtxStore<BinProbModel>::loadPStates( const std::vector<uint16_t>& probState
   {
     m_CtxBuffer[k].setState( probStates[k] );
   }
+  xRebase();
 }
 
 template <class BinProbModel>
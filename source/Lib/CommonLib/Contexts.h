@@ -303,15 +303,15 @@ public:
   CtxStore( bool dummy );
   CtxStore( const CtxStore<BinProbModel>& ctxStore );
 public:
-  void copyFrom   ( const CtxStore<BinProbModel>& src )                        { checkInit(); ::memcpy( m_Ctx,               src.m_Ctx,               sizeof( BinProbModel ) * ContextSetCfg::NumberOfContexts ); }
-  void copyFrom   ( const CtxStore<BinProbModel>& src, const CtxSet& ctxSet )  { checkInit(); ::memcpy( m_Ctx+ctxSet.Offset, src.m_Ctx+ctxSet.Offset, sizeof( BinProbModel ) * ctxSet.Size ); }
+  void copyFrom   ( const CtxStore<BinProbModel>& src );
+  void copyFrom   ( const CtxStore<BinProbModel>& src, const CtxSet& ctxSet )  { checkInit(); ::memcpy( m_Ctx+ctxSet.Offset, src.m_Ctx+ctxSet.Offset, sizeof( BinProbModel ) * ctxSet.Size ); xMarkDirty( ctxSet.Offset, ctxSet.Size ); }
   void init       ( int qp, int initId );
   void setWinSizes( const std::vector<uint8_t>&   log2WindowSizes );
   void loadPStates( const std::vector<uint16_t>&  probStates );
   void savePStates( std::vector<uint16_t>&        probStates )  const;
 
   const BinProbModel& operator[]      ( unsigned  ctxId  )  const { return m_Ctx[ctxId]; }
-  BinProbModel&       operator[]      ( unsigned  ctxId  )        { return m_Ctx[ctxId]; }
+  BinProbModel&       operator[]      ( unsigned  ctxId  )        { m_Dirty |= uint64_t( 1 ) << ( ctxId >> PageLog2 ); return m_Ctx[ctxId]; }
   uint32_t            estFracBits     ( unsigned  bin,
                                         unsigned  ctxId  )  const { return m_Ctx[ctxId].estFracBits(bin); }
 
@@ -319,9 +319,20 @@ public:
 
 private:
   inline void checkInit() { if( m_Ctx ) return; m_CtxBuffer.resize( ContextSetCfg::NumberOfContexts ); m_Ctx = m_CtxBuffer.data(); }
+
+  // The contexts are tracked in pages of (1<<PageLog2) models. A store holds the content of its base generation m_Gen,
+  // except for the pages set in m_Dirty. Two stores of the same generation therefore only differ in the union of their
+  // dirty pages, which is all copyFrom() has to copy when an RD trial restores or saves a context snapshot.
+  static const unsigned PageLog2 = 3;
+  static uint64_t xNewGen ();
+  static uint64_t xAllPages()                                 { return ~uint64_t( 0 ) >> ( 64 - ( ( ContextSetCfg::NumberOfContexts + ( 1 << PageLog2 ) - 1 ) >> PageLog2 ) ); }
+  void            xMarkDirty( unsigned offset, unsigned size ) { for( unsigned p = offset >> PageLog2; p <= ( offset + size - 1 ) >> PageLog2; p++ ) { m_Dirty |= uint64_t( 1 ) << p; } }
+  void            xRebase   ()                                 { m_Gen = xNewGen(); m_Dirty = 0; }
 private:
   std::vector<BinProbModel> m_CtxBuffer;
   BinProbModel*             m_Ctx;
+  mutable uint64_t          m_Gen;
+  mutable uint64_t          m_Dirty;
 };
 
 
@@ -1295,7 +1295,8 @@ namespace DQIntern
   public:
     DepQuant();
 
-    void    quant   ( TransformUnit& tu, const CCoeffBuf& srcCoeff, const ComponentID compID, const QpParam& cQP, const double lambda, const Ctx& ctx, TCoeff& absSum, bool enableScalingLists, int* quantCoeff );
+    void    quant   ( TransformUnit& tu, const CCoeffBuf& srcCoeff, const ComponentID compID, const QpParam& cQP, const double lambda, const Ctx& ctx, TCoeff& absSum, bool enableScalingLists, int* quantCoeff,
+                      bool ( *isZeroQuant )( const TCoeff*, const int, const int, const int, const int, const int*, const int64_t ) );
     void    dequant ( const TransformUnit& tu, CoeffBuf& recCoeff, const ComponentID compID, const QpParam& cQP, bool enableScalingLists, int* quantCoeff );
 
   private:
@@ -1441,7 +1442,8 @@ namespace DQIntern
   }
 
 
-  void DepQuant::quant( TransformUnit& tu, const CCoeffBuf& srcCoeff, const ComponentID compID, const QpParam& cQP, const double lambda, const Ctx& ctx, TCoeff& absSum, bool enableScalingLists, int* quantCoeff )
+  void DepQuant::quant( TransformUnit& tu, const CCoeffBuf& srcCoeff, const ComponentID compID, const QpParam& cQP, const double lambda, const Ctx& ctx, TCoeff& absSum, bool enableScalingLists, int* quantCoeff,
+                      bool ( *isZeroQuant )( const TCoeff*, const int, const int, const int, const int, const int*, const int64_t ) )
   {
     CHECKD( tu.cs->sps->getSpsRangeExtension().getExtendedPrecisionProcessingFlag(), "ext precision is not supported" );
 
@@ -1482,6 +1484,16 @@ namespace DQIntern
     }
     const TCoeff defaultQuantisationCoefficient = (TCoeff)m_quant.getQScale();
     const TCoeff thres = m_quant.getLastThreshold();
+    if( firstTestPos == numCoeff - 1 )
+    {
+      // abs( coeff ) > thres / ( 4 * scale ) is equivalent to abs( coeff ) * scale > thres / 4, thres being a multiple of 4
+      const int testWidth  = zeroOutforThres ? std::min<int>( width,  ( tuPars.m_width  == 32 && zeroOut ) ? 16 : 32 ) : width;
+      const int testHeight = zeroOutforThres ? std::min<int>( height, ( tuPars.m_height == 32 && zeroOut ) ? 16 : 32 ) : height;
+      if( isZeroQuant( tCoeff, width, testWidth, testHeight, defaultQuantisationCoefficient, enableScalingLists ? quantCoeff : nullptr, int64_t( thres >> 2 ) + 1 ) )
+      {
+        return;
+      }
+    }
     for( ; firstTestPos >= 0; firstTestPos-- )
     {
       if (zeroOutforThres && (tuPars.m_scanId2BlkPos[firstTestPos].x >= ((tuPars.m_width == 32 && zeroOut) ? 16 : 32)
@@ -1600,7 +1612,7 @@ void DepQuant::quant( TransformUnit &tu, const ComponentID &compID, const CCoeff
     const bool        isLfnstApplied = tu.cu->lfnstIdx > 0 && (tu.cu->isSepTree() ? true : isLuma(compID));
     const bool        disableSMForACT = tu.cs->slice->getSPS()->getScalingMatrixForAlternativeColourSpaceDisabledFlag() && (tu.cs->slice->getSPS()->getScalingMatrixDesignatedColourSpaceFlag() == tu.cu->colorTransform);
     const bool        enableScalingLists = getUseScalingList(width, height, (tu.mtsIdx[compID] == MTS_SKIP), isLfnstApplied, disableSMForLFNST, disableSMForACT);
-    static_cast<DQIntern::DepQuant*>(p)->quant( tu, pSrc, compID, cQP, Quant::m_dLambda, ctx, uiAbsSum, enableScalingLists, Quant::getQuantCoeff(scalingListType, qpRem, log2TrWidth, log2TrHeight) );
+    static_cast<DQIntern::DepQuant*>(p)->quant( tu, pSrc, compID, cQP, Quant::m_dLambda, ctx, uiAbsSum, enableScalingLists, Quant::getQuantCoeff(scalingListType, qpRem, log2TrWidth, log2TrHeight), m_isZeroQuant );
   }
   else
   {
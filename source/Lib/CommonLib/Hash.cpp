@@ -46,6 +46,7 @@
  // ====================================================================================================================
 
 int TComHash::m_blockSizeToIndex[65][65];
+const uint32_t TComHash::EMPTY_INDEX;
 TCRCCalculatorLight TComHash::m_crcCalculator1(24, 0x5D6DCB);
 TCRCCalculatorLight TComHash::m_crcCalculator2(24, 0x864CFB);
 
@@ -92,6 +93,16 @@ void TCRCCalculatorLight::xInitTable()
 
     m_table[value] = remainder;
   }
+
+  for (uint32_t value = 0; value < 256; value++)
+  {
+    m_slicedTable[0][value] = m_table[value] & m_finalResultMask;
+    for (int k = 1; k < 4; k++)
+    {
+      const uint32_t prev = m_slicedTable[k - 1][value];
+      m_slicedTable[k][value] = ((prev << 8) ^ m_table[(prev >> (m_bits - 8)) & 0xff]) & m_finalResultMask;
+    }
+  }
 }
 
 void TCRCCalculatorLight::processData(unsigned char* curData, uint32_t dataLength)
@@ -104,10 +115,28 @@ void TCRCCalculatorLight::processData(unsigned char* curData, uint32_t dataLengt
   }
 }
 
+uint32_t TCRCCalculatorLight::getCRC(const unsigned char* curData, uint32_t dataLength) const
+{
+  uint32_t remainder = 0;
+  uint32_t i = 0;
+  for (; i + 4 <= dataLength; i += 4)
+  {
+    const uint32_t x = (remainder << (32 - m_bits)) ^ (uint32_t(curData[i]) << 24) ^ (uint32_t(curData[i + 1]) << 16) ^ (uint32_t(curData[i + 2]) << 8) ^ curData[i + 3];
+    remainder = m_slicedTable[3][x >> 24] ^ m_slicedTable[2][(x >> 16) & 0xff] ^ m_slicedTable[1][(x >> 8) & 0xff] ^ m_slicedTable[0][x & 0xff];
+  }
+  for (; i < dataLength; i++)
+  {
+    unsigned char index = (remainder >> (m_bits - 8)) ^ curData[i];
+    remainder <<= 8;
+    remainder ^= m_table[index];
+  }
+  return remainder & m_finalResultMask;
+}
+
 
 TComHash::TComHash()
 {
-  m_lookupTable = NULL;
+  m_indexShift = 32;
   tableHasContent = false;
   for (int i = 0; i < 5; i++)
   {
@@ -117,119 +146,110 @@ TComHash::TComHash()
 
 TComHash::~TComHash()
 {
-  clearAll();
-  if (m_lookupTable != NULL)
-  {
-    delete[] m_lookupTable;
-    m_lookupTable = NULL;
-  }
 }
+
 void TComHash::create(int picWidth, int picHeight)
 {
-  if (m_lookupTable)
-  {
-    clearAll();
-  }
-  if (!hashPic[0])
-  {
-    for (int k = 0; k < 5; k++)
-    {
-      hashPic[k] = new uint16_t[picWidth*picHeight];
-    }
-  }
-  if (m_lookupTable)
+  reset();
+  m_hashPicBuf.resize(5 * size_t(picWidth * picHeight));
+  for (int k = 0; k < 5; k++)
   {
-    return;
+    hashPic[k] = m_hashPicBuf.data() + k * size_t(picWidth * picHeight);
   }
-  int maxAddr = 1 << (m_CRCBits + m_blockSizeBits);
-  m_lookupTable = new std::vector<BlockHash>*[maxAddr];
-  memset(m_lookupTable, 0, sizeof(std::vector<BlockHash>*) * maxAddr);
-  tableHasContent = false;
 }
 
+// releases the memory of the table, used when the picture is no longer referenced
 void TComHash::clearAll()
 {
-  if (hashPic[0])
+  std::vector<BlockHash>().swap(m_blocks);
+  std::vector<HashBucket>().swap(m_buckets);
+  std::vector<uint32_t>().swap(m_index);
+  std::vector<uint16_t>().swap(m_hashPicBuf);
+  for (int i = 0; i < 5; i++)
   {
-    for (int k = 0; k < 5; k++)
-    {
-      delete[] hashPic[k];
-      hashPic[k] = NULL;
-    }
+    hashPic[i] = NULL;
   }
+  m_indexShift = 32;
   tableHasContent = false;
-  if (m_lookupTable == NULL)
-  {
-    return;
-  }
-  int maxAddr = 1 << (m_CRCBits + m_blockSizeBits);
-  for (int i = 0; i < maxAddr; i++)
-  {
-    if (m_lookupTable[i] != NULL)
-    {
-      delete m_lookupTable[i];
-      m_lookupTable[i] = NULL;
-    }
-  }
 }
 
-void TComHash::addToTable(uint32_t hashValue, const BlockHash& blockHash)
+// empties the table but keeps the allocated memory, for rebuilding it for a picture of the same size
+void TComHash::reset()
 {
-  if (m_lookupTable[hashValue] == NULL)
-  {
-    m_lookupTable[hashValue] = new std::vector<BlockHash>;
-    m_lookupTable[hashValue]->push_back(blockHash);
-  }
-  else
-  {
-    m_lookupTable[hashValue]->push_back(blockHash);
-  }
+  m_blocks.clear();
+  m_buckets.clear();
+  m_index.clear();
+  m_indexShift = 32;
+  tableHasContent = false;
 }
 
-int TComHash::count(uint32_t hashValue)
+void TComHash::setInitial()
 {
-  if (m_lookupTable[hashValue] == NULL)
+  // index with at least twice as many slots as hash values, probed linearly from a multiplicative hash
+  int indexBits = 4;
+  while ((size_t(1) << indexBits) < 2 * m_buckets.size())
   {
-    return 0;
+    indexBits++;
   }
-  else
+  m_indexShift = 32 - indexBits;
+  m_index.assign(size_t(1) << indexBits, EMPTY_INDEX);
+
+  const uint32_t indexMask = (1 << indexBits) - 1;
+  for (uint32_t i = 0; i < (uint32_t) m_buckets.size(); i++)
   {
-    return static_cast<int>(m_lookupTable[hashValue]->size());
+    uint32_t slot = (m_buckets[i].hashValue * 0x9E3779B1u) >> m_indexShift;
+    while (m_index[slot] != EMPTY_INDEX)
+    {
+      slot = (slot + 1) & indexMask;
+    }
+    m_index[slot] = i;
   }
+  tableHasContent = true;
 }
 
-int TComHash::count(uint32_t hashValue) const
+const TComHash::HashBucket* TComHash::xFindBucket(uint32_t hashValue) const
 {
-  if (m_lookupTable[hashValue] == NULL)
+  if (m_index.empty())
   {
-    return 0;
+    return NULL;
   }
-  else
+  const uint32_t indexMask = (uint32_t) m_index.size() - 1;
+  uint32_t slot = (hashValue * 0x9E3779B1u) >> m_indexShift;
+  while (m_index[slot] != EMPTY_INDEX)
   {
-    return static_cast<int>(m_lookupTable[hashValue]->size());
+    const HashBucket& bucket = m_buckets[m_index[slot]];
+    if (bucket.hashValue == hashValue)
+    {
+      return &bucket;
+    }
+    slot = (slot + 1) & indexMask;
   }
+  return NULL;
 }
 
-MapIterator TComHash::getFirstIterator(uint32_t hashValue)
+int TComHash::count(uint32_t hashValue) const
 {
-  return m_lookupTable[hashValue]->begin();
+  const HashBucket* bucket = xFindBucket(hashValue);
+  return bucket ? static_cast<int>(bucket->count) : 0;
 }
 
-const MapIterator TComHash::getFirstIterator(uint32_t hashValue) const
+MapIterator TComHash::getFirstIterator(uint32_t hashValue) const
 {
-  return m_lookupTable[hashValue]->begin();
+  const HashBucket* bucket = xFindBucket(hashValue);
+  CHECK(bucket == NULL, "No block with this hash value");
+  return m_blocks.begin() + bucket->offset;
 }
 
-bool TComHash::hasExactMatch(uint32_t hashValue1, uint32_t hashValue2)
+bool TComHash::hasExactMatch(uint32_t hashValue1, uint32_t hashValue2) const
 {
-  if (m_lookupTable[hashValue1] == NULL)
+  const HashBucket* bucket = xFindBucket(hashValue1);
+  if (bucket == NULL)
   {
     return false;
   }
-  std::vector<BlockHash>::iterator it;
-  for (it = m_lookupTable[hashValue1]->begin(); it != m_lookupTable[hashValue1]->end(); it++)
+  for (uint32_t i = bucket->offset; i < bucket->offset + bucket->count; i++)
   {
-    if ((*it).hashValue2 == hashValue2)
+    if (m_blocks[i].hashValue2 == hashValue2)
     {
       return true;
     }
@@ -237,7 +257,8 @@ bool TComHash::hasExactMatch(uint32_t hashValue1, uint32_t hashValue2)
   return false;
 }
 
-void TComHash::generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWidth, int picHeight, const BitDepths bitDepths, uint32_t* picBlockHash[2], bool* picBlockSameInfo[3])
+// the rows of the hash levels are independent and computed in parallel stripes when numThreads > 1
+void TComHash::generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWidth, int picHeight, const BitDepths bitDepths, uint32_t* picBlockHash[2], bool* picBlockSameInfo[3], int numThreads)
 {
   const int width = 2;
   const int height = 2;
@@ -251,11 +272,14 @@ void TComHash::generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWid
     length *= 3;
     includeChroma = true;
   }
-  unsigned char* p = new unsigned char[length];
 
-  int pos = 0;
+#if _OPENMP
+#pragma omp parallel for schedule(static) num_threads(numThreads) if(numThreads > 1)
+#endif
   for (int yPos = 0; yPos < yEnd; yPos++)
   {
+    unsigned char p[2 * 2 * 3];
+    int pos = yPos * picWidth;
     for (int xPos = 0; xPos < xEnd; xPos++)
     {
       TComHash::getPixelsIn1DCharArrayByBlock2x2(curPicBuf, p, xPos, yPos, bitDepths, includeChroma);
@@ -267,13 +291,10 @@ void TComHash::generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWid
 
       pos++;
     }
-    pos += width - 1;
   }
-
-  delete[] p;
 }
 
-void TComHash::generateBlockHashValue(int picWidth, int picHeight, int width, int height, uint32_t* srcPicBlockHash[2], uint32_t* dstPicBlockHash[2], bool* srcPicBlockSameInfo[3], bool* dstPicBlockSameInfo[3])
+void TComHash::generateBlockHashValue(int picWidth, int picHeight, int width, int height, uint32_t* srcPicBlockHash[2], uint32_t* dstPicBlockHash[2], bool* srcPicBlockSameInfo[3], bool* dstPicBlockSameInfo[3], int numThreads)
 {
   int xEnd = picWidth - width + 1;
   int yEnd = picHeight - height + 1;
@@ -285,10 +306,13 @@ void TComHash::generateBlockHashValue(int picWidth, int picHeight, int width, in
 
   int length = 4 * sizeof(uint32_t);
 
-  uint32_t p[4];
-  int pos = 0;
+#if _OPENMP
+#pragma omp parallel for schedule(static) num_threads(numThreads) if(numThreads > 1)
+#endif
   for (int yPos = 0; yPos < yEnd; yPos++)
   {
+    uint32_t p[4];
+    int pos = yPos * picWidth;
     for (int xPos = 0; xPos < xEnd; xPos++)
     {
       p[0] = srcPicBlockHash[0][pos];
@@ -309,27 +333,18 @@ void TComHash::generateBlockHashValue(int picWidth, int picHeight, int width, in
       dstPicBlockSameInfo[1][pos] = srcPicBlockSameInfo[1][pos] && srcPicBlockSameInfo[1][pos + srcWidth] && srcPicBlockSameInfo[1][pos + quadHeight * picWidth]
         && srcPicBlockSameInfo[1][pos + quadHeight * picWidth + srcWidth] && srcPicBlockSameInfo[1][pos + srcHeight * picWidth] && srcPicBlockSameInfo[1][pos + srcHeight * picWidth + srcWidth];
 
-      pos++;
-    }
-    pos += width - 1;
-  }
-
-  if (width >= 4)
-  {
-    pos = 0;
-
-    for (int yPos = 0; yPos < yEnd; yPos++)
-    {
-      for (int xPos = 0; xPos < xEnd; xPos++)
+      if (width >= 4)
       {
         dstPicBlockSameInfo[2][pos] = (!dstPicBlockSameInfo[0][pos] && !dstPicBlockSameInfo[1][pos]);
-        pos++;
       }
-      pos += width - 1;
+
+      pos++;
     }
   }
 }
 
+// the blocks are added in two passes, counting the blocks per hash value and then storing them at their final
+// position, so the blocks of each hash value are contiguous and in the same order as the scan of the picture
 void TComHash::addToHashMapByRowWithPrecalData(uint32_t* picHash[2], bool* picIsSame, int picWidth, int picHeight, int width, int height)
 {
   int xEnd = picWidth - width + 1;
@@ -345,6 +360,8 @@ void TComHash::addToHashMapByRowWithPrecalData(uint32_t* picHash[2], bool* picIs
   crcMask -= 1;
   int blockIdx = floorLog2(width) - 2;
 
+  std::vector<uint32_t> blockPos(size_t(1) << m_CRCBits, 0);
+
   for (int xPos = 0; xPos < xEnd; xPos++)
   {
     for (int yPos = 0; yPos < yEnd; yPos++)
@@ -354,14 +371,40 @@ void TComHash::addToHashMapByRowWithPrecalData(uint32_t* picHash[2], bool* picIs
       //valid data
       if (srcIsAdded[pos])
       {
-        BlockHash blockHash;
+        blockPos[srcHash[0][pos] & crcMask]++;
+      }
+    }
+  }
+
+  // the hash values of each block size are disjoint, so their buckets are simply appended
+  uint32_t offset = (uint32_t) m_blocks.size();
+  for (uint32_t crc = 0; crc < (uint32_t) blockPos.size(); crc++)
+  {
+    if (blockPos[crc])
+    {
+      HashBucket bucket;
+      bucket.hashValue = crc + addValue;
+      bucket.offset    = offset;
+      bucket.count     = blockPos[crc];
+      m_buckets.push_back(bucket);
+
+      blockPos[crc] = offset;
+      offset += bucket.count;
+    }
+  }
+  m_blocks.resize(offset);
+
+  for (int xPos = 0; xPos < xEnd; xPos++)
+  {
+    for (int yPos = 0; yPos < yEnd; yPos++)
+    {
+      int pos = yPos * picWidth + xPos;
+      if (srcIsAdded[pos])
+      {
+        BlockHash& blockHash = m_blocks[blockPos[srcHash[0][pos] & crcMask]++];
         blockHash.x = xPos;
         blockHash.y = yPos;
-
-        uint32_t hashValue1 = (srcHash[0][pos] & crcMask) + addValue;
         blockHash.hashValue2 = srcHash[1][pos];
-
-        addToTable(hashValue1, blockHash);
       }
     }
   }
@@ -688,15 +731,11 @@ void TComHash::initBlockSizeToIndex()
 
 uint32_t TComHash::getCRCValue1(unsigned char* p, int length)
 {
-  m_crcCalculator1.reset();
-  m_crcCalculator1.processData(p, length);
-  return m_crcCalculator1.getCRC();
+  return m_crcCalculator1.getCRC(p, length);
 }
 
 uint32_t TComHash::getCRCValue2(unsigned char* p, int length)
 {
-  m_crcCalculator2.reset();
-  m_crcCalculator2.processData(p, length);
-  return m_crcCalculator2.getCRC();
+  return m_crcCalculator2.getCRC(p, length);
 }
 //! \}
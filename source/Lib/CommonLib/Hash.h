@@ -56,7 +56,7 @@ struct BlockHash
   uint32_t hashValue2;
 };
 
-typedef std::vector<BlockHash>::iterator MapIterator;
+typedef std::vector<BlockHash>::const_iterator MapIterator;
 
 // ====================================================================================================================
 // Class definitions
@@ -73,6 +73,8 @@ public:
   void processData(unsigned char* curData, uint32_t dataLength);
   void reset() { m_remainder = 0; }
   uint32_t getCRC() { return m_remainder & m_finalResultMask; }
+  /// CRC of the data, independent of the running remainder and thus usable from several threads
+  uint32_t getCRC(const unsigned char* curData, uint32_t dataLength) const;
 
 private:
   void xInitTable();
@@ -82,10 +84,13 @@ private:
   uint32_t m_truncPoly;
   uint32_t m_bits;
   uint32_t m_table[256];
+  uint32_t m_slicedTable[4][256];   ///< CRC of a byte followed by 0..3 zero bytes, for four bytes per step
   uint32_t m_finalResultMask;
 };
 
 
+/// block hash table of a picture: the blocks of all hash values are stored contiguously (grouped by hash value) in one
+/// array, and an open-addressing index maps each hash value present in the picture to its range of blocks
 struct TComHash
 {
 public:
@@ -93,18 +98,16 @@ public:
   ~TComHash();
   void create(int picWidth, int picHeight);
   void clearAll();
-  void addToTable(uint32_t hashValue, const BlockHash& blockHash);
-  int count(uint32_t hashValue);
+  void reset();
   int count(uint32_t hashValue) const;
-  MapIterator getFirstIterator(uint32_t hashValue);
-  const MapIterator getFirstIterator(uint32_t hashValue) const;
-  bool hasExactMatch(uint32_t hashValue1, uint32_t hashValue2);
+  MapIterator getFirstIterator(uint32_t hashValue) const;
+  bool hasExactMatch(uint32_t hashValue1, uint32_t hashValue2) const;
 
-  void generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWidth, int picHeight, const BitDepths bitDepths, uint32_t* picBlockHash[2], bool* picBlockSameInfo[3]);
-  void generateBlockHashValue(int picWidth, int picHeight, int width, int height, uint32_t* srcPicBlockHash[2], uint32_t* dstPicBlockHash[2], bool* srcPicBlockSameInfo[3], bool* dstPicBlockSameInfo[3]);
+  void generateBlock2x2HashValue(const PelUnitBuf &curPicBuf, int picWidth, int picHeight, const BitDepths bitDepths, uint32_t* picBlockHash[2], bool* picBlockSameInfo[3], int numThreads = 1);
+  void generateBlockHashValue(int picWidth, int picHeight, int width, int height, uint32_t* srcPicBlockHash[2], uint32_t* dstPicBlockHash[2], bool* srcPicBlockSameInfo[3], bool* dstPicBlockSameInfo[3], int numThreads = 1);
   void addToHashMapByRowWithPrecalData(uint32_t* srcHash[2], bool* srcIsSame, int picWidth, int picHeight, int width, int height);
   bool isInitial() { return tableHasContent; }
-  void setInitial() { tableHasContent = true; }
+  void setInitial();
   uint16_t* getHashPic(int baseSize) const { return hashPic[floorLog2(baseSize) - 2]; }
 
 
@@ -120,13 +123,27 @@ public:
   static bool isVerticalPerfectLuma(const Pel* srcPel, int stride, int width, int height);
 
 private:
-  std::vector<BlockHash>** m_lookupTable;
+  struct HashBucket
+  {
+    uint32_t hashValue;
+    uint32_t offset;   ///< index of the first block in m_blocks
+    uint32_t count;
+  };
+
+  const HashBucket* xFindBucket(uint32_t hashValue) const;
+
+  std::vector<BlockHash>  m_blocks;        ///< blocks of all hash values, grouped by hash value
+  std::vector<HashBucket> m_buckets;       ///< one entry per hash value, in the order of addition
+  std::vector<uint32_t>   m_index;         ///< open-addressing index into m_buckets, EMPTY_INDEX if unused
+  uint32_t                m_indexShift;
   bool tableHasContent;
+  std::vector<uint16_t> m_hashPicBuf;
   uint16_t* hashPic[5];//4x4 ~ 64x64
 
 private:
   static const int m_CRCBits = 16;
   static const int m_blockSizeBits = 3;
+  static const uint32_t EMPTY_INDEX = 0xffffffff;
   static int m_blockSizeToIndex[65][65];
 
   static TCRCCalculatorLight m_crcCalculator1;
@@ -50,12 +50,16 @@ using namespace std;
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
 
+const unsigned int IbcHashMap::EMPTY_INDEX;
+
 IbcHashMap::IbcHashMap()
 {
   m_picWidth = 0;
   m_picHeight = 0;
-  m_pos2Hash = NULL;
+  m_valid = false;
+  m_indexShift = 32;
   m_computeCrc32c = xxComputeCrc32c16bit;
+  m_computeBlockCrc32c = xxComputeBlockCrc32c;
 
 #if ENABLE_SIMD_OPT_IBC
 #ifdef TARGET_SIMD_X86
@@ -70,6 +74,7 @@ IbcHashMap::~IbcHashMap()
   destroy();
 }
 
+// the buffers are kept as long as the picture size does not change, only the hash values become invalid
 void IbcHashMap::init(const int picWidth, const int picHeight)
 {
   if (picWidth != m_picWidth || picHeight != m_picHeight)
@@ -79,25 +84,18 @@ void IbcHashMap::init(const int picWidth, const int picHeight)
 
   m_picWidth = picWidth;
   m_picHeight = picHeight;
-  m_pos2Hash = new unsigned int*[m_picHeight];
-  m_pos2Hash[0] = new unsigned int[m_picWidth * m_picHeight];
-  for (int n = 1; n < m_picHeight; n++)
-  {
-    m_pos2Hash[n] = m_pos2Hash[n - 1] + m_picWidth;
-  }
+  m_pos2Hash.resize(m_picWidth * m_picHeight);
+  m_valid = false;
 }
 
 void IbcHashMap::destroy()
 {
-  if (m_pos2Hash != NULL)
-  {
-    if (m_pos2Hash[0] != NULL)
-    {
-      delete[] m_pos2Hash[0];
-    }
-    delete[] m_pos2Hash;
-  }
-  m_pos2Hash = NULL;
+  std::vector<unsigned int>().swap(m_pos2Hash);
+  std::vector<HashBucket>  ().swap(m_buckets);
+  std::vector<unsigned int>().swap(m_index);
+  std::vector<Position>    ().swap(m_positions);
+  m_indexShift = 32;
+  m_valid = false;
 }
 ////////////////////////////////////////////////////////
 // CRC32C calculation in C code, same results as SSE 4.2's implementation
@@ -181,21 +179,26 @@ uint32_t IbcHashMap::xxComputeCrc32c16bit(uint32_t crc, const Pel pel)
 
   return crc;
 }
-// CRC calculation in C code
-////////////////////////////////////////////////////////
 
-unsigned int IbcHashMap::xxCalcBlockHash(const Pel* pel, const int stride, const int width, const int height, unsigned int crc)
+uint32_t IbcHashMap::xxComputeBlockCrc32c(uint32_t crc, const Pel* pel, const int stride, const int width, const int height)
 {
   for (int y = 0; y < height; y++)
   {
     for (int x = 0; x < width; x++)
     {
-      crc = m_computeCrc32c(crc, pel[x]);
+      crc = xxComputeCrc32c16bit(crc, pel[x]);
     }
     pel += stride;
   }
   return crc;
 }
+// CRC calculation in C code
+////////////////////////////////////////////////////////
+
+unsigned int IbcHashMap::xxCalcBlockHash(const Pel* pel, const int stride, const int width, const int height, unsigned int crc)
+{
+  return m_computeBlockCrc32c(crc, pel, stride, width, height);
+}
 
 template<ChromaFormat chromaFormat>
 void IbcHashMap::xxBuildPicHashMap(const PelUnitBuf& pic)
@@ -219,6 +222,7 @@ void IbcHashMap::xxBuildPicHashMap(const PelUnitBuf& pic)
       pelCb = pic.Cb().bufAt(0, chromaY);
       pelCr = pic.Cr().bufAt(0, chromaY);
     }
+    unsigned int* pos2Hash = &m_pos2Hash[pos.y * m_picWidth];
 
     for (pos.x = 0; pos.x + MIN_PU_SIZE <= pic.Y().width; pos.x++)
     {
@@ -236,17 +240,108 @@ void IbcHashMap::xxBuildPicHashMap(const PelUnitBuf& pic)
         hashValue = xxCalcBlockHash(&pelCr[chromaX], pic.Cr().stride, chromaMinBlkWidth, chromaMinBlkHeight, hashValue);
       }
 
-      // hash table
-      m_hash2Pos[hashValue].push_back(pos);
-      m_pos2Hash[pos.y][pos.x] = hashValue;
+      pos2Hash[pos.x] = hashValue;
     }
   }
 }
 
-void IbcHashMap::rebuildPicHashMap(const PelUnitBuf& pic)
+/// returns the bucket of the hash value, or bucketIdx after adding it at this index if the hash value is new
+unsigned int IbcHashMap::xxInsert(unsigned int hashValue, unsigned int bucketIdx)
+{
+  const unsigned int indexMask = (unsigned int) m_index.size() - 1;
+  unsigned int slot = (hashValue * 0x9E3779B1u) >> m_indexShift;
+  while (m_index[slot] != EMPTY_INDEX)
+  {
+    if (m_buckets[m_index[slot]].hashValue == hashValue)
+    {
+      return m_index[slot];
+    }
+    slot = (slot + 1) & indexMask;
+  }
+  m_index[slot] = bucketIdx;
+  return bucketIdx;
+}
+
+/// returns the bucket of a hash value of the picture
+unsigned int IbcHashMap::xxFindBucket(unsigned int hashValue) const
+{
+  const unsigned int indexMask = (unsigned int) m_index.size() - 1;
+  unsigned int slot = (hashValue * 0x9E3779B1u) >> m_indexShift;
+  while (true)
+  {
+    CHECK(m_index[slot] == EMPTY_INDEX, "Hash value not in the IBC hash map");
+    if (m_buckets[m_index[slot]].hashValue == hashValue)
+    {
+      return m_index[slot];
+    }
+    slot = (slot + 1) & indexMask;
+  }
+}
+
+// the positions are added in two passes, counting the positions per hash value and then storing them at their final
+// place, so the positions of each hash value are contiguous and in raster order
+void IbcHashMap::xxBuildIndex()
 {
-  m_hash2Pos.clear();
+  const int xEnd = m_picWidth - MIN_PU_SIZE + 1;
+  const int yEnd = m_picHeight - MIN_PU_SIZE + 1;
+
+  m_buckets.clear();
+  if (m_index.empty())
+  {
+    m_index.resize(1024);
+    m_indexShift = 32 - 10;
+  }
+  std::fill(m_index.begin(), m_index.end(), EMPTY_INDEX);
+
+  for (int y = 0; y < yEnd; y++)
+  {
+    for (int x = 0; x < xEnd; x++)
+    {
+      const unsigned int hashValue = xxGetHash(x, y);
+      const unsigned int bucketIdx = xxInsert(hashValue, (unsigned int) m_buckets.size());
+      if (bucketIdx == m_buckets.size())
+      {
+        m_buckets.push_back(HashBucket{ hashValue, 0, 1 });
+
+        // keep the index at most half full
+        if (2 * m_buckets.size() > m_index.size())
+        {
+          m_index.assign(2 * m_index.size(), EMPTY_INDEX);
+          m_indexShift--;
+          for (unsigned int i = 0; i < (unsigned int) m_buckets.size(); i++)
+          {
+            xxInsert(m_buckets[i].hashValue, i);
+          }
+        }
+      }
+      else
+      {
+        m_buckets[bucketIdx].count++;
+      }
+    }
+  }
 
+  unsigned int offset = 0;
+  for (HashBucket& bucket : m_buckets)
+  {
+    bucket.offset = offset;
+    offset += bucket.count;
+    bucket.count = 0;
+  }
+  m_positions.resize(offset);
+
+  for (int y = 0; y < yEnd; y++)
+  {
+    for (int x = 0; x < xEnd; x++)
+    {
+      HashBucket& bucket = m_buckets[xxFindBucket(xxGetHash(x, y))];
+      m_positions[bucket.offset + bucket.count++] = Position(x, y);
+    }
+  }
+}
+
+void IbcHashMap::rebuildPicHashMap(const PelUnitBuf& pic)
+{
   switch (pic.chromaFormat)
   {
   case CHROMA_400:
@@ -265,6 +360,8 @@ void IbcHashMap::rebuildPicHashMap(const PelUnitBuf& pic)
     THROW("invalid chroma fomat");
     break;
   }
+  xxBuildIndex();
+  m_valid = true;
 }
 
 bool IbcHashMap::ibcHashMatch(const Area& lumaArea, std::vector<Position>& cand, const CodingStructure& cs, const int maxCand, const int searchRange4SmallBlk)
@@ -279,22 +376,24 @@ bool IbcHashMap::ibcHashMatch(const Area& lumaArea, std::vector<Position>& cand,
   {
     for (SizeType x = 0; x < lumaArea.width && minSize > 1; x += MIN_PU_SIZE)
     {
-      unsigned int hash = m_pos2Hash[lumaArea.pos().y + y][lumaArea.pos().x + x];
-      if (m_hash2Pos[hash].size() < minSize)
+      unsigned int hash = xxGetHash(lumaArea.pos().x + x, lumaArea.pos().y + y);
+      const HashBucket& bucket = m_buckets[xxFindBucket(hash)];
+      if (bucket.count < minSize)
       {
-        minSize = m_hash2Pos[hash].size();
+        minSize = bucket.count;
         targetHashOneBlock = hash;
         targetBlockOffsetInCu.repositionTo(Position(x, y));
       }
     }
   }
 
-  if (m_hash2Pos[targetHashOneBlock].size() > 1)
+  if (minSize > 1 && minSize != MAX_UINT)
   {
-    std::vector<Position>& candOneBlock = m_hash2Pos[targetHashOneBlock];
+    const HashBucket& candOneBlock = m_buckets[xxFindBucket(targetHashOneBlock)];
+    const Position*   candBegin    = m_positions.data() + candOneBlock.offset;
 
     // check whether whole block match
-    for (std::vector<Position>::iterator refBlockPos = candOneBlock.begin(); refBlockPos != candOneBlock.end(); refBlockPos++)
+    for (const Position* refBlockPos = candBegin; refBlockPos != candBegin + candOneBlock.count; refBlockPos++)
     {
       Position topLeft = refBlockPos->offset(-targetBlockOffsetInCu.x, -targetBlockOffsetInCu.y);
       Position bottomRight = topLeft.offset(lumaArea.width - 1, lumaArea.height - 1);
@@ -310,7 +409,7 @@ bool IbcHashMap::ibcHashMatch(const Area& lumaArea, std::vector<Position>& cand,
           for (SizeType x = 0; x < lumaArea.width && wholeBlockMatch; x += MIN_PU_SIZE)
           {
             // whether the reference block and current block has the same hash
-            wholeBlockMatch &= (m_pos2Hash[lumaArea.pos().y + y][lumaArea.pos().x + x] == m_pos2Hash[topLeft.y + y][topLeft.x + x]);
+            wholeBlockMatch &= (xxGetHash(lumaArea.pos().x + x, lumaArea.pos().y + y) == xxGetHash(topLeft.x + x, topLeft.y + y));
           }
         }
       }
@@ -345,8 +444,8 @@ int IbcHashMap::getHashHitRatio(const Area& lumaArea)
   {
     for (int x = lumaArea.x; x < maxX; x += MIN_PU_SIZE)
     {
-      const unsigned int hash = m_pos2Hash[y][x];
-      hit += (m_hash2Pos[hash].size() > 1);
+      const unsigned int hash = xxGetHash(x, y);
+      hit += (m_buckets[xxFindBucket(hash)].count > 1);
       total++;
     }
   }
@@ -368,11 +467,10 @@ int IbcHashMap::calHashBlkMatchPerc(const Area& lumaArea)
     mostSelHash[i] = 0;
   }
 
-  for (std::unordered_map<unsigned int, std::vector<Position>>::iterator it = m_hash2Pos.begin(); it != m_hash2Pos.end(); ++it)
+  for (const HashBucket& bucket : m_buckets)
   {
-    unsigned int hash = it->first;
-    int usage = (int)it->second.size();
-    assert(usage == m_hash2Pos[hash].size());
+    unsigned int hash = bucket.hashValue;
+    int usage = (int)bucket.count;
 
     int insertPos = -1;
     for (insertPos = 0; insertPos < numExcludedHashValue; insertPos++)
@@ -401,7 +499,7 @@ int IbcHashMap::calHashBlkMatchPerc(const Area& lumaArea)
   {
     for (int x = lumaArea.x; x < maxX; x += MIN_PU_SIZE)
     {
-      unsigned int hash = m_pos2Hash[y][x];
+      unsigned int hash = xxGetHash(x, y);
 
       bool excludedHash = false;
       for (int i = 0; i < numExcludedHashValue && !excludedHash; i++)
@@ -417,7 +515,7 @@ int IbcHashMap::calHashBlkMatchPerc(const Area& lumaArea)
         continue;
       }
 
-      hit += (m_hash2Pos[hash].size() > 1);
+      hit += (m_buckets[xxFindBucket(hash)].count > 1);
       total++;
     }
   }
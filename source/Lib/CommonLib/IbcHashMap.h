@@ -46,7 +46,6 @@
 #include "CommonLib/Unit.h"
 #include "CommonLib/UnitPartitioner.h"
 
-#include <unordered_map>
 #include <vector>
 //! \ingroup EncoderLib
 //! \{
@@ -58,20 +57,39 @@
 class IbcHashMap
 {
 private:
+  struct HashBucket
+  {
+    unsigned int hashValue;
+    unsigned int offset;   ///< index of the first position in m_positions
+    unsigned int count;
+  };
+
   int     m_picWidth;
   int     m_picHeight;
-  unsigned int**  m_pos2Hash;
-  std::unordered_map<unsigned int, std::vector<Position>> m_hash2Pos;
+  bool    m_valid;
+  std::vector<unsigned int> m_pos2Hash;    ///< hash value of the block at each position
+  std::vector<HashBucket>   m_buckets;     ///< one entry per hash value, in order of first occurrence
+  std::vector<unsigned int> m_index;       ///< open-addressing index into m_buckets, EMPTY_INDEX if unused
+  std::vector<Position>     m_positions;   ///< positions of all hash values, grouped by hash value in raster order
+  unsigned int              m_indexShift;
+
+  static const unsigned int EMPTY_INDEX = 0xffffffff;
 
   unsigned int xxCalcBlockHash(const Pel* pel, const int stride, const int width, const int height, unsigned int crc);
 
   template<ChromaFormat chromaFormat>
   void    xxBuildPicHashMap(const PelUnitBuf& pic);
+  void    xxBuildIndex();
+  unsigned int xxInsert(unsigned int hashValue, unsigned int bucketIdx);
+  unsigned int xxFindBucket(unsigned int hashValue) const;
+  unsigned int xxGetHash(int x, int y) const { return m_pos2Hash[y * m_picWidth + x]; }
 
   static  uint32_t xxComputeCrc32c16bit(uint32_t crc, const Pel pel);
+  static  uint32_t xxComputeBlockCrc32c(uint32_t crc, const Pel* pel, const int stride, const int width, const int height);
 
 public:
   uint32_t (*m_computeCrc32c) (uint32_t crc, const Pel pel);
+  uint32_t (*m_computeBlockCrc32c) (uint32_t crc, const Pel* pel, const int stride, const int width, const int height);
 
   IbcHashMap();
   virtual ~IbcHashMap();
@@ -79,6 +97,7 @@ public:
   void    init(const int picWidth, const int picHeight);
   void    destroy();
   void    rebuildPicHashMap(const PelUnitBuf& pic);
+  bool    isValid() const { return m_valid; }
   bool    ibcHashMatch(const Area& lumaArea, std::vector<Position>& cand, const CodingStructure& cs, const int maxCand, const int searchRange4SmallBlk);
   int     getHashHitRatio(const Area& lumaArea);
 
@@ -2432,6 +2432,8 @@ bool InterPrediction::xPredInterBlkRPR( const std::pair<int, int>& scalingRatio,
     Pel buffer[( MAX_CU_SIZE + 16 ) * ( MAX_CU_SIZE * MAX_SCALING_RATIO + 16 )];
     int tmpStride = width;
     int xInt = 0, yInt = 0;
+    int colOffset[MAX_CU_SIZE];
+    int colFrac[MAX_CU_SIZE];
 
     for( col = 0; col < width; col++ )
     {
@@ -2442,13 +2444,15 @@ bool InterPrediction::xPredInterBlkRPR( const std::pair<int, int>& scalingRatio,
 
       CHECK( xInt0 > xInt, "Wrong horizontal starting point" );
 
-      Position offset = Position( xInt, yInt0 );
-      refBuf = refPic->getRecoBuf( CompArea( compID, chFmt, offset, Size( 1, refHeight ) ), wrapRef );
-      Pel* tempBuf = buffer + col;
-
-      m_if.filterHor( compID, (Pel*)refBuf.buf - ( ( vFilterSize >> 1 ) - 1 ) * refBuf.stride, refBuf.stride, tempBuf, tmpStride, 1, refHeight + vFilterSize - 1 + extSize, xFrac, false, chFmt, clpRng, xFilter, false, useAltHpelIf && scalingRatio.first == 1 << SCALE_RATIO_BITS );
+      colOffset[col] = xInt - xInt0;
+      colFrac[col]   = xFrac;
     }
 
+    // all columns are filtered at once, each with its own integer offset and filter phase
+    refBuf = refPic->getRecoBuf( CompArea( compID, chFmt, Position( xInt0, yInt0 ), Size( 1, refHeight ) ), wrapRef );
+
+    m_if.filterHorScaled( compID, (Pel*)refBuf.buf - ( ( vFilterSize >> 1 ) - 1 ) * refBuf.stride, refBuf.stride, buffer, tmpStride, width, refHeight + vFilterSize - 1 + extSize, colOffset, colFrac, chFmt, clpRng, xFilter, useAltHpelIf && scalingRatio.first == 1 << SCALE_RATIO_BITS );
+
     for( row = 0; row < height; row++ )
     {
       int posY = (int32_t)y0Int + row * stepY;
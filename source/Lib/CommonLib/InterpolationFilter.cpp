@@ -369,6 +369,9 @@ InterpolationFilter::InterpolationFilter()
   m_filterCopy[1][0]   = filterCopy<true, false>;
   m_filterCopy[1][1]   = filterCopy<true, true>;
 
+  m_filterScaled[0]    = filterScaled<8>;
+  m_filterScaled[1]    = filterScaled<4>;
+
   m_weightedGeoBlk = xWeightedGeoBlk;
 }
 
@@ -655,6 +658,64 @@ void InterpolationFilter::filter(const ClpRng& clpRng, Pel const *src, int srcSt
   }
 }
 
+/**
+ * \brief Filter a block of samples horizontally with a different filter in each column (first of two filtering operations)
+ *
+ * \tparam N          Number of taps
+ * \param  src        Pointer to source samples
+ * \param  srcStride  Stride of source samples
+ * \param  dst        Pointer to destination samples
+ * \param  dstStride  Stride of destination samples
+ * \param  width      Width of block
+ * \param  height     Height of block
+ * \param  colOffset  Offset of the source sample of each column relative to src
+ * \param  coeff      Pointers to the filter taps of each column
+ */
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// !!! NOTE !!!
+//
+//  This is the scalar version of the function.
+//  If you change the functionality here, consider to switch off the SIMD implementation of this function.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<int N>
+void InterpolationFilter::filterScaled( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, const int *colOffset, TFilterCoeff const * const *coeff )
+{
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+  const int headRoom = IF_INTERNAL_FRAC_BITS(clpRng.bd);
+#else
+  const int headRoom = std::max<int>(2, (IF_INTERNAL_PREC - clpRng.bd));
+#endif
+  const int shift    = IF_FILTER_PREC - headRoom;
+  const int offset   = -IF_INTERNAL_OFFS << shift;
+
+  src -= N / 2 - 1;
+
+  for( int row = 0; row < height; row++ )
+  {
+    for( int col = 0; col < width; col++ )
+    {
+      const Pel*          s = src + colOffset[col];
+      const TFilterCoeff* c = coeff[col];
+      int sum = 0;
+
+      for( int k = 0; k < N; k++ )
+      {
+        sum += s[k] * c[k];
+      }
+
+      dst[col] = ( sum + offset ) >> shift;
+    }
+
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+template void InterpolationFilter::filterScaled<8>( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, const int *colOffset, TFilterCoeff const * const *coeff );
+template void InterpolationFilter::filterScaled<4>( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, const int *colOffset, TFilterCoeff const * const *coeff );
+
 /**
  * \brief Filter a block of samples (horizontal)
  *
@@ -813,6 +874,65 @@ void InterpolationFilter::filterHor(const ComponentID compID, Pel const *src, in
 }
 
 
+/**
+ * \brief Filter a block of Luma/Chroma samples horizontally with a fractional sample offset per column, as used for
+ *        scaled reference pictures; output is the intermediate (first operation) precision
+ *
+ * \param  compID     Chroma component ID
+ * \param  src        Pointer to source samples
+ * \param  srcStride  Stride of source samples
+ * \param  dst        Pointer to destination samples
+ * \param  dstStride  Stride of destination samples
+ * \param  width      Width of block
+ * \param  height     Height of block
+ * \param  colOffset  Integer sample offset of each column relative to src
+ * \param  colFrac    Fractional sample offset of each column
+ * \param  fmt        Chroma format
+ * \param  bitDepth   Bit depth
+ */
+void InterpolationFilter::filterHorScaled(const ComponentID compID, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, const int *colOffset, const int *colFrac, const ChromaFormat fmt, const ClpRng& clpRng, int nFilterIdx, bool useAltHpelIf)
+{
+  CHECK( nFilterIdx == 1, "Bilinear filter not supported for scaled reference pictures" );
+  CHECK( width > MAX_CU_SIZE, "Block too wide" );
+
+  TFilterCoeff const *coeff[MAX_CU_SIZE];
+
+  // the copy for frac == 0 of filterHor() equals filtering with the first phase of the default filters
+  if( isLuma( compID ) )
+  {
+    for( int col = 0; col < width; col++ )
+    {
+      const int frac = colFrac[col];
+      CHECK( frac < 0 || frac >= LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS, "Invalid fraction" );
+      coeff[col] = nFilterIdx == 2                ? m_lumaFilter4x4[frac]
+                 : nFilterIdx == 3                ? m_lumaFilterRPR1[frac]
+                 : nFilterIdx == 4                ? m_lumaFilterRPR2[frac]
+                 : nFilterIdx == 5                ? m_affineLumaFilterRPR1[frac]
+                 : nFilterIdx == 6                ? m_affineLumaFilterRPR2[frac]
+                 : frac == 8 && useAltHpelIf      ? m_lumaAltHpelIFilter
+                 :                                  m_lumaFilter[frac];
+    }
+
+    m_filterScaled[0]( clpRng, src, srcStride, dst, dstStride, width, height, colOffset, coeff );
+  }
+  else
+  {
+    const uint32_t csx = getComponentScaleX( compID, fmt );
+
+    for( int col = 0; col < width; col++ )
+    {
+      const int frac = colFrac[col] << ( 1 - csx );
+      CHECK( frac < 0 || csx >= 2 || frac >= CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS, "Invalid fraction" );
+      coeff[col] = nFilterIdx == 3 ? m_chromaFilterRPR1[frac]
+                 : nFilterIdx == 4 ? m_chromaFilterRPR2[frac]
+                 :                   m_chromaFilter[frac];
+    }
+
+    m_filterScaled[1]( clpRng, src, srcStride, dst, dstStride, width, height, colOffset, coeff );
+  }
+}
+
+
 /**
  * \brief Filter a block of Luma/Chroma samples (vertical)
  *
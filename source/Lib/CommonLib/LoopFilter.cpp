@@ -43,6 +43,7 @@
 #include "UnitPartitioner.h"
 #include "dtrace_codingstruct.h"
 #include "dtrace_buffer.h"
+#include "StageProfiler.h"
 
 //! \ingroup CommonLib
 //! \{
@@ -144,6 +145,8 @@ void LoopFilter::destroy()
 void LoopFilter::loopFilterPic( CodingStructure& cs
                                 )
 {
+  PROFILE_STAGE( PROF_DEBLOCK );
+
   const PreCalcValues& pcv = *cs.pcv;
   m_shiftHor = ::getComponentScaleX( COMPONENT_Cb, cs.pcv->chrFormat );
   m_shiftVer = ::getComponentScaleY( COMPONENT_Cb, cs.pcv->chrFormat );
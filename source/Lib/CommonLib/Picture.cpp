@@ -201,10 +201,9 @@ void Picture::create( const ChromaFormat &_chromaFormat, const Size &size, const
 {
   layerId = _layerId;
   UnitArea::operator=( UnitArea( _chromaFormat, Area( Position{ 0, 0 }, size ) ) );
-  margin            =  MAX_SCALING_RATIO*_margin;
+  margin            =  _margin;
   const Area a      = Area( Position(), size );
   M_BUFS( 0, PIC_RECONSTRUCTION ).create( _chromaFormat, a, _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
-  M_BUFS( 0, PIC_RECON_WRAP ).create( _chromaFormat, a, _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
 
   if( !_decoder )
   {
@@ -218,6 +217,16 @@ void Picture::create( const ChromaFormat &_chromaFormat, const Size &size, const
   m_hashMap.clearAll();
 }
 
+/** margin of the reconstruction buffers
+    motion vectors are clipped to one CTU (plus the interpolation taps) outside of the picture, only references scaled
+    by RPR or inter-layer prediction are read up to MAX_SCALING_RATIO times as far
+ */
+unsigned Picture::getPicMargin( const SPS &sps )
+{
+  const bool scaledRefs = sps.getRprEnabledFlag() || sps.getVPSId() != 0;
+  return ( scaledRefs ? MAX_SCALING_RATIO : 1 ) * ( sps.getMaxCUWidth() + 16 );
+}
+
 void Picture::destroy()
 {
 #if ENABLE_SPLIT_PARALLELISM
@@ -615,7 +624,7 @@ void Picture::sampleRateConv( const std::pair<int, int> scalingRatio, const std:
                               const CPelBuf& beforeScale, const int beforeScaleLeftOffset, const int beforeScaleTopOffset,
                               const PelBuf& afterScale, const int afterScaleLeftOffset, const int afterScaleTopOffset,
                               const int bitDepth, const bool useLumaFilter, const bool downsampling,
-                              const bool horCollocatedPositionFlag, const bool verCollocatedPositionFlag )
+                              const bool horCollocatedPositionFlag, const bool verCollocatedPositionFlag, const int numThreads )
 {
   const Pel* orgSrc = beforeScale.buf;
   const int orgWidth = beforeScale.width;
@@ -674,71 +683,74 @@ void Picture::sampleRateConv( const std::pair<int, int> scalingRatio, const std:
   const int filterLength = downsampling ? 12 : ( useLumaFilter ? NTAPS_LUMA : NTAPS_CHROMA );
   const int log2Norm = downsampling ? 14 : 12;
 
-  int *buf = new int[orgHeight * scaledWidth];
   int maxVal = ( 1 << bitDepth ) - 1;
 
   CHECK( bitDepth > 17, "Overflow may happen!" );
 
+  // phase tables: per output column the first tap in the padded source row and the filter phase; the source
+  // rows are padded by filterLength replicated samples on both sides, which is equivalent to clipping each tap
+  std::vector<int> srcOffset( scaledWidth );
+  std::vector<int> phaseHor ( scaledWidth );
+
   for( int i = 0; i < scaledWidth; i++ )
   {
-    const Pel* org = orgSrc;
     int refPos = ( ( ( i << compScale.first ) - afterScaleLeftOffset ) * scalingRatio.first + addX ) >> posShiftX;
     int integer = refPos >> numFracShift;
-    int frac = refPos & numFracPositions;
-    int* tmp = buf + i;
 
-    for( int j = 0; j < orgHeight; j++ )
-    {
-      int sum = 0;
-      const TFilterCoeff* f = filterHor + frac * filterLength;
+    srcOffset[i] = Clip3( -filterLength, orgWidth, integer - filterLength / 2 + 1 ) + filterLength;
+    phaseHor[i]  = refPos & numFracPositions;
+  }
 
-      for( int k = 0; k < filterLength; k++ )
-      {
-        int xInt = std::min<int>( std::max( 0, integer + k - filterLength / 2 + 1 ), orgWidth - 1 );
-        sum += f[k] * org[xInt]; // postpone horizontal filtering gain removal after vertical filtering
-      }
+  std::vector<int> buf( orgHeight * scaledWidth );
 
-      *tmp = sum;
+#if _OPENMP
+#pragma omp parallel num_threads( numThreads ) if( numThreads > 1 )
+#endif
+  {
+    std::vector<Pel> line( orgWidth + 2 * filterLength );
 
-      tmp += scaledWidth;
-      org += orgStride;
-    }
-  }
+#if _OPENMP
+#pragma omp for schedule( static )
+#endif
+    for( int j = 0; j < orgHeight; j++ )
+    {
+      const Pel* org = orgSrc + j * orgStride;
 
-  Pel* dst = scaledSrc;
+      std::fill_n( line.begin(), filterLength, org[0] );
+      std::copy_n( org, orgWidth, line.begin() + filterLength );
+      std::fill_n( line.begin() + filterLength + orgWidth, filterLength, org[orgWidth - 1] );
 
-  for( int j = 0; j < scaledHeight; j++ )
-  {
-    int refPos = ( ( ( j << compScale.second ) - afterScaleTopOffset ) * scalingRatio.second + addY ) >> posShiftY;
-    int integer = refPos >> numFracShift;
-    int frac = refPos & numFracPositions;
+      // postpone horizontal filtering gain removal after vertical filtering
+      g_pelBufOP.sampleRateConvHor( line.data(), buf.data() + j * scaledWidth, scaledWidth, srcOffset.data(), phaseHor.data(), filterHor, filterLength );
+    }
 
-    for( int i = 0; i < scaledWidth; i++ )
+#if _OPENMP
+#pragma omp for schedule( static )
+#endif
+    for( int j = 0; j < scaledHeight; j++ )
     {
-      int sum = 0;
-      int* tmp = buf + i;
-      const TFilterCoeff* f = filterVer + frac * filterLength;
+      int refPos = ( ( ( j << compScale.second ) - afterScaleTopOffset ) * scalingRatio.second + addY ) >> posShiftY;
+      int integer = refPos >> numFracShift;
+      int frac = refPos & numFracPositions;
+
+      const int* rows[12];
 
       for( int k = 0; k < filterLength; k++ )
       {
         int yInt = std::min<int>( std::max( 0, integer + k - filterLength / 2 + 1 ), orgHeight - 1 );
-        sum += f[k] * tmp[yInt*scaledWidth];
+        rows[k] = buf.data() + yInt * scaledWidth;
       }
 
-      dst[i] = std::min<int>( std::max( 0, ( sum + ( 1 << ( log2Norm - 1 ) ) ) >> log2Norm ), maxVal );
+      g_pelBufOP.sampleRateConvVer( rows, scaledSrc + j * scaledStride, scaledWidth, filterVer + frac * filterLength, filterLength, log2Norm, maxVal );
     }
-
-    dst += scaledStride;
   }
-
-  delete[] buf;
 }
 
 void Picture::rescalePicture( const std::pair<int, int> scalingRatio,
                               const CPelUnitBuf& beforeScaling, const Window& scalingWindowBefore,
                               const PelUnitBuf& afterScaling, const Window& scalingWindowAfter,
                               const ChromaFormat chromaFormatIDC, const BitDepths& bitDepths, const bool useLumaFilter, const bool downsampling,
-                              const bool horCollocatedChromaFlag, const bool verCollocatedChromaFlag )
+                              const bool horCollocatedChromaFlag, const bool verCollocatedChromaFlag, const int numThreads )
 {
   for( int comp = 0; comp < ::getNumberValidComponents( chromaFormatIDC ); comp++ )
   {
@@ -750,7 +762,7 @@ void Picture::rescalePicture( const std::pair<int, int> scalingRatio,
                     beforeScale, scalingWindowBefore.getWindowLeftOffset() * SPS::getWinUnitX( chromaFormatIDC ), scalingWindowBefore.getWindowTopOffset() * SPS::getWinUnitY( chromaFormatIDC ),
                     afterScale, scalingWindowAfter.getWindowLeftOffset() * SPS::getWinUnitX( chromaFormatIDC ), scalingWindowAfter.getWindowTopOffset() * SPS::getWinUnitY( chromaFormatIDC ),
                     bitDepths.recon[toChannelType(compID)], downsampling || useLumaFilter ? true : isLuma( compID ), downsampling,
-                    isLuma( compID ) ? 1 : horCollocatedChromaFlag, isLuma( compID ) ? 1 : verCollocatedChromaFlag );
+                    isLuma( compID ) ? 1 : horCollocatedChromaFlag, isLuma( compID ) ? 1 : verCollocatedChromaFlag, numThreads );
   }
 }
 
@@ -772,8 +784,11 @@ void Picture::saveSubPicBorder(int POC, int subPicX0, int subPicY0, int subPicWi
   m_bufSubPicBelow.create(unitAreaAboveBelow);
   m_bufSubPicLeft.create(unitAreaLeftRight);
   m_bufSubPicRight.create(unitAreaLeftRight);
-  m_bufWrapSubPicAbove.create(unitAreaAboveBelow);
-  m_bufWrapSubPicBelow.create(unitAreaAboveBelow);
+  if (m_wrapAroundValid)
+  {
+    m_bufWrapSubPicAbove.create(unitAreaAboveBelow);
+    m_bufWrapSubPicBelow.create(unitAreaAboveBelow);
+  }
 
   for (int comp = 0; comp < getNumberValidComponents(cs->area.chromaFormat); comp++)
   {
@@ -832,7 +847,7 @@ void Picture::saveSubPicBorder(int POC, int subPicX0, int subPicY0, int subPicWi
     }
 
     // back up recon wrap buffer
-    if (cs->sps->getWrapAroundEnabledFlag())
+    if (m_wrapAroundValid)
     {
       PelBuf sWrap = M_BUFS(0, PIC_RECON_WRAP).get(compID);
       Pel *srcWrap = sWrap.bufAt(left, top);
@@ -881,25 +896,7 @@ void Picture::extendSubPicBorder(int POC, int subPicX0, int subPicY0, int subPic
     Pel *src = s.bufAt(left, top);
 
     // 4.1 apply padding for left and right
-    {
-      Pel *dstLeft  = src - xmargin;
-      Pel *dstRight = src + width;
-      Pel *srcLeft  = src + 0;
-      Pel *srcRight = src + width - 1;
-
-      for (int y = 0; y < height; y++)
-      {
-        for (int x = 0; x < xmargin; x++)
-        {
-          dstLeft[x]  = *srcLeft;
-          dstRight[x] = *srcRight;
-        }
-        dstLeft += s.stride;
-        dstRight += s.stride;
-        srcLeft += s.stride;
-        srcRight += s.stride;
-      }
-    }
+    g_pelBufOP.extendBorderHor(src, s.stride, width, height, xmargin);
 
     // 4.2 apply padding on bottom
     Pel *srcBottom = src + s.stride * (height - 1) - xmargin;
@@ -922,7 +919,7 @@ void Picture::extendSubPicBorder(int POC, int subPicX0, int subPicY0, int subPic
     }
 
     // Appy padding for recon wrap buffer
-    if (cs->sps->getWrapAroundEnabledFlag())
+    if (m_wrapAroundValid)
     {
       // set recon wrap picture
       PelBuf sWrap = M_BUFS(0, PIC_RECON_WRAP).get(compID);
@@ -1012,7 +1009,7 @@ void Picture::restoreSubPicBorder(int POC, int subPicX0, int subPicY0, int subPi
     }
 
     // restore recon wrap buffer
-    if (cs->sps->getWrapAroundEnabledFlag())
+    if (m_wrapAroundValid)
     {
       // set recon wrap picture
       PelBuf sWrap = M_BUFS(0, PIC_RECON_WRAP).get(compID);
@@ -1047,7 +1044,7 @@ void Picture::restoreSubPicBorder(int POC, int subPicX0, int subPicY0, int subPi
   m_bufWrapSubPicBelow.destroy();
 }
 
-void Picture::extendPicBorder( const PPS *pps )
+void Picture::extendPicBorder( const PPS *pps, const int numThreads )
 {
   if ( m_bIsBorderExtended )
   {
@@ -1062,48 +1059,48 @@ void Picture::extendPicBorder( const PPS *pps )
   {
     ComponentID compID = ComponentID( comp );
     PelBuf p = M_BUFS( 0, PIC_RECONSTRUCTION ).get( compID );
-    Pel *piTxt = p.bufAt(0,0);
     int xmargin = margin >> getComponentScaleX( compID, cs->area.chromaFormat );
     int ymargin = margin >> getComponentScaleY( compID, cs->area.chromaFormat );
 
-    Pel*  pi = piTxt;
-    // do left and right margins
-      for (int y = 0; y < p.height; y++)
-      {
-        for (int x = 0; x < xmargin; x++ )
-        {
-          pi[ -xmargin + x ] = pi[0];
-          pi[  p.width + x ] = pi[p.width-1];
-        }
-        pi += p.stride;
-      }
+    // (-marginX, 0) and (-marginX, height-1)
+    Pel* piTop    = p.bufAt( 0, 0 ) - xmargin;
+    Pel* piBottom = p.bufAt( 0, p.height - 1 ) - xmargin;
+    const size_t lineSize = sizeof( Pel ) * ( p.width + ( xmargin << 1 ) );
 
-    // pi is now the (0,height) (bottom left of image within bigger picture
-    pi -= (p.stride + xmargin);
-    // pi is now the (-marginX, height-1)
-    for (int y = 0; y < ymargin; y++ )
+#if _OPENMP
+#pragma omp parallel num_threads( numThreads ) if( numThreads > 1 )
+#endif
     {
-      ::memcpy( pi + (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin << 1)));
-    }
+      // do left and right margins in stripes of rows
+#if _OPENMP
+#pragma omp for schedule( static )
+#endif
+      for( int y = 0; y < p.height; y += BORDER_EXT_STRIPE_HEIGHT )
+      {
+        g_pelBufOP.extendBorderHor( p.bufAt( 0, y ), p.stride, p.width, std::min<int>( BORDER_EXT_STRIPE_HEIGHT, p.height - y ), xmargin );
+      }
 
-    // pi is still (-marginX, height-1)
-    pi -= ((p.height-1) * p.stride);
-    // pi is now (-marginX, 0)
-    for (int y = 0; y < ymargin; y++ )
-    {
-      ::memcpy( pi - (y+1)*p.stride, pi, sizeof(Pel)*(p.width + (xmargin<<1)) );
+      // then copy the extended first and last rows to the top and bottom margins
+#if _OPENMP
+#pragma omp for schedule( static )
+#endif
+      for( int y = 1; y <= ymargin; y++ )
+      {
+        ::memcpy( piBottom + y * p.stride, piBottom, lineSize );
+        ::memcpy( piTop    - y * p.stride, piTop,    lineSize );
+      }
     }
+  }
 
-    // reference picture with horizontal wrapped boundary
-    if ( isWrapAroundEnabled( pps ) )
-    {
-      extendWrapBorder( pps );
-    }
-    else
-    {
-      m_wrapAroundValid = false;
-      m_wrapAroundOffset = 0;
-    }
+  // reference picture with horizontal wrapped boundary
+  if ( isWrapAroundEnabled( pps ) )
+  {
+    extendWrapBorder( pps );
+  }
+  else
+  {
+    m_wrapAroundValid = false;
+    m_wrapAroundOffset = 0;
   }
 
   m_bIsBorderExtended = true;
@@ -1111,6 +1108,12 @@ void Picture::extendPicBorder( const PPS *pps )
 
 void Picture::extendWrapBorder( const PPS *pps )
 {
+  // the wrap-around reconstruction is only needed by pictures referenced with wrap-around motion compensation
+  if( M_BUFS( 0, PIC_RECON_WRAP ).bufs.empty() )
+  {
+    M_BUFS( 0, PIC_RECON_WRAP ).create( chromaFormat, Y(), cs->pcv->maxCUWidth, margin, MEMORY_ALIGN_DEF_SIZE );
+  }
+
   for(int comp=0; comp<getNumberValidComponents( cs->area.chromaFormat ); comp++)
   {
     ComponentID compID = ComponentID( comp );
@@ -1121,20 +1124,18 @@ void Picture::extendWrapBorder( const PPS *pps )
     int ymargin = margin >> getComponentScaleY( compID, cs->area.chromaFormat );
     Pel*  pi = piTxt;
     int xoffset = pps->getWrapAroundOffset() >> getComponentScaleX( compID, cs->area.chromaFormat );
+    const int xwrap = std::min( xoffset, xmargin );
+    // samples beyond the wrap-around offset are padded as in extendPicBorder
+    if( xwrap < xmargin )
+    {
+      g_pelBufOP.extendBorderHor( pi, p.stride, p.width, p.height, xmargin );
+    }
     for (int y = 0; y < p.height; y++)
     {
-      for (int x = 0; x < xmargin; x++ )
+      for (int x = 0; x < xwrap; x++ )
       {
-        if( x < xoffset )
-        {
-          pi[ -x - 1 ] = pi[ -x - 1 + xoffset ];
-          pi[  p.width + x ] = pi[ p.width + x - xoffset ];
-        }
-        else
-        {
-          pi[ -x - 1 ] = pi[ 0 ];
-          pi[  p.width + x ] = pi[ p.width - 1 ];
-        }
+        pi[ -x - 1 ] = pi[ -x - 1 + xoffset ];
+        pi[  p.width + x ] = pi[ p.width + x - xoffset ];
       }
       pi += p.stride;
     }
@@ -1265,7 +1266,7 @@ bool Picture::getSpliceFull()
   return true;
 }
 
-void Picture::addPictureToHashMapForInter()
+void Picture::addPictureToHashMapForInter( int numThreads )
 {
   int picWidth = slices[0]->getPPS()->getPicWidthInLumaSamples();
   int picHeight = slices[0]->getPPS()->getPicHeightInLumaSamples();
@@ -1285,20 +1286,20 @@ void Picture::addPictureToHashMapForInter()
     }
   }
   m_hashMap.create(picWidth, picHeight);
-  m_hashMap.generateBlock2x2HashValue(getOrigBuf(), picWidth, picHeight, slices[0]->getSPS()->getBitDepths(), blockHashValues[0], bIsBlockSame[0]);//2x2
-  m_hashMap.generateBlockHashValue(picWidth, picHeight, 4, 4, blockHashValues[0], blockHashValues[1], bIsBlockSame[0], bIsBlockSame[1]);//4x4
+  m_hashMap.generateBlock2x2HashValue(getOrigBuf(), picWidth, picHeight, slices[0]->getSPS()->getBitDepths(), blockHashValues[0], bIsBlockSame[0], numThreads);//2x2
+  m_hashMap.generateBlockHashValue(picWidth, picHeight, 4, 4, blockHashValues[0], blockHashValues[1], bIsBlockSame[0], bIsBlockSame[1], numThreads);//4x4
   m_hashMap.addToHashMapByRowWithPrecalData(blockHashValues[1], bIsBlockSame[1][2], picWidth, picHeight, 4, 4);
 
-  m_hashMap.generateBlockHashValue(picWidth, picHeight, 8, 8, blockHashValues[1], blockHashValues[0], bIsBlockSame[1], bIsBlockSame[0]);//8x8
+  m_hashMap.generateBlockHashValue(picWidth, picHeight, 8, 8, blockHashValues[1], blockHashValues[0], bIsBlockSame[1], bIsBlockSame[0], numThreads);//8x8
   m_hashMap.addToHashMapByRowWithPrecalData(blockHashValues[0], bIsBlockSame[0][2], picWidth, picHeight, 8, 8);
 
-  m_hashMap.generateBlockHashValue(picWidth, picHeight, 16, 16, blockHashValues[0], blockHashValues[1], bIsBlockSame[0], bIsBlockSame[1]);//16x16
+  m_hashMap.generateBlockHashValue(picWidth, picHeight, 16, 16, blockHashValues[0], blockHashValues[1], bIsBlockSame[0], bIsBlockSame[1], numThreads);//16x16
   m_hashMap.addToHashMapByRowWithPrecalData(blockHashValues[1], bIsBlockSame[1][2], picWidth, picHeight, 16, 16);
 
-  m_hashMap.generateBlockHashValue(picWidth, picHeight, 32, 32, blockHashValues[1], blockHashValues[0], bIsBlockSame[1], bIsBlockSame[0]);//32x32
+  m_hashMap.generateBlockHashValue(picWidth, picHeight, 32, 32, blockHashValues[1], blockHashValues[0], bIsBlockSame[1], bIsBlockSame[0], numThreads);//32x32
   m_hashMap.addToHashMapByRowWithPrecalData(blockHashValues[0], bIsBlockSame[0][2], picWidth, picHeight, 32, 32);
 
-  m_hashMap.generateBlockHashValue(picWidth, picHeight, 64, 64, blockHashValues[0], blockHashValues[1], bIsBlockSame[0], bIsBlockSame[1]);//64x64
+  m_hashMap.generateBlockHashValue(picWidth, picHeight, 64, 64, blockHashValues[0], blockHashValues[1], bIsBlockSame[0], bIsBlockSame[1], numThreads);//64x64
   m_hashMap.addToHashMapByRowWithPrecalData(blockHashValues[1], bIsBlockSame[1][2], picWidth, picHeight, 64, 64);
 
   m_hashMap.setInitial();
@@ -100,6 +100,7 @@ struct Picture : public UnitArea
   Picture();
 
   void create( const ChromaFormat &_chromaFormat, const Size &size, const unsigned _maxCUSize, const unsigned margin, const bool bDecoder, const int layerId );
+  static unsigned getPicMargin( const SPS &sps );
   void destroy();
 
   void createTempBuffers( const unsigned _maxCUSize );
@@ -144,7 +145,7 @@ struct Picture : public UnitArea
          PelUnitBuf getBuf(const UnitArea &unit,     const PictureType &type);
   const CPelUnitBuf getBuf(const UnitArea &unit,     const PictureType &type) const;
 
-  void extendPicBorder( const PPS *pps );
+  void extendPicBorder( const PPS *pps, const int numThreads = 1 );
   void extendWrapBorder( const PPS *pps );
   void finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps );
 
@@ -169,13 +170,13 @@ struct Picture : public UnitArea
                                 const CPelBuf& beforeScale, const int beforeScaleLeftOffset, const int beforeScaleTopOffset,
                                 const PelBuf& afterScale, const int afterScaleLeftOffset, const int afterScaleTopOffset,
                                 const int bitDepth, const bool useLumaFilter, const bool downsampling,
-                                const bool horCollocatedPositionFlag, const bool verCollocatedPositionFlag );
+                                const bool horCollocatedPositionFlag, const bool verCollocatedPositionFlag, const int numThreads = 1 );
 
   static void   rescalePicture( const std::pair<int, int> scalingRatio,
                                 const CPelUnitBuf& beforeScaling, const Window& scalingWindowBefore,
                                 const PelUnitBuf& afterScaling, const Window& scalingWindowAfter,
                                 const ChromaFormat chromaFormatIDC, const BitDepths& bitDepths, const bool useLumaFilter, const bool downsampling,
-                                const bool horCollocatedChromaFlag, const bool verCollocatedChromaFlag );
+                                const bool horCollocatedChromaFlag, const bool verCollocatedChromaFlag, const int numThreads = 1 );
 
 private:
   Window        m_conformanceWindow;
@@ -244,7 +245,7 @@ public:
   TComHash           m_hashMap;
   TComHash*          getHashMap() { return &m_hashMap; }
   const TComHash*    getHashMap() const { return &m_hashMap; }
-  void               addPictureToHashMapForInter();
+  void               addPictureToHashMapForInter( int numThreads = 1 );
 
   CodingStructure*   cs;
   std::deque<Slice*> slices;
@@ -300,6 +301,8 @@ public:
 
   std::vector<SAOBlkParam> m_sao[2];
 
+  std::vector<uint8_t>    m_cuHistory;                          ///< encoder: depth and skip flag of the final luma CUs on an 8x8 grid, see CuHistoryCtrl
+
   std::vector<uint8_t> m_alfCtuEnableFlag[MAX_NUM_COMPONENT];
   uint8_t* getAlfCtuEnableFlag( int compIdx ) { return m_alfCtuEnableFlag[compIdx].data(); }
   std::vector<uint8_t>* getAlfCtuEnableFlag() { return m_alfCtuEnableFlag; }
@@ -133,6 +133,16 @@ QpParam::QpParam(const TransformUnit& tu, const ComponentID &compIDX, const int
 Quant::Quant( const Quant* other )
 {
   xInitScalingList( other );
+
+  m_dequantBlk  = dequantCore;
+  m_quantBlk    = quantCore;
+  m_isZeroQuant = isZeroQuantCore;
+
+#if ENABLE_SIMD_OPT_QUANT
+#ifdef TARGET_SIMD_X86
+  initQuantX86();
+#endif
+#endif
 }
 
 Quant::~Quant()
@@ -417,30 +427,7 @@ void Quant::dequant(const TransformUnit &tu,
     const uint32_t uiLog2TrHeight = floorLog2(uiHeight);
     int *piDequantCoef        = getDequantCoeff(scalingListType, QP_rem, uiLog2TrWidth, uiLog2TrHeight);
 
-    if(rightShift > 0)
-    {
-      const Intermediate_Int iAdd = (Intermediate_Int) 1 << (rightShift - 1);
-
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = ((Intermediate_Int(clipQCoef) * piDequantCoef[n]) + iAdd ) >> rightShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
-    else
-    {
-      const int leftShift = -rightShift;
-
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * piDequantCoef[n]) << leftShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
+    m_dequantBlk( piQCoef, piCoef, numSamplesInBlock, 0, piDequantCoef, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
   }
   else
   {
@@ -454,31 +441,72 @@ void Quant::dequant(const TransformUnit &tu,
     const Intermediate_Int inputMinimum        = -(1 << (targetInputBitDepth - 1));
     const Intermediate_Int inputMaximum        =  (1 << (targetInputBitDepth - 1)) - 1;
 
-    if (rightShift > 0)
-    {
-      const Intermediate_Int iAdd = (Intermediate_Int) 1 << (rightShift - 1);
+    m_dequantBlk( piQCoef, piCoef, numSamplesInBlock, scale, nullptr, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
+  }
+}
 
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale + iAdd) >> rightShift;
+void Quant::dequantCore( const TCoeff* src, TCoeff* dst, const int numCoeff, const int scale, const int* scales, const int rightShift, const TCoeff inputMin, const TCoeff inputMax, const TCoeff outputMin, const TCoeff outputMax )
+{
+  if( rightShift > 0 )
+  {
+    const Intermediate_Int iAdd = ( Intermediate_Int ) 1 << ( rightShift - 1 );
 
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
+    for( int n = 0; n < numCoeff; n++ )
+    {
+      const TCoeff           clipQCoef = TCoeff( Clip3<Intermediate_Int>( inputMin, inputMax, src[n] ) );
+      const Intermediate_Int iCoeffQ   = ( ( Intermediate_Int( clipQCoef ) * ( scales ? scales[n] : scale ) ) + iAdd ) >> rightShift;
+
+      dst[n] = TCoeff( Clip3<Intermediate_Int>( outputMin, outputMax, iCoeffQ ) );
     }
-    else
+  }
+  else
+  {
+    const int leftShift = -rightShift;
+
+    for( int n = 0; n < numCoeff; n++ )
     {
-      const int leftShift = -rightShift;
+      const TCoeff           clipQCoef = TCoeff( Clip3<Intermediate_Int>( inputMin, inputMax, src[n] ) );
+      const Intermediate_Int iCoeffQ   = ( Intermediate_Int( clipQCoef ) * ( scales ? scales[n] : scale ) ) << leftShift;
 
-      for( int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale) << leftShift;
+      dst[n] = TCoeff( Clip3<Intermediate_Int>( outputMin, outputMax, iCoeffQ ) );
+    }
+  }
+}
+
+TCoeff Quant::quantCore( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int numCoeff, const int scale, const int* scales, const int64_t add, const int qBits, const TCoeff outputMin, const TCoeff outputMax )
+{
+  const int qBits8 = qBits - 8;
+  TCoeff    absSum = 0;
+
+  for( int n = 0; n < numCoeff; n++ )
+  {
+    const TCoeff  level    = src[n];
+    const int64_t tmpLevel = ( int64_t ) abs( level ) * ( scales ? scales[n] : scale );
+
+    const TCoeff quantisedMagnitude = TCoeff( ( tmpLevel + add ) >> qBits );
+    deltaU[n] = ( TCoeff ) ( ( tmpLevel - ( ( int64_t ) quantisedMagnitude << qBits ) ) >> qBits8 );
+
+    absSum += quantisedMagnitude;
+    dst[n]  = Clip3<TCoeff>( outputMin, outputMax, level < 0 ? -quantisedMagnitude : quantisedMagnitude );
+  }
 
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
+  return absSum;
+}
+
+bool Quant::isZeroQuantCore( const TCoeff* src, const int stride, const int width, const int height, const int scale, const int* scales, const int64_t threshold )
+{
+  for( int y = 0; y < height; y++, src += stride )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      if( ( int64_t ) abs( src[x] ) * ( scales ? scales[y * stride + x] : scale ) >= threshold )
+      {
+        return false;
       }
     }
   }
+
+  return true;
 }
 
 void Quant::init( uint32_t uiMaxTrSize,
@@ -1004,6 +1032,12 @@ void Quant::quant(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf
     const int maxNumberOfCoeffs = lfnstIdx > 0 ? ((( uiWidth == 4 && uiHeight == 4 ) || ( uiWidth == 8 && uiHeight == 8) ) ? 8 : 16) : piQCoef.area();
     memset( piQCoef.buf, 0, sizeof(TCoeff) * piQCoef.area() );
 
+    if( maxNumberOfCoeffs == piQCoef.area() )
+    {
+      uiAbsSum += m_quantBlk( piCoef.buf, piQCoef.buf, deltaU, maxNumberOfCoeffs, defaultQuantisationCoefficient, enableScalingLists ? piQuantCoeff : nullptr, iAdd, iQBits, entropyCodingMinimum, entropyCodingMaximum );
+    }
+    else
+    {
     const ScanElement* scan = g_scanOrder[SCAN_GROUPED_4x4][SCAN_DIAG][gp_sizeIdxInfo->idxFrom(uiWidth)][gp_sizeIdxInfo->idxFrom(uiHeight)];
 
     for (int uiScanPos = 0; uiScanPos < maxNumberOfCoeffs; uiScanPos++)
@@ -1022,6 +1056,7 @@ void Quant::quant(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf
 
       piQCoef.buf[uiBlockPos] = Clip3<TCoeff>( entropyCodingMinimum, entropyCodingMaximum, quantisedCoefficient );
     } // for n
+    }
     if ((tu.cu->bdpcmMode && isLuma(compID)) || (tu.cu->bdpcmModeChroma && isChroma(compID)) )
     {
       fwdResDPCM( tu, compID );
@@ -1084,18 +1119,10 @@ bool Quant::xNeedRDOQ(TransformUnit &tu, const ComponentID &compID, const CCoeff
   // iAdd is different from the iAdd used in normal quantization
   const int64_t iAdd = int64_t(compID == COMPONENT_Y ? 171 : 256) << (iQBits - 9);
 
-  for (int uiBlockPos = 0; uiBlockPos < rect.area(); uiBlockPos++)
-  {
-    const TCoeff iLevel   = piCoef.buf[uiBlockPos];
-    const int64_t  tmpLevel = (int64_t)abs(iLevel) * (enableScalingLists ? piQuantCoeff[uiBlockPos] : defaultQuantisationCoefficient);
-    const TCoeff quantisedMagnitude = TCoeff((tmpLevel + iAdd ) >> iQBits);
+  // a level is non-zero when (tmpLevel + iAdd) >> iQBits != 0, i.e. tmpLevel >= (1 << iQBits) - iAdd
+  const int64_t threshold = ( int64_t( 1 ) << iQBits ) - iAdd;
 
-    if (quantisedMagnitude != 0)
-    {
-      return true;
-    }
-  } // for n
-  return false;
+  return !m_isZeroQuant( piCoef.buf, uiWidth, uiWidth, uiHeight, defaultQuantisationCoefficient, enableScalingLists ? piQuantCoeff : nullptr, threshold );
 }
 
 
@@ -150,6 +150,24 @@ public:
   virtual void copyState         ( const Quant& other );
 #endif
 
+  // block kernels working in raster order, the per coefficient scales are used instead of scale when not null
+  static void   dequantCore      ( const TCoeff* src, TCoeff* dst, const int numCoeff, const int scale, const int* scales, const int rightShift, const TCoeff inputMin, const TCoeff inputMax, const TCoeff outputMin, const TCoeff outputMax );
+  static TCoeff quantCore        ( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int numCoeff, const int scale, const int* scales, const int64_t add, const int qBits, const TCoeff outputMin, const TCoeff outputMax );
+  static bool   isZeroQuantCore  ( const TCoeff* src, const int stride, const int width, const int height, const int scale, const int* scales, const int64_t threshold );
+
+  /// dequantization of a block, including the clipping of the input and output values
+  void   ( *m_dequantBlk  )( const TCoeff* src, TCoeff* dst, const int numCoeff, const int scale, const int* scales, const int rightShift, const TCoeff inputMin, const TCoeff inputMax, const TCoeff outputMin, const TCoeff outputMax );
+  /// quantization of a block, returns the sum of the absolute levels
+  TCoeff ( *m_quantBlk    )( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int numCoeff, const int scale, const int* scales, const int64_t add, const int qBits, const TCoeff outputMin, const TCoeff outputMax );
+  /// returns true when abs( coeff ) * scale is below the threshold for all coefficients of the width x height area
+  bool   ( *m_isZeroQuant )( const TCoeff* src, const int stride, const int width, const int height, const int scale, const int* scales, const int64_t threshold );
+
+#ifdef TARGET_SIMD_X86
+  void initQuantX86();
+  template <X86_VEXT vext>
+  void _initQuantX86();
+#endif
+
 protected:
 
 #if T0196_SELECTIVE_RDOQ
@@ -667,6 +667,13 @@ void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
 
   const uint32_t lfnstIdx = tu.cu->lfnstIdx;
 
+  // no level of the scanned area rounds up to one: the last position search below would not find any
+  if( lfnstIdx == 0 && m_isZeroQuant( plSrcCoeff, uiWidth, std::min<int>( JVET_C0024_ZERO_OUT_TH, uiWidth ), std::min<int>( JVET_C0024_ZERO_OUT_TH, uiHeight ),
+                                      defaultQuantisationCoefficient, enableScalingLists ? piQCoef : nullptr, int64_t( 1 ) << ( iQBits - 1 ) ) )
+  {
+    return;
+  }
+
   const int iCGNum = lfnstIdx > 0 ? 1 : std::min<int>(JVET_C0024_ZERO_OUT_TH, uiWidth) * std::min<int>(JVET_C0024_ZERO_OUT_TH, uiHeight) >> cctx.log2CGSize();
 
   for (int subSetId = iCGNum - 1; subSetId >= 0; subSetId--)
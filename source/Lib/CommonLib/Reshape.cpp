@@ -38,6 +38,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <limits>
 #include <UnitTools.h>
  //! \ingroup CommonLib
  //! \{
@@ -160,23 +161,29 @@ int  Reshape::calculateChromaAdjVpduNei(TransformUnit &tu, const CompArea &areaY
     const Pel   valueDC = 1 << (tu.cs->sps->getBitDepth(CHANNEL_TYPE_LUMA) - 1);
     int32_t recLuma = 0;
     int pelnum = 0;
+    // neighbors beyond the picture boundary repeat the last one inside of the picture
     if (cuLeft != nullptr)
     {
-      for (int i = 0; i < numNeighbor; i++)
+      const int numInPic = std::min<int>(numNeighbor, picH - yPos);
+      const Pel* recLeft = recSrc0 - 1;
+      for (int i = 0; i < numInPic; i++)
       {
-        int k = (yPos + i) >= picH ? (picH - yPos - 1) : i;
-        recLuma += recSrc0[-1 + k * strideY];
-        pelnum++;
+        recLuma += recLeft[i * strideY];
       }
+      recLuma += (numNeighbor - numInPic) * recLeft[(numInPic - 1) * strideY];
+      pelnum += numNeighbor;
     }
     if (cuAbove != nullptr)
     {
-      for (int i = 0; i < numNeighbor; i++)
+      // contiguous row, summed without the per-sample boundary check so that it is vectorized
+      const int numInPic = std::min<int>(numNeighbor, picW - xPos);
+      const Pel* recAbove = recSrc0 - strideY;
+      for (int i = 0; i < numInPic; i++)
       {
-        int k = (xPos + i) >= picW ? (picW - xPos - 1) : i;
-        recLuma += recSrc0[-strideY + k];
-        pelnum++;
+        recLuma += recAbove[i];
       }
+      recLuma += (numNeighbor - numInPic) * recAbove[numInPic - 1];
+      pelnum += numNeighbor;
     }
     if (pelnum == numNeighbor)
     {
@@ -275,8 +282,35 @@ void Reshape::constructReshaper()
     int invSample = m_inputPivot[idxYInv] + ((m_invScaleCoef[idxYInv] * (lumaSample - m_reshapePivot[idxYInv]) + (1 << (FP_PREC - 1))) >> FP_PREC);
     m_invLUT[lumaSample] = Clip3((Pel)0, (Pel)((1 << m_lumaBD) - 1), (Pel)(invSample));
   }
+  updateLutPwl();
 }
 
+/** derive the piecewise linear description of the forward mapping table from the reshaper model, which allows the
+    vectorized mapping to evaluate the segments instead of reading the table; the inverse mapping has segments of
+    different lengths, which are more expensive to find than reading its table
+ */
+void Reshape::updateLutPwl()
+{
+  m_fwdLUT.pwlValid   = true;
+  m_fwdLUT.log2SegLen = floorLog2( m_initCW );
+  m_fwdLUT.maxVal     = ( 1 << m_lumaBD ) - 1;
+
+  for( int i = 0; i < PIC_CODE_CW_BINS; i++ )
+  {
+    m_fwdLUT.outBase[i] = m_reshapePivot[i];
+    m_fwdLUT.slope  [i] = (int16_t) m_fwdScaleCoef[i];
+    m_fwdLUT.pwlValid  &= m_inputPivot[i] == i * m_initCW && m_fwdScaleCoef[i] <= std::numeric_limits<int16_t>::max();
+  }
+
+  // the segments have to reproduce every entry of the table, otherwise the table is used
+  for( int x = 0; x < (int) m_fwdLUT.size() && m_fwdLUT.pwlValid; x++ )
+  {
+    const int idx = x >> m_fwdLUT.log2SegLen;
+    const int val = m_fwdLUT.outBase[idx] + ( ( m_fwdLUT.slope[idx] * ( x & ( m_initCW - 1 ) ) + ( 1 << ( FP_PREC - 1 ) ) ) >> FP_PREC );
+    m_fwdLUT.pwlValid = Clip3( 0, (int) m_fwdLUT.maxVal, val ) == m_fwdLUT[x];
+  }
+  m_invLUT.pwlValid = false;
+}
 
 
 //
@@ -57,8 +57,8 @@ protected:
   SliceReshapeInfo        m_sliceReshapeInfo;
   bool                    m_CTUFlag;
   bool                    m_recReshaped;
-  std::vector<Pel>        m_invLUT;
-  std::vector<Pel>        m_fwdLUT;
+  ReshapeLUT              m_invLUT;
+  ReshapeLUT              m_fwdLUT;
   std::vector<int>        m_chromaAdjHelpLUT;
   std::vector<uint16_t>   m_binCW;
   uint16_t                m_initCW;
@@ -83,8 +83,8 @@ public:
   void createDec(int bitDepth);
   void destroy();
 
-  std::vector<Pel>&  getFwdLUT() { return m_fwdLUT; }
-  std::vector<Pel>&  getInvLUT() { return m_invLUT; }
+  ReshapeLUT&        getFwdLUT() { return m_fwdLUT; }
+  ReshapeLUT&        getInvLUT() { return m_invLUT; }
   std::vector<int>&  getChromaAdjHelpLUT() { return m_chromaAdjHelpLUT; }
 
   bool getCTUFlag()              { return m_CTUFlag; }
@@ -98,6 +98,7 @@ public:
   void copySliceReshaperInfo(SliceReshapeInfo& tInfo, SliceReshapeInfo& sInfo);
 
   void constructReshaper();
+  void updateLutPwl();
   bool getReshapeFlag() { return m_reshape; }
   void setReshapeFlag(bool b) { m_reshape = b; }
   int  calculateChromaAdjVpduNei(TransformUnit &tu, const CompArea &areaY);
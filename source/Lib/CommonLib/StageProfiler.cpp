@@ -0,0 +1,320 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     StageProfiler.cpp
+    \brief    runtime-enabled per-stage timers and counters
+*/
+
+#include "StageProfiler.h"
+
+#if ENABLE_STAGE_PROFILING
+
+#include <fstream>
+#include <iomanip>
+#include <map>
+
+//! \ingroup CommonLib
+//! \{
+
+bool          StageProfiler::s_enabled = false;
+StageProfiler g_stageProfiler;
+
+StageProfiler::StageProfiler()
+  : m_inPicture( false )
+{
+  for( int i = 0; i < NUM_PROF_STAGES; i++ )
+  {
+    m_pending[i].calls = 0;
+    m_pending[i].time  = 0;
+  }
+}
+
+const char* StageProfiler::getStageName( ProfilingStage stage )
+{
+  static const char *stageNames[] =
+  {
+    "cu_intra",
+    "cu_inter",
+    "cu_hash_inter",
+    "cu_merge",
+    "cu_geo",
+    "cu_affine",
+    "cu_ibc",
+    "cu_ibc_merge",
+    "cu_plt",
+    "intra_search",
+    "inter_me",
+    "affine_me",
+    "transform",
+    "quant",
+    "ctu_parse",
+    "ctu_recon",
+    "lmcs",
+    "deblock",
+    "sao",
+    "alf",
+    "temporal_filter",
+    "metrics",
+    "input",
+    "output",
+  };
+  CHECK( NUM_PROF_STAGES != sizeof( stageNames ) / sizeof( char* ) || stage >= NUM_PROF_STAGES, "stage out of range" );
+  return stageNames[stage];
+}
+
+void StageProfiler::xFlushPending( StageStat* dst )
+{
+  for( int i = 0; i < NUM_PROF_STAGES; i++ )
+  {
+    StageStat stat;
+    stat.calls = m_pending[i].calls.exchange( 0, std::memory_order_relaxed );
+    stat.time  = m_pending[i].time .exchange( 0, std::memory_order_relaxed );
+
+    m_sequence[i] += stat;
+    if( dst )
+    {
+      dst[i] += stat;
+    }
+  }
+}
+
+void StageProfiler::beginPicture( int layerId, int poc )
+{
+  if( !s_enabled )
+  {
+    return;
+  }
+
+  // stages measured since the last completed picture only count for the sequence
+  xFlushPending( nullptr );
+
+  m_current = PictureRecord();
+  m_current.layerId     = layerId;
+  m_current.poc         = poc;
+  m_current.temporalId  = 0;
+  m_current.sliceType   = '-';
+  m_current.numPictures = 1;
+  m_current.totalTime   = 0;
+  m_inPicture           = true;
+  m_pictureStart        = std::chrono::steady_clock::now();
+}
+
+void StageProfiler::endPicture( int temporalId, SliceType sliceType )
+{
+  if( !s_enabled || !m_inPicture )
+  {
+    return;
+  }
+
+  xFlushPending( m_current.stages );
+
+  const auto elapsed = std::chrono::steady_clock::now() - m_pictureStart;
+  m_current.totalTime  = std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count();
+  m_current.temporalId = temporalId;
+  m_current.sliceType  = sliceType == I_SLICE ? 'I' : sliceType == P_SLICE ? 'P' : 'B';
+  m_pictures.push_back( m_current );
+  m_inPicture = false;
+}
+
+void StageProfiler::finish()
+{
+  if( !s_enabled )
+  {
+    return;
+  }
+
+  xFlushPending( m_inPicture ? m_current.stages : nullptr );
+}
+
+void StageProfiler::xGetLayerStats( std::vector<PictureRecord>& layers ) const
+{
+  std::map<std::pair<int, int>, PictureRecord> layerMap;
+
+  for( const PictureRecord& pic : m_pictures )
+  {
+    auto it = layerMap.find( std::make_pair( pic.layerId, pic.temporalId ) );
+    if( it == layerMap.end() )
+    {
+      PictureRecord rec;
+      rec.layerId    = pic.layerId;
+      rec.poc         = -1;
+      rec.temporalId  = pic.temporalId;
+      rec.sliceType   = '-';
+      rec.numPictures = 0;
+      rec.totalTime   = 0;
+      it = layerMap.insert( std::make_pair( std::make_pair( pic.layerId, pic.temporalId ), rec ) ).first;
+    }
+
+    PictureRecord& rec = it->second;
+    rec.numPictures++;
+    rec.totalTime += pic.totalTime;
+    for( int i = 0; i < NUM_PROF_STAGES; i++ )
+    {
+      rec.stages[i] += pic.stages[i];
+    }
+  }
+
+  layers.clear();
+  for( auto& entry : layerMap )
+  {
+    layers.push_back( entry.second );
+  }
+}
+
+static inline double toMs( int64_t ns )
+{
+  return ns / 1000000.0;
+}
+
+void StageProfiler::writeCsv( std::ostream& os ) const
+{
+  os << "scope,layer_id,poc,ctu_addr,temporal_id,slice_type,num_pictures,stage,calls,time_ms\n";
+  os << std::fixed << std::setprecision( 3 );
+
+  for( const PictureRecord& pic : m_pictures )
+  {
+    os << "picture," << pic.layerId << "," << pic.poc << ",-," << pic.temporalId << "," << pic.sliceType << ",1,total,1," << toMs( pic.totalTime ) << "\n";
+    for( int i = 0; i < NUM_PROF_STAGES; i++ )
+    {
+      if( pic.stages[i].calls )
+      {
+        os << "picture," << pic.layerId << "," << pic.poc << ",-," << pic.temporalId << "," << pic.sliceType << ",1," << getStageName( ProfilingStage( i ) ) << "," << pic.stages[i].calls << "," << toMs( pic.stages[i].time ) << "\n";
+      }
+    }
+    for( const CtuRecord& ctu : pic.ctus )
+    {
+      os << "ctu," << pic.layerId << "," << pic.poc << "," << ctu.ctuRsAddr << "," << pic.temporalId << "," << pic.sliceType << ",1," << getStageName( ctu.stage ) << ",1," << toMs( ctu.time ) << "\n";
+    }
+  }
+
+  std::vector<PictureRecord> layers;
+  xGetLayerStats( layers );
+  for( const PictureRecord& tl : layers )
+  {
+    os << "temporal_layer," << tl.layerId << ",-,-," << tl.temporalId << ",-," << tl.numPictures << ",total," << tl.numPictures << "," << toMs( tl.totalTime ) << "\n";
+    for( int i = 0; i < NUM_PROF_STAGES; i++ )
+    {
+      if( tl.stages[i].calls )
+      {
+        os << "temporal_layer," << tl.layerId << ",-,-," << tl.temporalId << ",-," << tl.numPictures << "," << getStageName( ProfilingStage( i ) ) << "," << tl.stages[i].calls << "," << toMs( tl.stages[i].time ) << "\n";
+      }
+    }
+  }
+
+  for( int i = 0; i < NUM_PROF_STAGES; i++ )
+  {
+    if( m_sequence[i].calls )
+    {
+      os << "sequence,-,-,-,-,-," << m_pictures.size() << "," << getStageName( ProfilingStage( i ) ) << "," << m_sequence[i].calls << "," << toMs( m_sequence[i].time ) << "\n";
+    }
+  }
+}
+
+static void writeJsonStages( std::ostream& os, const StageProfiler::StageStat* stages )
+{
+  os << "\"stages\": {";
+  bool first = true;
+  for( int i = 0; i < NUM_PROF_STAGES; i++ )
+  {
+    if( stages[i].calls )
+    {
+      os << ( first ? " " : ", " ) << "\"" << StageProfiler::getStageName( ProfilingStage( i ) ) << "\": { \"calls\": " << stages[i].calls << ", \"time_ms\": " << toMs( stages[i].time ) << " }";
+      first = false;
+    }
+  }
+  os << " }";
+}
+
+void StageProfiler::writeJson( std::ostream& os ) const
+{
+  os << std::fixed << std::setprecision( 3 );
+  os << "{\n  \"pictures\": [";
+  for( size_t n = 0; n < m_pictures.size(); n++ )
+  {
+    const PictureRecord& pic = m_pictures[n];
+    os << ( n ? ",\n" : "\n" ) << "    { \"layer_id\": " << pic.layerId << ", \"poc\": " << pic.poc << ", \"temporal_id\": " << pic.temporalId
+       << ", \"slice_type\": \"" << pic.sliceType << "\", \"total_ms\": " << toMs( pic.totalTime ) << ", ";
+    writeJsonStages( os, pic.stages );
+    if( !pic.ctus.empty() )
+    {
+      os << ", \"ctus\": [";
+      for( size_t c = 0; c < pic.ctus.size(); c++ )
+      {
+        const CtuRecord& ctu = pic.ctus[c];
+        os << ( c ? ", " : " " ) << "{ \"ctu_addr\": " << ctu.ctuRsAddr << ", \"stage\": \"" << getStageName( ctu.stage ) << "\", \"time_ms\": " << toMs( ctu.time ) << " }";
+      }
+      os << " ]";
+    }
+    os << " }";
+  }
+  os << "\n  ],\n  \"temporal_layers\": [";
+
+  std::vector<PictureRecord> layers;
+  xGetLayerStats( layers );
+  for( size_t n = 0; n < layers.size(); n++ )
+  {
+    const PictureRecord& tl = layers[n];
+    os << ( n ? ",\n" : "\n" ) << "    { \"layer_id\": " << tl.layerId << ", \"temporal_id\": " << tl.temporalId << ", \"num_pictures\": " << tl.numPictures
+       << ", \"total_ms\": " << toMs( tl.totalTime ) << ", ";
+    writeJsonStages( os, tl.stages );
+    os << " }";
+  }
+  os << "\n  ],\n  \"sequence\": { \"num_pictures\": " << m_pictures.size() << ", ";
+  writeJsonStages( os, m_sequence );
+  os << " }\n}\n";
+}
+
+bool StageProfiler::writeFile( const std::string& fileName ) const
+{
+  std::ofstream os( fileName );
+  if( !os.is_open() )
+  {
+    return false;
+  }
+
+  const bool json = fileName.size() >= 5 && fileName.compare( fileName.size() - 5, 5, ".json" ) == 0;
+  if( json )
+  {
+    writeJson( os );
+  }
+  else
+  {
+    writeCsv( os );
+  }
+  return os.good();
+}
+
+//! \}
+
+#endif // ENABLE_STAGE_PROFILING
@@ -0,0 +1,213 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     StageProfiler.h
+    \brief    runtime-enabled per-stage timers and counters (header)
+*/
+
+#ifndef __STAGEPROFILER__
+#define __STAGEPROFILER__
+
+#include "CommonDef.h"
+
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+// function list
+#if !ENABLE_STAGE_PROFILING
+#define PROFILE_STAGE( stage )                         /* do nothing */
+#define PROFILE_CTU_STAGE( stage, ctuRsAddr )          /* do nothing */
+#else
+#define PROFILE_STAGE( stage )                         StageTimer stageTimer_( stage )
+#define PROFILE_CTU_STAGE( stage, ctuRsAddr )          StageTimer stageTimer_( stage, ctuRsAddr )
+
+/// profiled stages; time of nested stages is also contained in the time of the enclosing stage
+enum ProfilingStage
+{
+  PROF_CU_INTRA = 0,      ///< EncCu::xCheckRDCostIntra
+  PROF_CU_INTER,          ///< EncCu::xCheckRDCostInter, xCheckRDCostInterIMV
+  PROF_CU_HASH_INTER,     ///< EncCu::xCheckRDCostHashInter
+  PROF_CU_MERGE,          ///< EncCu::xCheckRDCostMerge2Nx2N
+  PROF_CU_GEO,            ///< EncCu::xCheckRDCostMergeGeo2Nx2N
+  PROF_CU_AFFINE,         ///< EncCu::xCheckRDCostAffineMerge2Nx2N
+  PROF_CU_IBC,            ///< EncCu::xCheckRDCostIBCMode
+  PROF_CU_IBC_MERGE,      ///< EncCu::xCheckRDCostIBCModeMerge2Nx2N
+  PROF_CU_PLT,            ///< EncCu::xCheckPLT
+  PROF_INTRA_SEARCH,      ///< IntraSearch::estIntraPredLumaQT, estIntraPredChromaQT
+  PROF_INTER_ME,          ///< InterSearch::xMotionEstimation
+  PROF_AFFINE_ME,         ///< InterSearch::xAffineMotionEstimation
+  PROF_TRANSFORM,         ///< TrQuant forward and inverse transforms
+  PROF_QUANT,             ///< TrQuant quantization and dequantization (incl. RDOQ and DepQuant)
+  PROF_CTU_PARSE,         ///< DecSlice: CABAC parsing of a CTU
+  PROF_CTU_RECON,         ///< DecSlice: prediction and reconstruction of a CTU
+  PROF_LMCS,              ///< inverse luma mapping of the reconstructed picture before the in-loop filters
+  PROF_DEBLOCK,           ///< deblocking filter
+  PROF_SAO,               ///< SAO parameter estimation and filtering
+  PROF_ALF,               ///< ALF/CC-ALF parameter estimation and filtering
+  PROF_TEMPORAL_FILTER,   ///< GOP based temporal filter
+  PROF_METRICS,           ///< PSNR/MSE computation of the reconstructed picture
+  PROF_INPUT,             ///< reading of YUV files
+  PROF_OUTPUT,            ///< writing of YUV files and of the bitstream
+  NUM_PROF_STAGES
+};
+
+class StageProfiler
+{
+public:
+  struct StageStat
+  {
+    StageStat() : calls( 0 ), time( 0 ) { }
+
+    int64_t calls;
+    int64_t time;   ///< nanoseconds
+
+    StageStat &operator+=( const StageStat &src ) { calls += src.calls; time += src.time; return *this; }
+  };
+
+  struct CtuRecord
+  {
+    int            ctuRsAddr;
+    ProfilingStage stage;
+    int64_t        time;   ///< nanoseconds
+  };
+
+  struct PictureRecord
+  {
+    int       layerId;
+    int       poc;
+    int       temporalId;
+    char      sliceType;
+    int       numPictures;
+    int64_t   totalTime;   ///< nanoseconds between beginPicture and endPicture
+    StageStat stages[NUM_PROF_STAGES];
+    std::vector<CtuRecord> ctus;   ///< per-CTU times, in order of measurement
+  };
+
+  StageProfiler();
+
+  static bool isEnabled()                                  { return s_enabled; }
+  static void setEnabled( bool enabled )                   { s_enabled = enabled; }
+
+  static const char* getStageName( ProfilingStage stage );
+
+  void beginPicture ( int layerId, int poc );
+  void endPicture   ( int temporalId, SliceType sliceType );
+  void finish       ();
+
+  void addTime( ProfilingStage stage, int64_t time )
+  {
+    m_pending[stage].calls.fetch_add( 1,    std::memory_order_relaxed );
+    m_pending[stage].time .fetch_add( time, std::memory_order_relaxed );
+  }
+
+  /// records a per-CTU time of the current picture; not thread-safe, the decoder processes CTUs sequentially
+  void addCtuTime( int ctuRsAddr, ProfilingStage stage, int64_t time )
+  {
+    if( m_inPicture )
+    {
+      m_current.ctus.push_back( CtuRecord{ ctuRsAddr, stage, time } );
+    }
+  }
+
+  const std::vector<PictureRecord>& getPictures() const    { return m_pictures; }
+
+  void writeCsv ( std::ostream& os ) const;
+  void writeJson( std::ostream& os ) const;
+  bool writeFile( const std::string& fileName ) const;
+
+private:
+  struct PendingStat
+  {
+    std::atomic<int64_t> calls;
+    std::atomic<int64_t> time;
+  };
+
+  void xFlushPending( StageStat* dst );
+  void xGetLayerStats( std::vector<PictureRecord>& layers ) const;
+
+  static bool                  s_enabled;
+
+  PendingStat                  m_pending[NUM_PROF_STAGES];
+  bool                         m_inPicture;
+  PictureRecord                m_current;
+  std::chrono::steady_clock::time_point m_pictureStart;
+  std::vector<PictureRecord>   m_pictures;
+  StageStat                    m_sequence[NUM_PROF_STAGES];   ///< all stages, including those outside of any picture
+};
+
+extern StageProfiler g_stageProfiler;
+
+/// scoped timer adding the elapsed time to a stage of the global profiler, and to a CTU when ctuRsAddr is given
+class StageTimer
+{
+public:
+  StageTimer( ProfilingStage stage, int ctuRsAddr = -1 ) : m_stage( stage ), m_ctuRsAddr( ctuRsAddr ), m_active( StageProfiler::isEnabled() )
+  {
+    if( m_active )
+    {
+      m_start = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~StageTimer()
+  {
+    if( m_active )
+    {
+      const auto    elapsed = std::chrono::steady_clock::now() - m_start;
+      const int64_t time    = std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count();
+      g_stageProfiler.addTime( m_stage, time );
+      if( m_ctuRsAddr >= 0 )
+      {
+        g_stageProfiler.addCtuTime( m_ctuRsAddr, m_stage, time );
+      }
+    }
+  }
+
+private:
+  ProfilingStage                        m_stage;
+  int                                   m_ctuRsAddr;
+  bool                                  m_active;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+#endif // ENABLE_STAGE_PROFILING
+
+//! \}
+
+#endif // __STAGEPROFILER__
@@ -45,6 +45,7 @@
 
 
 #include "dtrace_buffer.h"
+#include "StageProfiler.h"
 
 #include <stdlib.h>
 #include <limits>
@@ -180,6 +181,15 @@ TrQuant::TrQuant() : m_quant( nullptr )
     m_fwdICT[ 3]  = fwdTransformCbCr< 3>;
     m_fwdICT[-3]  = fwdTransformCbCr<-3>;
   }
+
+  m_fwdLfnst = fwdLfnstCore;
+  m_invLfnst = invLfnstCore;
+
+#if ENABLE_SIMD_OPT_LFNST
+#ifdef TARGET_SIMD_X86
+  initTrQuantX86();
+#endif
+#endif
 }
 
 TrQuant::~TrQuant()
@@ -203,6 +213,8 @@ void TrQuant::xDeQuant(const TransformUnit &tu,
                        const ComponentID   &compID,
                        const QpParam       &cQP)
 {
+  PROFILE_STAGE( PROF_QUANT );
+
   m_quant->dequant( tu, dstCoeff, compID, cQP );
 }
 
@@ -229,41 +241,52 @@ void TrQuant::init( const Quant* otherQuant,
   }
 }
 
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-void TrQuant::fwdLfnstNxN( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize )
-#else
-void TrQuant::fwdLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize )
-#endif
+void TrQuant::fwdLfnstCore( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize )
 {
-  const int8_t* trMat  = ( size > 4 ) ? g_lfnst8x8[ mode ][ index ][ 0 ] : g_lfnst4x4[ mode ][ index ][ 0 ];
-  const int     trSize = ( size > 4 ) ? 48 : 16;
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-  TCoeff           coef;
-  TCoeff*          out    = dst;
-#else
-  int           coef;
-  int*          out    = dst;
-#endif
-  assert( index < 3 );
-
   for( int j = 0; j < zeroOutSize; j++ )
   {
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-    TCoeff*          srcPtr   = src;
-#else
-    int*          srcPtr   = src;
-#endif
+    const TCoeff* srcPtr   = src;
     const int8_t* trMatTmp = trMat;
-    coef = 0;
+    TCoeff        coef     = 0;
     for( int i = 0; i < trSize; i++ )
     {
       coef += *srcPtr++ * *trMatTmp++;
     }
-    *out++ = ( coef + 64 ) >> 7;
+    *dst++ = ( coef + 64 ) >> 7;
     trMat += trSize;
   }
+}
 
-  ::memset( out, 0, ( trSize - zeroOutSize ) * sizeof( int ) );
+void TrQuant::invLfnstCore( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize, const TCoeff outputMin, const TCoeff outputMax )
+{
+  for( int j = 0; j < trSize; j++ )
+  {
+    const TCoeff* srcPtr   = src;
+    const int8_t* trMatTmp = trMat;
+    TCoeff        resi     = 0;
+    for( int i = 0; i < zeroOutSize; i++ )
+    {
+      resi += *srcPtr++ * *trMatTmp;
+      trMatTmp += trSize;
+    }
+    *dst++ = Clip3<TCoeff>( outputMin, outputMax, ( resi + 64 ) >> 7 );
+    trMat++;
+  }
+}
+
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+void TrQuant::fwdLfnstNxN( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize )
+#else
+void TrQuant::fwdLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize )
+#endif
+{
+  const int8_t* trMat  = ( size > 4 ) ? g_lfnst8x8[ mode ][ index ][ 0 ] : g_lfnst4x4[ mode ][ index ][ 0 ];
+  const int     trSize = ( size > 4 ) ? 48 : 16;
+  assert( index < 3 );
+
+  m_fwdLfnst( src, dst, trMat, trSize, zeroOutSize );
+
+  ::memset( dst + zeroOutSize, 0, ( trSize - zeroOutSize ) * sizeof( TCoeff ) );
 }
 
 #if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
@@ -278,36 +301,9 @@ void TrQuant::invLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32
   const TCoeff    outputMaximum         =  ( 1 << maxLog2TrDynamicRange ) - 1;
   const int8_t*   trMat                 =  ( size > 4 ) ? g_lfnst8x8[ mode ][ index ][ 0 ] : g_lfnst4x4[ mode ][ index ][ 0 ];
   const int       trSize                =  ( size > 4 ) ? 48 : 16;
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-  TCoeff          resi;
-  TCoeff*         out                   =  dst;
-#else
-  int             resi;
-  int*            out                   =  dst;
-#endif
   assert( index < 3 );
 
-  for( int j = 0; j < trSize; j++ )
-  {
-    resi = 0;
-    const int8_t* trMatTmp = trMat;
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-    TCoeff*       srcPtr   = src;
-#else
-    int*          srcPtr   = src;
-#endif
-    for( int i = 0; i < zeroOutSize; i++ )
-    {
-      resi += *srcPtr++ * *trMatTmp;
-      trMatTmp += trSize;
-    }
-#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
-    *out++ = Clip3<TCoeff>( outputMinimum, outputMaximum, ( resi + 64 ) >> 7 );
-#else
-    *out++ = Clip3( outputMinimum, outputMaximum, ( int ) ( resi + 64 ) >> 7 );
-#endif
-    trMat++;
-  }
+  m_invLfnst( src, dst, trMat, trSize, zeroOutSize, outputMinimum, outputMaximum );
 }
 
 uint32_t TrQuant::getLFNSTIntraMode( int wideAngPredMode )
@@ -338,6 +334,8 @@ bool TrQuant::getTransposeFlag( uint32_t intraMode )
 
 void TrQuant::xInvLfnst( const TransformUnit &tu, const ComponentID compID )
 {
+  PROFILE_STAGE( PROF_TRANSFORM );
+
 #if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
   const int maxLog2TrDynamicRange = tu.cs->sps->getMaxLog2TrDynamicRange(toChannelType(compID));
 #endif
@@ -435,6 +433,8 @@ void TrQuant::xInvLfnst( const TransformUnit &tu, const ComponentID compID )
 
 void TrQuant::xFwdLfnst( const TransformUnit &tu, const ComponentID compID, const bool loadTr )
 {
+  PROFILE_STAGE( PROF_TRANSFORM );
+
   const CompArea& area     = tu.blocks[ compID ];
   const uint32_t  width    = area.width;
   const uint32_t  height   = area.height;
@@ -775,6 +775,8 @@ void TrQuant::getTrTypes(const TransformUnit tu, const ComponentID compID, int &
 
 void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPelBuf &resi, CoeffBuf &dstCoeff, const int width, const int height )
 {
+  PROFILE_STAGE( PROF_TRANSFORM );
+
   const unsigned maxLog2TrDynamicRange  = tu.cs->sps->getMaxLog2TrDynamicRange( toChannelType( compID ) );
   const unsigned bitDepth               = tu.cs->sps->getBitDepth(              toChannelType( compID ) );
   const int      TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_FORWARD];
@@ -852,6 +854,8 @@ void TrQuant::xT( const TransformUnit &tu, const ComponentID &compID, const CPel
 
 void TrQuant::xIT( const TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pCoeff, PelBuf &pResidual )
 {
+  PROFILE_STAGE( PROF_TRANSFORM );
+
   const int      width                  = pCoeff.width;
   const int      height                 = pCoeff.height;
   const unsigned maxLog2TrDynamicRange  = tu.cs->sps->getMaxLog2TrDynamicRange( toChannelType( compID ) );
@@ -944,6 +948,8 @@ void TrQuant::xITransformSkip(const CCoeffBuf     &pCoeff,
 
 void TrQuant::xQuant(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, TCoeff &uiAbsSum, const QpParam &cQP, const Ctx& ctx)
 {
+  PROFILE_STAGE( PROF_QUANT );
+
   m_quant->quant( tu, compID, pSrc, uiAbsSum, cQP, ctx );
 }
 
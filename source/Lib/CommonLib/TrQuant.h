@@ -90,6 +90,18 @@ public:
   uint32_t getLFNSTIntraMode( int wideAngPredMode );
   bool     getTransposeFlag ( uint32_t intraMode  );
 
+  static void fwdLfnstCore( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize );
+  static void invLfnstCore( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize, const TCoeff outputMin, const TCoeff outputMax );
+
+  void ( *m_fwdLfnst )( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize );
+  void ( *m_invLfnst )( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize, const TCoeff outputMin, const TCoeff outputMax );
+
+#ifdef TARGET_SIMD_X86
+  void initTrQuantX86();
+  template <X86_VEXT vext>
+  void _initTrQuantX86();
+#endif
+
 protected:
 
   void xFwdLfnst( const TransformUnit &tu, const ComponentID compID, const bool loadTr = false );
@@ -119,6 +119,10 @@ typedef std::pair<int, int>  TrCost;
 #endif
 #endif
 
+#ifndef ENABLE_STAGE_PROFILING
+#define ENABLE_STAGE_PROFILING                            1 ///< per-stage timers and counters, only active when enabled at runtime (e.g. encoder option --ProfilingFile)
+#endif
+
 #define WCG_EXT                                           1
 #define WCG_WPSNR                                         WCG_EXT
 
@@ -188,6 +192,9 @@ typedef std::pair<int, int>  TrCost;
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
 #define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for affine ME, no impact on RD performance
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
+#define ENABLE_SIMD_OPT_IBC                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization (CRC32C) for the IBC hash map, no impact on RD performance
+#define ENABLE_SIMD_OPT_LFNST                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the LFNST matrix multiplications, no impact on RD performance
+#define ENABLE_SIMD_OPT_QUANT                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the quantization and dequantization, no impact on RD performance
 #if ENABLE_SIMD_OPT_BUFFER
 #define ENABLE_SIMD_OPT_BCW                               1                                                 ///< SIMD optimization for Bcw
 #endif
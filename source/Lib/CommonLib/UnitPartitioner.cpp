@@ -277,24 +277,24 @@ void QTBTPartitioner::splitCurrArea( const PartSplit split, const CodingStructur
   bool qgEnable = currQgEnable();
   bool qgChromaEnable = currQgChromaEnable();
 
+  // the parent area stays valid, the storage of the partitioning stack is never reallocated
+  const UnitArea &area = currArea();
+  m_partStack.push_back( PartLevel() );
+  m_partStack.back().split = split;
+  Partitioning &sub = m_partStack.back().parts;
+
   switch( split )
   {
   case CU_QUAD_SPLIT:
-    m_partStack.push_back( PartLevel( split, PartitionerImpl::getCUSubPartitions( currArea(), cs ) ) );
-    m_partStack.back().modeType = modeType;
-    break;
   case CU_HORZ_SPLIT:
   case CU_VERT_SPLIT:
-    m_partStack.push_back( PartLevel( split, PartitionerImpl::getCUSubPartitions( currArea(), cs, split ) ) );
-    m_partStack.back().modeType = modeType;
-    break;
   case CU_TRIH_SPLIT:
   case CU_TRIV_SPLIT:
-    m_partStack.push_back( PartLevel( split, PartitionerImpl::getCUSubPartitions( currArea(), cs, split ) ) );
+    PartitionerImpl::getCUSubPartitions( sub, area, cs, split );
     m_partStack.back().modeType = modeType;
     break;
   case TU_MAX_TR_SPLIT:
-    m_partStack.push_back( PartLevel( split, PartitionerImpl::getMaxTuTiling( currArea(), cs ) ) );
+    PartitionerImpl::getMaxTuTiling( sub, area, cs );
     break;
   case SBT_VER_HALF_POS0_SPLIT:
   case SBT_VER_HALF_POS1_SPLIT:
@@ -304,7 +304,7 @@ void QTBTPartitioner::splitCurrArea( const PartSplit split, const CodingStructur
   case SBT_VER_QUAD_POS1_SPLIT:
   case SBT_HOR_QUAD_POS0_SPLIT:
   case SBT_HOR_QUAD_POS1_SPLIT:
-    m_partStack.push_back( PartLevel( split, PartitionerImpl::getSbtTuTiling( currArea(), cs, split ) ) );
+    PartitionerImpl::getSbtTuTiling( sub, area, cs, split );
     break;
   default:
     THROW( "Unknown split mode" );
@@ -679,8 +679,13 @@ void TUIntraSubPartitioner::splitCurrArea( const PartSplit split, const CodingSt
       break;
     }
     case TU_MAX_TR_SPLIT: //we need this non ISP split because of the maxTrSize limitation
-      m_partStack.push_back( PartLevel( split, PartitionerImpl::getMaxTuTiling( currArea(), cs ) ) );
+    {
+      const UnitArea &area = currArea();
+      m_partStack.push_back( PartLevel() );
+      m_partStack.back().split = split;
+      PartitionerImpl::getMaxTuTiling( m_partStack.back().parts, area, cs );
       break;
+    }
     default:
       THROW( "Unknown ISP split mode" );
       break;
@@ -768,16 +773,16 @@ bool TUIntraSubPartitioner::canSplit( const PartSplit split, const CodingStructu
 // Partitioner methods describing the actual partitioning logic
 //////////////////////////////////////////////////////////////////////////
 
-Partitioning PartitionerImpl::getCUSubPartitions( const UnitArea &cuArea, const CodingStructure &cs, const PartSplit _splitType /*= CU_QUAD_SPLIT*/ )
+void PartitionerImpl::getCUSubPartitions( Partitioning &sub, const UnitArea &cuArea, const CodingStructure &cs, const PartSplit _splitType /*= CU_QUAD_SPLIT*/ )
 {
   const PartSplit splitType = _splitType;
 
+  sub.clear();
+
   if( splitType == CU_QUAD_SPLIT )
   {
     if( !cs.pcv->noChroma2x2 )
     {
-      Partitioning sub;
-
       sub.resize( 4, cuArea );
 
       for( uint32_t i = 0; i < 4; i++ )
@@ -793,7 +798,7 @@ Partitioning PartitionerImpl::getCUSubPartitions( const UnitArea &cuArea, const
         CHECK( sub[i].lumaSize().height < MIN_TB_SIZEY, "the split causes the block to be smaller than the minimal TU size" );
       }
 
-      return sub;
+      return;
     }
     else
     {
@@ -801,36 +806,33 @@ Partitioning PartitionerImpl::getCUSubPartitions( const UnitArea &cuArea, const
 
       bool canSplit = cuArea.lumaSize().width > minCUSize && cuArea.lumaSize().height > minCUSize;
 
-      Partitioning ret;
-
-
       if( canSplit )
       {
-        ret.resize( 4 );
+        sub.resize( 4 );
 
         if( cuArea.chromaFormat == CHROMA_400 )
         {
           CompArea  blkY = cuArea.Y();
           blkY.width >>= 1;
           blkY.height >>= 1;
-          ret[0]  = UnitArea( cuArea.chromaFormat, blkY );
+          sub[0]  = UnitArea( cuArea.chromaFormat, blkY );
           blkY.x += blkY.width;
-          ret[1]  = UnitArea( cuArea.chromaFormat, blkY );
+          sub[1]  = UnitArea( cuArea.chromaFormat, blkY );
           blkY.x -= blkY.width;
           blkY.y += blkY.height;
-          ret[2]  = UnitArea( cuArea.chromaFormat, blkY );
+          sub[2]  = UnitArea( cuArea.chromaFormat, blkY );
           blkY.x += blkY.width;
-          ret[3]  = UnitArea( cuArea.chromaFormat, blkY );
+          sub[3]  = UnitArea( cuArea.chromaFormat, blkY );
         }
         else
         {
           for( uint32_t i = 0; i < 4; i++ )
           {
-            ret[i] = cuArea;
+            sub[i] = cuArea;
 
-            CompArea &blkY  = ret[i].Y();
-            CompArea &blkCb = ret[i].Cb();
-            CompArea &blkCr = ret[i].Cr();
+            CompArea &blkY  = sub[i].Y();
+            CompArea &blkCb = sub[i].Cb();
+            CompArea &blkCr = sub[i].Cr();
 
             blkY.width  /= 2;
             blkY.height /= 2;
@@ -866,13 +868,10 @@ Partitioning PartitionerImpl::getCUSubPartitions( const UnitArea &cuArea, const
         }
       }
 
-      return ret;
     }
   }
   else if( splitType == CU_HORZ_SPLIT )
   {
-    Partitioning sub;
-
     sub.resize(2, cuArea);
 
     for (uint32_t i = 0; i < 2; i++)
@@ -886,12 +885,10 @@ Partitioning PartitionerImpl::getCUSubPartitions( const UnitArea &cuArea, const
       CHECK(sub[i].lumaSize().height < MIN_TB_SIZEY, "the cs split causes the block to be smaller than the minimal TU size");
     }
 
-    return sub;
+    return;
   }
   else if( splitType == CU_VERT_SPLIT )
   {
-    Partitioning sub;
-
     sub.resize( 2, cuArea );
 
     for( uint32_t i = 0; i < 2; i++ )
@@ -905,12 +902,10 @@ Partitioning PartitionerImpl::getCUSubPartitions( const UnitArea &cuArea, const
       CHECK( sub[i].lumaSize().width < MIN_TB_SIZEY, "the split causes the block to be smaller than the minimal TU size" );
     }
 
-    return sub;
+    return;
   }
   else if( splitType == CU_TRIH_SPLIT )
   {
-    Partitioning sub;
-
     sub.resize( 3, cuArea );
 
     for( int i = 0; i < 3; i++ )
@@ -926,12 +921,10 @@ Partitioning PartitionerImpl::getCUSubPartitions( const UnitArea &cuArea, const
       CHECK( sub[i].lumaSize().height < MIN_TB_SIZEY, "the cs split causes the block to be smaller than the minimal TU size" );
     }
 
-    return sub;
+    return;
   }
   else if( splitType == CU_TRIV_SPLIT )
   {
-    Partitioning sub;
-
     sub.resize( 3, cuArea );
 
     for( int i = 0; i < 3; i++ )
@@ -948,12 +941,11 @@ Partitioning PartitionerImpl::getCUSubPartitions( const UnitArea &cuArea, const
       CHECK( sub[i].lumaSize().width < MIN_TB_SIZEY, "the cs split causes the block to be smaller than the minimal TU size" );
     }
 
-    return sub;
+    return;
   }
   else
   {
     THROW( "Unknown CU sub-partitioning" );
-    return Partitioning();
   }
 }
 
@@ -1048,7 +1040,7 @@ static const int g_rsScanToZ[1 << ( g_maxRtGridSize << 1 )] =
   42, 43, 46, 47, 58, 59, 62, 63,
 };
 
-Partitioning PartitionerImpl::getMaxTuTiling( const UnitArea &cuArea, const CodingStructure &cs )
+void PartitionerImpl::getMaxTuTiling( Partitioning &sub, const UnitArea &cuArea, const CodingStructure &cs )
 {
   static_assert( MAX_LOG2_DIFF_CU_TR_SIZE <= g_maxRtGridSize, "Z-scan tables are only provided for MAX_LOG2_DIFF_CU_TR_SIZE for up to 3 (8x8 tiling)!" );
 
@@ -1058,10 +1050,10 @@ Partitioning PartitionerImpl::getMaxTuTiling( const UnitArea &cuArea, const Codi
   const int numTilesV = std::max<int>( 1, area.height / maxTrSize );
   const int numTiles  = numTilesH * numTilesV;
 
-  CHECK( numTiles > MAX_CU_TILING_PARTITIONS, "CU partitioning requires more partitions than available" );
+  CHECK( numTiles > MAX_NUM_SPLIT_PARTITIONS, "CU partitioning requires more partitions than available" );
 
-  Partitioning ret;
-  ret.resize( numTiles, cuArea );
+  sub.clear();
+  sub.resize( numTiles, cuArea );
 
   for( int i = 0; i < numTiles; i++ )
   {
@@ -1071,7 +1063,7 @@ Partitioning PartitionerImpl::getMaxTuTiling( const UnitArea &cuArea, const Codi
     const int x = g_zScanToX[g_rsScanToZ[( rsy << g_maxRtGridSize ) + rsx]];
     const int y = g_zScanToY[g_rsScanToZ[( rsy << g_maxRtGridSize ) + rsx]];
 
-    UnitArea& tile = ret[i];
+    UnitArea& tile = sub[i];
 
     for( CompArea &comp : tile.blocks )
     {
@@ -1084,18 +1076,16 @@ Partitioning PartitionerImpl::getMaxTuTiling( const UnitArea &cuArea, const Codi
       comp.y += comp.height * y;
     }
   }
-
-  return ret;
 }
 
-Partitioning PartitionerImpl::getSbtTuTiling( const UnitArea& cuArea, const CodingStructure &cs, const PartSplit splitType )
+void PartitionerImpl::getSbtTuTiling( Partitioning &sub, const UnitArea& cuArea, const CodingStructure &cs, const PartSplit splitType )
 {
-  Partitioning ret;
   int numTiles = 2;
   int widthFactor, heightFactor, xOffsetFactor, yOffsetFactor; // y = (x * factor) >> 2;
   assert( splitType >= SBT_VER_HALF_POS0_SPLIT && splitType <= SBT_HOR_QUAD_POS1_SPLIT );
 
-  ret.resize( numTiles, cuArea );
+  sub.clear();
+  sub.resize( numTiles, cuArea );
   for( int i = 0; i < numTiles; i++ )
   {
     if( splitType >= SBT_VER_QUAD_POS0_SPLIT )
@@ -1133,7 +1123,7 @@ Partitioning PartitionerImpl::getSbtTuTiling( const UnitArea& cuArea, const Codi
       }
     }
 
-    UnitArea& tile = ret[i];
+    UnitArea& tile = sub[i];
     for( CompArea &comp : tile.blocks )
     {
       if( !comp.valid() ) continue;
@@ -1143,6 +1133,4 @@ Partitioning PartitionerImpl::getSbtTuTiling( const UnitArea& cuArea, const Codi
       comp.height = ( comp.height * heightFactor ) >> 2;
     }
   }
-
-  return ret;
 }
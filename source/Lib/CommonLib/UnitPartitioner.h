@@ -42,8 +42,8 @@
 
 #include "CommonDef.h"
 
-static_assert( MAX_CU_TILING_PARTITIONS >= 4, "Minimum required number of partitions for the Partitioning type is 4!" );
-typedef std::vector <UnitArea> Partitioning;
+static_assert( MAX_NUM_SPLIT_PARTITIONS >= 4, "Minimum required number of partitions for the Partitioning type is 4!" );
+typedef static_vector<UnitArea, MAX_NUM_SPLIT_PARTITIONS> Partitioning;
 
 //////////////////////////////////////////////////////////////////////////
 // PartManager class - manages the partitioning tree
@@ -215,14 +215,17 @@ public:
 
 //////////////////////////////////////////////////////////////////////////
 // Partitioner namespace - contains methods calculating the actual splits
+//
+// the sub-partitions are written directly into the (fixed capacity)
+// partitioning of the pushed partitioning level, no heap memory is used.
 //////////////////////////////////////////////////////////////////////////
 
 namespace PartitionerImpl
 {
-  Partitioning getCUSubPartitions( const UnitArea   &cuArea, const CodingStructure &cs, const PartSplit splitType = CU_QUAD_SPLIT );
-  Partitioning getMaxTuTiling    ( const UnitArea& curArea, const CodingStructure &cs );
-  void    getTUIntraSubPartitions( Partitioning &sub, const UnitArea &tuArea, const CodingStructure &cs, const PartSplit splitType );
-  Partitioning getSbtTuTiling    ( const UnitArea& curArea, const CodingStructure &cs, const PartSplit splitType );
+  void getCUSubPartitions     ( Partitioning &sub, const UnitArea &cuArea, const CodingStructure &cs, const PartSplit splitType = CU_QUAD_SPLIT );
+  void getMaxTuTiling         ( Partitioning &sub, const UnitArea &cuArea, const CodingStructure &cs );
+  void getTUIntraSubPartitions( Partitioning &sub, const UnitArea &tuArea, const CodingStructure &cs, const PartSplit splitType );
+  void getSbtTuTiling         ( Partitioning &sub, const UnitArea &cuArea, const CodingStructure &cs, const PartSplit splitType );
 };
 
 #endif
@@ -43,27 +43,6 @@
 #include "CodingStructure.h"
 
 
-static inline Pel weightBidir( int w0, Pel P0, int w1, Pel P1, int round, int shift, int offset, const ClpRng& clpRng)
-{
-  return ClipPel( ( (w0*(P0 + IF_INTERNAL_OFFS) + w1*(P1 + IF_INTERNAL_OFFS) + round + (offset << (shift-1))) >> shift ), clpRng );
-}
-
-static inline Pel weightUnidir( int w0, Pel P0, int round, int shift, int offset, const ClpRng& clpRng)
-{
-  return ClipPel( ( (w0*(P0 + IF_INTERNAL_OFFS) + round) >> shift ) + offset, clpRng );
-}
-
-static inline Pel noWeightUnidir( Pel P0, int round, int shift, int offset, const ClpRng& clpRng)
-{
-  return ClipPel( ( ((P0 + IF_INTERNAL_OFFS) + round) >> shift ) + offset, clpRng );
-}
-
-static inline Pel noWeightOffsetUnidir( Pel P0, int round, int shift, const ClpRng& clpRng)
-{
-  return ClipPel( ( ((P0 + IF_INTERNAL_OFFS) + round) >> shift ), clpRng );
-}
-
-
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -201,27 +180,10 @@ void WeightPrediction::addWeightBi(const CPelUnitBuf          &pcYuvSrc0,
     const uint32_t iSrc1Stride = pcYuvSrc1.bufs[compID].stride;
     const uint32_t iDstStride =  rpcYuvDst.bufs[compID].stride;
 
-    for (int y = iHeight - 1; y >= 0; y--)
-    {
-      // do it in batches of 4 (partial unroll)
-      int x = iWidth - 1;
-
-      for (; x >= 3; )
-      {
-        pDst[x] = weightBidir(w0, pSrc0[x], w1, pSrc1[x], round, shift, offset, clpRng ); x--;
-        pDst[x] = weightBidir(w0, pSrc0[x], w1, pSrc1[x], round, shift, offset, clpRng ); x--;
-        pDst[x] = weightBidir(w0, pSrc0[x], w1, pSrc1[x], round, shift, offset, clpRng ); x--;
-        pDst[x] = weightBidir(w0, pSrc0[x], w1, pSrc1[x], round, shift, offset, clpRng ); x--;
-      }
-      for (; x >= 0; x--)
-      {
-        pDst[x] = weightBidir(w0, pSrc0[x], w1, pSrc1[x], round, shift, offset, clpRng );
-      }
-
-      pSrc0 += iSrc0Stride;
-      pSrc1 += iSrc1Stride;
-      pDst += iDstStride;
-    } // y loop
+    // the weighted IF_INTERNAL_OFFS of both sources is folded into the offset of the kernel
+    const int  biOffset = (w0 + w1) * IF_INTERNAL_OFFS + round + offset * (1 << (shift - 1));
+
+    g_pelBufOP.weightBi(pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight, w0, w1, shift, biOffset, clpRng);
   } // compID loop
 }
 
@@ -262,27 +224,9 @@ void WeightPrediction::addWeightBiComponent(const CPelUnitBuf          &pcYuvSrc
   const uint32_t src1Stride = pcYuvSrc1.bufs[compID].stride;
   const uint32_t dstStride =  rpcYuvDst.bufs[compID].stride;
 
-  for (int y = height - 1; y >= 0; y--)
-  {
-    // do it in batches of 4 (partial unroll)
-    int x = width - 1;
-
-    for (; x >= 3; )
-    {
-      dst[x] = weightBidir(w0, src0[x], w1, src1[x], round, shift, offset, clpRng ); x--;
-      dst[x] = weightBidir(w0, src0[x], w1, src1[x], round, shift, offset, clpRng ); x--;
-      dst[x] = weightBidir(w0, src0[x], w1, src1[x], round, shift, offset, clpRng ); x--;
-      dst[x] = weightBidir(w0, src0[x], w1, src1[x], round, shift, offset, clpRng ); x--;
-    }
-    for (; x >= 0; x--)
-    {
-      dst[x] = weightBidir(w0, src0[x], w1, src1[x], round, shift, offset, clpRng );
-    }
+  const int  biOffset = (w0 + w1) * IF_INTERNAL_OFFS + round + offset * (1 << (shift - 1));
 
-    src0 += src0Stride;
-    src1 += src1Stride;
-    dst += dstStride;
-  } // y loop
+  g_pelBufOP.weightBi(src0, src0Stride, src1, src1Stride, dst, dstStride, width, height, w0, w1, shift, biOffset, clpRng);
 }
 
 void  WeightPrediction::addWeightUni(const CPelUnitBuf          &pcYuvSrc0,
@@ -323,70 +267,16 @@ void  WeightPrediction::addWeightUni(const CPelUnitBuf          &pcYuvSrc0,
     const int  iHeight      = rpcYuvDst.bufs[compID].height;
     const int  iWidth       = rpcYuvDst.bufs[compID].width;
 
+    // the weighted IF_INTERNAL_OFFS of the source is folded into the rounding of the kernel
     if (w0 != 1 << wp0[compID].shift)
     {
       const int  round = (shift > 0) ? (1 << (shift - 1)) : 0;
-      for (int y = iHeight - 1; y >= 0; y--)
-      {
-        int x = iWidth - 1;
-        for (; x >= 3; )
-        {
-          pDst[x] = weightUnidir(w0, pSrc0[x], round, shift, offset, clpRng); x--;
-          pDst[x] = weightUnidir(w0, pSrc0[x], round, shift, offset, clpRng); x--;
-          pDst[x] = weightUnidir(w0, pSrc0[x], round, shift, offset, clpRng); x--;
-          pDst[x] = weightUnidir(w0, pSrc0[x], round, shift, offset, clpRng); x--;
-        }
-        for (; x >= 0; x--)
-        {
-          pDst[x] = weightUnidir(w0, pSrc0[x], round, shift, offset, clpRng);
-        }
-        pSrc0 += iSrc0Stride;
-        pDst += iDstStride;
-      }
+      g_pelBufOP.weightUni(pSrc0, iSrc0Stride, pDst, iDstStride, iWidth, iHeight, w0, w0 * IF_INTERNAL_OFFS + round, shift, offset, clpRng);
     }
     else
     {
       const int  round = (shiftNum > 0) ? (1 << (shiftNum - 1)) : 0;
-      if (offset == 0)
-      {
-        for (int y = iHeight - 1; y >= 0; y--)
-        {
-          int x = iWidth - 1;
-          for (; x >= 3; )
-          {
-            pDst[x] = noWeightOffsetUnidir(pSrc0[x], round, shiftNum, clpRng); x--;
-            pDst[x] = noWeightOffsetUnidir(pSrc0[x], round, shiftNum, clpRng); x--;
-            pDst[x] = noWeightOffsetUnidir(pSrc0[x], round, shiftNum, clpRng); x--;
-            pDst[x] = noWeightOffsetUnidir(pSrc0[x], round, shiftNum, clpRng); x--;
-          }
-          for (; x >= 0; x--)
-          {
-            pDst[x] = noWeightOffsetUnidir(pSrc0[x], round, shiftNum, clpRng);
-          }
-          pSrc0 += iSrc0Stride;
-          pDst += iDstStride;
-        }
-      }
-      else
-      {
-        for (int y = iHeight - 1; y >= 0; y--)
-        {
-          int x = iWidth - 1;
-          for (; x >= 3; )
-          {
-            pDst[x] = noWeightUnidir(pSrc0[x], round, shiftNum, offset, clpRng); x--;
-            pDst[x] = noWeightUnidir(pSrc0[x], round, shiftNum, offset, clpRng); x--;
-            pDst[x] = noWeightUnidir(pSrc0[x], round, shiftNum, offset, clpRng); x--;
-            pDst[x] = noWeightUnidir(pSrc0[x], round, shiftNum, offset, clpRng); x--;
-          }
-          for (; x >= 0; x--)
-          {
-            pDst[x] = noWeightUnidir(pSrc0[x], round, shiftNum, offset, clpRng);
-          }
-          pSrc0 += iSrc0Stride;
-          pDst += iDstStride;
-        }
-      }
+      g_pelBufOP.weightUni(pSrc0, iSrc0Stride, pDst, iDstStride, iWidth, iHeight, 1, IF_INTERNAL_OFFS + round, shiftNum, offset, clpRng);
     }
   }
 }
@@ -478,6 +478,194 @@ static const uint16_t shuffleTab[4][2][8] = {
   },
 };
 
+#ifdef USE_AVX512
+static inline __m512i combineLanes_AVX512( const __m128i a, const __m128i b, const __m128i c, const __m128i d )
+{
+  return _mm512_inserti64x4_z( _mm512_castsi256_si512( _mm256_inserti128_si256( _mm256_castsi128_si256( a ), b, 1 ) ),
+                             _mm256_inserti128_si256( _mm256_castsi128_si256( c ), d, 1 ), 1 );
+}
+
+/** 7x7 luma filtering of 32 samples per step, the first width (multiple of 32) columns of the block. Each 128-bit lane
+    processes 8 samples like simdFilter7x7Blk, i.e. two groups of 4 samples with their own class and transpose index.
+ */
+static void simdFilter7x7Blk_AVX512(AlfClassifier **classifier, const Pel *src, const size_t srcStride, Pel *dst,
+  const size_t dstStride, const Area &blkDst, const size_t width, const size_t height, const short *filterSet,
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+  const Pel *fClipSet, const ClpRng &clpRng, const int vbCTUHeight, int vbPos)
+#else
+  const short *fClipSet, const ClpRng &clpRng, const int vbCTUHeight, int vbPos)
+#endif
+{
+  constexpr int SHIFT = AdaptiveLoopFilter::m_NUM_BITS - 1;
+  constexpr int ROUND = 1 << (SHIFT - 1);
+
+  constexpr size_t STEP_X = 32;
+  constexpr size_t STEP_Y = 4;
+
+  const __m512i mmOffset  = _mm512_set1_epi32(ROUND);
+  const __m512i mmOffset1 = _mm512_set1_epi32((1 << ((SHIFT + 3) - 1)) - ROUND);
+  const __m512i mmMin     = _mm512_set1_epi16(clpRng.min);
+  const __m512i mmMax     = _mm512_set1_epi16(clpRng.max);
+  const __m512i mmSign    = _mm512_set1_epi8((char) 0x80);
+
+  for (size_t i = 0; i < height; i += STEP_Y)
+  {
+    const AlfClassifier *pClass = classifier[blkDst.y + i] + blkDst.x;
+
+    for (size_t j = 0; j < width; j += STEP_X)
+    {
+      __m512i params[2][2][6];
+
+      for (int k = 0; k < 2; ++k)
+      {
+        __m128i rawCoeff0[4], rawCoeff1[4], rawClip0[4], rawClip1[4], shuffle0[4], shuffle1[4];
+
+        for (int l = 0; l < 4; l++)
+        {
+          const AlfClassifier &cl = pClass[j + 8 * l + 4 * k];
+
+          rawCoeff0[l] = _mm_loadu_si128((const __m128i *) (filterSet + cl.classIdx * MAX_NUM_ALF_LUMA_COEFF));
+          rawCoeff1[l] = _mm_loadl_epi64((const __m128i *) (filterSet + cl.classIdx * MAX_NUM_ALF_LUMA_COEFF + 8));
+          rawClip0[l]  = _mm_loadu_si128((const __m128i *) (fClipSet + cl.classIdx * MAX_NUM_ALF_LUMA_COEFF));
+          rawClip1[l]  = _mm_loadl_epi64((const __m128i *) (fClipSet + cl.classIdx * MAX_NUM_ALF_LUMA_COEFF + 8));
+          shuffle0[l]  = _mm_loadu_si128((const __m128i *) shuffleTab[cl.transposeIdx][0]);
+          shuffle1[l]  = _mm_loadu_si128((const __m128i *) shuffleTab[cl.transposeIdx][1]);
+        }
+
+        const __m512i coeff0 = combineLanes_AVX512(rawCoeff0[0], rawCoeff0[1], rawCoeff0[2], rawCoeff0[3]);
+        const __m512i coeff1 = combineLanes_AVX512(rawCoeff1[0], rawCoeff1[1], rawCoeff1[2], rawCoeff1[3]);
+        const __m512i clip0  = combineLanes_AVX512(rawClip0[0], rawClip0[1], rawClip0[2], rawClip0[3]);
+        const __m512i clip1  = combineLanes_AVX512(rawClip1[0], rawClip1[1], rawClip1[2], rawClip1[3]);
+
+        const __m512i s0 = combineLanes_AVX512(shuffle0[0], shuffle0[1], shuffle0[2], shuffle0[3]);
+        const __m512i s1 = _mm512_xor_si512(s0, mmSign);
+        const __m512i s2 = combineLanes_AVX512(shuffle1[0], shuffle1[1], shuffle1[2], shuffle1[3]);
+        const __m512i s3 = _mm512_xor_si512(s2, mmSign);
+
+        const __m512i rawCoeffLo = _mm512_or_si512(_mm512_shuffle_epi8(coeff0, s0), _mm512_shuffle_epi8(coeff1, s1));
+        const __m512i rawCoeffHi = _mm512_or_si512(_mm512_shuffle_epi8(coeff0, s2), _mm512_shuffle_epi8(coeff1, s3));
+        const __m512i rawClipLo  = _mm512_or_si512(_mm512_shuffle_epi8(clip0, s0), _mm512_shuffle_epi8(clip1, s1));
+        const __m512i rawClipHi  = _mm512_or_si512(_mm512_shuffle_epi8(clip0, s2), _mm512_shuffle_epi8(clip1, s3));
+
+        params[k][0][0] = _mm512_shuffle_epi32_z(rawCoeffLo, _MM_PERM_AAAA);
+        params[k][0][1] = _mm512_shuffle_epi32_z(rawCoeffLo, _MM_PERM_BBBB);
+        params[k][0][2] = _mm512_shuffle_epi32_z(rawCoeffLo, _MM_PERM_CCCC);
+        params[k][0][3] = _mm512_shuffle_epi32_z(rawCoeffLo, _MM_PERM_DDDD);
+        params[k][0][4] = _mm512_shuffle_epi32_z(rawCoeffHi, _MM_PERM_AAAA);
+        params[k][0][5] = _mm512_shuffle_epi32_z(rawCoeffHi, _MM_PERM_BBBB);
+        params[k][1][0] = _mm512_shuffle_epi32_z(rawClipLo, _MM_PERM_AAAA);
+        params[k][1][1] = _mm512_shuffle_epi32_z(rawClipLo, _MM_PERM_BBBB);
+        params[k][1][2] = _mm512_shuffle_epi32_z(rawClipLo, _MM_PERM_CCCC);
+        params[k][1][3] = _mm512_shuffle_epi32_z(rawClipLo, _MM_PERM_DDDD);
+        params[k][1][4] = _mm512_shuffle_epi32_z(rawClipHi, _MM_PERM_AAAA);
+        params[k][1][5] = _mm512_shuffle_epi32_z(rawClipHi, _MM_PERM_BBBB);
+      }
+
+      for (size_t ii = 0; ii < STEP_Y; ii++)
+      {
+        const Pel *pImg0, *pImg1, *pImg2, *pImg3, *pImg4, *pImg5, *pImg6;
+
+        pImg0 = src + j + ii * srcStride;
+        pImg1 = pImg0 + srcStride;
+        pImg2 = pImg0 - srcStride;
+        pImg3 = pImg1 + srcStride;
+        pImg4 = pImg2 - srcStride;
+        pImg5 = pImg3 + srcStride;
+        pImg6 = pImg4 - srcStride;
+
+        const int yVb = (blkDst.y + i + ii) & (vbCTUHeight - 1);
+        if (yVb < vbPos && (yVb >= vbPos - 4))   // above
+        {
+          pImg1 = (yVb == vbPos - 1) ? pImg0 : pImg1;
+          pImg3 = (yVb >= vbPos - 2) ? pImg1 : pImg3;
+          pImg5 = (yVb >= vbPos - 3) ? pImg3 : pImg5;
+
+          pImg2 = (yVb == vbPos - 1) ? pImg0 : pImg2;
+          pImg4 = (yVb >= vbPos - 2) ? pImg2 : pImg4;
+          pImg6 = (yVb >= vbPos - 3) ? pImg4 : pImg6;
+        }
+        else if (yVb >= vbPos && (yVb <= vbPos + 3))   // bottom
+        {
+          pImg2 = (yVb == vbPos) ? pImg0 : pImg2;
+          pImg4 = (yVb <= vbPos + 1) ? pImg2 : pImg4;
+          pImg6 = (yVb <= vbPos + 2) ? pImg4 : pImg6;
+
+          pImg1 = (yVb == vbPos) ? pImg0 : pImg1;
+          pImg3 = (yVb <= vbPos + 1) ? pImg1 : pImg3;
+          pImg5 = (yVb <= vbPos + 2) ? pImg3 : pImg5;
+        }
+        const __m512i cur = _mm512_loadu_si512((const void *) pImg0);
+
+        __m512i accumA = mmOffset;
+        __m512i accumB = mmOffset;
+
+        auto process2coeffs = [&](const int i, const Pel *ptr0, const Pel *ptr1, const Pel *ptr2, const Pel *ptr3) {
+          const __m512i val00 = _mm512_sub_epi16(_mm512_loadu_si512((const void *) ptr0), cur);
+          const __m512i val10 = _mm512_sub_epi16(_mm512_loadu_si512((const void *) ptr2), cur);
+          const __m512i val01 = _mm512_sub_epi16(_mm512_loadu_si512((const void *) ptr1), cur);
+          const __m512i val11 = _mm512_sub_epi16(_mm512_loadu_si512((const void *) ptr3), cur);
+
+          __m512i val01A = _mm512_unpacklo_epi16(val00, val10);
+          __m512i val01B = _mm512_unpackhi_epi16(val00, val10);
+          __m512i val01C = _mm512_unpacklo_epi16(val01, val11);
+          __m512i val01D = _mm512_unpackhi_epi16(val01, val11);
+
+          __m512i limit01A = params[0][1][i];
+          __m512i limit01B = params[1][1][i];
+
+          val01A = _mm512_min_epi16(val01A, limit01A);
+          val01B = _mm512_min_epi16(val01B, limit01B);
+          val01C = _mm512_min_epi16(val01C, limit01A);
+          val01D = _mm512_min_epi16(val01D, limit01B);
+
+          limit01A = _mm512_sub_epi16(_mm512_setzero_si512(), limit01A);
+          limit01B = _mm512_sub_epi16(_mm512_setzero_si512(), limit01B);
+
+          val01A = _mm512_max_epi16(val01A, limit01A);
+          val01B = _mm512_max_epi16(val01B, limit01B);
+          val01C = _mm512_max_epi16(val01C, limit01A);
+          val01D = _mm512_max_epi16(val01D, limit01B);
+
+          val01A = _mm512_add_epi16(val01A, val01C);
+          val01B = _mm512_add_epi16(val01B, val01D);
+
+          accumA = _mm512_add_epi32(accumA, _mm512_madd_epi16(val01A, params[0][0][i]));
+          accumB = _mm512_add_epi32(accumB, _mm512_madd_epi16(val01B, params[1][0][i]));
+        };
+
+        process2coeffs(0, pImg5 + 0, pImg6 + 0, pImg3 + 1, pImg4 - 1);
+        process2coeffs(1, pImg3 + 0, pImg4 + 0, pImg3 - 1, pImg4 + 1);
+        process2coeffs(2, pImg1 + 2, pImg2 - 2, pImg1 + 1, pImg2 - 1);
+        process2coeffs(3, pImg1 + 0, pImg2 + 0, pImg1 - 1, pImg2 + 1);
+        process2coeffs(4, pImg1 - 2, pImg2 + 2, pImg0 + 3, pImg0 - 3);
+        process2coeffs(5, pImg0 + 2, pImg0 - 2, pImg0 + 1, pImg0 - 1);
+
+        bool isNearVBabove = yVb < vbPos && (yVb >= vbPos - 1);
+        bool isNearVBbelow = yVb >= vbPos && (yVb <= vbPos);
+        if (!(isNearVBabove || isNearVBbelow))
+        {
+          accumA = _mm512_srai_epi32_z(accumA, SHIFT);
+          accumB = _mm512_srai_epi32_z(accumB, SHIFT);
+        }
+        else
+        {
+          accumA = _mm512_srai_epi32_z(_mm512_add_epi32(accumA, mmOffset1), SHIFT + 3);
+          accumB = _mm512_srai_epi32_z(_mm512_add_epi32(accumB, mmOffset1), SHIFT + 3);
+        }
+        accumA = _mm512_packs_epi32(accumA, accumB);
+        accumA = _mm512_add_epi16(accumA, cur);
+        accumA = _mm512_min_epi16(mmMax, _mm512_max_epi16(accumA, mmMin));
+
+        _mm512_storeu_si512((void *) (dst + ii * dstStride + j), accumA);
+      }
+    }
+
+    src += srcStride * STEP_Y;
+    dst += dstStride * STEP_Y;
+  }
+}
+#endif
+
 template<X86_VEXT vext>
 static void simdFilter7x7Blk(AlfClassifier **classifier, const PelUnitBuf &recDst, const CPelUnitBuf &recSrc,
   const Area &blkDst, const Area &blk, const ComponentID compId, const short *filterSet,
@@ -520,12 +708,21 @@ static void simdFilter7x7Blk(AlfClassifier **classifier, const PelUnitBuf &recDs
   const __m128i mmMin = _mm_set1_epi16( clpRng.min );
   const __m128i mmMax = _mm_set1_epi16( clpRng.max );
 
+  size_t startX = 0;
+#ifdef USE_AVX512
+  if (vext >= AVX512 && width >= 32)
+  {
+    startX = width & ~size_t(31);
+    simdFilter7x7Blk_AVX512(classifier, src, srcStride, dst, dstStride, blkDst, startX, height, filterSet, fClipSet, clpRng,
+                            vbCTUHeight, vbPos);
+  }
+#endif
 
   for (size_t i = 0; i < height; i += STEP_Y)
   {
     const AlfClassifier *pClass = classifier[blkDst.y + i] + blkDst.x;
 
-    for (size_t j = 0; j < width; j += STEP_X)
+    for (size_t j = startX; j < width; j += STEP_X)
     {
       __m128i params[2][2][6];
 
@@ -56,6 +56,41 @@ void addAvg_SSE( const int16_t* src0, int src0Stride, const int16_t* src1, int s
     CHECK(offset & 1, "offset must be even");
     CHECK(offset < -32768 || offset > 32767, "offset must be a 16-bit value");
 
+#ifdef USE_AVX512
+    if( vext >= AVX512 && ( width & 31 ) == 0 )
+    {
+      const __m512i vibdimin = _mm512_set1_epi16( clpRng.min );
+      const __m512i vibdimax = _mm512_set1_epi16( clpRng.max );
+      const __m512i vflip    = _mm512_set1_epi16( 0x7fff );
+      const __m512i voffset  = _mm512_set1_epi16( offset >> 1 );
+      const __m128i vshift   = _mm_cvtsi32_si128( shift - 1 );
+
+      for( int row = 0; row < height; row++ )
+      {
+        for( int col = 0; col < width; col += 32 )
+        {
+          __m512i vsrc0 = _mm512_loadu_si512( ( const void * ) &src0[col] );
+          __m512i vsrc1 = _mm512_loadu_si512( ( const void * ) &src1[col] );
+
+          vsrc0 = _mm512_xor_si512( vsrc0, vflip );
+          vsrc1 = _mm512_xor_si512( vsrc1, vflip );
+          vsrc0 = _mm512_avg_epu16( vsrc0, vsrc1 );
+          vsrc0 = _mm512_xor_si512( vsrc0, vflip );
+          vsrc0 = _mm512_adds_epi16( vsrc0, voffset );
+          vsrc0 = _mm512_sra_epi16( vsrc0, vshift );
+          vsrc0 = _mm512_max_epi16( vsrc0, vibdimin );
+          vsrc0 = _mm512_min_epi16( vsrc0, vibdimax );
+          _mm512_storeu_si512( ( void * ) &dst[col], vsrc0 );
+        }
+
+        src0 += src0Stride;
+        src1 += src1Stride;
+        dst  += dstStride;
+      }
+      return;
+    }
+#endif
+
     __m128i vibdimin = _mm_set1_epi16(clpRng.min);
     __m128i vibdimax = _mm_set1_epi16(clpRng.max);
 
@@ -486,18 +521,18 @@ void roundIntVector_SIMD(int* v, int size, unsigned int nShift, const int dmvLim
 #ifdef USE_AVX512
   if (vext >= AVX512 && size >= 16)
   {
-    __m512i dMvMin = _mm256_set1_epi32(-dmvLimit);
-    __m512i dMvMax = _mm256_set1_epi32( dmvLimit );
+    __m512i dMvMin = _mm512_set1_epi32(-dmvLimit);
+    __m512i dMvMax = _mm512_set1_epi32( dmvLimit );
     __m512i nOffset = _mm512_set1_epi32((1 << (nShift - 1)));
     __m512i vones = _mm512_set1_epi32(1);
     __m512i vzero = _mm512_setzero_si512();
     for (int i = 0; i < size; i += 16, v += 16)
     {
       __m512i src = _mm512_loadu_si512(v);
-      __mmask16 mask = _mm512_cmpge_epi32_mask(src, vzero);
-      src = __mm512_add_epi32(src, nOffset);
-      __mm512i dst = _mm512_srai_epi32(_mm512_mask_sub_epi32(src, mask, src, vones), nShift);
-      dst = _mm512_min_epi32(dMvMax, _mm512_max_epi32(dMvMin, dst));
+      __mmask16 mask = _mm512_cmpgt_epi32_mask(src, vzero);
+      src = _mm512_add_epi32(src, nOffset);
+      __m512i dst = _mm512_srai_epi32_z(_mm512_mask_sub_epi32(src, mask, src, vones), nShift);
+      dst = _mm512_min_epi32_z(dMvMax, _mm512_max_epi32_z(dMvMin, dst));
       _mm512_storeu_si512(v, dst);
     }
   }
@@ -1048,6 +1083,592 @@ void linTf_SSE_entry( const Pel* src, int srcStride, Pel *dst, int dstStride, in
   }
 }
 
+template<X86_VEXT vext>
+void sampleRateConvHor_SIMD( const Pel* src, int* dst, int width, const int* srcOffset, const int* phase, const TFilterCoeff* filter, const int filterLength )
+{
+  int i = 0;
+
+  if( filterLength == 8 || filterLength == 12 )
+  {
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      // columns i..i+3 in the low lane, i+4..i+7 in the high lane
+      for( ; i + 8 <= width; i += 8 )
+      {
+        __m256i sum[4];
+
+        for( int c = 0; c < 4; c++ )
+        {
+          const Pel*          s0 = src + srcOffset[i + c];
+          const Pel*          s1 = src + srcOffset[i + c + 4];
+          const TFilterCoeff* f0 = filter + phase[i + c] * filterLength;
+          const TFilterCoeff* f1 = filter + phase[i + c + 4] * filterLength;
+
+          __m256i vsrc = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) s0 ) ), _mm_loadu_si128( ( const __m128i* ) s1 ), 1 );
+          __m256i vcof = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* ) f0 ) ), _mm_loadu_si128( ( const __m128i* ) f1 ), 1 );
+          sum[c] = _mm256_madd_epi16( vsrc, vcof );
+
+          if( filterLength == 12 )
+          {
+            vsrc = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadl_epi64( ( const __m128i* ) ( s0 + 8 ) ) ), _mm_loadl_epi64( ( const __m128i* ) ( s1 + 8 ) ), 1 );
+            vcof = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadl_epi64( ( const __m128i* ) ( f0 + 8 ) ) ), _mm_loadl_epi64( ( const __m128i* ) ( f1 + 8 ) ), 1 );
+            sum[c] = _mm256_add_epi32( sum[c], _mm256_madd_epi16( vsrc, vcof ) );
+          }
+        }
+
+        _mm256_storeu_si256( ( __m256i* ) ( dst + i ), _mm256_hadd_epi32( _mm256_hadd_epi32( sum[0], sum[1] ), _mm256_hadd_epi32( sum[2], sum[3] ) ) );
+      }
+    }
+#endif
+
+    for( ; i + 4 <= width; i += 4 )
+    {
+      __m128i sum[4];
+
+      for( int c = 0; c < 4; c++ )
+      {
+        const Pel*          s = src + srcOffset[i + c];
+        const TFilterCoeff* f = filter + phase[i + c] * filterLength;
+
+        sum[c] = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) s ), _mm_loadu_si128( ( const __m128i* ) f ) );
+
+        if( filterLength == 12 )
+        {
+          sum[c] = _mm_add_epi32( sum[c], _mm_madd_epi16( _mm_loadl_epi64( ( const __m128i* ) ( s + 8 ) ), _mm_loadl_epi64( ( const __m128i* ) ( f + 8 ) ) ) );
+        }
+      }
+
+      _mm_storeu_si128( ( __m128i* ) ( dst + i ), _mm_hadd_epi32( _mm_hadd_epi32( sum[0], sum[1] ), _mm_hadd_epi32( sum[2], sum[3] ) ) );
+    }
+  }
+  else if( filterLength == 4 )
+  {
+    for( ; i + 4 <= width; i += 4 )
+    {
+      __m128i sum[2];
+
+      for( int c = 0; c < 2; c++ )
+      {
+        const __m128i vsrc = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) ( src + srcOffset[i + 2 * c] ) ),
+                                                 _mm_loadl_epi64( ( const __m128i* ) ( src + srcOffset[i + 2 * c + 1] ) ) );
+        const __m128i vcof = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) ( filter + phase[i + 2 * c] * 4 ) ),
+                                                 _mm_loadl_epi64( ( const __m128i* ) ( filter + phase[i + 2 * c + 1] * 4 ) ) );
+        sum[c] = _mm_madd_epi16( vsrc, vcof );
+      }
+
+      _mm_storeu_si128( ( __m128i* ) ( dst + i ), _mm_hadd_epi32( sum[0], sum[1] ) );
+    }
+  }
+
+  if( i < width )
+  {
+    sampleRateConvHorCore( src, dst + i, width - i, srcOffset + i, phase + i, filter, filterLength );
+  }
+}
+
+template<X86_VEXT vext>
+void sampleRateConvVer_SIMD( const int* const* src, Pel* dst, int width, const TFilterCoeff* coeff, const int filterLength, const int shift, const int maxVal )
+{
+  CHECKD( filterLength > 12, "Unsupported filter length" );
+
+  int i = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    __m256i vcoeff[12];
+    for( int k = 0; k < filterLength; k++ )
+    {
+      vcoeff[k] = _mm256_set1_epi32( coeff[k] );
+    }
+    const __m256i voffset = _mm256_set1_epi32( 1 << ( shift - 1 ) );
+    const __m256i vmax    = _mm256_set1_epi32( maxVal );
+    const __m256i vzero   = _mm256_setzero_si256();
+
+    for( ; i + 8 <= width; i += 8 )
+    {
+      __m256i sum = voffset;
+
+      for( int k = 0; k < filterLength; k++ )
+      {
+        sum = _mm256_add_epi32( sum, _mm256_mullo_epi32( _mm256_loadu_si256( ( const __m256i* ) ( src[k] + i ) ), vcoeff[k] ) );
+      }
+
+      sum = _mm256_min_epi32( _mm256_max_epi32( _mm256_srai_epi32( sum, shift ), vzero ), vmax );
+      _mm_storeu_si128( ( __m128i* ) ( dst + i ), _mm_packs_epi32( _mm256_castsi256_si128( sum ), _mm256_extracti128_si256( sum, 1 ) ) );
+    }
+  }
+#endif
+
+  __m128i vcoeff[12];
+  for( int k = 0; k < filterLength; k++ )
+  {
+    vcoeff[k] = _mm_set1_epi32( coeff[k] );
+  }
+  const __m128i voffset = _mm_set1_epi32( 1 << ( shift - 1 ) );
+  const __m128i vmax    = _mm_set1_epi32( maxVal );
+  const __m128i vzero   = _mm_setzero_si128();
+
+  for( ; i + 4 <= width; i += 4 )
+  {
+    __m128i sum = voffset;
+
+    for( int k = 0; k < filterLength; k++ )
+    {
+      sum = _mm_add_epi32( sum, _mm_mullo_epi32( _mm_loadu_si128( ( const __m128i* ) ( src[k] + i ) ), vcoeff[k] ) );
+    }
+
+    sum = _mm_min_epi32( _mm_max_epi32( _mm_srai_epi32( sum, shift ), vzero ), vmax );
+    _mm_storel_epi64( ( __m128i* ) ( dst + i ), _mm_packs_epi32( sum, sum ) );
+  }
+
+  for( ; i < width; i++ )
+  {
+    int sum = 1 << ( shift - 1 );
+
+    for( int k = 0; k < filterLength; k++ )
+    {
+      sum += coeff[k] * src[k][i];
+    }
+
+    dst[i] = std::min<int>( std::max( 0, sum >> shift ), maxVal );
+  }
+}
+
+// 16 bit values of the segments selected by bidx, the segment index in both bytes of each 16 bit lane
+static inline __m128i rspLookup( const __m128i& tabLo, const __m128i& tabHi, const __m128i& bidx )
+{
+  const __m128i lo = _mm_and_si128( _mm_shuffle_epi8( tabLo, bidx ), _mm_set1_epi16( 0xff ) );
+  const __m128i hi = _mm_slli_epi16( _mm_shuffle_epi8( tabHi, bidx ), 8 );
+  return _mm_or_si128( lo, hi );
+}
+
+#ifdef USE_AVX2
+static inline __m256i rspLookup( const __m256i& tabLo, const __m256i& tabHi, const __m256i& bidx )
+{
+  const __m256i lo = _mm256_and_si256( _mm256_shuffle_epi8( tabLo, bidx ), _mm256_set1_epi16( 0xff ) );
+  const __m256i hi = _mm256_slli_epi16( _mm256_shuffle_epi8( tabHi, bidx ), 8 );
+  return _mm256_or_si256( lo, hi );
+}
+#endif
+
+// evaluates the piecewise linear LMCS mapping instead of reading the table: the segment index and the offset in the
+// segment are given by the high and low bits of the sample, the segment parameters are looked up with byte shuffles;
+// with 128 bit registers this is only faster than reading the table for narrow blocks
+template<X86_VEXT vext>
+void rspSignal_SIMD( Pel* ptr, int stride, int width, int height, const ReshapeLUT& lut )
+{
+  const bool simd = ( vext >= AVX2 && ( width & 15 ) == 0 ) || width == 4 || width == 8;
+  if( !lut.pwlValid || !simd )
+  {
+    rspSignalCore( ptr, stride, width, height, lut );
+    return;
+  }
+
+  // low and high bytes of the segment parameters
+  ALIGN_DATA( MEMORY_ALIGN_DEF_SIZE, uint8_t tab[4][PIC_CODE_CW_BINS] );
+  for( int i = 0; i < PIC_CODE_CW_BINS; i++ )
+  {
+    tab[0][i] = ( uint16_t ) lut.outBase[i] & 0xff;
+    tab[1][i] = ( uint16_t ) lut.outBase[i] >> 8;
+    tab[2][i] = ( uint16_t ) lut.slope  [i] & 0xff;
+    tab[3][i] = ( uint16_t ) lut.slope  [i] >> 8;
+  }
+  const int shift = lut.log2SegLen;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && ( width & 15 ) == 0 )
+  {
+    __m256i vtab[4];
+    for( int t = 0; t < 4; t++ )
+    {
+      vtab[t] = _mm256_broadcastsi128_si256( _mm_load_si128( ( const __m128i* ) tab[t] ) );
+    }
+    const __m256i vmask  = _mm256_set1_epi16( ( 1 << shift ) - 1 );
+    const __m256i vone   = _mm256_set1_epi16( 1 );
+    const __m256i vround = _mm256_set1_epi16( 1 << ( FP_PREC - 1 ) );
+    const __m256i vzero  = _mm256_setzero_si256();
+    const __m256i vmax   = _mm256_set1_epi16( lut.maxVal );
+
+    for( int y = 0; y < height; y++, ptr += stride )
+    {
+      for( int x = 0; x < width; x += 16 )
+      {
+        const __m256i val     = _mm256_loadu_si256( ( const __m256i* ) ( ptr + x ) );
+        const __m256i idx     = _mm256_srli_epi16( val, shift );
+        const __m256i bidx    = _mm256_or_si256( idx, _mm256_slli_epi16( idx, 8 ) );
+        const __m256i diff    = _mm256_and_si256( val, vmask );
+        const __m256i outBase = rspLookup( vtab[0], vtab[1], bidx );
+        const __m256i slope   = rspLookup( vtab[2], vtab[3], bidx );
+
+        // slope * diff + rounding in 32 bit
+        __m256i lo = _mm256_madd_epi16( _mm256_unpacklo_epi16( diff, vone ), _mm256_unpacklo_epi16( slope, vround ) );
+        __m256i hi = _mm256_madd_epi16( _mm256_unpackhi_epi16( diff, vone ), _mm256_unpackhi_epi16( slope, vround ) );
+        lo = _mm256_srai_epi32( lo, FP_PREC );
+        hi = _mm256_srai_epi32( hi, FP_PREC );
+
+        __m256i res = _mm256_adds_epi16( outBase, _mm256_packs_epi32( lo, hi ) );
+        res = _mm256_min_epi16( _mm256_max_epi16( res, vzero ), vmax );
+        _mm256_storeu_si256( ( __m256i* ) ( ptr + x ), res );
+      }
+    }
+    return;
+  }
+#endif
+
+  __m128i vtab[4];
+  for( int t = 0; t < 4; t++ )
+  {
+    vtab[t] = _mm_load_si128( ( const __m128i* ) tab[t] );
+  }
+  const __m128i vmask  = _mm_set1_epi16( ( 1 << shift ) - 1 );
+  const __m128i vone   = _mm_set1_epi16( 1 );
+  const __m128i vround = _mm_set1_epi16( 1 << ( FP_PREC - 1 ) );
+  const __m128i vzero  = _mm_setzero_si128();
+  const __m128i vmax   = _mm_set1_epi16( lut.maxVal );
+
+  for( int y = 0; y < height; y++, ptr += stride )
+  {
+    for( int x = 0; x < width; x += 8 )
+    {
+      const bool    half    = x + 8 > width;
+      const __m128i val     = half ? _mm_loadl_epi64( ( const __m128i* ) ( ptr + x ) ) : _mm_loadu_si128( ( const __m128i* ) ( ptr + x ) );
+      const __m128i idx     = _mm_srli_epi16( val, shift );
+      const __m128i bidx    = _mm_or_si128( idx, _mm_slli_epi16( idx, 8 ) );
+      const __m128i diff    = _mm_and_si128( val, vmask );
+      const __m128i outBase = rspLookup( vtab[0], vtab[1], bidx );
+      const __m128i slope   = rspLookup( vtab[2], vtab[3], bidx );
+
+      // slope * diff + rounding in 32 bit
+      __m128i lo = _mm_madd_epi16( _mm_unpacklo_epi16( diff, vone ), _mm_unpacklo_epi16( slope, vround ) );
+      __m128i hi = _mm_madd_epi16( _mm_unpackhi_epi16( diff, vone ), _mm_unpackhi_epi16( slope, vround ) );
+      lo = _mm_srai_epi32( lo, FP_PREC );
+      hi = _mm_srai_epi32( hi, FP_PREC );
+
+      __m128i res = _mm_adds_epi16( outBase, _mm_packs_epi32( lo, hi ) );
+      res = _mm_min_epi16( _mm_max_epi16( res, vzero ), vmax );
+      if( half )
+      {
+        _mm_storel_epi64( ( __m128i* ) ( ptr + x ), res );
+      }
+      else
+      {
+        _mm_storeu_si128( ( __m128i* ) ( ptr + x ), res );
+      }
+    }
+  }
+}
+
+template<X86_VEXT vext>
+void scaleSignalInv_SIMD( Pel* ptr, int stride, int width, int height, int scale, int maxAbs )
+{
+  if( width & 3 )
+  {
+    scaleSignalInvCore( ptr, stride, width, height, scale, maxAbs );
+    return;
+  }
+
+  const __m128i vmin   = _mm_set1_epi16( -maxAbs - 1 );
+  const __m128i vmax   = _mm_set1_epi16( maxAbs );
+  const __m128i vscale = _mm_set1_epi32( scale );
+  const __m128i vround = _mm_set1_epi32( 1 << ( CSCALE_FP_PREC - 1 ) );
+
+  for( int y = 0; y < height; y++, ptr += stride )
+  {
+    for( int x = 0; x < width; x += 8 )
+    {
+      const bool    half = x + 8 > width;
+      __m128i       val  = half ? _mm_loadl_epi64( ( const __m128i* ) ( ptr + x ) ) : _mm_loadu_si128( ( const __m128i* ) ( ptr + x ) );
+      val = _mm_min_epi16( _mm_max_epi16( val, vmin ), vmax );
+
+      // scale the absolute values, then restore the sign in 32 bit before saturating to 16 bit
+      const __m128i absVal = _mm_abs_epi16( val );
+      __m128i lo = _mm_cvtepu16_epi32( absVal );
+      __m128i hi = _mm_cvtepu16_epi32( _mm_unpackhi_epi64( absVal, absVal ) );
+      lo = _mm_srai_epi32( _mm_add_epi32( _mm_mullo_epi32( lo, vscale ), vround ), CSCALE_FP_PREC );
+      hi = _mm_srai_epi32( _mm_add_epi32( _mm_mullo_epi32( hi, vscale ), vround ), CSCALE_FP_PREC );
+      lo = _mm_sign_epi32( lo, _mm_cvtepi16_epi32( val ) );
+      hi = _mm_sign_epi32( hi, _mm_cvtepi16_epi32( _mm_unpackhi_epi64( val, val ) ) );
+
+      const __m128i res = _mm_packs_epi32( lo, hi );
+      if( half )
+      {
+        _mm_storel_epi64( ( __m128i* ) ( ptr + x ), res );
+      }
+      else
+      {
+        _mm_storeu_si128( ( __m128i* ) ( ptr + x ), res );
+      }
+    }
+  }
+}
+
+// both sources are interleaved, so that one madd per 32 bit lane applies both weights
+template<X86_VEXT vext>
+void weightBi_SIMD( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, Pel* dst, int dstStride, int width, int height, int w0, int w1, int shift, int offset, const ClpRng& clpRng )
+{
+  if( width & 3 )
+  {
+    weightBiCore( src0, src0Stride, src1, src1Stride, dst, dstStride, width, height, w0, w1, shift, offset, clpRng );
+    return;
+  }
+
+  const int     weights = ( int ) ( ( uint32_t ) ( w0 & 0xffff ) | ( ( uint32_t ) w1 << 16 ) );
+  const __m128i vshift  = _mm_cvtsi32_si128( shift );
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && ( width & 15 ) == 0 )
+  {
+    const __m256i vweights = _mm256_set1_epi32( weights );
+    const __m256i voffset  = _mm256_set1_epi32( offset );
+    const __m256i vmin     = _mm256_set1_epi16( clpRng.min );
+    const __m256i vmax     = _mm256_set1_epi16( clpRng.max );
+
+    for( int y = 0; y < height; y++, src0 += src0Stride, src1 += src1Stride, dst += dstStride )
+    {
+      for( int x = 0; x < width; x += 16 )
+      {
+        const __m256i s0 = _mm256_loadu_si256( ( const __m256i* ) ( src0 + x ) );
+        const __m256i s1 = _mm256_loadu_si256( ( const __m256i* ) ( src1 + x ) );
+        __m256i lo = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( s0, s1 ), vweights ), voffset );
+        __m256i hi = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( s0, s1 ), vweights ), voffset );
+        lo = _mm256_sra_epi32( lo, vshift );
+        hi = _mm256_sra_epi32( hi, vshift );
+        const __m256i res = _mm256_min_epi16( _mm256_max_epi16( _mm256_packs_epi32( lo, hi ), vmin ), vmax );
+        _mm256_storeu_si256( ( __m256i* ) ( dst + x ), res );
+      }
+    }
+    return;
+  }
+#endif
+
+  const __m128i vweights = _mm_set1_epi32( weights );
+  const __m128i voffset  = _mm_set1_epi32( offset );
+  const __m128i vmin     = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax     = _mm_set1_epi16( clpRng.max );
+
+  for( int y = 0; y < height; y++, src0 += src0Stride, src1 += src1Stride, dst += dstStride )
+  {
+    for( int x = 0; x < width; x += 8 )
+    {
+      const bool half = x + 8 > width;
+      __m128i    s0   = half ? _mm_loadl_epi64( ( const __m128i* ) ( src0 + x ) ) : _mm_loadu_si128( ( const __m128i* ) ( src0 + x ) );
+      __m128i    s1   = half ? _mm_loadl_epi64( ( const __m128i* ) ( src1 + x ) ) : _mm_loadu_si128( ( const __m128i* ) ( src1 + x ) );
+      __m128i    lo   = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( s0, s1 ), vweights ), voffset );
+      __m128i    hi   = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( s0, s1 ), vweights ), voffset );
+      lo = _mm_sra_epi32( lo, vshift );
+      hi = _mm_sra_epi32( hi, vshift );
+      const __m128i res = _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( lo, hi ), vmin ), vmax );
+      if( half )
+      {
+        _mm_storel_epi64( ( __m128i* ) ( dst + x ), res );
+      }
+      else
+      {
+        _mm_storeu_si128( ( __m128i* ) ( dst + x ), res );
+      }
+    }
+  }
+}
+
+// the source is interleaved with zeros, so that madd yields the 32 bit products with the weight
+template<X86_VEXT vext>
+void weightUni_SIMD( const Pel* src, int srcStride, Pel* dst, int dstStride, int width, int height, int w0, int round, int shift, int offset, const ClpRng& clpRng )
+{
+  if( width & 3 )
+  {
+    weightUniCore( src, srcStride, dst, dstStride, width, height, w0, round, shift, offset, clpRng );
+    return;
+  }
+
+  const __m128i vshift = _mm_cvtsi32_si128( shift );
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && ( width & 15 ) == 0 )
+  {
+    const __m256i vweight = _mm256_set1_epi32( w0 & 0xffff );
+    const __m256i vround  = _mm256_set1_epi32( round );
+    const __m256i voffset = _mm256_set1_epi32( offset );
+    const __m256i vmin    = _mm256_set1_epi16( clpRng.min );
+    const __m256i vmax    = _mm256_set1_epi16( clpRng.max );
+    const __m256i vzero   = _mm256_setzero_si256();
+
+    for( int y = 0; y < height; y++, src += srcStride, dst += dstStride )
+    {
+      for( int x = 0; x < width; x += 16 )
+      {
+        const __m256i s = _mm256_loadu_si256( ( const __m256i* ) ( src + x ) );
+        __m256i lo = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( s, vzero ), vweight ), vround );
+        __m256i hi = _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( s, vzero ), vweight ), vround );
+        lo = _mm256_add_epi32( _mm256_sra_epi32( lo, vshift ), voffset );
+        hi = _mm256_add_epi32( _mm256_sra_epi32( hi, vshift ), voffset );
+        const __m256i res = _mm256_min_epi16( _mm256_max_epi16( _mm256_packs_epi32( lo, hi ), vmin ), vmax );
+        _mm256_storeu_si256( ( __m256i* ) ( dst + x ), res );
+      }
+    }
+    return;
+  }
+#endif
+
+  const __m128i vweight = _mm_set1_epi32( w0 & 0xffff );
+  const __m128i vround  = _mm_set1_epi32( round );
+  const __m128i voffset = _mm_set1_epi32( offset );
+  const __m128i vmin    = _mm_set1_epi16( clpRng.min );
+  const __m128i vmax    = _mm_set1_epi16( clpRng.max );
+  const __m128i vzero   = _mm_setzero_si128();
+
+  for( int y = 0; y < height; y++, src += srcStride, dst += dstStride )
+  {
+    for( int x = 0; x < width; x += 8 )
+    {
+      const bool half = x + 8 > width;
+      __m128i    s    = half ? _mm_loadl_epi64( ( const __m128i* ) ( src + x ) ) : _mm_loadu_si128( ( const __m128i* ) ( src + x ) );
+      __m128i    lo   = _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( s, vzero ), vweight ), vround );
+      __m128i    hi   = _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( s, vzero ), vweight ), vround );
+      lo = _mm_add_epi32( _mm_sra_epi32( lo, vshift ), voffset );
+      hi = _mm_add_epi32( _mm_sra_epi32( hi, vshift ), voffset );
+      const __m128i res = _mm_min_epi16( _mm_max_epi16( _mm_packs_epi32( lo, hi ), vmin ), vmax );
+      if( half )
+      {
+        _mm_storel_epi64( ( __m128i* ) ( dst + x ), res );
+      }
+      else
+      {
+        _mm_storeu_si128( ( __m128i* ) ( dst + x ), res );
+      }
+    }
+  }
+}
+
+// madd yields the sums of two squared differences, which are accumulated in unsigned 32 bit lanes for as many
+// iterations as cannot overflow for the bit depth before they are added to the 64 bit sums
+template<X86_VEXT vext>
+uint64_t calcSSE_SIMD( const Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int bitDepth )
+{
+  if( bitDepth > 15 || width < 8 )
+  {
+    return calcSSECore( src0, src0Stride, src1, src1Stride, width, height, bitDepth );
+  }
+
+  const int maxIter = 1 << std::min( 16, 31 - 2 * bitDepth );
+  uint64_t  sum     = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && width >= 16 )
+  {
+    const int     widthSimd = width & ~15;
+    const int     chunk     = maxIter << 4;
+    const __m256i vzero     = _mm256_setzero_si256();
+    __m256i       vsum64    = _mm256_setzero_si256();
+
+    for( int y = 0; y < height; y++, src0 += src0Stride, src1 += src1Stride )
+    {
+      for( int x0 = 0; x0 < widthSimd; x0 += chunk )
+      {
+        const int xEnd   = std::min( widthSimd, x0 + chunk );
+        __m256i   vsum32 = _mm256_setzero_si256();
+        for( int x = x0; x < xEnd; x += 16 )
+        {
+          const __m256i diff = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) ( src0 + x ) ), _mm256_loadu_si256( ( const __m256i* ) ( src1 + x ) ) );
+          vsum32 = _mm256_add_epi32( vsum32, _mm256_madd_epi16( diff, diff ) );
+        }
+        vsum64 = _mm256_add_epi64( vsum64, _mm256_unpacklo_epi32( vsum32, vzero ) );
+        vsum64 = _mm256_add_epi64( vsum64, _mm256_unpackhi_epi32( vsum32, vzero ) );
+      }
+      for( int x = widthSimd; x < width; x++ )
+      {
+        const int diff = src0[x] - src1[x];
+        sum += uint64_t( diff * diff );
+      }
+    }
+
+    uint64_t part[4];
+    _mm256_storeu_si256( ( __m256i* ) part, vsum64 );
+    return sum + part[0] + part[1] + part[2] + part[3];
+  }
+#endif
+
+  const int     widthSimd = width & ~7;
+  const int     chunk     = maxIter << 3;
+  const __m128i vzero     = _mm_setzero_si128();
+  __m128i       vsum64    = _mm_setzero_si128();
+
+  for( int y = 0; y < height; y++, src0 += src0Stride, src1 += src1Stride )
+  {
+    for( int x0 = 0; x0 < widthSimd; x0 += chunk )
+    {
+      const int xEnd   = std::min( widthSimd, x0 + chunk );
+      __m128i   vsum32 = _mm_setzero_si128();
+      for( int x = x0; x < xEnd; x += 8 )
+      {
+        const __m128i diff = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) ( src0 + x ) ), _mm_loadu_si128( ( const __m128i* ) ( src1 + x ) ) );
+        vsum32 = _mm_add_epi32( vsum32, _mm_madd_epi16( diff, diff ) );
+      }
+      vsum64 = _mm_add_epi64( vsum64, _mm_unpacklo_epi32( vsum32, vzero ) );
+      vsum64 = _mm_add_epi64( vsum64, _mm_unpackhi_epi32( vsum32, vzero ) );
+    }
+    for( int x = widthSimd; x < width; x++ )
+    {
+      const int diff = src0[x] - src1[x];
+      sum += uint64_t( diff * diff );
+    }
+  }
+
+  uint64_t part[2];
+  _mm_storeu_si128( ( __m128i* ) part, vsum64 );
+  return sum + part[0] + part[1];
+}
+
+// the last store of each margin is moved back to end at the margin boundary, overlapping the previous one
+template<X86_VEXT vext>
+void extendBorderHor_SIMD( Pel* ptr, int stride, int width, int height, int margin )
+{
+  if( margin < 8 )
+  {
+    extendBorderHorCore( ptr, stride, width, height, margin );
+    return;
+  }
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && margin >= 16 )
+  {
+    for( int y = 0; y < height; y++, ptr += stride )
+    {
+      Pel*          dstLeft  = ptr - margin;
+      Pel*          dstRight = ptr + width;
+      const __m256i vleft    = _mm256_set1_epi16( ptr[0] );
+      const __m256i vright   = _mm256_set1_epi16( ptr[width - 1] );
+
+      for( int x = 0; x < margin - 16; x += 16 )
+      {
+        _mm256_storeu_si256( ( __m256i* ) ( dstLeft  + x ), vleft );
+        _mm256_storeu_si256( ( __m256i* ) ( dstRight + x ), vright );
+      }
+      _mm256_storeu_si256( ( __m256i* ) ( dstLeft  + margin - 16 ), vleft );
+      _mm256_storeu_si256( ( __m256i* ) ( dstRight + margin - 16 ), vright );
+    }
+    return;
+  }
+#endif
+
+  for( int y = 0; y < height; y++, ptr += stride )
+  {
+    Pel*          dstLeft  = ptr - margin;
+    Pel*          dstRight = ptr + width;
+    const __m128i vleft    = _mm_set1_epi16( ptr[0] );
+    const __m128i vright   = _mm_set1_epi16( ptr[width - 1] );
+
+    for( int x = 0; x < margin - 8; x += 8 )
+    {
+      _mm_storeu_si128( ( __m128i* ) ( dstLeft  + x ), vleft );
+      _mm_storeu_si128( ( __m128i* ) ( dstRight + x ), vright );
+    }
+    _mm_storeu_si128( ( __m128i* ) ( dstLeft  + margin - 8 ), vleft );
+    _mm_storeu_si128( ( __m128i* ) ( dstRight + margin - 8 ), vright );
+  }
+}
+
 template<X86_VEXT vext>
 void PelBufferOps::_initPelBufOpsX86()
 {
@@ -1060,6 +1681,12 @@ void PelBufferOps::_initPelBufOpsX86()
 
   copyBuffer = copyBufferSimd<vext>;
   padding    = paddingSimd<vext>;
+  extendBorderHor = extendBorderHor_SIMD<vext>;
+  rspSignal       = rspSignal_SIMD<vext>;
+  scaleSignalInv  = scaleSignalInv_SIMD<vext>;
+  weightBi        = weightBi_SIMD<vext>;
+  weightUni       = weightUni_SIMD<vext>;
+  calcSSE         = calcSSE_SIMD<vext>;
   reco8 = reco_SSE<vext, 8>;
   reco4 = reco_SSE<vext, 4>;
 
@@ -1074,6 +1701,9 @@ void PelBufferOps::_initPelBufOpsX86()
   profGradFilter = gradFilter_SSE<vext, false>;
   applyPROF      = applyPROF_SSE<vext>;
   roundIntVector = roundIntVector_SIMD<vext>;
+
+  sampleRateConvHor = sampleRateConvHor_SIMD<vext>;
+  sampleRateConvVer = sampleRateConvVer_SIMD<vext>;
 }
 
 template void PelBufferOps::_initPelBufOpsX86<SIMDX86>();
@@ -155,14 +155,12 @@ X86_VEXT _get_x86_extensions()
     if (!(regs[1] & BIT_HAS_AVX2))  return ext;
     ext = AVX2;
 // #endif
-#ifdef USE_AVX512
     if ((xgetbv(0) & 0xE0) != 0xE0) return ext; // see if OPMASK state and ZMM are availabe and enabled
     do_cpuidex( regs, 7, 0 );
     if (!(regs[1] & BIT_HAS_AVX512F ))  return ext;
     if (!(regs[1] & BIT_HAS_AVX512DQ))  return ext;
     if (!(regs[1] & BIT_HAS_AVX512BW))  return ext;
     ext = AVX512;
-#endif
 #endif
 
     return ext;
@@ -303,7 +303,8 @@ static inline void TRANSPOSE8x8_32b_AVX2(__m256i T[8])
 
 #endif
 
-#ifdef USE_AVX512
+#if defined( USE_AVX512 ) && defined( __GNUC__ ) && !defined( __clang__ ) && __GNUC__ < 9
+// provided by the compiler since gcc 9
 
 ALWAYS_INLINE inline __m512i
 _mm512_set_epi16( int16_t x31, int16_t x30, int16_t x29, int16_t x28,
@@ -326,6 +327,33 @@ _mm512_set_epi16( int16_t x31, int16_t x30, int16_t x29, int16_t x28,
 }
 #endif
 
+#ifdef USE_AVX512
+// the unmasked AVX-512 intrinsics of gcc pass an undefined vector as merge source to the masked builtins, which gcc 12
+// reports as uninitialized once they are inlined; the zero-masking forms with a full mask compile to the same code
+#define _mm512_srai_epi32_z( a, imm )             _mm512_maskz_srai_epi32( 0xffff, a, imm )
+#define _mm512_shuffle_epi32_z( a, imm )          _mm512_maskz_shuffle_epi32( 0xffff, a, imm )
+#define _mm512_abs_epi32_z( a )                   _mm512_maskz_abs_epi32( 0xffff, a )
+#define _mm512_max_epi32_z( a, b )                _mm512_maskz_max_epi32( 0xffff, a, b )
+#define _mm512_min_epi32_z( a, b )                _mm512_maskz_min_epi32( 0xffff, a, b )
+#define _mm512_cvtepi16_epi32_z( a )              _mm512_maskz_cvtepi16_epi32( 0xffff, a )
+#define _mm512_permutexvar_epi32_z( idx, a )      _mm512_maskz_permutexvar_epi32( 0xffff, idx, a )
+#define _mm512_broadcast_i32x4_z( a )             _mm512_maskz_broadcast_i32x4( 0xffff, a )
+#define _mm512_inserti64x4_z( a, b, imm )         _mm512_maskz_inserti64x4( 0xff, a, b, imm )
+#define _mm512_extracti64x4_epi64_z( a, imm )     _mm512_maskz_extracti64x4_epi64( 0xf, a, imm )
+#define _mm512_extracti32x4_epi32_z( a, imm )     _mm512_maskz_extracti32x4_epi32( 0xf, a, imm )
+#define _mm512_castsi512_si256_z( a )             _mm512_maskz_extracti64x4_epi64( 0xf, a, 0 )
+#define _mm512_castsi512_si128_z( a )             _mm512_maskz_extracti32x4_epi32( 0xf, a, 0 )
+
+static inline int _mm512_reduce_add_epi32_z( __m512i a )
+{
+  const __m256i s256 = _mm256_add_epi32( _mm512_castsi512_si256_z( a ), _mm512_extracti64x4_epi64_z( a, 1 ) );
+  __m128i       s128 = _mm_add_epi32( _mm256_castsi256_si128( s256 ), _mm256_extracti128_si256( s256, 1 ) );
+  s128 = _mm_add_epi32( s128, _mm_shuffle_epi32( s128, 0x4e ) );
+  s128 = _mm_add_epi32( s128, _mm_shuffle_epi32( s128, 0xb1 ) );
+  return _mm_cvtsi128_si32( s128 );
+}
+#endif
+
 #ifdef ENABLE_REGISTER_PRINTING
 /* note for gcc: this helper throws a compilation error
  * because of name mangling when used with different types for R at the same time,
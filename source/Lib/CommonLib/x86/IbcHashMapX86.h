@@ -49,10 +49,42 @@ static uint32_t simdComputeCrc32c16bit(uint32_t crc, const Pel pel)
   return _mm_crc32_u16(crc, pel);
 }
 
+// the CRC is defined on the byte sequence, so several 16-bit samples per instruction give the same result as one at a
+// time; wider Pel types are hashed by their 16 lower bits, one sample per instruction
+template<X86_VEXT vext>
+static uint32_t simdComputeBlockCrc32c(uint32_t crc, const Pel* pel, const int stride, const int width, const int height)
+{
+  for (int y = 0; y < height; y++)
+  {
+    int x = 0;
+#if defined( _M_X64 ) || defined( __x86_64__ )
+    for (; sizeof(Pel) == 2 && x + 4 <= width; x += 4)
+    {
+      uint64_t val;
+      memcpy(&val, &pel[x], sizeof(val));
+      crc = (uint32_t) _mm_crc32_u64(crc, val);
+    }
+#endif
+    for (; sizeof(Pel) == 2 && x + 2 <= width; x += 2)
+    {
+      uint32_t val;
+      memcpy(&val, &pel[x], sizeof(val));
+      crc = _mm_crc32_u32(crc, val);
+    }
+    for (; x < width; x++)
+    {
+      crc = _mm_crc32_u16(crc, pel[x]);
+    }
+    pel += stride;
+  }
+  return crc;
+}
+
 template <X86_VEXT vext>
 void IbcHashMap::_initIbcHashMapX86()
 {
   m_computeCrc32c = simdComputeCrc32c16bit<vext>;
+  m_computeBlockCrc32c = simdComputeBlockCrc32c<vext>;
 }
 
 template void IbcHashMap::_initIbcHashMapX86<SIMDX86>();
@@ -41,6 +41,7 @@
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/InterpolationFilter.h"
 #include "CommonLib/TrQuant.h"
+#include "CommonLib/Quant.h"
 #include "CommonLib/RdCost.h"
 #include "CommonLib/Buffer.h"
 
@@ -59,6 +60,8 @@ void InterpolationFilter::initInterpolationFilterX86( /*int iBitDepthY, int iBit
   auto vext = read_x86_extension_flags();
   switch (vext){
   case AVX512:
+    _initInterpolationFilterX86<AVX512>(/*iBitDepthY, iBitDepthC*/);
+    break;
   case AVX2:
     _initInterpolationFilterX86<AVX2>(/*iBitDepthY, iBitDepthC*/);
     break;
@@ -81,6 +84,8 @@ void PelBufferOps::initPelBufOpsX86()
   auto vext = read_x86_extension_flags();
   switch (vext){
     case AVX512:
+      _initPelBufOpsX86<AVX512>();
+      break;
     case AVX2:
       _initPelBufOpsX86<AVX2>();
       break;
@@ -106,6 +111,8 @@ void RdCost::initRdCostX86()
   auto vext = read_x86_extension_flags();
   switch (vext){
     case AVX512:
+      _initRdCostX86<AVX512>();
+      break;
     case AVX2:
       _initRdCostX86<AVX2>();
       break;
@@ -128,6 +135,8 @@ void AffineGradientSearch::initAffineGradientSearchX86()
   auto vext = read_x86_extension_flags();
   switch ( vext ) {
   case AVX512:
+    _initAffineGradientSearchX86<AVX512>();
+    break;
   case AVX2:
     _initAffineGradientSearchX86<AVX2>();
     break;
@@ -151,6 +160,8 @@ void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
   switch ( vext )
   {
   case AVX512:
+    _initAdaptiveLoopFilterX86<AVX512>();
+    break;
   case AVX2:
     _initAdaptiveLoopFilterX86<AVX2>();
     break;
@@ -167,6 +178,56 @@ void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_LFNST
+void TrQuant::initTrQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+    _initTrQuantX86<AVX512>();
+    break;
+  case AVX2:
+    _initTrQuantX86<AVX2>();
+    break;
+  case AVX:
+    _initTrQuantX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initTrQuantX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_QUANT
+void Quant::initQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+    _initQuantX86<AVX512>();
+    break;
+  case AVX2:
+    _initQuantX86<AVX2>();
+    break;
+  case AVX:
+    _initQuantX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initQuantX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 #if ENABLE_SIMD_OPT_IBC
 void IbcHashMap::initIbcHashMapX86()
 {
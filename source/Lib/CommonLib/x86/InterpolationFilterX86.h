@@ -1164,6 +1164,122 @@ static void simdInterpolateN2_10BIT_M4(const int16_t* src, int srcStride, int16_
   }
 }
 
+template<X86_VEXT vext, int N, bool shiftBack>
+static void simdInterpolateHorM32_AVX512( const int16_t* src, int srcStride, int16_t *dst, int dstStride, int width, int height, int shift, int offset, const ClpRng& clpRng, int16_t const *coeff )
+{
+#ifdef USE_AVX512
+  const __m512i voffset  = _mm512_set1_epi32( offset );
+  const __m512i vibdimin = _mm512_set1_epi16( clpRng.min );
+  const __m512i vibdimax = _mm512_set1_epi16( clpRng.max );
+
+  // same pairing of the samples as in simdInterpolateHorM16_AVX2, for each 128-bit lane
+  const __m512i vshuf0 = _mm512_broadcast_i32x4_z( _mm_set_epi8( 0x9, 0x8, 0x7, 0x6, 0x7, 0x6, 0x5, 0x4, 0x5, 0x4, 0x3, 0x2, 0x3, 0x2, 0x1, 0x0 ) );
+  const __m512i vshuf1 = _mm512_broadcast_i32x4_z( _mm_set_epi8( 0xd, 0xc, 0xb, 0xa, 0xb, 0xa, 0x9, 0x8, 0x9, 0x8, 0x7, 0x6, 0x7, 0x6, 0x5, 0x4 ) );
+
+  __m512i vcoeff[N/2];
+  for( int i=0; i<N; i+=2 )
+  {
+    vcoeff[i/2] = _mm512_unpacklo_epi16( _mm512_set1_epi16( coeff[i] ), _mm512_set1_epi16( coeff[i+1] ) );
+  }
+
+  for( int row = 0; row < height; row++ )
+  {
+    _mm_prefetch( (const char*)( src+2*srcStride ), _MM_HINT_T0 );
+    _mm_prefetch( (const char*)( src+width+( N-1 )+2*srcStride ), _MM_HINT_T0 );
+
+    for( int col = 0; col < width; col+=32 )
+    {
+      __m512i vsrc[N/4+1];
+      for( int i=0; i<N/4+1; i++ )
+      {
+        vsrc[i] = _mm512_loadu_si512( ( const void * )&src[col+i*4] );
+      }
+
+      // vsuma: samples 0..3 of each lane, vsumb: samples 4..7 of each lane
+      __m512i vsuma = _mm512_setzero_si512();
+      __m512i vsumb = _mm512_setzero_si512();
+      for( int i=0; i<N/4; i++ )
+      {
+        vsuma = _mm512_add_epi32( vsuma, _mm512_madd_epi16( _mm512_shuffle_epi8( vsrc[i], vshuf0 ), vcoeff[2*i] ) );
+        vsuma = _mm512_add_epi32( vsuma, _mm512_madd_epi16( _mm512_shuffle_epi8( vsrc[i], vshuf1 ), vcoeff[2*i+1] ) );
+        vsumb = _mm512_add_epi32( vsumb, _mm512_madd_epi16( _mm512_shuffle_epi8( vsrc[i+1], vshuf0 ), vcoeff[2*i] ) );
+        vsumb = _mm512_add_epi32( vsumb, _mm512_madd_epi16( _mm512_shuffle_epi8( vsrc[i+1], vshuf1 ), vcoeff[2*i+1] ) );
+      }
+
+      vsuma = _mm512_srai_epi32_z( _mm512_add_epi32( vsuma, voffset ), shift );
+      vsumb = _mm512_srai_epi32_z( _mm512_add_epi32( vsumb, voffset ), shift );
+      __m512i vsum = _mm512_packs_epi32( vsuma, vsumb );
+
+      if( shiftBack )
+      { //clip
+        vsum = _mm512_min_epi16( vibdimax, _mm512_max_epi16( vibdimin, vsum ) );
+      }
+      _mm512_storeu_si512( ( void * )&dst[col], vsum );
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+#endif
+}
+
+template<X86_VEXT vext, int N, bool shiftBack>
+static void simdInterpolateVerM32_AVX512( const int16_t *src, int srcStride, int16_t *dst, int dstStride, int width, int height, int shift, int offset, const ClpRng& clpRng, int16_t const *coeff )
+{
+#ifdef USE_AVX512
+  const __m512i voffset  = _mm512_set1_epi32( offset );
+  const __m512i vibdimin = _mm512_set1_epi16( clpRng.min );
+  const __m512i vibdimax = _mm512_set1_epi16( clpRng.max );
+
+  __m512i vsrc[N];
+  __m512i vcoeff[N/2];
+  for( int i=0; i<N; i+=2 )
+  {
+    vcoeff[i/2] = _mm512_unpacklo_epi16( _mm512_set1_epi16( coeff[i] ), _mm512_set1_epi16( coeff[i+1] ) );
+  }
+
+  for( int col = 0; col < width; col+=32 )
+  {
+    const int16_t *srcCol = src + col;
+    int16_t       *dstCol = dst + col;
+
+    for( int i=0; i<N-1; i++ )
+    {
+      vsrc[i] = _mm512_loadu_si512( ( const void * )&srcCol[i * srcStride] );
+    }
+    for( int row = 0; row < height; row++ )
+    {
+      vsrc[N-1] = _mm512_loadu_si512( ( const void * )&srcCol[( N-1 ) * srcStride] );
+
+      __m512i vsuma = _mm512_setzero_si512();
+      __m512i vsumb = _mm512_setzero_si512();
+      for( int i=0; i<N; i+=2 )
+      {
+        vsuma = _mm512_add_epi32( vsuma, _mm512_madd_epi16( _mm512_unpacklo_epi16( vsrc[i], vsrc[i+1] ), vcoeff[i/2] ) );
+        vsumb = _mm512_add_epi32( vsumb, _mm512_madd_epi16( _mm512_unpackhi_epi16( vsrc[i], vsrc[i+1] ), vcoeff[i/2] ) );
+      }
+      for( int i=0; i<N-1; i++ )
+      {
+        vsrc[i] = vsrc[i+1];
+      }
+
+      vsuma = _mm512_srai_epi32_z( _mm512_add_epi32( vsuma, voffset ), shift );
+      vsumb = _mm512_srai_epi32_z( _mm512_add_epi32( vsumb, voffset ), shift );
+      __m512i vsum = _mm512_packs_epi32( vsuma, vsumb );
+
+      if( shiftBack )
+      { //clip
+        vsum = _mm512_min_epi16( vibdimax, _mm512_max_epi16( vibdimin, vsum ) );
+      }
+      _mm512_storeu_si512( ( void * )dstCol, vsum );
+
+      srcCol += srcStride;
+      dstCol += dstStride;
+    }
+  }
+#endif
+}
+
+
 template<X86_VEXT vext, int N, bool isVertical, bool isFirst, bool isLast>
 static void simdFilter( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, TFilterCoeff const *coeff, bool biMCForDMVR)
 {
@@ -1233,14 +1349,18 @@ static void simdFilter( const ClpRng& clpRng, Pel const *src, int srcStride, Pel
     {
       if( !isVertical )
       {
-        if( vext>= AVX2 )
+        if( vext>= AVX512 && !( width & 0x1f ) )
+          simdInterpolateHorM32_AVX512<vext, 8, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+        else if( vext>= AVX2 )
           simdInterpolateHorM8_AVX2<vext, 8, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
         else
           simdInterpolateHorM8<vext, 8, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
       }
       else
       {
-        if( vext>= AVX2 )
+        if( vext>= AVX512 && !( width & 0x1f ) )
+          simdInterpolateVerM32_AVX512<vext, 8, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+        else if( vext>= AVX2 )
           simdInterpolateVerM8_AVX2<vext, 8, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
         else
           simdInterpolateVerM8<vext, 8, isLast>( src, srcStride, dst, dstStride, width, height, shift, offset, clpRng, c );
@@ -1339,6 +1459,83 @@ static void simdFilter( const ClpRng& clpRng, Pel const *src, int srcStride, Pel
   }
 }
 
+template<X86_VEXT vext, int N>
+static void simdFilterScaled( const ClpRng& clpRng, Pel const *src, int srcStride, Pel *dst, int dstStride, int width, int height, const int *colOffset, TFilterCoeff const * const *coeff )
+{
+  if( width < 4 )
+  {
+    InterpolationFilter::filterScaled<N>( clpRng, src, srcStride, dst, dstStride, width, height, colOffset, coeff );
+    return;
+  }
+
+#if JVET_R0351_HIGH_BIT_DEPTH_SUPPORT
+  const int headRoom = IF_INTERNAL_FRAC_BITS( clpRng.bd );
+#else
+  const int headRoom = std::max<int>( 2, ( IF_INTERNAL_PREC - clpRng.bd ) );
+#endif
+  const int     shift   = IF_FILTER_PREC - headRoom;
+  const __m128i voffset = _mm_set1_epi32( -IF_INTERNAL_OFFS << shift );
+
+  const int widthM4 = width & ~3;
+  src -= N / 2 - 1;
+
+  // the filters change per column only, so columns are processed in groups of four over all rows
+  for( int col = 0; col < widthM4; col += 4 )
+  {
+    __m128i vcoeff[4];
+
+    for( int c = 0; c < 4; c++ )
+    {
+      vcoeff[c] = N == 8 ? _mm_loadu_si128( ( const __m128i* ) coeff[col + c] ) : _mm_loadl_epi64( ( const __m128i* ) coeff[col + c] );
+    }
+    if( N == 4 )
+    {
+      vcoeff[0] = _mm_unpacklo_epi64( vcoeff[0], vcoeff[1] );
+      vcoeff[1] = _mm_unpacklo_epi64( vcoeff[2], vcoeff[3] );
+    }
+
+    const Pel* s0 = src + colOffset[col + 0];
+    const Pel* s1 = src + colOffset[col + 1];
+    const Pel* s2 = src + colOffset[col + 2];
+    const Pel* s3 = src + colOffset[col + 3];
+    Pel*       d  = dst + col;
+
+    for( int row = 0; row < height; row++ )
+    {
+      __m128i vsum;
+
+      if( N == 8 )
+      {
+        const __m128i vsum0 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) s0 ), vcoeff[0] );
+        const __m128i vsum1 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) s1 ), vcoeff[1] );
+        const __m128i vsum2 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) s2 ), vcoeff[2] );
+        const __m128i vsum3 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) s3 ), vcoeff[3] );
+        vsum = _mm_hadd_epi32( _mm_hadd_epi32( vsum0, vsum1 ), _mm_hadd_epi32( vsum2, vsum3 ) );
+      }
+      else
+      {
+        const __m128i vsrc01 = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) s0 ), _mm_loadl_epi64( ( const __m128i* ) s1 ) );
+        const __m128i vsrc23 = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) s2 ), _mm_loadl_epi64( ( const __m128i* ) s3 ) );
+        vsum = _mm_hadd_epi32( _mm_madd_epi16( vsrc01, vcoeff[0] ), _mm_madd_epi16( vsrc23, vcoeff[1] ) );
+      }
+
+      vsum = _mm_srai_epi32( _mm_add_epi32( vsum, voffset ), shift );
+      _mm_storel_epi64( ( __m128i* ) d, _mm_packs_epi32( vsum, vsum ) );
+
+      s0 += srcStride;
+      s1 += srcStride;
+      s2 += srcStride;
+      s3 += srcStride;
+      d  += dstStride;
+    }
+  }
+
+  if( widthM4 < width )
+  {
+    InterpolationFilter::filterScaled<N>( clpRng, src + N / 2 - 1, srcStride, dst + widthM4, dstStride, width - widthM4, height, colOffset + widthM4, coeff + widthM4 );
+  }
+}
+
 template< X86_VEXT vext >
 void xWeightedGeoBlk_SSE(const PredictionUnit &pu, const uint32_t width, const uint32_t height, const ComponentID compIdx, const uint8_t splitDir, PelUnitBuf& predDst, PelUnitBuf& predSrc0, PelUnitBuf& predSrc1)
 {
@@ -1602,6 +1799,9 @@ void InterpolationFilter::_initInterpolationFilterX86()
   m_filterCopy[1][0]   = simdFilterCopy<vext, true, false>;
   m_filterCopy[1][1]   = simdFilterCopy<vext, true, true>;
 
+  m_filterScaled[0]    = simdFilterScaled<vext, 8>;
+  m_filterScaled[1]    = simdFilterScaled<vext, 4>;
+
   m_weightedGeoBlk = xWeightedGeoBlk_SSE<vext>;
 }
 
@@ -0,0 +1,273 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * \file
+ * \brief Implementation of the SIMD quantization and dequantization kernels of the Quant class
+ */
+
+#include "CommonDefX86.h"
+#include "../Quant.h"
+
+#ifdef TARGET_SIMD_X86
+#if ENABLE_SIMD_OPT_QUANT
+
+#ifdef USE_AVX2
+// only used with AVX2, the compiler vectorizes the scalar loop about as well with 128 bit
+template<X86_VEXT vext>
+static void simdDequant( const TCoeff* src, TCoeff* dst, const int numCoeff, const int scale, const int* scales, const int rightShift, const TCoeff inputMin, const TCoeff inputMax, const TCoeff outputMin, const TCoeff outputMax )
+{
+  // the input is clipped such that the products fit into 32 bit, as in the scalar implementation
+  const __m256i vinMin  = _mm256_set1_epi32( inputMin );
+  const __m256i vinMax  = _mm256_set1_epi32( inputMax );
+  const __m256i voutMin = _mm256_set1_epi32( outputMin );
+  const __m256i voutMax = _mm256_set1_epi32( outputMax );
+  const __m256i vscale  = _mm256_set1_epi32( scale );
+  int           n       = 0;
+
+  if( rightShift > 0 )
+  {
+    const __m256i vadd   = _mm256_set1_epi32( 1 << ( rightShift - 1 ) );
+    const __m128i vshift = _mm_cvtsi32_si128( rightShift );
+
+    for( ; n + 8 <= numCoeff; n += 8 )
+    {
+      __m256i vcoef = _mm256_loadu_si256( ( const __m256i* ) ( src + n ) );
+      vcoef = _mm256_min_epi32( _mm256_max_epi32( vcoef, vinMin ), vinMax );
+      vcoef = _mm256_mullo_epi32( vcoef, scales ? _mm256_loadu_si256( ( const __m256i* ) ( scales + n ) ) : vscale );
+      vcoef = _mm256_sra_epi32( _mm256_add_epi32( vcoef, vadd ), vshift );
+      vcoef = _mm256_min_epi32( _mm256_max_epi32( vcoef, voutMin ), voutMax );
+      _mm256_storeu_si256( ( __m256i* ) ( dst + n ), vcoef );
+    }
+  }
+  else
+  {
+    const __m128i vshift = _mm_cvtsi32_si128( -rightShift );
+
+    for( ; n + 8 <= numCoeff; n += 8 )
+    {
+      __m256i vcoef = _mm256_loadu_si256( ( const __m256i* ) ( src + n ) );
+      vcoef = _mm256_min_epi32( _mm256_max_epi32( vcoef, vinMin ), vinMax );
+      vcoef = _mm256_mullo_epi32( vcoef, scales ? _mm256_loadu_si256( ( const __m256i* ) ( scales + n ) ) : vscale );
+      vcoef = _mm256_sll_epi32( vcoef, vshift );
+      vcoef = _mm256_min_epi32( _mm256_max_epi32( vcoef, voutMin ), voutMax );
+      _mm256_storeu_si256( ( __m256i* ) ( dst + n ), vcoef );
+    }
+  }
+
+  if( n < numCoeff )
+  {
+    Quant::dequantCore( src + n, dst + n, numCoeff - n, scale, scales ? scales + n : nullptr, rightShift, inputMin, inputMax, outputMin, outputMax );
+  }
+}
+#endif
+
+// the products abs( coeff ) * scale need 64 bit, they are computed separately for the even and the odd 32 bit lanes
+template<X86_VEXT vext>
+static TCoeff simdQuant( const TCoeff* src, TCoeff* dst, TCoeff* deltaU, const int numCoeff, const int scale, const int* scales, const int64_t add, const int qBits, const TCoeff outputMin, const TCoeff outputMax )
+{
+  // the remainder ( tmpLevel - ( quantisedMagnitude << qBits ) ) only fits into 32 bit for qBits < 32
+  if( qBits > 31 )
+  {
+    return Quant::quantCore( src, dst, deltaU, numCoeff, scale, scales, add, qBits, outputMin, outputMax );
+  }
+
+  const __m128i vqBits  = _mm_cvtsi32_si128( qBits );
+  const __m128i vqBits8 = _mm_cvtsi32_si128( qBits - 8 );
+  TCoeff        absSum  = 0;
+  int           n       = 0;
+
+#ifdef USE_AVX2
+  {
+    const __m256i vadd    = _mm256_set1_epi64x( add );
+    const __m256i vscale  = _mm256_set1_epi32( scale );
+    const __m256i voutMin = _mm256_set1_epi32( outputMin );
+    const __m256i voutMax = _mm256_set1_epi32( outputMax );
+    __m256i       vsum    = _mm256_setzero_si256();
+
+    for( ; n + 8 <= numCoeff; n += 8 )
+    {
+      const __m256i vcoef  = _mm256_loadu_si256( ( const __m256i* ) ( src + n ) );
+      const __m256i vabs   = _mm256_abs_epi32( vcoef );
+      const __m256i vsc    = scales ? _mm256_loadu_si256( ( const __m256i* ) ( scales + n ) ) : vscale;
+
+      const __m256i vprodE = _mm256_mul_epu32( vabs, vsc );
+      const __m256i vprodO = _mm256_mul_epu32( _mm256_srli_epi64( vabs, 32 ), _mm256_srli_epi64( vsc, 32 ) );
+      const __m256i vqE    = _mm256_srl_epi64( _mm256_add_epi64( vprodE, vadd ), vqBits );
+      const __m256i vqO    = _mm256_srl_epi64( _mm256_add_epi64( vprodO, vadd ), vqBits );
+      const __m256i vremE  = _mm256_sub_epi64( vprodE, _mm256_sll_epi64( vqE, vqBits ) );
+      const __m256i vremO  = _mm256_sub_epi64( vprodO, _mm256_sll_epi64( vqO, vqBits ) );
+
+      const __m256i vq     = _mm256_blend_epi32( vqE,   _mm256_slli_epi64( vqO,   32 ), 0xAA );
+      const __m256i vrem   = _mm256_blend_epi32( vremE, _mm256_slli_epi64( vremO, 32 ), 0xAA );
+
+      _mm256_storeu_si256( ( __m256i* ) ( deltaU + n ), _mm256_sra_epi32( vrem, vqBits8 ) );
+      vsum = _mm256_add_epi32( vsum, vq );
+
+      const __m256i vlevel = _mm256_min_epi32( _mm256_max_epi32( _mm256_sign_epi32( vq, vcoef ), voutMin ), voutMax );
+      _mm256_storeu_si256( ( __m256i* ) ( dst + n ), vlevel );
+    }
+
+    __m128i vsum128 = _mm_add_epi32( _mm256_castsi256_si128( vsum ), _mm256_extracti128_si256( vsum, 1 ) );
+    vsum128 = _mm_hadd_epi32( vsum128, vsum128 );
+    vsum128 = _mm_hadd_epi32( vsum128, vsum128 );
+    absSum += _mm_cvtsi128_si32( vsum128 );
+  }
+#endif
+  {
+    const __m128i vadd    = _mm_set1_epi64x( add );
+    const __m128i vscale  = _mm_set1_epi32( scale );
+    const __m128i voutMin = _mm_set1_epi32( outputMin );
+    const __m128i voutMax = _mm_set1_epi32( outputMax );
+    __m128i       vsum    = _mm_setzero_si128();
+
+    for( ; n + 4 <= numCoeff; n += 4 )
+    {
+      const __m128i vcoef  = _mm_loadu_si128( ( const __m128i* ) ( src + n ) );
+      const __m128i vabs   = _mm_abs_epi32( vcoef );
+      const __m128i vsc    = scales ? _mm_loadu_si128( ( const __m128i* ) ( scales + n ) ) : vscale;
+
+      const __m128i vprodE = _mm_mul_epu32( vabs, vsc );
+      const __m128i vprodO = _mm_mul_epu32( _mm_srli_epi64( vabs, 32 ), _mm_srli_epi64( vsc, 32 ) );
+      const __m128i vqE    = _mm_srl_epi64( _mm_add_epi64( vprodE, vadd ), vqBits );
+      const __m128i vqO    = _mm_srl_epi64( _mm_add_epi64( vprodO, vadd ), vqBits );
+      const __m128i vremE  = _mm_sub_epi64( vprodE, _mm_sll_epi64( vqE, vqBits ) );
+      const __m128i vremO  = _mm_sub_epi64( vprodO, _mm_sll_epi64( vqO, vqBits ) );
+
+      const __m128i vq     = _mm_blend_epi16( vqE,   _mm_slli_epi64( vqO,   32 ), 0xCC );
+      const __m128i vrem   = _mm_blend_epi16( vremE, _mm_slli_epi64( vremO, 32 ), 0xCC );
+
+      _mm_storeu_si128( ( __m128i* ) ( deltaU + n ), _mm_sra_epi32( vrem, vqBits8 ) );
+      vsum = _mm_add_epi32( vsum, vq );
+
+      const __m128i vlevel = _mm_min_epi32( _mm_max_epi32( _mm_sign_epi32( vq, vcoef ), voutMin ), voutMax );
+      _mm_storeu_si128( ( __m128i* ) ( dst + n ), vlevel );
+    }
+
+    vsum = _mm_hadd_epi32( vsum, vsum );
+    vsum = _mm_hadd_epi32( vsum, vsum );
+    absSum += _mm_cvtsi128_si32( vsum );
+  }
+
+  if( n < numCoeff )
+  {
+    absSum += Quant::quantCore( src + n, dst + n, deltaU + n, numCoeff - n, scale, scales ? scales + n : nullptr, add, qBits, outputMin, outputMax );
+  }
+
+  return absSum;
+}
+
+// the 64 bit products are compared against the threshold by the sign of ( threshold - 1 - product ), SSE4.1 has no 64 bit compare
+template<X86_VEXT vext>
+static bool simdIsZeroQuant( const TCoeff* src, const int stride, const int width, const int height, const int scale, const int* scales, const int64_t threshold )
+{
+  if( width & 3 )
+  {
+    return Quant::isZeroQuantCore( src, stride, width, height, scale, scales, threshold );
+  }
+
+#ifdef USE_AVX2
+  if( ( width & 7 ) == 0 )
+  {
+    const __m256i vthres = _mm256_set1_epi64x( threshold - 1 );
+    const __m256i vscale = _mm256_set1_epi32( scale );
+
+    for( int y = 0; y < height; y++, src += stride )
+    {
+      const int* scaleRow = scales ? scales + y * stride : nullptr;
+      __m256i    vneg     = _mm256_setzero_si256();
+
+      for( int x = 0; x < width; x += 8 )
+      {
+        const __m256i vabs = _mm256_abs_epi32( _mm256_loadu_si256( ( const __m256i* ) ( src + x ) ) );
+        const __m256i vsc  = scaleRow ? _mm256_loadu_si256( ( const __m256i* ) ( scaleRow + x ) ) : vscale;
+
+        const __m256i vprodE = _mm256_mul_epu32( vabs, vsc );
+        const __m256i vprodO = _mm256_mul_epu32( _mm256_srli_epi64( vabs, 32 ), _mm256_srli_epi64( vsc, 32 ) );
+        vneg = _mm256_or_si256( vneg, _mm256_sub_epi64( vthres, vprodE ) );
+        vneg = _mm256_or_si256( vneg, _mm256_sub_epi64( vthres, vprodO ) );
+      }
+
+      if( _mm256_movemask_pd( _mm256_castsi256_pd( vneg ) ) )
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+#endif
+
+  const __m128i vthres = _mm_set1_epi64x( threshold - 1 );
+  const __m128i vscale = _mm_set1_epi32( scale );
+
+  for( int y = 0; y < height; y++, src += stride )
+  {
+    const int* scaleRow = scales ? scales + y * stride : nullptr;
+    __m128i    vneg     = _mm_setzero_si128();
+
+    for( int x = 0; x < width; x += 4 )
+    {
+      const __m128i vabs = _mm_abs_epi32( _mm_loadu_si128( ( const __m128i* ) ( src + x ) ) );
+      const __m128i vsc  = scaleRow ? _mm_loadu_si128( ( const __m128i* ) ( scaleRow + x ) ) : vscale;
+
+      const __m128i vprodE = _mm_mul_epu32( vabs, vsc );
+      const __m128i vprodO = _mm_mul_epu32( _mm_srli_epi64( vabs, 32 ), _mm_srli_epi64( vsc, 32 ) );
+      vneg = _mm_or_si128( vneg, _mm_sub_epi64( vthres, vprodE ) );
+      vneg = _mm_or_si128( vneg, _mm_sub_epi64( vthres, vprodO ) );
+    }
+
+    if( _mm_movemask_pd( _mm_castsi128_pd( vneg ) ) )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template <X86_VEXT vext>
+void Quant::_initQuantX86()
+{
+#ifdef USE_AVX2
+  m_dequantBlk  = simdDequant<vext>;
+#endif
+  m_quantBlk    = simdQuant<vext>;
+  m_isZeroQuant = simdIsZeroQuant<vext>;
+}
+
+template void Quant::_initQuantX86<SIMDX86>();
+
+#endif // ENABLE_SIMD_OPT_QUANT
+#endif // TARGET_SIMD_X86
@@ -207,6 +207,29 @@ Distortion RdCost::xGetSSE_NxN_SIMD( const DistParam &rcDtParam )
   return uiRet;
 }
 
+#ifdef USE_AVX512
+static inline uint32_t xGetSAD_AVX512( const short* pSrc1, const int iStrideSrc1, const short* pSrc2, const int iStrideSrc2, const int iCols, const int iRows, const int iSubStep )
+{
+  // Do for width that multiple of 32, the 16-bit row sums of at most 4 blocks of 10-bit samples cannot overflow
+  const __m512i vone   = _mm512_set1_epi16( 1 );
+  __m512i       vsum32 = _mm512_setzero_si512();
+  for( int iY = 0; iY < iRows; iY += iSubStep )
+  {
+    __m512i vsum16 = _mm512_setzero_si512();
+    for( int iX = 0; iX < iCols; iX += 32 )
+    {
+      __m512i vsrc1 = _mm512_loadu_si512( ( const void* )( &pSrc1[iX] ) );
+      __m512i vsrc2 = _mm512_loadu_si512( ( const void* )( &pSrc2[iX] ) );
+      vsum16 = _mm512_add_epi16( vsum16, _mm512_abs_epi16( _mm512_sub_epi16( vsrc1, vsrc2 ) ) );
+    }
+    vsum32 = _mm512_add_epi32( vsum32, _mm512_madd_epi16( vsum16, vone ) );
+    pSrc1 += iStrideSrc1;
+    pSrc2 += iStrideSrc2;
+  }
+  return uint32_t( _mm512_reduce_add_epi32_z( vsum32 ) );
+}
+#endif
+
 template< X86_VEXT vext >
 Distortion RdCost::xGetSAD_SIMD( const DistParam &rcDtParam )
 {
@@ -223,6 +246,13 @@ Distortion RdCost::xGetSAD_SIMD( const DistParam &rcDtParam )
   const int iStrideSrc2 = rcDtParam.cur.stride * iSubStep;
 
   uint32_t uiSum = 0;
+#ifdef USE_AVX512
+  if( vext >= AVX512 && ( iCols & 31 ) == 0 )
+  {
+    uiSum = xGetSAD_AVX512( pSrc1, iStrideSrc1, pSrc2, iStrideSrc2, iCols, iRows, iSubStep );
+  }
+  else
+#endif
   if( vext >= AVX2 && ( iCols & 15 ) == 0 )
   {
 #ifdef USE_AVX2
@@ -401,6 +431,13 @@ Distortion RdCost::xGetSAD_NxN_SIMD( const DistParam &rcDtParam )
   }
   else
   {
+#ifdef USE_AVX512
+    if( vext >= AVX512 && iWidth >= 32 )
+    {
+      uiSum = xGetSAD_AVX512( pSrc1, iStrideSrc1, pSrc2, iStrideSrc2, iWidth, iRows, iSubStep );
+    }
+    else
+#endif
     if( vext >= AVX2 && iWidth >= 16 )
     {
 #ifdef USE_AVX2
@@ -2061,6 +2098,171 @@ static uint32_t xCalcHAD8x16_AVX2( const Pel* piOrg, const Pel* piCur, const int
   return (sad);
 }
 
+#ifdef USE_AVX512
+/// Hadamard butterfly between the 32-bit elements i and i ^ D of a register; the sign of the difference is
+/// irrelevant for the SATD, and the sum always ends up in the element with the lower index
+template<int D>
+static inline __m512i xHadButterfly_AVX512( const __m512i x )
+{
+  constexpr __mmask16 upper = D == 1 ? 0xaaaa : D == 2 ? 0xcccc : D == 4 ? 0xf0f0 : 0xff00;
+  const __m512i idx  = _mm512_xor_si512( _mm512_set_epi32( 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 ), _mm512_set1_epi32( D ) );
+  const __m512i swap = _mm512_permutexvar_epi32_z( idx, x );
+  return _mm512_mask_sub_epi32( _mm512_add_epi32( x, swap ), upper, swap, x );
+}
+
+/// 8-point Hadamard transform between the registers m[0..7]
+static inline void xHadVertical8_AVX512( __m512i m[8] )
+{
+  for( int d = 4; d > 0; d >>= 1 )
+  {
+    for( int i = 0; i < 8; i++ )
+    {
+      if( !( i & d ) )
+      {
+        const __m512i t = m[i];
+        m[i]     = _mm512_add_epi32( t, m[i + d] );
+        m[i + d] = _mm512_sub_epi32( t, m[i + d] );
+      }
+    }
+  }
+}
+
+static inline __m512i xLoadDiff16_AVX512( const Pel* piOrg, const Pel* piCur )
+{
+  return _mm512_cvtepi16_epi32_z( _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* ) piOrg ), _mm256_loadu_si256( ( const __m256i* ) piCur ) ) );
+}
+
+static inline __m256i xLoadDiff8_AVX512( const Pel* piOrg, const Pel* piCur )
+{
+  return _mm256_cvtepi16_epi32( _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) piOrg ), _mm_loadu_si128( ( const __m128i* ) piCur ) ) );
+}
+#endif
+
+static uint32_t xCalcHAD16x8_AVX512( const Pel* piOrg, const Pel* piCur, const int iStrideOrg, const int iStrideCur, const int iBitDepth )
+{
+  uint32_t sad = 0;
+
+#ifdef USE_AVX512
+  // one row of 16 differences per register
+  __m512i m[8];
+  for( int k = 0; k < 8; k++ )
+  {
+    m[k] = xLoadDiff16_AVX512( piOrg, piCur );
+    piCur += iStrideCur;
+    piOrg += iStrideOrg;
+  }
+
+  xHadVertical8_AVX512( m );
+
+  __m512i vsum = _mm512_setzero_si512();
+  for( int k = 0; k < 8; k++ )
+  {
+    m[k] = xHadButterfly_AVX512<1>( m[k] );
+    m[k] = xHadButterfly_AVX512<2>( m[k] );
+    m[k] = xHadButterfly_AVX512<4>( m[k] );
+    m[k] = _mm512_abs_epi32_z( xHadButterfly_AVX512<8>( m[k] ) );
+    vsum = _mm512_add_epi32( vsum, m[k] );
+  }
+
+  int sad2 = _mm512_reduce_add_epi32_z( vsum );
+#if JVET_R0164_MEAN_SCALED_SATD
+  const int absDc = _mm_cvtsi128_si32( _mm512_castsi512_si128_z( m[0] ) );
+  sad2 -= absDc;
+  sad2 += absDc >> 2;
+#endif
+  sad = (uint32_t)(sad2 / sqrt(16.0 * 8) * 2);
+#endif //USE_AVX512
+
+  return (sad);
+}
+
+static uint32_t xCalcHAD8x16_AVX512( const Pel* piOrg, const Pel* piCur, const int iStrideOrg, const int iStrideCur, const int iBitDepth )
+{
+  uint32_t sad = 0;
+
+#ifdef USE_AVX512
+  // rows k and k + 8 in the lower and upper half of register k
+  __m512i m[8];
+  for( int k = 0; k < 8; k++ )
+  {
+    const __m256i r0 = xLoadDiff8_AVX512( piOrg, piCur );
+    const __m256i r1 = xLoadDiff8_AVX512( piOrg + 8 * iStrideOrg, piCur + 8 * iStrideCur );
+    m[k] = _mm512_inserti64x4_z( _mm512_castsi256_si512( r0 ), r1, 1 );
+    piCur += iStrideCur;
+    piOrg += iStrideOrg;
+  }
+
+  for( int k = 0; k < 8; k++ )
+  {
+    m[k] = xHadButterfly_AVX512<8>( m[k] );
+  }
+  xHadVertical8_AVX512( m );
+
+  __m512i vsum = _mm512_setzero_si512();
+  for( int k = 0; k < 8; k++ )
+  {
+    m[k] = xHadButterfly_AVX512<1>( m[k] );
+    m[k] = xHadButterfly_AVX512<2>( m[k] );
+    m[k] = _mm512_abs_epi32_z( xHadButterfly_AVX512<4>( m[k] ) );
+    vsum = _mm512_add_epi32( vsum, m[k] );
+  }
+
+  int sad2 = _mm512_reduce_add_epi32_z( vsum );
+#if JVET_R0164_MEAN_SCALED_SATD
+  const int absDc = _mm_cvtsi128_si32( _mm512_castsi512_si128_z( m[0] ) );
+  sad2 -= absDc;
+  sad2 += absDc >> 2;
+#endif
+  sad = (uint32_t)(sad2 / sqrt(16.0 * 8) * 2);
+#endif //USE_AVX512
+
+  return (sad);
+}
+
+static uint32_t xCalcHAD16x16_AVX512( const Pel* piOrg, const Pel* piCur, const int iStrideOrg, const int iStrideCur, const int iBitDepth )
+{
+  uint32_t sad = 0;
+
+#ifdef USE_AVX512
+  // four 8x8 transforms, two side by side in the halves of the registers
+  for( int l = 0; l < 2; l++ )
+  {
+    __m512i m[8];
+    for( int k = 0; k < 8; k++ )
+    {
+      m[k] = xLoadDiff16_AVX512( piOrg, piCur );
+      piCur += iStrideCur;
+      piOrg += iStrideOrg;
+    }
+
+    xHadVertical8_AVX512( m );
+
+    __m512i vsum = _mm512_setzero_si512();
+    for( int k = 0; k < 8; k++ )
+    {
+      m[k] = xHadButterfly_AVX512<1>( m[k] );
+      m[k] = xHadButterfly_AVX512<2>( m[k] );
+      m[k] = _mm512_abs_epi32_z( xHadButterfly_AVX512<4>( m[k] ) );
+      vsum = _mm512_add_epi32( vsum, m[k] );
+    }
+
+    for( int b = 0; b < 2; b++ )
+    {
+      uint32_t tmp = _mm512_reduce_add_epi32_z( _mm512_maskz_mov_epi32( b ? 0xff00 : 0x00ff, vsum ) );
+#if JVET_R0164_MEAN_SCALED_SATD
+      const uint32_t absDc = _mm_cvtsi128_si32( b ? _mm512_extracti32x4_epi32_z( m[0], 2 ) : _mm512_castsi512_si128_z( m[0] ) );
+      tmp -= absDc;
+      tmp += absDc >> 2;
+#endif
+      tmp  = ( ( tmp + 2 ) >> 2 );
+      sad += tmp;
+    }
+  }
+#endif
+
+  return ( sad );
+}
+
 template< X86_VEXT vext >
 Distortion RdCost::xGetSADwMask_SIMD( const DistParam &rcDtParam )
 {
@@ -2176,7 +2378,9 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
     {
       for( x = 0; x < iCols; x += 16 )
       {
-        if( vext >= AVX2 )
+        if( vext >= AVX512 )
+          uiSum += xCalcHAD16x8_AVX512( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
+        else if( vext >= AVX2 )
           uiSum += xCalcHAD16x8_AVX2( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
         else
           uiSum += xCalcHAD16x8_SSE( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
@@ -2191,7 +2395,9 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
     {
       for( x = 0; x < iCols; x += 8 )
       {
-        if( vext >= AVX2 )
+        if( vext >= AVX512 )
+          uiSum += xCalcHAD8x16_AVX512( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
+        else if( vext >= AVX2 )
           uiSum += xCalcHAD8x16_AVX2( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
         else
           uiSum += xCalcHAD8x16_SSE( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
@@ -2232,7 +2438,10 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
     {
       for( x = 0; x < iCols; x += 16 )
       {
-        uiSum += xCalcHAD16x16_AVX2( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
+        if( vext >= AVX512 )
+          uiSum += xCalcHAD16x16_AVX512( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
+        else
+          uiSum += xCalcHAD16x16_AVX2( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur, iBitDepth );
       }
       piOrg += iOffsetOrg;
       piCur += iOffsetCur;
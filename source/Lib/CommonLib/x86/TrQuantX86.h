@@ -0,0 +1,240 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ * \brief Implementation of the SIMD LFNST kernels of the TrQuant class
+ */
+
+#include "CommonDefX86.h"
+#include "../TrQuant.h"
+
+#ifdef TARGET_SIMD_X86
+#if ENABLE_SIMD_OPT_LFNST
+
+#ifdef USE_AVX2
+// the 16 bit multiply-add kernels are exact if all input values fit into 16 bit, which is the case for the dynamic range
+// of 15 bit used without extended precision processing
+static inline bool fitsInt16( const TCoeff* src, const int size )
+{
+  const __m256i vmax = _mm256_set1_epi32( 32767 );
+  const __m256i vmin = _mm256_set1_epi32( -32768 );
+  __m256i       vout = _mm256_setzero_si256();
+  for( int i = 0; i < size; i += 8 )
+  {
+    const __m256i vsrc = _mm256_loadu_si256( ( const __m256i* ) ( src + i ) );
+    vout = _mm256_or_si256( vout, _mm256_or_si256( _mm256_cmpgt_epi32( vsrc, vmax ), _mm256_cmpgt_epi32( vmin, vsrc ) ) );
+  }
+  return _mm256_testz_si256( vout, vout );
+}
+#endif
+
+// the sums are accumulated in 32 bit as in the scalar implementation, so the order of the additions does not matter
+template<X86_VEXT vext>
+static void simdFwdLfnst( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize )
+{
+  CHECKD( ( trSize & 15 ) != 0 || ( zeroOutSize & 7 ) != 0, "Unsupported LFNST size" );
+
+#ifdef USE_AVX2
+  if( !fitsInt16( src, trSize ) )
+  {
+    TrQuant::fwdLfnstCore( src, dst, trMat, trSize, zeroOutSize );
+    return;
+  }
+
+  // the input vector is kept in registers as 16 bit values, eight rows of the matrix are processed per iteration
+  const int numVec = trSize >> 4;
+  __m256i   vsrc[3];
+  for( int i = 0; i < numVec; i++ )
+  {
+    const __m256i vlo = _mm256_loadu_si256( ( const __m256i* ) ( src + 16 * i ) );
+    const __m256i vhi = _mm256_loadu_si256( ( const __m256i* ) ( src + 16 * i + 8 ) );
+    vsrc[i] = _mm256_permute4x64_epi64( _mm256_packs_epi32( vlo, vhi ), 0xd8 );
+  }
+
+  const __m256i vrnd = _mm256_set1_epi32( 64 );
+
+  for( int j = 0; j < zeroOutSize; j += 8 )
+  {
+    __m256i vsum[8];
+    for( int k = 0; k < 8; k++ )
+    {
+      __m256i vacc = _mm256_setzero_si256();
+      for( int i = 0; i < numVec; i++ )
+      {
+        const __m256i vmat = _mm256_cvtepi8_epi16( _mm_loadu_si128( ( const __m128i* ) ( trMat + 16 * i ) ) );
+        vacc = _mm256_add_epi32( vacc, _mm256_madd_epi16( vsrc[i], vmat ) );
+      }
+      vsum[k] = vacc;
+      trMat  += trSize;
+    }
+
+    // reduce the eight row sums into one vector
+    const __m256i vh01   = _mm256_hadd_epi32( vsum[0], vsum[1] );
+    const __m256i vh23   = _mm256_hadd_epi32( vsum[2], vsum[3] );
+    const __m256i vh45   = _mm256_hadd_epi32( vsum[4], vsum[5] );
+    const __m256i vh67   = _mm256_hadd_epi32( vsum[6], vsum[7] );
+    const __m256i vh0123 = _mm256_hadd_epi32( vh01, vh23 );
+    const __m256i vh4567 = _mm256_hadd_epi32( vh45, vh67 );
+    __m256i       vres   = _mm256_add_epi32( _mm256_permute2x128_si256( vh0123, vh4567, 0x20 ), _mm256_permute2x128_si256( vh0123, vh4567, 0x31 ) );
+
+    vres = _mm256_srai_epi32( _mm256_add_epi32( vres, vrnd ), 7 );
+    _mm256_storeu_si256( ( __m256i* ) ( dst + j ), vres );
+  }
+#else
+  const int numVec = trSize >> 2;
+  __m128i   vsrc[12];
+  for( int i = 0; i < numVec; i++ )
+  {
+    vsrc[i] = _mm_loadu_si128( ( const __m128i* ) ( src + 4 * i ) );
+  }
+
+  const __m128i vrnd = _mm_set1_epi32( 64 );
+
+  for( int j = 0; j < zeroOutSize; j += 4 )
+  {
+    __m128i vsum[4];
+    for( int k = 0; k < 4; k++ )
+    {
+      __m128i vacc = _mm_setzero_si128();
+      for( int i = 0; i < numVec; i++ )
+      {
+        const __m128i vmat = _mm_cvtepi8_epi32( _mm_cvtsi32_si128( *( const int32_t* ) ( trMat + 4 * i ) ) );
+        vacc = _mm_add_epi32( vacc, _mm_mullo_epi32( vsrc[i], vmat ) );
+      }
+      vsum[k] = vacc;
+      trMat  += trSize;
+    }
+
+    __m128i vres = _mm_hadd_epi32( _mm_hadd_epi32( vsum[0], vsum[1] ), _mm_hadd_epi32( vsum[2], vsum[3] ) );
+
+    vres = _mm_srai_epi32( _mm_add_epi32( vres, vrnd ), 7 );
+    _mm_storeu_si128( ( __m128i* ) ( dst + j ), vres );
+  }
+#endif
+}
+
+// the matrix is read row by row, zero input coefficients (the common case after quantization) are skipped
+template<X86_VEXT vext>
+static void simdInvLfnst( const TCoeff* src, TCoeff* dst, const int8_t* trMat, const int trSize, const int zeroOutSize, const TCoeff outputMin, const TCoeff outputMax )
+{
+  CHECKD( ( trSize & 15 ) != 0, "Unsupported LFNST size" );
+
+#ifdef USE_AVX2
+  if( !fitsInt16( src, zeroOutSize ) )
+  {
+    TrQuant::invLfnstCore( src, dst, trMat, trSize, zeroOutSize, outputMin, outputMax );
+    return;
+  }
+
+  // two rows of the matrix are interleaved, so that each 16 bit multiply-add covers two input coefficients
+  const int numVec = trSize >> 3;
+  __m256i   vacc[6];
+  for( int k = 0; k < numVec; k++ )
+  {
+    vacc[k] = _mm256_setzero_si256();
+  }
+
+  for( int i = 0; i < zeroOutSize; i += 2, trMat += 2 * trSize )
+  {
+    if( src[i] == 0 && src[i + 1] == 0 )
+    {
+      continue;
+    }
+
+    const __m256i vcoef = _mm256_set1_epi32( ( uint32_t ) ( src[i] & 0xffff ) | ( ( uint32_t ) src[i + 1] << 16 ) );
+    for( int k = 0; k < numVec; k += 2 )
+    {
+      const __m128i vrow0 = _mm_loadu_si128( ( const __m128i* ) ( trMat          + 8 * k ) );
+      const __m128i vrow1 = _mm_loadu_si128( ( const __m128i* ) ( trMat + trSize + 8 * k ) );
+      vacc[k    ] = _mm256_add_epi32( vacc[k    ], _mm256_madd_epi16( vcoef, _mm256_cvtepi8_epi16( _mm_unpacklo_epi8( vrow0, vrow1 ) ) ) );
+      vacc[k + 1] = _mm256_add_epi32( vacc[k + 1], _mm256_madd_epi16( vcoef, _mm256_cvtepi8_epi16( _mm_unpackhi_epi8( vrow0, vrow1 ) ) ) );
+    }
+  }
+  const __m256i vrnd = _mm256_set1_epi32( 64 );
+  const __m256i vmin = _mm256_set1_epi32( outputMin );
+  const __m256i vmax = _mm256_set1_epi32( outputMax );
+
+  for( int k = 0; k < numVec; k++ )
+  {
+    __m256i vres = _mm256_srai_epi32( _mm256_add_epi32( vacc[k], vrnd ), 7 );
+    vres = _mm256_min_epi32( _mm256_max_epi32( vres, vmin ), vmax );
+    _mm256_storeu_si256( ( __m256i* ) ( dst + 8 * k ), vres );
+  }
+#else
+  const int numVec = trSize >> 2;
+  __m128i   vacc[12];
+  for( int k = 0; k < numVec; k++ )
+  {
+    vacc[k] = _mm_setzero_si128();
+  }
+
+  for( int i = 0; i < zeroOutSize; i++, trMat += trSize )
+  {
+    if( src[i] == 0 )
+    {
+      continue;
+    }
+
+    const __m128i vcoef = _mm_set1_epi32( src[i] );
+    for( int k = 0; k < numVec; k++ )
+    {
+      const __m128i vmat = _mm_cvtepi8_epi32( _mm_cvtsi32_si128( *( const int32_t* ) ( trMat + 4 * k ) ) );
+      vacc[k] = _mm_add_epi32( vacc[k], _mm_mullo_epi32( vcoef, vmat ) );
+    }
+  }
+
+  const __m128i vrnd = _mm_set1_epi32( 64 );
+  const __m128i vmin = _mm_set1_epi32( outputMin );
+  const __m128i vmax = _mm_set1_epi32( outputMax );
+
+  for( int k = 0; k < numVec; k++ )
+  {
+    __m128i vres = _mm_srai_epi32( _mm_add_epi32( vacc[k], vrnd ), 7 );
+    vres = _mm_min_epi32( _mm_max_epi32( vres, vmin ), vmax );
+    _mm_storeu_si128( ( __m128i* ) ( dst + 4 * k ), vres );
+  }
+#endif
+}
+
+template <X86_VEXT vext>
+void TrQuant::_initTrQuantX86()
+{
+  m_fwdLfnst = simdFwdLfnst<vext>;
+  m_invLfnst = simdInvLfnst<vext>;
+}
+
+template void TrQuant::_initTrQuantX86<SIMDX86>();
+
+#endif // ENABLE_SIMD_OPT_LFNST
+#endif // TARGET_SIMD_X86
@@ -0,0 +1 @@
+#include "../AffineGradientSearchX86.h"
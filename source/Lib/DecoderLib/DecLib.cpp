@@ -42,6 +42,7 @@
 #include "CommonLib/dtrace_buffer.h"
 #include "CommonLib/Buffer.h"
 #include "CommonLib/UnitTools.h"
+#include "CommonLib/StageProfiler.h"
 
 #include <fstream>
 #include <set>
@@ -538,7 +539,7 @@ Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_
   {
     pcPic = new Picture();
 
-    pcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, true, layerId );
+    pcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), Picture::getPicMargin( sps ), true, layerId );
 
     m_cListPic.push_back( pcPic );
 
@@ -574,14 +575,14 @@ Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_
 
     m_cListPic.push_back( pcPic );
 
-    pcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, true, layerId );
+    pcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), Picture::getPicMargin( sps ), true, layerId );
   }
   else
   {
-    if( !pcPic->Y().Size::operator==( Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ) ) || pps.pcv->maxCUWidth != sps.getMaxCUWidth() || pps.pcv->maxCUHeight != sps.getMaxCUHeight() || pcPic->layerId != layerId )
+    if( !pcPic->Y().Size::operator==( Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ) ) || pps.pcv->maxCUWidth != sps.getMaxCUWidth() || pps.pcv->maxCUHeight != sps.getMaxCUHeight() || pcPic->layerId != layerId || pcPic->margin != Picture::getPicMargin( sps ) )
     {
       pcPic->destroy();
-      pcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, true, layerId );
+      pcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), Picture::getPicMargin( sps ), true, layerId );
     }
   }
 
@@ -606,6 +607,7 @@ void DecLib::executeLoopFilters()
 
   if (cs.sps->getUseLmcs() && cs.picHeader->getLmcsEnabledFlag())
   {
+      PROFILE_STAGE( PROF_LMCS );
       const PreCalcValues& pcv = *cs.pcv;
       for (uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight)
       {
@@ -629,6 +631,7 @@ void DecLib::executeLoopFilters()
   CS::setRefinedMotionField(cs);
   if( cs.sps->getSAOEnabledFlag() )
   {
+    PROFILE_STAGE( PROF_SAO );
     m_cSAO.SAOProcess( cs, cs.picture->getSAO() );
   }
 
@@ -638,6 +641,7 @@ void DecLib::executeLoopFilters()
     // ALF decodes the differentially coded coefficients and stores them in the parameters structure.
     // Code could be restructured to do directly after parsing. So far we just pass a fresh non-const
     // copy in case the APS gets used more than once.
+    PROFILE_STAGE( PROF_ALF );
     m_cALF.ALFProcess(cs);
   }
 
@@ -674,6 +678,9 @@ void DecLib::finishPictureLight(int& poc, PicList*& rpcListPic )
 
   m_pcPic->neededForOutput = (pcSlice->getPicHeader()->getPicOutputFlag() ? true : false);
   m_pcPic->reconstructed = true;
+#if ENABLE_STAGE_PROFILING
+  g_stageProfiler.endPicture( pcSlice->getTLayer(), pcSlice->getSliceType() );
+#endif
 
   Slice::sortPicList( m_cListPic ); // sorting for application output
   poc                 = pcSlice->getPOC();
@@ -766,6 +773,9 @@ void DecLib::finishPicture(int& poc, PicList*& rpcListPic, MsgLevel msgl )
 
   m_pcPic->neededForOutput = (pcSlice->getPicHeader()->getPicOutputFlag() ? true : false);
   m_pcPic->reconstructed = true;
+#if ENABLE_STAGE_PROFILING
+  g_stageProfiler.endPicture( pcSlice->getTLayer(), pcSlice->getSliceType() );
+#endif
 
 
   Slice::sortPicList( m_cListPic ); // sorting for application output
@@ -2495,6 +2505,13 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
     m_cReshaper.setRecReshaped(false);
   }
 
+#if ENABLE_STAGE_PROFILING
+  if( m_bFirstSliceInPicture )
+  {
+    g_stageProfiler.beginPicture( m_pcPic->layerId, m_pcPic->getPOC() );
+  }
+#endif
+
   //  Decode a picture
   m_cSliceDecoder.decompressSlice( pcSlice, &( nalu.getBitstream() ), ( m_pcPic->poc == getDebugPOC() ? getDebugCTU() : -1 ) );
 
@@ -2918,59 +2935,7 @@ bool DecLib::isNewPicture(std::ifstream *bitstreamFile, class InputByteStream *b
     {
       // get next NAL unit type
       read(nalu);
-      switch( nalu.m_nalUnitType ) {
-
-      // NUT that indicate the start of a new picture
-      case NAL_UNIT_ACCESS_UNIT_DELIMITER:
-      case NAL_UNIT_DCI:
-      case NAL_UNIT_VPS:
-      case NAL_UNIT_SPS:
-      case NAL_UNIT_PPS:
-      case NAL_UNIT_PH:
-        ret = true;
-        finished = true;
-        break;
-
-      // NUT that may be the start of a new picture - check first bit in slice header
-      case NAL_UNIT_CODED_SLICE_TRAIL:
-      case NAL_UNIT_CODED_SLICE_STSA:
-      case NAL_UNIT_CODED_SLICE_RASL:
-      case NAL_UNIT_CODED_SLICE_RADL:
-      case NAL_UNIT_RESERVED_VCL_4:
-      case NAL_UNIT_RESERVED_VCL_5:
-      case NAL_UNIT_RESERVED_VCL_6:
-      case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
-      case NAL_UNIT_CODED_SLICE_IDR_N_LP:
-      case NAL_UNIT_CODED_SLICE_CRA:
-      case NAL_UNIT_CODED_SLICE_GDR:
-      case NAL_UNIT_RESERVED_IRAP_VCL_11:
-      case NAL_UNIT_RESERVED_IRAP_VCL_12:
-        ret = checkPictureHeaderInSliceHeaderFlag(nalu);
-        finished = true;
-        break;
-
-      // NUT that are not the start of a new picture
-      case NAL_UNIT_EOS:
-      case NAL_UNIT_EOB:
-      case NAL_UNIT_SUFFIX_APS:
-      case NAL_UNIT_SUFFIX_SEI:
-      case NAL_UNIT_FD:
-        ret = false;
-        finished = true;
-        break;
-
-      // NUT that might indicate the start of a new picture - keep looking
-      case NAL_UNIT_PREFIX_APS:
-      case NAL_UNIT_PREFIX_SEI:
-      case NAL_UNIT_RESERVED_NVCL_26:
-      case NAL_UNIT_RESERVED_NVCL_27:
-      case NAL_UNIT_UNSPECIFIED_28:
-      case NAL_UNIT_UNSPECIFIED_29:
-      case NAL_UNIT_UNSPECIFIED_30:
-      case NAL_UNIT_UNSPECIFIED_31:
-      default:
-        break;
-      }
+      ret = isNewPicture( nalu, finished );
     }
   }
 
@@ -2991,6 +2956,71 @@ bool DecLib::isNewPicture(std::ifstream *bitstreamFile, class InputByteStream *b
   return ret;
 }
 
+/**
+- classify a look-ahead NAL unit: returns true if it is the first NAL unit of a new picture, finished is set when the
+  NAL unit determines the result and is left unchanged when the following NAL units have to be checked
+*/
+bool DecLib::isNewPicture( InputNALUnit& nalu, bool& finished )
+{
+  bool ret = false;
+
+  switch( nalu.m_nalUnitType ) {
+
+  // NUT that indicate the start of a new picture
+  case NAL_UNIT_ACCESS_UNIT_DELIMITER:
+  case NAL_UNIT_DCI:
+  case NAL_UNIT_VPS:
+  case NAL_UNIT_SPS:
+  case NAL_UNIT_PPS:
+  case NAL_UNIT_PH:
+    ret = true;
+    finished = true;
+    break;
+
+  // NUT that may be the start of a new picture - check first bit in slice header
+  case NAL_UNIT_CODED_SLICE_TRAIL:
+  case NAL_UNIT_CODED_SLICE_STSA:
+  case NAL_UNIT_CODED_SLICE_RASL:
+  case NAL_UNIT_CODED_SLICE_RADL:
+  case NAL_UNIT_RESERVED_VCL_4:
+  case NAL_UNIT_RESERVED_VCL_5:
+  case NAL_UNIT_RESERVED_VCL_6:
+  case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
+  case NAL_UNIT_CODED_SLICE_IDR_N_LP:
+  case NAL_UNIT_CODED_SLICE_CRA:
+  case NAL_UNIT_CODED_SLICE_GDR:
+  case NAL_UNIT_RESERVED_IRAP_VCL_11:
+  case NAL_UNIT_RESERVED_IRAP_VCL_12:
+    ret = checkPictureHeaderInSliceHeaderFlag(nalu);
+    finished = true;
+    break;
+
+  // NUT that are not the start of a new picture
+  case NAL_UNIT_EOS:
+  case NAL_UNIT_EOB:
+  case NAL_UNIT_SUFFIX_APS:
+  case NAL_UNIT_SUFFIX_SEI:
+  case NAL_UNIT_FD:
+    ret = false;
+    finished = true;
+    break;
+
+  // NUT that might indicate the start of a new picture - keep looking
+  case NAL_UNIT_PREFIX_APS:
+  case NAL_UNIT_PREFIX_SEI:
+  case NAL_UNIT_RESERVED_NVCL_26:
+  case NAL_UNIT_RESERVED_NVCL_27:
+  case NAL_UNIT_UNSPECIFIED_28:
+  case NAL_UNIT_UNSPECIFIED_29:
+  case NAL_UNIT_UNSPECIFIED_30:
+  case NAL_UNIT_UNSPECIFIED_31:
+  default:
+    break;
+  }
+
+  return ret;
+}
+
 /**
 - lookahead through next NAL units to determine if current NAL unit is the first NAL unit in a new access unit
 */
@@ -3027,41 +3057,7 @@ bool DecLib::isNewAccessUnit( bool newPicture, std::ifstream *bitstreamFile, cla
     {
       // get next NAL unit type
       read(nalu);
-      switch( nalu.m_nalUnitType ) {
-
-      // AUD always indicates the start of a new access unit
-      case NAL_UNIT_ACCESS_UNIT_DELIMITER:
-        ret = true;
-        finished = true;
-        break;
-
-      // slice types - check layer ID and POC
-      case NAL_UNIT_CODED_SLICE_TRAIL:
-      case NAL_UNIT_CODED_SLICE_STSA:
-      case NAL_UNIT_CODED_SLICE_RASL:
-      case NAL_UNIT_CODED_SLICE_RADL:
-      case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
-      case NAL_UNIT_CODED_SLICE_IDR_N_LP:
-      case NAL_UNIT_CODED_SLICE_CRA:
-      case NAL_UNIT_CODED_SLICE_GDR:
-        ret = isSliceNaluFirstInAU( newPicture, nalu );
-        finished = true;
-        break;
-
-      // NUT that are not the start of a new access unit
-      case NAL_UNIT_EOS:
-      case NAL_UNIT_EOB:
-      case NAL_UNIT_SUFFIX_APS:
-      case NAL_UNIT_SUFFIX_SEI:
-      case NAL_UNIT_FD:
-        ret = false;
-        finished = true;
-        break;
-
-      // all other NUT - keep looking to find first VCL
-      default:
-        break;
-      }
+      ret = isNewAccessUnit( newPicture, nalu, finished );
     }
   }
 
@@ -3081,4 +3077,375 @@ bool DecLib::isNewAccessUnit( bool newPicture, std::ifstream *bitstreamFile, cla
   // return TRUE if next NAL unit is the start of a new picture
   return ret;
 }
+
+/**
+- classify a look-ahead NAL unit: returns true if it is the first NAL unit of a new access unit, finished is set when
+  the NAL unit determines the result and is left unchanged when the following NAL units have to be checked
+*/
+bool DecLib::isNewAccessUnit( bool newPicture, InputNALUnit& nalu, bool& finished )
+{
+  bool ret = false;
+
+  switch( nalu.m_nalUnitType ) {
+
+  // AUD always indicates the start of a new access unit
+  case NAL_UNIT_ACCESS_UNIT_DELIMITER:
+    ret = true;
+    finished = true;
+    break;
+
+  // slice types - check layer ID and POC
+  case NAL_UNIT_CODED_SLICE_TRAIL:
+  case NAL_UNIT_CODED_SLICE_STSA:
+  case NAL_UNIT_CODED_SLICE_RASL:
+  case NAL_UNIT_CODED_SLICE_RADL:
+  case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
+  case NAL_UNIT_CODED_SLICE_IDR_N_LP:
+  case NAL_UNIT_CODED_SLICE_CRA:
+  case NAL_UNIT_CODED_SLICE_GDR:
+    ret = isSliceNaluFirstInAU( newPicture, nalu );
+    finished = true;
+    break;
+
+  // NUT that are not the start of a new access unit
+  case NAL_UNIT_EOS:
+  case NAL_UNIT_EOB:
+  case NAL_UNIT_SUFFIX_APS:
+  case NAL_UNIT_SUFFIX_SEI:
+  case NAL_UNIT_FD:
+    ret = false;
+    finished = true;
+    break;
+
+  // all other NUT - keep looking to find first VCL
+  default:
+    break;
+  }
+
+  return ret;
+}
+
+/**
+ - loop filters and finishes the decoded picture at the end of a picture unit, an EOS NAL unit or the bitstream
+ */
+void DecLib::finishPictureUnit( const InputNALUnit& nalu, bool newPicture, bool endOfStream, bool picSkipped, bool loopFiltered[MAX_VPS_LAYERS], PicList*& pcListPic )
+{
+  if( ( newPicture || endOfStream || nalu.m_nalUnitType == NAL_UNIT_EOS ) && !getFirstSliceInSequence( nalu.m_nuhLayerId ) && !picSkipped )
+  {
+    if( !loopFiltered[nalu.m_nuhLayerId] || !endOfStream )
+    {
+      int poc;
+      executeLoopFilters();
+      finishPicture( poc, pcListPic );
+    }
+    loopFiltered[nalu.m_nuhLayerId] = ( nalu.m_nalUnitType == NAL_UNIT_EOS );
+    if( nalu.m_nalUnitType == NAL_UNIT_EOS )
+    {
+      setFirstSliceInSequence( true, nalu.m_nuhLayerId );
+    }
+
+    updateAssociatedIRAP();
+    updatePrevGDRInSameLayer();
+    updatePrevIRAPAndGDRSubpic();
+  }
+  else if( ( newPicture || endOfStream || nalu.m_nalUnitType == NAL_UNIT_EOS ) && getFirstSliceInSequence( nalu.m_nuhLayerId ) )
+  {
+    setFirstSliceInPicture( true );
+  }
+}
+
+/**
+ - bumps the pictures which have to be output after a NAL unit, including the additional bumping as defined in C.5.2.3
+ */
+void DecLib::bumpPictures( const InputNALUnit& nalu, bool newPicture, PicList* pcListPic, int maxTemporalLayer, int& iPOCLastDisplay, DecPicWriterIf* writer )
+{
+  if( !pcListPic )
+  {
+    return;
+  }
+
+  if( newPicture )
+  {
+    writeOutput( pcListPic, maxTemporalLayer, iPOCLastDisplay, writer );
+  }
+  if( nalu.m_nalUnitType == NAL_UNIT_EOS )
+  {
+    writeOutput( pcListPic, maxTemporalLayer, iPOCLastDisplay, writer );
+    setFirstSliceInPicture( false );
+  }
+  if( !newPicture && ( ( nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_TRAIL && nalu.m_nalUnitType <= NAL_UNIT_RESERVED_IRAP_VCL_12 )
+    || ( nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_IDR_W_RADL && nalu.m_nalUnitType <= NAL_UNIT_CODED_SLICE_GDR ) ) )
+  {
+    writeOutput( pcListPic, maxTemporalLayer, iPOCLastDisplay, writer );
+  }
+}
+
+/**
+ - checks and resets the NAL units collected for the picture unit and the access unit which end with a NAL unit
+ */
+void DecLib::finishAccessUnit( const InputNALUnit& nalu, bool newPicture, bool newAccessUnit, bool endOfStream )
+{
+  if( newPicture )
+  {
+    checkSeiInPictureUnit();
+    resetPictureSeiNalus();
+  }
+  if( newPicture || endOfStream || nalu.m_nalUnitType == NAL_UNIT_EOS )
+  {
+    checkAPSInPictureUnit();
+    resetPictureUnitNals();
+  }
+  if( newAccessUnit || endOfStream )
+  {
+    CheckNoOutputPriorPicFlagsInAccessUnit();
+    resetAccessUnitNoOutputPriorPicFlags();
+  }
+  if( newAccessUnit )
+  {
+    isCvsStart();
+    checkTidLayerIdInAccessUnit();
+    resetAccessUnitSeiTids();
+    checkSEIInAccessUnit();
+    resetAccessUnitSeiPayLoadTypes();
+    resetAccessUnitNals();
+    resetAccessUnitApsNals();
+    resetAccessUnitPicInfo();
+  }
+}
+
+/** \param pcListPic        list of pictures to be output
+    \param maxTemporalLayer highest decoded temporal sub-layer, -1 for all
+ */
+void DecLib::writeOutput( PicList* pcListPic, int maxTemporalLayer, int& iPOCLastDisplay, DecPicWriterIf* writer )
+{
+  if( pcListPic->empty() )
+  {
+    return;
+  }
+
+  PicList::iterator iterPic = pcListPic->begin();
+  int numPicsNotYetDisplayed = 0;
+  int dpbFullness = 0;
+  const SPS* activeSPS = pcListPic->front()->cs->sps;
+  uint32_t numReorderPicsHighestTid;
+  uint32_t maxDecPicBufferingHighestTid;
+  uint32_t maxNrSublayers = activeSPS->getMaxTLayers();
+
+  const VPS* referredVPS = pcListPic->front()->cs->vps;
+  const int temporalId = ( maxTemporalLayer == -1 || maxTemporalLayer >= maxNrSublayers ) ? maxNrSublayers - 1 : maxTemporalLayer;
+
+  if( referredVPS == nullptr || referredVPS->m_numLayersInOls[referredVPS->m_targetOlsIdx] == 1 )
+  {
+    numReorderPicsHighestTid = activeSPS->getNumReorderPics( temporalId );
+    maxDecPicBufferingHighestTid = activeSPS->getMaxDecPicBuffering( temporalId );
+  }
+  else
+  {
+    numReorderPicsHighestTid = referredVPS->getNumReorderPics( temporalId );
+    maxDecPicBufferingHighestTid = referredVPS->getMaxDecPicBuffering( temporalId );
+  }
+
+  while( iterPic != pcListPic->end() )
+  {
+    Picture* pcPic = *( iterPic );
+    if( pcPic->neededForOutput && pcPic->getPOC() > iPOCLastDisplay )
+    {
+      numPicsNotYetDisplayed++;
+      dpbFullness++;
+    }
+    else if( pcPic->referenced )
+    {
+      dpbFullness++;
+    }
+    iterPic++;
+  }
+
+  iterPic = pcListPic->begin();
+
+  if( numPicsNotYetDisplayed > 2 )
+  {
+    iterPic++;
+  }
+
+  Picture* pcPic = *( iterPic );
+  if( numPicsNotYetDisplayed > 2 && pcPic->fieldPic ) //Field Decoding
+  {
+    PicList::iterator endPic = pcListPic->end();
+    endPic--;
+    iterPic = pcListPic->begin();
+    while( iterPic != endPic )
+    {
+      Picture* pcPicTop = *( iterPic );
+      iterPic++;
+      Picture* pcPicBottom = *( iterPic );
+
+      if( pcPicTop->neededForOutput && pcPicBottom->neededForOutput &&
+          ( numPicsNotYetDisplayed > numReorderPicsHighestTid || dpbFullness > maxDecPicBufferingHighestTid ) &&
+          ( !( pcPicTop->getPOC() % 2 ) && pcPicBottom->getPOC() == pcPicTop->getPOC() + 1 ) &&
+          ( pcPicTop->getPOC() == iPOCLastDisplay + 1 || iPOCLastDisplay < 0 ) )
+      {
+        numPicsNotYetDisplayed = numPicsNotYetDisplayed - 2;
+        writer->writeFieldPair( pcPicTop, pcPicBottom );
+
+        // update POC of display order
+        iPOCLastDisplay = pcPicBottom->getPOC();
+
+        // erase non-referenced picture in the reference picture list after display
+        if( !pcPicTop->referenced && pcPicTop->reconstructed )
+        {
+          pcPicTop->reconstructed = false;
+        }
+        if( !pcPicBottom->referenced && pcPicBottom->reconstructed )
+        {
+          pcPicBottom->reconstructed = false;
+        }
+        pcPicTop->neededForOutput = false;
+        pcPicBottom->neededForOutput = false;
+      }
+    }
+  }
+  else if( !pcPic->fieldPic ) //Frame Decoding
+  {
+    iterPic = pcListPic->begin();
+
+    while( iterPic != pcListPic->end() )
+    {
+      pcPic = *( iterPic );
+
+      if( pcPic->neededForOutput && pcPic->getPOC() > iPOCLastDisplay &&
+          ( numPicsNotYetDisplayed > numReorderPicsHighestTid || dpbFullness > maxDecPicBufferingHighestTid ) )
+      {
+        numPicsNotYetDisplayed--;
+        if( !pcPic->referenced )
+        {
+          dpbFullness--;
+        }
+
+        writer->writePicture( pcPic );
+
+        // update POC of display order
+        iPOCLastDisplay = pcPic->getPOC();
+
+        // erase non-referenced picture in the reference picture list after display
+        if( !pcPic->referenced && pcPic->reconstructed )
+        {
+          pcPic->reconstructed = false;
+        }
+        pcPic->neededForOutput = false;
+      }
+
+      iterPic++;
+    }
+  }
+}
+
+/** \param pcListPic list of pictures to be output and deleted
+    \param layerId   layer of the pictures to be flushed, NOT_VALID for all layers
+ */
+void DecLib::flushOutput( PicList* pcListPic, int layerId, int& iPOCLastDisplay, DecPicWriterIf* writer )
+{
+  if( !pcListPic || pcListPic->empty() )
+  {
+    return;
+  }
+  PicList::iterator iterPic = pcListPic->begin();
+  Picture* pcPic = *( iterPic );
+
+  if( pcPic->fieldPic ) //Field Decoding
+  {
+    PicList::iterator endPic = pcListPic->end();
+    endPic--;
+    Picture *pcPicTop, *pcPicBottom = NULL;
+    while( iterPic != endPic )
+    {
+      pcPicTop = *( iterPic );
+      iterPic++;
+      pcPicBottom = *( iterPic );
+
+      if( pcPicTop->layerId != layerId && layerId != NOT_VALID )
+      {
+        continue;
+      }
+
+      if( pcPicTop->neededForOutput && pcPicBottom->neededForOutput && !( pcPicTop->getPOC() % 2 ) && ( pcPicBottom->getPOC() == pcPicTop->getPOC() + 1 ) )
+      {
+        writer->writeFieldPair( pcPicTop, pcPicBottom );
+
+        // update POC of display order
+        iPOCLastDisplay = pcPicBottom->getPOC();
+
+        // erase non-referenced picture in the reference picture list after display
+        if( !pcPicTop->referenced && pcPicTop->reconstructed )
+        {
+          pcPicTop->reconstructed = false;
+        }
+        if( !pcPicBottom->referenced && pcPicBottom->reconstructed )
+        {
+          pcPicBottom->reconstructed = false;
+        }
+        pcPicTop->neededForOutput = false;
+        pcPicBottom->neededForOutput = false;
+
+        if( pcPicTop )
+        {
+          pcPicTop->destroy();
+          delete pcPicTop;
+          pcPicTop = NULL;
+        }
+      }
+    }
+    if( pcPicBottom )
+    {
+      pcPicBottom->destroy();
+      delete pcPicBottom;
+      pcPicBottom = NULL;
+    }
+  }
+  else //Frame decoding
+  {
+    while( iterPic != pcListPic->end() )
+    {
+      pcPic = *( iterPic );
+
+      if( pcPic->layerId != layerId && layerId != NOT_VALID )
+      {
+        iterPic++;
+        continue;
+      }
+
+      if( pcPic->neededForOutput )
+      {
+        writer->writePicture( pcPic );
+
+        // update POC of display order
+        iPOCLastDisplay = pcPic->getPOC();
+
+        // erase non-referenced picture in the reference picture list after display
+        if( !pcPic->referenced && pcPic->reconstructed )
+        {
+          pcPic->reconstructed = false;
+        }
+        pcPic->neededForOutput = false;
+      }
+      if( pcPic != NULL )
+      {
+        pcPic->destroy();
+        delete pcPic;
+        pcPic = NULL;
+        *iterPic = nullptr;
+      }
+      iterPic++;
+    }
+  }
+
+  if( layerId != NOT_VALID )
+  {
+    pcListPic->remove_if( []( Picture* p ) { return p == nullptr; } );
+  }
+  else
+  {
+    pcListPic->clear();
+  }
+  iPOCLastDisplay = -MAX_INT;
+}
 //! \}
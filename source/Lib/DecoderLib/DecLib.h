@@ -61,6 +61,17 @@ class InputNALUnit;
 //! \{
 
 bool tryDecodePicture( Picture* pcPic, const int expectedPoc, const std::string& bitstreamFileName, ParameterSetMap<APS> *apsMap = nullptr, bool bDecodeUntilPocFound = false, int debugCTU = -1, int debugPOC = -1 );
+
+/// receives the pictures bumped out of the DPB by DecLib::writeOutput() and DecLib::flushOutput() in output order
+class DecPicWriterIf
+{
+public:
+  virtual ~DecPicWriterIf() {}
+
+  virtual void writePicture  ( Picture* pcPic ) = 0;
+  virtual void writeFieldPair( Picture* pcPicTop, Picture* pcPicBottom ) = 0;
+};
+
 // Class definition
 // ====================================================================================================================
 
@@ -254,6 +265,15 @@ public:
   void  setAPSMapEnc( ParameterSetMap<APS>* apsMap ) { m_apsMapEnc = apsMap;  }
   bool  isNewPicture( std::ifstream *bitstreamFile, class InputByteStream *bytestream );
   bool  isNewAccessUnit( bool newPicture, std::ifstream *bitstreamFile, class InputByteStream *bytestream );
+  bool  isNewPicture( InputNALUnit& nalu, bool& finished );                       ///< check a look-ahead NAL unit, for decoding from memory
+  bool  isNewAccessUnit( bool newPicture, InputNALUnit& nalu, bool& finished );   ///< check a look-ahead NAL unit, for decoding from memory
+
+  // steps of the decoder loop after a NAL unit, shared by DecApp and DecStream
+  void  finishPictureUnit( const InputNALUnit& nalu, bool newPicture, bool endOfStream, bool picSkipped, bool loopFiltered[MAX_VPS_LAYERS], PicList*& pcListPic );
+  void  bumpPictures     ( const InputNALUnit& nalu, bool newPicture, PicList* pcListPic, int maxTemporalLayer, int& iPOCLastDisplay, DecPicWriterIf* writer );
+  void  finishAccessUnit ( const InputNALUnit& nalu, bool newPicture, bool newAccessUnit, bool endOfStream );
+  void  writeOutput      ( PicList* pcListPic, int maxTemporalLayer, int& iPOCLastDisplay, DecPicWriterIf* writer );
+  void  flushOutput      ( PicList* pcListPic, int layerId, int& iPOCLastDisplay, DecPicWriterIf* writer );
 protected:
   void  xUpdateRasInit(Slice* slice);
 
@@ -38,6 +38,7 @@
 #include "DecSlice.h"
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/dtrace_next.h"
+#include "CommonLib/StageProfiler.h"
 
 #include <vector>
 
@@ -229,9 +230,15 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
     {
       break;
     }
-    cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
+    {
+      PROFILE_CTU_STAGE( PROF_CTU_PARSE, ctuRsAddr );
+      cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
+    }
 
-    m_pcCuDecoder->decompressCtu( cs, ctuArea );
+    {
+      PROFILE_CTU_STAGE( PROF_CTU_RECON, ctuRsAddr );
+      m_pcCuDecoder->decompressCtu( cs, ctuArea );
+    }
 
     if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
     {
@@ -0,0 +1,414 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     DecStream.cpp
+    \brief    streaming decoder interface around DecLib
+*/
+
+#include "DecStream.h"
+
+#include "NALread.h"
+
+//! \ingroup DecoderLib
+//! \{
+
+static bool isVclNalUnitType( const NalUnitType nalUnitType )
+{
+  return ( nalUnitType >= NAL_UNIT_CODED_SLICE_TRAIL && nalUnitType <= NAL_UNIT_RESERVED_IRAP_VCL_12 )
+      || ( nalUnitType >= NAL_UNIT_CODED_SLICE_IDR_W_RADL && nalUnitType <= NAL_UNIT_CODED_SLICE_GDR );
+}
+
+/// the look-ahead reads the slice header, restart behind the NAL unit header which was read when the NAL unit was queued
+static void rewindToPayload( InputNALUnit& nalu )
+{
+  InputBitstream& bitstream = nalu.getBitstream();
+  uint32_t        header;
+  bitstream.resetToStart();
+  bitstream.read( 16, header );
+}
+
+DecStream::DecStream()
+  : m_outputIf                     ( nullptr )
+  , m_maxTemporalLayer             ( -1 )
+  , m_targetOlsIdx                 ( 0 )
+  , m_decodedPictureHashSEIEnabled ( 0 )
+  , m_created                      ( false )
+  , m_nalStart                     ( 0 )
+  , m_scanPos                      ( 0 )
+  , m_pcListPic                    ( nullptr )
+  , m_iPOCLastDisplay              ( -MAX_INT )
+  , m_picSkipped                   ( false )
+{
+}
+
+DecStream::~DecStream()
+{
+  destroy();
+}
+
+void DecStream::create()
+{
+  CHECK( m_created, "Decoder already created" );
+
+  m_cDecLib.create();
+  m_cDecLib.init(
+#if JVET_J0090_MEMORY_BANDWITH_MEASURE
+    ""
+#endif
+  );
+  m_cDecLib.setDecodedPictureHashSEIEnabled( m_decodedPictureHashSEIEnabled );
+  m_cDecLib.initScalingList();
+
+  m_targetDecLayerIdSet.clear();
+  m_byteStream.clear();
+  m_nalStart        = 0;
+  m_scanPos         = 0;
+  m_nalUnits.clear();
+  m_pcListPic       = nullptr;
+  m_iPOCLastDisplay = -MAX_INT;
+  m_picSkipped      = false;
+  std::fill_n( m_loopFiltered, MAX_VPS_LAYERS, false );
+
+  m_created = true;
+}
+
+void DecStream::destroy()
+{
+  if( !m_created )
+  {
+    return;
+  }
+
+  m_cDecLib.deletePicBuffer();
+  m_cDecLib.destroy();
+
+  for( auto &buf : m_ownBuffers )
+  {
+    buf->destroy();
+    delete buf;
+  }
+  m_ownBuffers.clear();
+  m_freeBuffers.clear();
+  m_decodedPictures.clear();
+
+  m_created = false;
+}
+
+void DecStream::pushData( const uint8_t* data, size_t size )
+{
+  CHECK( !m_created, "Decoder not created" );
+
+  m_byteStream.insert( m_byteStream.end(), data, data + size );
+
+  xExtractNalUnits( false );
+  xDecode( false );
+}
+
+void DecStream::pushNalUnit( const uint8_t* data, size_t size )
+{
+  CHECK( !m_created, "Decoder not created" );
+  CHECK( !m_byteStream.empty(), "NAL units cannot be pushed after incomplete byte stream data" );
+
+  if( size > 0 )
+  {
+    xAddNalUnit( data, data + size );
+  }
+
+  xDecode( false );
+}
+
+void DecStream::flush()
+{
+  CHECK( !m_created, "Decoder not created" );
+
+  xExtractNalUnits( true );
+  xDecode( true );
+
+  m_cDecLib.flushOutput( m_pcListPic, NOT_VALID, m_iPOCLastDisplay, this );
+}
+
+bool DecStream::pullPicture( DecodedPicture& pic )
+{
+  if( m_decodedPictures.empty() )
+  {
+    return false;
+  }
+
+  pic = m_decodedPictures.front();
+  m_decodedPictures.pop_front();
+
+  return true;
+}
+
+/**
+  Splits the buffered byte stream into NAL units. A NAL unit is complete when the next start code has been received,
+  at the end of the stream the remaining data is the last NAL unit. Scanning resumes where the previous call stopped.
+ */
+void DecStream::xExtractNalUnits( bool endOfStream )
+{
+  const uint8_t* data  = m_byteStream.data();
+  const size_t   size  = m_byteStream.size();
+  size_t         start = m_nalStart;
+  size_t         pos   = m_scanPos;
+
+  while( pos + 3 <= size )
+  {
+    if( data[pos + 2] > 1 )
+    {
+      pos += 3;
+    }
+    else if( data[pos] == 0 && data[pos + 1] == 0 && data[pos + 2] == 1 )
+    {
+      if( start > 0 )
+      {
+        xAddNalUnit( data + start, data + pos );
+      }
+      pos  += 3;
+      start = pos;
+    }
+    else
+    {
+      pos++;
+    }
+  }
+
+  if( endOfStream )
+  {
+    if( start > 0 )
+    {
+      xAddNalUnit( data + start, data + size );
+    }
+    m_byteStream.clear();
+    m_nalStart = 0;
+    m_scanPos  = 0;
+    return;
+  }
+
+  // drop the extracted NAL units, the pending one is kept together with its start code
+  const size_t consumed = start > 0 ? start - 3 : 0;
+  m_byteStream.erase( m_byteStream.begin(), m_byteStream.begin() + consumed );
+  m_nalStart = start - consumed;
+  m_scanPos  = pos - consumed;
+}
+
+void DecStream::xAddNalUnit( const uint8_t* begin, const uint8_t* end )
+{
+  // leading_zero_8bits, zero_byte and trailing_zero_8bits are not part of the NAL unit
+  while( end > begin && end[-1] == 0 )
+  {
+    end--;
+  }
+  if( end > begin )
+  {
+    m_nalUnits.emplace_back();
+    InputNALUnit& nalu = m_nalUnits.back();
+    nalu.getBitstream().getFifo().assign( begin, end );
+    read( nalu );
+  }
+}
+
+/**
+  Look-ahead of DecLib::isNewPicture() and DecLib::isNewAccessUnit() on the queued NAL units.
+  Returns 1 or 0, and -1 when the queued NAL units do not determine the result.
+ */
+int DecStream::xLookAhead( bool accessUnit, bool newPicture )
+{
+  for( auto &nalu : m_nalUnits )
+  {
+    rewindToPayload( nalu );
+
+    bool finished = false;
+    const bool ret = accessUnit ? m_cDecLib.isNewAccessUnit( newPicture, nalu, finished ) : m_cDecLib.isNewPicture( nalu, finished );
+    if( finished )
+    {
+      return ret ? 1 : 0;
+    }
+  }
+
+  return -1;
+}
+
+bool DecStream::xIsNaluWithinTargetDecLayerIdSet( const InputNALUnit& nalu ) const
+{
+  if( m_targetDecLayerIdSet.empty() )
+  {
+    return true;
+  }
+
+  return std::find( m_targetDecLayerIdSet.begin(), m_targetDecLayerIdSet.end(), nalu.m_nuhLayerId ) != m_targetDecLayerIdSet.end();
+}
+
+/**
+  Decoder loop of DecApp::decode() on the queued NAL units, sharing the picture completion and bumping steps of DecLib.
+  A NAL unit is only decoded when it is known whether it is the last one of the bitstream, and when the queued NAL
+  units determine whether it starts a new picture and a new access unit.
+ */
+void DecStream::xDecode( bool endOfStream )
+{
+  while( !m_nalUnits.empty() )
+  {
+    if( m_nalUnits.size() < 2 && !endOfStream )
+    {
+      break;
+    }
+
+    // determine if next NAL unit will be the first one from a new picture
+    int newPicture = m_cDecLib.getFirstSliceInPicture() ? 0 : xLookAhead( false, false );
+    if( newPicture < 0 && !endOfStream )
+    {
+      break;
+    }
+    int newAccessUnit = newPicture > 0 ? xLookAhead( true, true ) : 0;
+    if( newAccessUnit < 0 && !endOfStream )
+    {
+      break;
+    }
+
+    const bool bNewPicture    = newPicture > 0;
+    const bool bNewAccessUnit = newAccessUnit > 0;
+
+    InputNALUnit  noNalu;
+    noNalu.m_nalUnitType = NAL_UNIT_INVALID;
+    InputNALUnit& nalu   = bNewPicture ? noNalu : m_nalUnits.front();
+
+    if( !bNewPicture )
+    {
+      rewindToPayload( nalu );
+
+      // flush output for first slice of an IDR picture
+      if( m_cDecLib.getFirstSliceInPicture() && ( nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP ) )
+      {
+        m_cDecLib.flushOutput( m_pcListPic, nalu.m_nuhLayerId, m_iPOCLastDisplay, this );
+      }
+
+      // parse NAL unit syntax if within target decoding layer
+      if( ( m_maxTemporalLayer < 0 || nalu.m_temporalId <= m_maxTemporalLayer ) && xIsNaluWithinTargetDecLayerIdSet( nalu ) )
+      {
+        CHECK( nalu.m_temporalId > m_maxTemporalLayer, "bitstream shall not include any NAL unit with TemporalId greater than HighestTid" );
+        if( !m_targetDecLayerIdSet.empty() )
+        {
+          CHECK( std::find( m_targetDecLayerIdSet.begin(), m_targetDecLayerIdSet.end(), nalu.m_nuhLayerId ) == m_targetDecLayerIdSet.end(), "bitstream shall not contain any other layers than included in the OLS with OlsIdx" );
+        }
+        if( m_picSkipped && isVclNalUnitType( nalu.m_nalUnitType ) )
+        {
+          if( m_cDecLib.isSliceNaluFirstInAU( true, nalu ) )
+          {
+            m_cDecLib.resetAccessUnitNals();
+            m_cDecLib.resetAccessUnitApsNals();
+            m_cDecLib.resetAccessUnitPicInfo();
+          }
+          m_picSkipped = false;
+        }
+        int skipFrame = 0;
+        m_cDecLib.decode( nalu, skipFrame, m_iPOCLastDisplay, m_targetOlsIdx );
+        if( nalu.m_nalUnitType == NAL_UNIT_VPS )
+        {
+          m_cDecLib.deriveTargetOutputLayerSet( m_targetOlsIdx );
+          m_targetDecLayerIdSet = m_cDecLib.getVPS()->m_targetLayerIdSet;
+        }
+      }
+      else
+      {
+        m_picSkipped = true;
+      }
+    }
+
+    // corresponds to the end of the bitstream file in DecApp
+    const bool lastNalu = endOfStream && !bNewPicture && m_nalUnits.size() == 1;
+
+    m_cDecLib.finishPictureUnit( nalu, bNewPicture, lastNalu, m_picSkipped, m_loopFiltered, m_pcListPic );
+    m_cDecLib.bumpPictures( nalu, bNewPicture, m_pcListPic, m_maxTemporalLayer, m_iPOCLastDisplay, this );
+    m_cDecLib.finishAccessUnit( nalu, bNewPicture, bNewAccessUnit, lastNalu );
+
+    if( !bNewPicture )
+    {
+      m_nalUnits.pop_front();
+    }
+  }
+}
+
+UnitArea DecStream::getOutputArea( const Picture& pic )
+{
+  const Window&      conf            = pic.getConformanceWindow();
+  const ChromaFormat chromaFormatIDC = pic.cs->sps->getChromaFormatIdc();
+  const CPelUnitBuf  reco            = pic.getRecoBuf();
+
+  const int left   = conf.getWindowLeftOffset()   * SPS::getWinUnitX( chromaFormatIDC );
+  const int right  = conf.getWindowRightOffset()  * SPS::getWinUnitX( chromaFormatIDC );
+  const int top    = conf.getWindowTopOffset()    * SPS::getWinUnitY( chromaFormatIDC );
+  const int bottom = conf.getWindowBottomOffset() * SPS::getWinUnitY( chromaFormatIDC );
+
+  return UnitArea( chromaFormatIDC, Area( left, top, reco.Y().width - left - right, reco.Y().height - top - bottom ) );
+}
+
+void DecStream::writePicture( Picture* pcPic )
+{
+  const ChromaFormat chromaFormatIDC = pcPic->cs->sps->getChromaFormatIdc();
+  const UnitArea     area            = getOutputArea( *pcPic );
+  const CPelUnitBuf  cropped         = static_cast<const Picture*>( pcPic )->getRecoBuf().subBuf( area );
+
+  if( m_outputIf )
+  {
+    m_outputIf->outputPicture( *pcPic, cropped );
+    return;
+  }
+
+  PelStorage* buf = nullptr;
+  if( m_freeBuffers.empty() )
+  {
+    buf = new PelStorage;
+    m_ownBuffers.push_back( buf );
+  }
+  else
+  {
+    buf = m_freeBuffers.back();
+    m_freeBuffers.pop_back();
+  }
+
+  if( buf->chromaFormat != chromaFormatIDC || buf->bufs.empty() || buf->Y().width != area.lwidth() || buf->Y().height != area.lheight() )
+  {
+    buf->destroy();
+    buf->create( chromaFormatIDC, Area( 0, 0, area.lwidth(), area.lheight() ) );
+  }
+  buf->copyFrom( cropped );
+
+  m_decodedPictures.push_back( DecodedPicture{ buf, pcPic->getPOC(), pcPic->layerId, int( pcPic->temporalId ) } );
+}
+
+void DecStream::writeFieldPair( Picture* pcPicTop, Picture* pcPicBottom )
+{
+  writePicture( pcPicTop );
+  writePicture( pcPicBottom );
+}
+
+//! \}
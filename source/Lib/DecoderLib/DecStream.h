@@ -0,0 +1,142 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     DecStream.h
+    \brief    streaming decoder interface around DecLib (header)
+*/
+
+#ifndef __DECSTREAM__
+#define __DECSTREAM__
+
+#include "DecLib.h"
+
+#include <deque>
+#include <vector>
+
+//! \ingroup DecoderLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// receives the decoded pictures of DecStream in output order
+class DecPicOutputIf
+{
+public:
+  virtual ~DecPicOutputIf() {}
+
+  /// buf is the reconstruction of pic cropped to the conformance window, it is only valid during the call
+  virtual void outputPicture( const Picture& pic, const CPelUnitBuf& buf ) = 0;
+};
+
+/**
+  Memory based decoder.
+  The bitstream is pushed either as Annex B byte stream data in chunks of any size, or as single NAL units. NAL units
+  are decoded as soon as the following data determines the picture and access unit boundaries, and flush() decodes the
+  remaining data at the end of the bitstream. Pictures are bumped out of the DPB in output order, as by DecApp, and
+  are either handed to an output callback or copied into output buffers which can be provided by the caller and are
+  returned by pullPicture(). Field pictures are output one by one. initROM() has to be called once before creating
+  the first decoder, and like DecApp the decoder is too large to be placed on the stack.
+*/
+class DecStream : public DecPicWriterIf
+{
+public:
+  struct DecodedPicture
+  {
+    PelStorage* buf;        ///< cropped picture, back to the pool with addOutputBuffer()
+    int         poc;
+    int         layerId;
+    int         temporalId;
+  };
+
+  DecStream();
+  virtual ~DecStream();
+
+  void        setMaxTemporalLayer             ( int maxTemporalLayer )             { m_maxTemporalLayer = maxTemporalLayer; }
+  void        setTargetOlsIdx                 ( int targetOlsIdx )                 { m_targetOlsIdx = targetOlsIdx; }
+  void        setDecodedPictureHashSEIEnabled ( int enabled )                      { m_decodedPictureHashSEIEnabled = enabled; }
+  void        setOutputCallback               ( DecPicOutputIf* outputIf )         { m_outputIf = outputIf; }
+
+  void        create                          ();
+  void        destroy                         ();
+
+  void        pushData                        ( const uint8_t* data, size_t size );   ///< Annex B byte stream
+  void        pushNalUnit                     ( const uint8_t* data, size_t size );   ///< NAL unit without start code
+  void        flush                           ();                                     ///< end of the bitstream
+
+  /// adds a caller-owned buffer to the output pool, or returns a buffer received from pullPicture()
+  void        addOutputBuffer                 ( PelStorage* buf )                  { m_freeBuffers.push_back( buf ); }
+  bool        pullPicture                     ( DecodedPicture& pic );
+  size_t      getNumPictures                  () const                             { return m_decodedPictures.size(); }
+
+  uint32_t    getNumberOfChecksumErrorsDetected() const                            { return m_cDecLib.getNumberOfChecksumErrorsDetected(); }
+  DecLib&     getDecLib                       ()                                   { return m_cDecLib; }
+
+  void        writePicture                    ( Picture* pcPic );                           ///< crops a bumped picture for output
+  void        writeFieldPair                  ( Picture* pcPicTop, Picture* pcPicBottom );  ///< outputs both fields one by one
+
+  static UnitArea getOutputArea               ( const Picture& pic );                       ///< conformance window of the reconstruction
+
+private:
+  void        xExtractNalUnits                ( bool endOfStream );
+  void        xAddNalUnit                     ( const uint8_t* begin, const uint8_t* end );
+  void        xDecode                         ( bool endOfStream );
+  int         xLookAhead                      ( bool accessUnit, bool newPicture );
+  bool        xIsNaluWithinTargetDecLayerIdSet( const InputNALUnit& nalu ) const;
+
+  DecLib                            m_cDecLib;
+  DecPicOutputIf*                   m_outputIf;
+  int                               m_maxTemporalLayer;
+  int                               m_targetOlsIdx;
+  int                               m_decodedPictureHashSEIEnabled;
+  std::vector<int>                  m_targetDecLayerIdSet;
+  bool                              m_created;
+
+  std::vector<uint8_t>              m_byteStream;       ///< byte stream data not yet split into NAL units
+  size_t                            m_nalStart;         ///< first byte of the pending NAL unit, 0 before the first start code
+  size_t                            m_scanPos;          ///< position where the search for the next start code resumes
+  std::deque<InputNALUnit>          m_nalUnits;         ///< NAL units not yet decoded, the header is read when queued
+  PicList*                          m_pcListPic;
+  int                               m_iPOCLastDisplay;
+  bool                              m_loopFiltered[MAX_VPS_LAYERS];
+  bool                              m_picSkipped;
+
+  std::deque<DecodedPicture>        m_decodedPictures;
+  std::vector<PelStorage*>          m_freeBuffers;
+  std::vector<PelStorage*>          m_ownBuffers;       ///< buffers allocated when the pool was empty
+};
+
+//! \}
+
+#endif // __DECSTREAM__
@@ -121,6 +121,7 @@ public:
                                         unsigned cutoff,
                                         int      maxLog2TrDynamicRange    ) = 0;
   virtual void      encodeBinTrm      ( unsigned bin                      ) = 0;
+  virtual void      addEstFracBits    ( uint64_t fracBits                 ) = 0;
   virtual void      align             ()                                    = 0;
 public:
   virtual uint32_t  getNumBins        ()                                    = 0;
@@ -184,6 +185,7 @@ public:
                                   unsigned cutoff,
                                   int      maxLog2TrDynamicRange    );
   void      encodeBinTrm        ( unsigned bin                      );
+  void      addEstFracBits      ( uint64_t fracBits                 ) { THROW( "not supported" ); }
   void      align               ();
   unsigned  getNumWrittenBits   () { return ( m_Bitstream->getNumberOfWrittenBits() + 8 * m_numBufferedBytes + 23 - m_bitsLeft ); }
 public:
@@ -249,6 +251,7 @@ public:
                                   unsigned goRicePar,
                                   unsigned cutoff,
                                   int      maxLog2TrDynamicRange    );
+  void      addEstFracBits      ( uint64_t fracBits                 ) { m_EstFracBits += fracBits; }
   void      align               ();
 public:
   uint32_t  getNumBins          ()                                      { THROW("Not supported"); return 0; }
@@ -2709,7 +2709,14 @@ void CABACWriter::residual_coding( const TransformUnit& tu, ComponentID compID,
         continue;
       }
     }
-    residual_coding_subblock( cctx, coeff, stateTab, state );
+    if( m_residualRateTable )
+    {
+      m_BinEncoder.addEstFracBits( m_residualRateTable->subblockBits( cctx, coeff, stateTab, state ) );
+    }
+    else
+    {
+      residual_coding_subblock( cctx, coeff, stateTab, state );
+    }
 
     if ( cuCtx && isLuma(compID) && cctx.isSigGroup() && ( cctx.cgPosY() > 3 || cctx.cgPosX() > 3 ) )
     {
@@ -2880,6 +2887,12 @@ void CABACWriter::last_sig_coeff( CoeffCodingContext& cctx, const TransformUnit&
     maxLastPosY = ( tu.blocks[compID].height == 32 ) ? g_uiGroupIdx[ 15 ] : maxLastPosY;
   }
 
+  if( m_residualRateTable )
+  {
+    m_BinEncoder.addEstFracBits( m_residualRateTable->lastPosBits( cctx, posX, posY, maxLastPosX, maxLastPosY ) );
+    return;
+  }
+
   for( CtxLast = 0; CtxLast < GroupIdxX; CtxLast++ )
   {
     m_BinEncoder.encodeBin( 1, cctx.lastXCtxId( CtxLast ) );
@@ -41,6 +41,7 @@
 #include "CommonLib/BitStream.h"
 #include "CommonLib/ContextModelling.h"
 #include "BinEncoder.h"
+#include "ResidualRateTable.h"
 
 
 //! \ingroup EncoderLib
@@ -51,12 +52,14 @@ class EncCu;
 class CABACWriter
 {
 public:
-  CABACWriter(BinEncIf& binEncoder)   : m_BinEncoder(binEncoder), m_Bitstream(0) { m_TestCtx = m_BinEncoder.getCtx(); m_EncCu = NULL; }
+  CABACWriter(BinEncIf& binEncoder)   : m_BinEncoder(binEncoder), m_Bitstream(0), m_residualRateTable(nullptr) { m_TestCtx = m_BinEncoder.getCtx(); m_EncCu = NULL; }
   virtual ~CABACWriter() {}
 
 public:
   void        initCtxModels             ( const Slice&                  slice );
   void        setEncCu(EncCu* pcEncCu) { m_EncCu = pcEncCu; }
+  /// the regular residual coding is estimated from the table instead of the current context states when set (bit estimation only)
+  void        setResidualRateTable      ( const ResidualRateTable*      table )               { m_residualRateTable = table; }
   SliceType   getCtxInitId              ( const Slice&                  slice );
   void        initBitstream             ( OutputBitstream*              bitstream )           { m_Bitstream = bitstream; m_BinEncoder.init( m_Bitstream ); }
 
@@ -183,6 +186,7 @@ private:
   Ctx               m_TestCtx;
   EncCu*            m_EncCu;
   ScanElement*      m_scanOrder;
+  const ResidualRateTable* m_residualRateTable;
 };
 
 
@@ -38,6 +38,7 @@
 
 #include "CommonLib/Picture.h"
 #include "CommonLib/CodingStructure.h"
+#include "CommonLib/StageProfiler.h"
 
 #define AlfCtx(c) SubCtx( Ctx::Alf, c)
 std::vector<double> EncAdaptiveLoopFilter::m_lumaLevelToWeightPLUT;
@@ -871,6 +872,8 @@ void EncAdaptiveLoopFilter::ALFProcess(CodingStructure& cs, const double *lambda
                                        , Picture* pcPic, uint32_t numSliceSegments
                                       )
 {
+  PROFILE_STAGE( PROF_ALF );
+
   int layerIdx = cs.vps == nullptr ? 0 : cs.vps->getGeneralLayerIdx( cs.slice->getPic()->layerId );
 
    // IRAP AU is assumed
@@ -173,6 +173,8 @@ protected:
   bool      m_printHexPsnr;
   bool      m_printFrameMSE;
   bool      m_printSequenceMSE;
+  int       m_metricThreads;
+  bool      m_asyncMetrics;
   bool      m_cabacZeroWordPaddingEnabled;
 
   bool      m_onePictureOnlyConstraintFlag;
@@ -335,6 +337,9 @@ protected:
   bool      m_allowDisFracMMVD;
   bool      m_AffineAmvr;
   bool      m_HashME;
+  int       m_hashMEThreads;
+  bool      m_hierarchicalME;
+  int       m_hierarchicalMEThreads;
   bool      m_AffineAmvrEncOpt;
   bool      m_DMVR;
   bool      m_MMVD;
@@ -353,6 +358,7 @@ protected:
 
   bool      m_wrapAround;
   unsigned  m_wrapAroundOffset;
+  int       m_borderExtThreads;
 
   // ADD_NEW_TOOL : (encoder lib) add tool enabling flags and associated parameters here
   bool      m_virtualBoundariesEnabledFlag;
@@ -373,6 +379,8 @@ protected:
   bool      m_useAMaxBT;
   bool      m_e0023FastEnc;
   bool      m_contentBasedFastQtbt;
+  unsigned  m_fastPartition;
+  bool      m_temporalCuReuse;
   bool      m_useNonLinearAlfLuma;
   bool      m_useNonLinearAlfChroma;
   unsigned  m_maxNumAlfAlternativesChroma;
@@ -380,6 +388,7 @@ protected:
   bool      m_MIP;
   bool      m_useFastMIP;
   int       m_fastLocalDualTreeMode;
+  bool      m_useFastResidualRate;                ///< estimate the residual rates of the mode decision from per-CTU rate tables
   uint32_t  m_log2MaxTbSize;
 
   //====== Loop/Deblock Filter ========
@@ -658,6 +667,8 @@ protected:
   uint32_t  m_PPSMaxNumMergeCandMinusMaxNumGeoCandPlus1;
   bool      m_DepQuantEnabledFlag;
   bool      m_SignDataHidingEnabledFlag;
+  bool      m_lookAhead;                                      ///< analyse the buffered pictures ahead of the GOP encoder
+  int       m_sceneCutThreshold;                              ///< scene cut sensitivity of the look-ahead in percent, 0: no scene cut detection
   bool      m_RCEnableRateControl;
   int       m_RCTargetBitrate;
   int       m_RCKeepHierarchicalBit;
@@ -665,6 +676,8 @@ protected:
   bool      m_RCUseLCUSeparateModel;
   int       m_RCInitialQP;
   bool      m_RCForceIntraQP;
+  int       m_RCPass;                                         ///< 0: single pass; 1: first pass writing statistics; 2: second pass reading statistics
+  std::string m_RCStatsFileName;                              ///< file of the first pass statistics
 #if U0132_TARGET_BITS_SATURATION
   bool      m_RCCpbSaturationEnabled;
   uint32_t      m_RCCpbSize;
@@ -743,6 +756,7 @@ protected:
   double      m_scalingRatioVer;
   bool        m_resChangeInClvsEnabled;
   int         m_switchPocPeriod;
+  int         m_rprThreads;
   int         m_upscaledOutput;
   int         m_numRefLayers[MAX_VPS_LAYERS];
   bool        m_avoidIntraInDepLayer;
@@ -890,6 +904,12 @@ public:
   bool      getPrintSequenceMSE             ()         const { return m_printSequenceMSE;           }
   void      setPrintSequenceMSE             (bool value)     { m_printSequenceMSE = value;          }
 
+  int       getMetricThreads                ()         const { return m_metricThreads;              }
+  void      setMetricThreads                (int value)      { m_metricThreads = value;             }
+
+  bool      getAsyncMetrics                 ()         const { return m_asyncMetrics;               }
+  void      setAsyncMetrics                 (bool value)     { m_asyncMetrics = value;              }
+
   bool      getCabacZeroWordPaddingEnabled()           const { return m_cabacZeroWordPaddingEnabled;  }
   void      setCabacZeroWordPaddingEnabled(bool value)       { m_cabacZeroWordPaddingEnabled = value; }
 
@@ -1068,6 +1088,12 @@ public:
   bool      getAllowDisFracMMVD             ()         const { return m_allowDisFracMMVD; }
   void      setUseHashME                    ( bool b )       { m_HashME = b; }
   bool      getUseHashME                    ()         const { return m_HashME; }
+  void      setHashMEThreads                ( int i )        { m_hashMEThreads = i; }
+  int       getHashMEThreads                ()         const { return m_hashMEThreads; }
+  void      setUseHierarchicalME            ( bool b )       { m_hierarchicalME = b; }
+  bool      getUseHierarchicalME            ()         const { return m_hierarchicalME; }
+  void      setHierarchicalMEThreads        ( int i )        { m_hierarchicalMEThreads = i; }
+  int       getHierarchicalMEThreads        ()         const { return m_hierarchicalMEThreads; }
   void      setUseAffineAmvr                ( bool b )       { m_AffineAmvr = b;    }
   bool      getUseAffineAmvr                ()         const { return m_AffineAmvr; }
   void      setUseAffineAmvrEncOpt          ( bool b )       { m_AffineAmvrEncOpt = b;    }
@@ -1105,6 +1131,8 @@ public:
   bool      getUseWrapAround                ()         const { return m_wrapAround; }
   void      setWrapAroundOffset             ( unsigned u )   { m_wrapAroundOffset = u; }
   unsigned  getWrapAroundOffset             ()         const { return m_wrapAroundOffset; }
+  void      setBorderExtThreads             ( int i )        { m_borderExtThreads = i; }
+  int       getBorderExtThreads             ()         const { return m_borderExtThreads; }
 
   // ADD_NEW_TOOL : (encoder lib) add access functions here
   void      setVirtualBoundariesEnabledFlag( bool b ) { m_virtualBoundariesEnabledFlag = b; }
@@ -1153,6 +1181,10 @@ public:
   bool      getUseE0023FastEnc              () const         { return m_e0023FastEnc; }
   void      setUseContentBasedFastQtbt      ( bool b )       { m_contentBasedFastQtbt = b; }
   bool      getUseContentBasedFastQtbt      () const         { return m_contentBasedFastQtbt; }
+  void      setFastPartition                ( unsigned u )   { m_fastPartition = u; }
+  unsigned  getFastPartition                () const         { return m_fastPartition; }
+  void      setTemporalCuReuse              ( bool b )       { m_temporalCuReuse = b; }
+  bool      getTemporalCuReuse              () const         { return m_temporalCuReuse; }
   void      setUseNonLinearAlfLuma          ( bool b )       { m_useNonLinearAlfLuma = b; }
   bool      getUseNonLinearAlfLuma          () const         { return m_useNonLinearAlfLuma; }
   void      setUseNonLinearAlfChroma        ( bool b )       { m_useNonLinearAlfChroma = b; }
@@ -1167,6 +1199,8 @@ public:
   bool      getUseFastMIP                   () const         { return m_useFastMIP; }
   void     setFastLocalDualTreeMode         ( int i )        { m_fastLocalDualTreeMode = i; }
   int      getFastLocalDualTreeMode         () const         { return m_fastLocalDualTreeMode; }
+  void     setUseFastResidualRate           ( bool b )       { m_useFastResidualRate = b; }
+  bool     getUseFastResidualRate           () const         { return m_useFastResidualRate; }
 
   void      setLog2MaxTbSize                ( uint32_t  u )   { m_log2MaxTbSize = u; }
 
@@ -1726,6 +1760,10 @@ public:
   bool         getDepQuantEnabledFlag()                              { return m_DepQuantEnabledFlag; }
   void         setSignDataHidingEnabledFlag( bool b )                { m_SignDataHidingEnabledFlag = b;    }
   bool         getSignDataHidingEnabledFlag()                        { return m_SignDataHidingEnabledFlag; }
+  bool         getLookAhead           () const                       { return m_lookAhead;             }
+  void         setLookAhead           ( bool b )                     { m_lookAhead = b;                }
+  int          getSceneCutThreshold   () const                       { return m_sceneCutThreshold;     }
+  void         setSceneCutThreshold   ( int i )                      { m_sceneCutThreshold = i;        }
   bool         getUseRateCtrl         () const                       { return m_RCEnableRateControl;   }
   void         setUseRateCtrl         ( bool b )                     { m_RCEnableRateControl = b;      }
   int          getTargetBitrate       ()                             { return m_RCTargetBitrate;       }
@@ -1740,6 +1778,10 @@ public:
   void         setInitialQP           ( int QP )                     { m_RCInitialQP = QP;             }
   bool         getForceIntraQP        ()                             { return m_RCForceIntraQP;        }
   void         setForceIntraQP        ( bool b )                     { m_RCForceIntraQP = b;           }
+  int          getRCPass              () const                       { return m_RCPass;                }
+  void         setRCPass              ( int i )                      { m_RCPass = i;                   }
+  const std::string& getRCStatsFileName () const                     { return m_RCStatsFileName;       }
+  void         setRCStatsFileName     ( const std::string &s )       { m_RCStatsFileName = s;          }
 #if U0132_TARGET_BITS_SATURATION
   bool         getCpbSaturationEnabled()                             { return m_RCCpbSaturationEnabled;}
   void         setCpbSaturationEnabled( bool b )                     { m_RCCpbSaturationEnabled = b;   }
@@ -1912,6 +1954,8 @@ public:
   void        setResChangeInClvsEnabled(bool b)                      { m_resChangeInClvsEnabled = b; }
   bool        isResChangeInClvsEnabled()                        const { return m_resChangeInClvsEnabled; }
   void        setSwitchPocPeriod( int p )                            { m_switchPocPeriod = p;}
+  void        setRprThreads( int n )                                 { m_rprThreads = n; }
+  int         getRprThreads()                                  const { return m_rprThreads; }
   void        setUpscaledOutput( int b )                             { m_upscaledOutput = b; }
   int         getUpscaledOutput()                              const { return m_upscaledOutput; }
 
@@ -56,6 +56,7 @@
 #include "CommonLib/dtrace_codingstruct.h"
 #include "CommonLib/dtrace_buffer.h"
 #include "CommonLib/ProfileLevelTier.h"
+#include "CommonLib/StageProfiler.h"
 
 #include "DecoderLib/DecLib.h"
 
@@ -1590,6 +1591,7 @@ void EncGOP::xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic )
     return;
   }
 
+  // the tables are normally built right after the reference pictures have been coded, see xPicBuildHashME
   PicList::iterator iterPic = rcListPic.begin();
   while (iterPic != rcListPic.end())
   {
@@ -1599,60 +1601,54 @@ void EncGOP::xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic )
     {
       if (!refPic->getHashMap()->isInitial())
       {
-        if (refPic->getPOC() == 0)
+        if (!xPicBuildHashME(refPic, pps))
         {
-          Pel* picSrc = refPic->getOrigBuf().get(COMPONENT_Y).buf;
-          int stridePic = refPic->getOrigBuf().get(COMPONENT_Y).stride;
-          int picWidth = pps->getPicWidthInLumaSamples();
-          int picHeight = pps->getPicHeightInLumaSamples();
-          int blockSize = 4;
-          int allNum = 0;
-          int simpleNum = 0;
-          for (int j = 0; j <= picHeight - blockSize; j += blockSize)
-          {
-            for (int i = 0; i <= picWidth - blockSize; i += blockSize)
-            {
-              Pel* curBlock = picSrc + j * stridePic + i;
-              bool isHorSame = true;
-              for (int m = 0; m < blockSize&&isHorSame; m++)
-              {
-                for (int n = 1; n < blockSize&&isHorSame; n++)
-                {
-                  if (curBlock[m*stridePic] != curBlock[m*stridePic + n])
-                  {
-                    isHorSame = false;
-                  }
-                }
-              }
-              bool isVerSame = true;
-              for (int m = 1; m < blockSize&&isVerSame; m++)
-              {
-                for (int n = 0; n < blockSize&&isVerSame; n++)
-                {
-                  if (curBlock[n] != curBlock[m*stridePic + n])
-                  {
-                    isVerSame = false;
-                  }
-                }
-              }
-              allNum++;
-              if (isHorSame || isVerSame)
-              {
-                simpleNum++;
-              }
-            }
-          }
+          break;
+        }
+      }
+    }
+  }
+}
 
-          if (simpleNum < 0.3*allNum)
-          {
-            m_pcCfg->setUseHashME(false);
-            break;
-          }
+/** builds the hash motion estimation table of a picture from its original samples
+    \returns false if hash motion estimation has been disabled because the first picture is not screen content
+ */
+bool EncGOP::xPicBuildHashME( Picture *pic, const PPS *pps )
+{
+  const int numThreads = m_pcCfg->getHashMEThreads();
+
+  if (pic->getPOC() == 0)
+  {
+    Pel* picSrc = pic->getOrigBuf().get(COMPONENT_Y).buf;
+    int stridePic = pic->getOrigBuf().get(COMPONENT_Y).stride;
+    int picWidth = pps->getPicWidthInLumaSamples();
+    int picHeight = pps->getPicHeightInLumaSamples();
+    int blockSize = 4;
+    int allNum = ( picWidth / blockSize ) * ( picHeight / blockSize );
+    int simpleNum = 0;
+#if _OPENMP
+#pragma omp parallel for schedule(static) num_threads(numThreads) if(numThreads > 1) reduction(+:simpleNum)
+#endif
+    for (int j = 0; j <= picHeight - blockSize; j += blockSize)
+    {
+      for (int i = 0; i <= picWidth - blockSize; i += blockSize)
+      {
+        const Pel* curBlock = picSrc + j * stridePic + i;
+        if (TComHash::isHorizontalPerfectLuma(curBlock, stridePic, blockSize, blockSize) || TComHash::isVerticalPerfectLuma(curBlock, stridePic, blockSize, blockSize))
+        {
+          simpleNum++;
         }
-        refPic->addPictureToHashMapForInter();
       }
     }
+
+    if (simpleNum < 0.3*allNum)
+    {
+      m_pcCfg->setUseHashME(false);
+      return false;
+    }
   }
+  pic->addPictureToHashMapForInter(numThreads);
+  return true;
 }
 
 void EncGOP::xPicInitRateControl(int &estimatedBits, int gopId, double &lambda, Picture *pic, Slice *slice)
@@ -1662,11 +1658,11 @@ void EncGOP::xPicInitRateControl(int &estimatedBits, int gopId, double &lambda,
     return;
   }
   int frameLevel = m_pcRateCtrl->getRCSeq()->getGOPID2Level( gopId );
-  if ( pic->slices[0]->isIRAP() )
+  if ( pic->slices[0]->isIRAP() || m_pcEncLib->getLookahead()->isSceneCut( slice->getPOC() ) )
   {
     frameLevel = 0;
   }
-  m_pcRateCtrl->initRCPic( frameLevel );
+  m_pcRateCtrl->initRCPic( frameLevel, slice->getPOC() );
   estimatedBits = m_pcRateCtrl->getRCPic()->getTargetBits();
 
 #if U0132_TARGET_BITS_SATURATION
@@ -1713,7 +1709,7 @@ void EncGOP::xPicInitRateControl(int &estimatedBits, int gopId, double &lambda,
   else if ( frameLevel == 0 )   // intra case, but use the model
   {
     m_pcSliceEncoder->calCostPictureI(pic);
-    if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
+    if ( m_pcCfg->getIntraPeriod() != 1 && !m_pcRateCtrl->getRCPic()->hasFirstPassStats() )   // do not refine allocated bits for all intra case and in the second pass
     {
       int bits = m_pcRateCtrl->getRCSeq()->getLeftAverageBits();
       bits = m_pcRateCtrl->getRCPic()->getRefineBitsForIntra( bits );
@@ -2051,6 +2047,9 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     m_pcSliceEncoder->setSliceSegmentIdx(0);
 
     m_pcSliceEncoder->initEncSlice(pcPic, iPOCLast, pocCurr, iGOPid, pcSlice, isField, isEncodeLtRef, m_pcEncLib->getLayerId() );
+#if ENABLE_STAGE_PROFILING
+    g_stageProfiler.beginPicture( m_pcEncLib->getLayerId(), pocCurr );
+#endif
 
     DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "poc", pocCurr ) ) );
     DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "final", 0 ) ) );
@@ -2287,6 +2286,11 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 
     xPicInitHashME( pcPic, pcSlice->getPPS(), rcListPic );
 
+    if( m_pcCfg->getUseHierarchicalME() )
+    {
+      m_pcEncLib->getHierarchicalME()->estimatePicture( *pcPic, *pcSlice );
+    }
+
     if( m_pcCfg->getUseAMaxBT() )
     {
       if( !pcSlice->isIntra() )
@@ -2484,7 +2488,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       }
     }
 
-    pcSlice->scaleRefPicList( scaledRefPic, pcPic->cs->picHeader, m_pcEncLib->getApss(), picHeader->getLmcsAPS(), picHeader->getScalingListAPS(), false );
+    pcSlice->scaleRefPicList( scaledRefPic, pcPic->cs->picHeader, m_pcEncLib->getApss(), picHeader->getLmcsAPS(), picHeader->getScalingListAPS(), false, m_pcCfg->getRprThreads() );
 
     // set adaptive search range for non-intra-slices
     if (m_pcCfg->getUseASR() && !pcSlice->isIntra())
@@ -2791,6 +2795,11 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       CodingStructure& cs = *pcPic->cs;
       pcSlice = pcPic->slices[0];
 
+      if( m_pcCfg->getTemporalCuReuse() )
+      {
+        CuHistoryCtrl::storeCuHistory( *pcPic );
+      }
+
       if (cs.sps->getUseLmcs() && m_pcReshaper->getSliceReshaperInfo().getUseSliceReshaper())
       {
         picHeader->setLmcsEnabledFlag(true);
@@ -3398,14 +3407,42 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 
       m_pcCfg->setEncodedFlag(iGOPid, true);
 
+      // with AsyncMetrics the report of the picture, including the hash and the CPB state, is printed once the metrics
+      // have been computed, before the report of the next picture; the luma level weights may change with the picture
+#if WCG_WPSNR
+      const bool useLumaWPSNR = m_pcEncLib->getLumaLevelToDeltaQPMapping().isEnabled() || (m_pcCfg->getLmcs() && m_pcCfg->getReshapeSignalType() == RESHAPE_SIGNAL_PQ);
+      const bool asyncMetrics = m_pcCfg->getAsyncMetrics() && !isField && !useLumaWPSNR;
+#else
+      const bool asyncMetrics = m_pcCfg->getAsyncMetrics() && !isField;
+#endif
       double PSNR_Y;
-      xCalculateAddPSNRs(isField, isTff, iGOPid, pcPic, accessUnit, rcListPic, encTime, snr_conversion, printFrameMSE, &PSNR_Y, isEncodeLtRef );
+      if( asyncMetrics )
+      {
+        xLaunchPicMetrics( pcPic, accessUnit, (double)encTime, snr_conversion, printFrameMSE, isEncodeLtRef );
+      }
+      else
+      {
+        xFlushPicMetrics();
+        PROFILE_STAGE( PROF_METRICS );
+        xCalculateAddPSNRs(isField, isTff, iGOPid, pcPic, accessUnit, rcListPic, encTime, snr_conversion, printFrameMSE, &PSNR_Y, isEncodeLtRef );
+      }
 
 
       xWriteTrailingSEIMessages(trailingSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS());
 
-      printHash(m_pcCfg->getDecodedPictureHashSEIType(), digestStr);
+      if( asyncMetrics )
+      {
+        m_pendingMetrics.digestStr = digestStr;
+      }
+      else
+      {
+        printHash(m_pcCfg->getDecodedPictureHashSEIType(), digestStr);
+      }
 
+      if ( m_pcCfg->getRCPass() == 1 )
+      {
+        m_pcRateCtrl->addFirstPassPicture( pcSlice->getPOC(), pcSlice->getSliceQp(), pcSlice->getSliceType(), actualTotalBits );
+      }
       if ( m_pcCfg->getUseRateCtrl() )
       {
         double avgQP     = m_pcRateCtrl->getRCPic()->calAverageQP();
@@ -3431,7 +3468,14 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         if (m_pcRateCtrl->getCpbSaturationEnabled())
         {
           m_pcRateCtrl->updateCpbState(actualTotalBits);
-          msg( NOTICE, " [CPB %6d bits]", m_pcRateCtrl->getCpbState() );
+          if( asyncMetrics )
+          {
+            m_pendingMetrics.cpbState = m_pcRateCtrl->getCpbState();
+          }
+          else
+          {
+            msg( NOTICE, " [CPB %6d bits]", m_pcRateCtrl->getCpbState() );
+          }
         }
   #endif
       }
@@ -3475,13 +3519,34 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 
       m_AUWriterIf->outputAU( accessUnit );
 
-      msg( NOTICE, "\n" );
-      fflush( stdout );
+      if( !asyncMetrics )
+      {
+        msg( NOTICE, "\n" );
+        fflush( stdout );
+      }
     }
 
 
     DTRACE_UPDATE( g_trace_ctx, ( std::make_pair( "final", 0 ) ) );
 
+#if ENABLE_STAGE_PROFILING
+    g_stageProfiler.endPicture( pcSlice->getTLayer(), pcSlice->getSliceType() );
+#endif
+
+    // the hash table only depends on the original samples, build it once now instead of when the picture is first
+    // referenced; pictures of the highest of several temporal layers are usually not referenced and built on demand
+    const bool highestTLayer = pcSlice->getTLayer() > 0 && pcSlice->getTLayer() + 1 >= pcSlice->getSPS()->getMaxTLayers();
+    if( m_pcCfg->getUseHashME() && m_pcCfg->getIntraPeriod() != 1 && !highestTLayer && !pcPic->getHashMap()->isInitial() )
+    {
+      xPicBuildHashME( pcPic, pcSlice->getPPS() );
+    }
+
+    // with several threads the borders are extended right away instead of when the picture is first referenced
+    if( m_pcCfg->getBorderExtThreads() > 1 && !highestTLayer )
+    {
+      pcPic->extendPicBorder( pcSlice->getPPS(), m_pcCfg->getBorderExtThreads() );
+    }
+
     pcPic->reconstructed = true;
     m_bFirst = false;
     m_iNumPicCoded++;
@@ -3504,6 +3569,9 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     pcPic->cs->releaseIntermediateData();
   } // iGOPid-loop
 
+  // the pictures may be reused for the next GOP
+  xFlushPicMetrics();
+
   delete pcBitstreamRedirect;
 
   CHECK( m_iNumPicCoded > 1, "Unspecified error" );
@@ -3636,7 +3704,7 @@ uint64_t EncGOP::preLoopFilterPicAndCalcDist( Picture* pcPic )
 #if ENABLE_QPA
     CHECK( rshift >= 8, "shifts greater than 7 are not supported." );
 #endif
-    uiDist += xFindDistortionPlane( picOrg.get(compID), picRec.get(compID), rshift );
+    uiDist += xFindDistortionPlane( picOrg.get(compID), picRec.get(compID), rshift, cs.sps->getBitDepth(toChannelType(compID)) );
   }
   return uiDist;
 }
@@ -3772,7 +3840,7 @@ static inline double calcWeightedSquaredError(const CPelBuf& org,        const C
 }
 #endif // ENABLE_QPA
 
-uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1, const uint32_t rshift
+uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1, const uint32_t rshift, const int bitDepth
 #if ENABLE_QPA
                                     , const uint32_t chromaShiftHor /*= 0*/, const uint32_t chromaShiftVer /*= 0*/
 #endif
@@ -3800,18 +3868,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
 
       if (B < 4) // image is too small to use WPSNR, resort to traditional PSNR
       {
-        uiTotalDiff = 0;
-        for (y = 0; y < H; y++)
-        {
-          for (x = 0; x < W; x++)
-          {
-            const           int64_t iDiff = (int64_t)pSrc0[x] - (int64_t)pSrc1[x];
-            uiTotalDiff += uint64_t(iDiff * iDiff);
-          }
-          pSrc0 += pic0.stride;
-          pSrc1 += pic1.stride;
-        }
-        return uiTotalDiff;
+        return g_pelBufOP.calcSSE(pSrc0, pic0.stride, pSrc1, pic1.stride, W, H, bitDepth);
       }
 
       double wmse = 0.0, sumAct = 0.0; // compute activity normalized SNR value
@@ -3848,17 +3905,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
   }
   else
   {
-    uiTotalDiff = 0;
-    for (int y = 0; y < pic0.height; y++)
-    {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int iTemp = pSrc0[x] - pSrc1[x];
-        uiTotalDiff += uint64_t(iTemp * iTemp);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-    }
+    uiTotalDiff = g_pelBufOP.calcSSE(pSrc0, pic0.stride, pSrc1, pic1.stride, pic0.width, pic0.height, bitDepth);
   }
 
   return uiTotalDiff;
@@ -3995,6 +4042,19 @@ void EncGOP::xCalculateAddPSNRs( const bool isField, const bool isFieldTopFieldF
 void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUnit& accessUnit, double dEncTime, const InputColourSpaceConversion conversion, const bool printFrameMSE, double* PSNR_Y
                               , bool isEncodeLtRef
 )
+{
+  PicMetrics metrics;
+  xCalculatePicMetrics( pcPic, cPicD, conversion, metrics );
+  xAddPicMetrics( pcPic, metrics, xGetAccessUnitBits( accessUnit ), dEncTime, printFrameMSE, PSNR_Y, isEncodeLtRef, pcPic->referenced );
+}
+
+/** PSNR, MSE, the luma level weighted PSNR and the PSNR of the upscaled picture for all components
+ * \param pcPic      coded picture, providing the original
+ * \param cPicD      reconstruction
+ * The components are processed in parallel with MetricThreads threads. The function does not modify the state of the
+ * encoder, so that it can run in a worker thread while the next picture is coded.
+ */
+void EncGOP::xCalculatePicMetrics( Picture* pcPic, const CPelUnitBuf& cPicD, const InputColourSpaceConversion conversion, PicMetrics& metrics )
 {
   const SPS&         sps = *pcPic->cs->sps;
   const CPelUnitBuf& pic = cPicD;
@@ -4004,31 +4064,19 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
 #if ENABLE_QPA
   const bool    useWPSNR = m_pcEncLib->getUseWPSNR();
 #endif
-  double  dPSNR[MAX_NUM_COMPONENT];
 #if WCG_WPSNR
   const bool    useLumaWPSNR = m_pcEncLib->getLumaLevelToDeltaQPMapping().isEnabled() || (m_pcCfg->getLmcs() && m_pcCfg->getReshapeSignalType() == RESHAPE_SIGNAL_PQ);
-  double  dPSNRWeighted[MAX_NUM_COMPONENT];
-  double  MSEyuvframeWeighted[MAX_NUM_COMPONENT];
 #endif
-  double  upscaledPSNR[MAX_NUM_COMPONENT];
   for(int i=0; i<MAX_NUM_COMPONENT; i++)
   {
-    dPSNR[i]=0.0;
+    metrics.psnr[i] = 0.0;
+    metrics.mse[i]  = 0.0;
 #if WCG_WPSNR
-    dPSNRWeighted[i]=0.0;
-    MSEyuvframeWeighted[i] = 0.0;
+    metrics.psnrWeighted[i] = 0.0;
+    metrics.mseWeighted[i]  = 0.0;
 #endif
-    upscaledPSNR[i] = 0.0;
-  }
-#if JVET_O0756_CALCULATE_HDRMETRICS
-  double deltaE[hdrtoolslib::NB_REF_WHITE];
-  double psnrL[hdrtoolslib::NB_REF_WHITE];
-  for (int i=0; i<hdrtoolslib::NB_REF_WHITE; i++)
-  {
-    deltaE[i] = 0.0;
-    psnrL[i] = 0.0;
+    metrics.upscaledPSNR[i] = 0.0;
   }
-#endif
 
   PelStorage interm;
 
@@ -4041,12 +4089,10 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
   const CPelUnitBuf& picC = (conversion == IPCOLOURSPACE_UNCHANGED) ? pic : interm;
 
   //===== calculate PSNR =====
-  double MSEyuvframe[MAX_NUM_COMPONENT] = {0, 0, 0};
   const ChromaFormat formatD = pic.chromaFormat;
   const ChromaFormat format  = sps.getChromaFormatIdc();
 
   const bool bPicIsField     = pcPic->fieldPic;
-  const Slice*  pcSlice      = pcPic->slices[0];
 
   PelStorage upscaledRec;
 
@@ -4061,10 +4107,16 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     CU::getRprScaling( &sps, pps, pcPic, xScale, yScale );
     std::pair<int, int> scalingRatio = std::pair<int, int>( xScale, yScale );
 
-    Picture::rescalePicture( scalingRatio, picC, pcPic->getScalingWindow(), upscaledRec, pps->getScalingWindow(), format, sps.getBitDepths(), false, false, sps.getHorCollocatedChromaFlag(), sps.getVerCollocatedChromaFlag() );
+    Picture::rescalePicture( scalingRatio, picC, pcPic->getScalingWindow(), upscaledRec, pps->getScalingWindow(), format, sps.getBitDepths(), false, false, sps.getHorCollocatedChromaFlag(), sps.getVerCollocatedChromaFlag(), m_pcCfg->getRprThreads() );
   }
 
-  for (int comp = 0; comp < ::getNumberValidComponents(formatD); comp++)
+  const int numComp    = ::getNumberValidComponents(formatD);
+
+#if _OPENMP
+  const int numThreads = std::min( m_pcCfg->getMetricThreads(), numComp );
+#pragma omp parallel for schedule(static, 1) num_threads(numThreads) if(numThreads > 1)
+#endif
+  for (int comp = 0; comp < numComp; comp++)
   {
     const ComponentID compID = ComponentID(comp);
     const CPelBuf&    p = picC.get(compID);
@@ -4093,21 +4145,21 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     const CPelBuf orgPB(o.bufAt(0, 0), o.stride, width, height);
     const uint32_t    bitDepth = sps.getBitDepth(toChannelType(compID));
 #if ENABLE_QPA
-    const uint64_t uiSSDtemp = xFindDistortionPlane(recPB, orgPB, useWPSNR ? bitDepth : 0, ::getComponentScaleX(compID, format), ::getComponentScaleY(compID, format));
+    const uint64_t uiSSDtemp = xFindDistortionPlane(recPB, orgPB, useWPSNR ? bitDepth : 0, bitDepth, ::getComponentScaleX(compID, format), ::getComponentScaleY(compID, format));
 #else
-    const uint64_t uiSSDtemp = xFindDistortionPlane(recPB, orgPB, 0);
+    const uint64_t uiSSDtemp = xFindDistortionPlane(recPB, orgPB, 0, bitDepth);
 #endif
     const uint32_t maxval = 255 << (bitDepth - 8);
     const uint32_t size   = width * height;
     const double fRefValue = (double)maxval * maxval * size;
-    dPSNR[comp]       = uiSSDtemp ? 10.0 * log10(fRefValue / (double)uiSSDtemp) : 999.99;
-    MSEyuvframe[comp] = (double)uiSSDtemp / size;
+    metrics.psnr[comp] = uiSSDtemp ? 10.0 * log10(fRefValue / (double)uiSSDtemp) : 999.99;
+    metrics.mse[comp]  = (double)uiSSDtemp / size;
 #if WCG_WPSNR
     const double uiSSDtempWeighted = xFindDistortionPlaneWPSNR(recPB, orgPB, 0, org.get(COMPONENT_Y), compID, format);
     if (useLumaWPSNR)
     {
-      dPSNRWeighted[comp] = uiSSDtempWeighted ? 10.0 * log10(fRefValue / (double)uiSSDtempWeighted) : 999.99;
-      MSEyuvframeWeighted[comp] = (double)uiSSDtempWeighted / size;
+      metrics.psnrWeighted[comp] = uiSSDtempWeighted ? 10.0 * log10(fRefValue / (double)uiSSDtempWeighted) : 999.99;
+      metrics.mseWeighted[comp]  = (double)uiSSDtempWeighted / size;
     }
 #endif
 
@@ -4123,34 +4175,22 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
       const CPelBuf upscaledOrgPB( upscaledOrg.bufAt( 0, 0 ), upscaledOrg.stride, upscaledWidth, upscaledHeight );
 
 #if ENABLE_QPA
-      const uint64_t upscaledSSD = xFindDistortionPlane( upscaledRecPB, upscaledOrgPB, useWPSNR ? bitDepth : 0, ::getComponentScaleX( compID, format ) );
+      const uint64_t upscaledSSD = xFindDistortionPlane( upscaledRecPB, upscaledOrgPB, useWPSNR ? bitDepth : 0, bitDepth, ::getComponentScaleX( compID, format ) );
 #else
-      const uint64_t scaledSSD = xFindDistortionPlane( upsacledRecPB, upsacledOrgPB, 0 );
+      const uint64_t upscaledSSD = xFindDistortionPlane( upscaledRecPB, upscaledOrgPB, 0, bitDepth );
 #endif
 
-      upscaledPSNR[comp] = upscaledSSD ? 10.0 * log10( (double)maxval * maxval * upscaledWidth * upscaledHeight / (double)upscaledSSD ) : 999.99;
+      metrics.upscaledPSNR[comp] = upscaledSSD ? 10.0 * log10( (double)maxval * maxval * upscaledWidth * upscaledHeight / (double)upscaledSSD ) : 999.99;
     }
   }
+}
 
-#if EXTENSION_360_VIDEO
-  m_ext360.calculatePSNRs(pcPic);
-#endif
-
-#if JVET_O0756_CALCULATE_HDRMETRICS
-  const bool calculateHdrMetrics = m_pcEncLib->getCalcluateHdrMetrics();
-  if (calculateHdrMetrics)
-  {
-    auto beforeTime = std::chrono::steady_clock::now();
-    xCalculateHDRMetrics(pcPic, deltaE, psnrL);
-    auto elapsed = std::chrono::steady_clock::now() - beforeTime;
-    m_metricTime += elapsed;
-  }
-#endif
-
-  /* calculate the size of the access unit, excluding:
-   *  - any AnnexB contributions (start_code_prefix, zero_byte, etc.,)
-   *  - SEI NAL units
-   */
+/** size of an access unit in bits, excluding:
+ *  - any AnnexB contributions (start_code_prefix, zero_byte, etc.,)
+ *  - SEI NAL units
+ */
+uint32_t EncGOP::xGetAccessUnitBits( const AccessUnit& accessUnit )
+{
   uint32_t numRBSPBytes = 0;
   for (AccessUnit::const_iterator it = accessUnit.begin(); it != accessUnit.end(); it++)
   {
@@ -4173,7 +4213,95 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     }
   }
 
-  uint32_t uibits = numRBSPBytes * 8;
+  return numRBSPBytes * 8;
+}
+
+/** starts the computation of the metrics of a coded picture in a worker thread; its report, including the decoded
+ * picture hash and the CPB state which are stored by the caller, is issued by xFlushPicMetrics
+ */
+void EncGOP::xLaunchPicMetrics( Picture* pcPic, const AccessUnit& accessUnit, double dEncTime, const InputColourSpaceConversion conversion, const bool printFrameMSE, bool isEncodeLtRef )
+{
+  xFlushPicMetrics();
+
+  m_pendingMetrics.pic           = pcPic;
+  m_pendingMetrics.bits          = xGetAccessUnitBits( accessUnit );
+  m_pendingMetrics.encTime       = dEncTime;
+  m_pendingMetrics.printFrameMSE = printFrameMSE;
+  m_pendingMetrics.isEncodeLtRef = isEncodeLtRef;
+  m_pendingMetrics.referenced    = pcPic->referenced;
+  m_pendingMetrics.digestStr.clear();
+  m_pendingMetrics.cpbState      = -1;
+
+  const CPelUnitBuf recBuf = pcPic->getRecoBuf();
+  m_pendingMetrics.metrics = std::async( std::launch::async, [this, pcPic, recBuf, conversion]()
+  {
+    PROFILE_STAGE( PROF_METRICS );
+    PicMetrics metrics;
+    xCalculatePicMetrics( pcPic, recBuf, conversion, metrics );
+    return metrics;
+  } );
+}
+
+/// waits for the metrics of the pending picture, if any, and prints its report
+void EncGOP::xFlushPicMetrics()
+{
+  if( !m_pendingMetrics.metrics.valid() )
+  {
+    return;
+  }
+
+  PicMetrics metrics = m_pendingMetrics.metrics.get();
+  double     PSNR_Y;
+  xAddPicMetrics( m_pendingMetrics.pic, metrics, m_pendingMetrics.bits, m_pendingMetrics.encTime, m_pendingMetrics.printFrameMSE, &PSNR_Y, m_pendingMetrics.isEncodeLtRef, m_pendingMetrics.referenced );
+
+  printHash( m_pcCfg->getDecodedPictureHashSEIType(), m_pendingMetrics.digestStr );
+#if U0132_TARGET_BITS_SATURATION
+  if( m_pendingMetrics.cpbState >= 0 )
+  {
+    msg( NOTICE, " [CPB %6d bits]", m_pendingMetrics.cpbState );
+  }
+#endif
+  msg( NOTICE, "\n" );
+  fflush( stdout );
+}
+
+/// adds the metrics of a coded picture to the statistics and prints its report line
+void EncGOP::xAddPicMetrics( Picture* pcPic, PicMetrics& metrics, uint32_t uibits, double dEncTime, const bool printFrameMSE, double* PSNR_Y, bool isEncodeLtRef, bool isReferenced )
+{
+  double* dPSNR        = metrics.psnr;
+  double* MSEyuvframe  = metrics.mse;
+#if WCG_WPSNR
+  const bool useLumaWPSNR  = m_pcEncLib->getLumaLevelToDeltaQPMapping().isEnabled() || (m_pcCfg->getLmcs() && m_pcCfg->getReshapeSignalType() == RESHAPE_SIGNAL_PQ);
+  double* dPSNRWeighted       = metrics.psnrWeighted;
+  double* MSEyuvframeWeighted = metrics.mseWeighted;
+#endif
+  double* upscaledPSNR = metrics.upscaledPSNR;
+  const Slice* pcSlice = pcPic->slices[0];
+#if JVET_O0756_CALCULATE_HDRMETRICS
+  double deltaE[hdrtoolslib::NB_REF_WHITE];
+  double psnrL[hdrtoolslib::NB_REF_WHITE];
+  for (int i=0; i<hdrtoolslib::NB_REF_WHITE; i++)
+  {
+    deltaE[i] = 0.0;
+    psnrL[i] = 0.0;
+  }
+#endif
+
+#if EXTENSION_360_VIDEO
+  m_ext360.calculatePSNRs(pcPic);
+#endif
+
+#if JVET_O0756_CALCULATE_HDRMETRICS
+  const bool calculateHdrMetrics = m_pcEncLib->getCalcluateHdrMetrics();
+  if (calculateHdrMetrics)
+  {
+    auto beforeTime = std::chrono::steady_clock::now();
+    xCalculateHDRMetrics(pcPic, deltaE, psnrL);
+    auto elapsed = std::chrono::steady_clock::now() - beforeTime;
+    m_metricTime += elapsed;
+  }
+#endif
+
   m_vRVM_RP.push_back( uibits );
 
   //===== add PSNR =====
@@ -4249,7 +4377,7 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
 #endif
 
   char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (! pcPic->referenced)
+  if (! isReferenced)
   {
     c += 32;
   }
@@ -4549,9 +4677,9 @@ void EncGOP::xCalculateInterlacedAddPSNR( Picture* pcPicOrgFirstField, Picture*
     {
       CHECK(!(conversion == IPCOLOURSPACE_UNCHANGED), "Unspecified error");
 #if ENABLE_QPA
-      uiSSDtemp += xFindDistortionPlane( acPicRecFields[fieldNum].get(ch), apcPicOrgFields[fieldNum]->getOrigBuf().get(ch), useWPSNR ? bitDepth : 0, ::getComponentScaleX(ch, format), ::getComponentScaleY(ch, format) );
+      uiSSDtemp += xFindDistortionPlane( acPicRecFields[fieldNum].get(ch), apcPicOrgFields[fieldNum]->getOrigBuf().get(ch), useWPSNR ? bitDepth : 0, bitDepth, ::getComponentScaleX(ch, format), ::getComponentScaleY(ch, format) );
 #else
-      uiSSDtemp += xFindDistortionPlane( acPicRecFields[fieldNum].get(ch), apcPicOrgFields[fieldNum]->getOrigBuf().get(ch), 0 );
+      uiSSDtemp += xFindDistortionPlane( acPicRecFields[fieldNum].get(ch), apcPicOrgFields[fieldNum]->getOrigBuf().get(ch), 0, bitDepth );
 #endif
     }
     const uint32_t maxval = 255 << (bitDepth - 8);
@@ -4603,7 +4731,7 @@ NalUnitType EncGOP::getNalUnitType(int pocCurr, int lastIDR, bool isField)
     return NAL_UNIT_CODED_SLICE_TRAIL;
   }
 
-  if (m_pcCfg->getDecodingRefreshType() != 3 && (pocCurr - isField) % (m_pcCfg->getIntraPeriod() * (m_pcCfg->getUseCompositeRef() ? 2 : 1)) == 0)
+  if (m_pcCfg->getDecodingRefreshType() != 3 && ((pocCurr - isField) % (m_pcCfg->getIntraPeriod() * (m_pcCfg->getUseCompositeRef() ? 2 : 1)) == 0 || m_pcEncLib->getLookahead()->isSceneCut(pocCurr)))
   {
     if (m_pcCfg->getDecodingRefreshType() == 1)
     {
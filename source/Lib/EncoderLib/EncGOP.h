@@ -39,6 +39,7 @@
 #define __ENCGOP__
 
 #include <list>
+#include <future>
 
 #include <stdlib.h>
 
@@ -99,6 +100,32 @@ class EncGOP
     int accumNalsDU;
   };
 
+  // distortion based quality of a coded picture, see xCalculatePicMetrics
+  struct PicMetrics
+  {
+    double psnr        [MAX_NUM_COMPONENT];
+    double mse         [MAX_NUM_COMPONENT];
+#if WCG_WPSNR
+    double psnrWeighted[MAX_NUM_COMPONENT];
+    double mseWeighted [MAX_NUM_COMPONENT];
+#endif
+    double upscaledPSNR[MAX_NUM_COMPONENT];
+  };
+
+  // report of a picture whose metrics are computed by a worker thread while the next picture is coded
+  struct PendingMetrics
+  {
+    std::future<PicMetrics> metrics;
+    Picture*                pic;
+    uint32_t                bits;
+    double                  encTime;
+    bool                    printFrameMSE;
+    bool                    isEncodeLtRef;
+    bool                    referenced;
+    std::string             digestStr;
+    int                     cpbState;   ///< -1 when not printed
+  };
+
 private:
 
   Analyze                 m_gcAnalyzeAll;
@@ -183,6 +210,7 @@ private:
   bool                    m_bInitAMaxBT;
 
   AUWriterIf*             m_AUWriterIf;
+  PendingMetrics          m_pendingMetrics;
 
 #if JVET_O0756_CALCULATE_HDRMETRICS
 
@@ -264,6 +292,7 @@ protected:
     , bool isEncodeLtRef
   );
   void  xPicInitHashME( Picture *pic, const PPS *pps, PicList &rcListPic );
+  bool  xPicBuildHashME( Picture *pic, const PPS *pps );
   void  xPicInitRateControl(int &estimatedBits, int gopId, double &lambda, Picture *pic, Slice *slice);
   void  xPicInitLMCS       (Picture *pic, PicHeader *picHeader, Slice *slice);
   void  xGetBuffer        ( PicList& rcListPic, std::list<PelUnitBuf*>& rcListPicYuvRecOut,
@@ -280,13 +309,18 @@ protected:
   void  xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUnit&, double dEncTime, const InputColourSpaceConversion snr_conversion, const bool printFrameMSE, double* PSNR_Y
     , bool isEncodeLtRef
   );
+  void  xCalculatePicMetrics( Picture* pcPic, const CPelUnitBuf& cPicD, const InputColourSpaceConversion snr_conversion, PicMetrics& metrics );
+  void  xAddPicMetrics      ( Picture* pcPic, PicMetrics& metrics, uint32_t uibits, double dEncTime, const bool printFrameMSE, double* PSNR_Y, bool isEncodeLtRef, bool isReferenced );
+  uint32_t xGetAccessUnitBits( const AccessUnit& accessUnit );
+  void  xLaunchPicMetrics   ( Picture* pcPic, const AccessUnit& accessUnit, double dEncTime, const InputColourSpaceConversion snr_conversion, const bool printFrameMSE, bool isEncodeLtRef );
+  void  xFlushPicMetrics    ();
   void  xCalculateInterlacedAddPSNR( Picture* pcPicOrgFirstField, Picture* pcPicOrgSecondField,
                                      PelUnitBuf cPicRecFirstField, PelUnitBuf cPicRecSecondField,
                                      const InputColourSpaceConversion snr_conversion, const bool printFrameMSE, double* PSNR_Y
                                     , bool isEncodeLtRef
   );
 
-  uint64_t xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1, const uint32_t rshift
+  uint64_t xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1, const uint32_t rshift, const int bitDepth
 #if ENABLE_QPA
                             , const uint32_t chromaShiftHor = 0, const uint32_t chromaShiftVer = 0
 #endif
@@ -0,0 +1,327 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     EncHierarchicalME.cpp
+    \brief    hierarchical motion estimation pre-pass
+*/
+
+#include "EncHierarchicalME.h"
+
+#include <algorithm>
+
+//! \ingroup EncoderLib
+//! \{
+
+EncHierarchicalME::EncHierarchicalME()
+  : m_searchRange ( 0 )
+  , m_numThreads  ( 1 )
+  , m_pic         ( nullptr )
+{
+  for( int list = 0; list < NUM_REF_PIC_LIST_01; list++ )
+  {
+    std::fill_n( m_refPic[list], MAX_NUM_REF, nullptr );
+  }
+  for( int level = 0; level < HME_NUM_LEVELS; level++ )
+  {
+    // the search range of the coarsest level and the refinements, scaled to the resolution of the level
+    m_curPlane[level].margin = 0;
+    m_refPlane[level].margin = ( HME_MAX_SEARCH << ( HME_NUM_LEVELS - 1 - level ) ) + ( 2 << ( HME_NUM_LEVELS - 1 - level ) );
+  }
+}
+
+void EncHierarchicalME::init( int searchRange, int numThreads )
+{
+  m_searchRange = searchRange;
+  m_numThreads  = std::max( numThreads, 1 );
+  m_pic         = nullptr;
+}
+
+void EncHierarchicalME::estimatePicture( const Picture& pic, const Slice& slice )
+{
+  m_pic = nullptr;
+  for( int list = 0; list < NUM_REF_PIC_LIST_01; list++ )
+  {
+    std::fill_n( m_refPic[list], MAX_NUM_REF, nullptr );
+    for( auto& mvs : m_mvs[list] )
+    {
+      mvs.clear();
+    }
+  }
+  if( slice.isIntra() )
+  {
+    return;
+  }
+
+  xBuildPyramid( pic.getOrigBuf( pic.blocks[COMPONENT_Y] ), m_curPlane );
+  for( int level = 0; level < HME_NUM_LEVELS; level++ )
+  {
+    m_levels[level].blkSize = level == 0 ? HME_BLK_SIZE : HME_BLK_SIZE >> 1;
+    m_levels[level].numBlkX = m_curPlane[level].width  / m_levels[level].blkSize;
+    m_levels[level].numBlkY = m_curPlane[level].height / m_levels[level].blkSize;
+  }
+  if( m_levels[HME_NUM_LEVELS - 1].numBlkX == 0 || m_levels[HME_NUM_LEVELS - 1].numBlkY == 0 )
+  {
+    return;
+  }
+
+  for( int list = 0; list < ( slice.isInterB() ? 2 : 1 ); list++ )
+  {
+    const RefPicList refList = RefPicList( list );
+    for( int refIdx = 0; refIdx < slice.getNumRefIdx( refList ); refIdx++ )
+    {
+      const Picture* refPic = slice.getRefPic( refList, refIdx );
+      m_refPic[list][refIdx] = refPic;
+      if( refPic->lumaSize() != pic.lumaSize() )
+      {
+        continue;
+      }
+
+      // the motion to a picture contained in both lists is only estimated once
+      int refIdxL0 = -1;
+      for( int i = 0; list == REF_PIC_LIST_1 && i < slice.getNumRefIdx( REF_PIC_LIST_0 ); i++ )
+      {
+        if( m_refPic[REF_PIC_LIST_0][i] == refPic && !m_mvs[REF_PIC_LIST_0][i].empty() )
+        {
+          refIdxL0 = i;
+          break;
+        }
+      }
+      if( refIdxL0 >= 0 )
+      {
+        m_mvs[list][refIdx] = m_mvs[REF_PIC_LIST_0][refIdxL0];
+        continue;
+      }
+
+      xBuildPyramid( refPic->getRecoBuf( refPic->blocks[COMPONENT_Y] ), m_refPlane );
+      xEstimate( m_mvs[list][refIdx] );
+    }
+  }
+  m_pic = &pic;
+}
+
+bool EncHierarchicalME::getMv( const Slice& slice, RefPicList refList, int refIdx, const Area& area, Mv& mv ) const
+{
+  if( slice.getPic() != m_pic || m_mvs[refList][refIdx].empty() || slice.getRefPic( refList, refIdx ) != m_refPic[refList][refIdx] )
+  {
+    return false;
+  }
+
+  const Position center = area.center();
+  const int      blkX   = std::min<int>( center.x / HME_BLK_SIZE, m_levels[0].numBlkX - 1 );
+  const int      blkY   = std::min<int>( center.y / HME_BLK_SIZE, m_levels[0].numBlkY - 1 );
+  mv = m_mvs[refList][refIdx][blkY * m_levels[0].numBlkX + blkX];
+  return true;
+}
+
+void EncHierarchicalME::xCopyLuma( const CPelBuf& src, Plane& dst ) const
+{
+  dst.width  = src.width;
+  dst.height = src.height;
+  dst.stride = dst.width + 2 * dst.margin;
+  dst.luma.resize( dst.stride * ( dst.height + 2 * dst.margin ) );
+
+#if _OPENMP
+#pragma omp parallel for schedule(static) num_threads(m_numThreads) if(m_numThreads > 1)
+#endif
+  for( int y = 0; y < dst.height; y++ )
+  {
+    std::copy_n( src.bufAt( 0, y ), dst.width, dst.at( 0, y ) );
+  }
+}
+
+void EncHierarchicalME::xDownsample( const Plane& src, Plane& dst ) const
+{
+  dst.width  = src.width  >> 1;
+  dst.height = src.height >> 1;
+  dst.stride = dst.width + 2 * dst.margin;
+  dst.luma.resize( dst.stride * ( dst.height + 2 * dst.margin ) );
+
+#if _OPENMP
+#pragma omp parallel for schedule(static) num_threads(m_numThreads) if(m_numThreads > 1)
+#endif
+  for( int y = 0; y < dst.height; y++ )
+  {
+    const Pel* src0 = src.at( 0, 2 * y );
+    const Pel* src1 = src.at( 0, 2 * y + 1 );
+    Pel*       out  = dst.at( 0, y );
+    for( int x = 0; x < dst.width; x++ )
+    {
+      out[x] = ( src0[2 * x] + src0[2 * x + 1] + src1[2 * x] + src1[2 * x + 1] + 2 ) >> 2;
+    }
+  }
+}
+
+void EncHierarchicalME::xExtendBorder( Plane& plane ) const
+{
+  for( int y = 0; y < plane.height; y++ )
+  {
+    Pel* row = plane.at( 0, y );
+    std::fill_n( row - plane.margin, plane.margin, row[0] );
+    std::fill_n( row + plane.width,  plane.margin, row[plane.width - 1] );
+  }
+  for( int y = 1; y <= plane.margin; y++ )
+  {
+    std::copy_n( plane.at( -plane.margin, 0 ),                plane.stride, plane.at( -plane.margin, -y ) );
+    std::copy_n( plane.at( -plane.margin, plane.height - 1 ), plane.stride, plane.at( -plane.margin, plane.height - 1 + y ) );
+  }
+}
+
+void EncHierarchicalME::xBuildPyramid( const CPelBuf& src, Plane* planes ) const
+{
+  xCopyLuma( src, planes[0] );
+  for( int level = 1; level < HME_NUM_LEVELS; level++ )
+  {
+    xDownsample( planes[level - 1], planes[level] );
+  }
+  for( int level = 0; level < HME_NUM_LEVELS; level++ )
+  {
+    xExtendBorder( planes[level] );
+  }
+}
+
+void EncHierarchicalME::xEstimate( std::vector<Mv>& mvs ) const
+{
+  std::vector<Mv> levelMvs[HME_NUM_LEVELS];
+  for( int level = HME_NUM_LEVELS - 1; level >= 0; level-- )
+  {
+    xEstimateLevel( level, level + 1 < HME_NUM_LEVELS ? &levelMvs[level + 1] : nullptr, levelMvs[level] );
+  }
+  mvs.swap( levelMvs[0] );
+}
+
+void EncHierarchicalME::xEstimateLevel( int level, const std::vector<Mv>* parent, std::vector<Mv>& mvs ) const
+{
+  const Level& lvl    = m_levels[level];
+  const Plane& cur    = m_curPlane[level];
+  const int    range  = std::min( HME_MAX_SEARCH, ( m_searchRange + 3 ) >> 2 );
+  mvs.resize( lvl.numBlkX * lvl.numBlkY );
+
+#if _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(m_numThreads) if(m_numThreads > 1)
+#endif
+  for( int blkY = 0; blkY < lvl.numBlkY; blkY++ )
+  {
+    for( int blkX = 0; blkX < lvl.numBlkX; blkX++ )
+    {
+      const int x     = blkX * lvl.blkSize;
+      const int y     = blkY * lvl.blkSize;
+      const int margin = m_refPlane[level].margin;
+      const int minX   = -x - margin;
+      const int minY   = -y - margin;
+      const int maxX   = cur.width  + margin - lvl.blkSize - x;
+      const int maxY   = cur.height + margin - lvl.blkSize - y;
+
+      Mv  best    = Mv( 0, 0 );
+      int bestSad = xBlockSad( level, x, y, 0, 0, MAX_INT );
+
+      auto testMv = [&]( int mvX, int mvY )
+      {
+        mvX = Clip3( minX, maxX, mvX );
+        mvY = Clip3( minY, maxY, mvY );
+        if( mvX != best.hor || mvY != best.ver )
+        {
+          const int sad = xBlockSad( level, x, y, mvX, mvY, bestSad );
+          if( sad < bestSad )
+          {
+            best    = Mv( mvX, mvY );
+            bestSad = sad;
+          }
+        }
+      };
+
+      if( parent == nullptr )
+      {
+        // full search on the coarsest level
+        for( int mvY = -range; mvY <= range; mvY++ )
+        {
+          for( int mvX = -range; mvX <= range; mvX++ )
+          {
+            testMv( mvX, mvY );
+          }
+        }
+        mvs[blkY * lvl.numBlkX + blkX] = best;
+        continue;
+      }
+
+      // the scaled vectors of the co-located block and its neighbours on the coarser level, refined by one sample
+      const Level& upper  = m_levels[level + 1];
+      const int    scale  = 2 * upper.blkSize / lvl.blkSize;
+      const int    upperX = blkX / scale;
+      const int    upperY = blkY / scale;
+      for( int dy = -1; dy <= 1; dy++ )
+      {
+        for( int dx = -1; dx <= 1; dx++ )
+        {
+          const int candX = upperX + dx;
+          const int candY = upperY + dy;
+          if( candX >= 0 && candX < upper.numBlkX && candY >= 0 && candY < upper.numBlkY )
+          {
+            const Mv& cand = ( *parent )[candY * upper.numBlkX + candX];
+            testMv( 2 * cand.hor, 2 * cand.ver );
+          }
+        }
+      }
+      const Mv center = best;
+      for( int dy = -1; dy <= 1; dy++ )
+      {
+        for( int dx = -1; dx <= 1; dx++ )
+        {
+          testMv( center.hor + dx, center.ver + dy );
+        }
+      }
+      mvs[blkY * lvl.numBlkX + blkX] = best;
+    }
+  }
+}
+
+int EncHierarchicalME::xBlockSad( int level, int x, int y, int mvX, int mvY, int bestSad ) const
+{
+  const Plane& cur     = m_curPlane[level];
+  const Plane& ref     = m_refPlane[level];
+  const int    blkSize = m_levels[level].blkSize;
+  const Pel*   org     = cur.at( x, y );
+  const Pel*   pred    = ref.at( x + mvX, y + mvY );
+
+  int sad = 0;
+  for( int j = 0; j < blkSize && sad < bestSad; j++, org += cur.stride, pred += ref.stride )
+  {
+    for( int i = 0; i < blkSize; i++ )
+    {
+      sad += abs( org[i] - pred[i] );
+    }
+  }
+  return sad;
+}
+
+//! \}
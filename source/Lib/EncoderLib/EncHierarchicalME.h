@@ -0,0 +1,115 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     EncHierarchicalME.h
+    \brief    hierarchical motion estimation pre-pass (header)
+*/
+
+#ifndef __ENCHIERARCHICALME__
+#define __ENCHIERARCHICALME__
+
+#include "CommonLib/Mv.h"
+#include "CommonLib/Picture.h"
+#include "CommonLib/Slice.h"
+
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// coarse motion estimation of a picture to each of its reference pictures before its CTUs are coded. The motion is
+/// searched on quarter resolution luma and refined on half and full resolution. The resulting motion field of
+/// 16x16 luma blocks is used by the TZ search as an additional start point with a reduced search range.
+class EncHierarchicalME
+{
+public:
+  EncHierarchicalME();
+
+  /// searchRange: integer search range of the motion estimation, numThreads: threads used for the block rows
+  void    init                ( int searchRange, int numThreads );
+
+  /// estimates the motion of the picture to all reference pictures of the slice
+  void    estimatePicture     ( const Picture& pic, const Slice& slice );
+  /// integer motion vector of the 16x16 block containing the centre of the area, false when no estimate is available
+  bool    getMv               ( const Slice& slice, RefPicList refList, int refIdx, const Area& area, Mv& mv ) const;
+
+private:
+  static const int HME_NUM_LEVELS = 3;      ///< full, half and quarter resolution
+  static const int HME_BLK_SIZE   = 16;     ///< block size of the motion field on full resolution
+  static const int HME_MAX_SEARCH = 16;     ///< maximum search range on quarter resolution
+
+  struct Plane
+  {
+    int               width;
+    int               height;
+    int               margin;               ///< replicated samples around the picture, motion may point outside of it
+    int               stride;
+    std::vector<Pel>  luma;
+
+    Pel*        at( int x, int y )       { return &luma[( y + margin ) * stride + x + margin]; }
+    const Pel*  at( int x, int y ) const { return &luma[( y + margin ) * stride + x + margin]; }
+  };
+
+  struct Level
+  {
+    int               blkSize;              ///< block size on the resolution of the level
+    int               numBlkX;
+    int               numBlkY;
+  };
+
+  void        xCopyLuma           ( const CPelBuf& src, Plane& dst ) const;
+  void        xDownsample         ( const Plane& src, Plane& dst ) const;
+  void        xExtendBorder       ( Plane& plane ) const;
+  void        xBuildPyramid       ( const CPelBuf& src, Plane* planes ) const;
+  void        xEstimate           ( std::vector<Mv>& mvs ) const;
+  void        xEstimateLevel      ( int level, const std::vector<Mv>* parent, std::vector<Mv>& mvs ) const;
+  int         xBlockSad           ( int level, int x, int y, int mvX, int mvY, int bestSad ) const;
+
+  int                   m_searchRange;
+  int                   m_numThreads;
+  const Picture*        m_pic;
+  Level                 m_levels  [HME_NUM_LEVELS];
+  Plane                 m_curPlane[HME_NUM_LEVELS];
+  Plane                 m_refPlane[HME_NUM_LEVELS];
+  const Picture*        m_refPic  [NUM_REF_PIC_LIST_01][MAX_NUM_REF];
+  std::vector<Mv>       m_mvs     [NUM_REF_PIC_LIST_01][MAX_NUM_REF];
+};
+
+//! \}
+
+#endif // __ENCHIERARCHICALME__
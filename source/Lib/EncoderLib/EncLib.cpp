@@ -153,6 +153,11 @@ void EncLib::create( const int layerId )
     m_cRateCtrl.init(m_framesToBeEncoded, m_RCTargetBitrate, (int)((double)m_iFrameRate / m_temporalSubsampleRatio + 0.5), m_iGOPSize, m_iSourceWidth, m_iSourceHeight,
       m_maxCUWidth, m_maxCUHeight, getBitDepth(CHANNEL_TYPE_LUMA), m_RCKeepHierarchicalBit, m_RCUseLCUSeparateModel, m_GOPList);
   }
+  if ( m_RCPass > 0 )
+  {
+    const int numCtus = ( ( m_iSourceWidth + m_maxCUWidth - 1 ) / m_maxCUWidth ) * ( ( m_iSourceHeight + m_maxCUHeight - 1 ) / m_maxCUHeight );
+    m_cRateCtrl.initFirstPass( m_RCPass, m_RCStatsFileName, numCtus );
+  }
 
 }
 
@@ -177,6 +182,8 @@ void EncLib::destroy ()
   m_cEncSAO.            destroy();
   m_cLoopFilter.        destroy();
   m_cRateCtrl.          destroy();
+  m_cRateCtrl.          destroyFirstPass();
+  m_cLookahead.         destroy();
 #if ENABLE_SPLIT_PARALLELISM
   for (int jId = 0; jId < m_numCuEncStacks; jId++)
   {
@@ -241,6 +248,17 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
     sps0.setLongTermRefsPresent(true);
   }
 
+  if( m_lookAhead )
+  {
+    // intra pictures are only inserted at scene cuts when the pictures are coded in output order
+    bool codedInOutputOrder = !isFieldCoding && !getUseCompositeRef() && m_vps->getMaxLayers() == 1;
+    for( int i = 0; i < m_iGOPSize; i++ )
+    {
+      codedInOutputOrder &= m_GOPList[i].m_POC == i + 1;
+    }
+    m_cLookahead.init( codedInOutputOrder ? m_sceneCutThreshold : 0, 2 * m_iGOPSize + 2 );
+  }
+
 #if U0132_TARGET_BITS_SATURATION
   if (m_RCCpbSaturationEnabled)
   {
@@ -394,6 +412,7 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
 
     // link temporary buffets from intra search with inter search to avoid unnecessary memory overhead
     m_cInterSearch[jId].setTempBuffers( m_cIntraSearch[jId].getSplitCSBuf(), m_cIntraSearch[jId].getFullCSBuf(), m_cIntraSearch[jId].getSaveCSBuf() );
+    m_cInterSearch[jId].setHierarchicalME( m_hierarchicalME ? &m_cHierarchicalME : nullptr );
   }
 #else  // ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   m_cCuEncoder.   init( this, sps0 );
@@ -431,7 +450,9 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
 
   // link temporary buffets from intra search with inter search to avoid unneccessary memory overhead
   m_cInterSearch.setTempBuffers( m_cIntraSearch.getSplitCSBuf(), m_cIntraSearch.getFullCSBuf(), m_cIntraSearch.getSaveCSBuf() );
+  m_cInterSearch.setHierarchicalME( m_hierarchicalME ? &m_cHierarchicalME : nullptr );
 #endif // ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+  m_cHierarchicalME.init( m_iSearchRange, m_hierarchicalMEThreads );
 
   m_iMaxRefPicNum = 0;
 
@@ -453,14 +474,14 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
   if (getUseCompositeRef())
   {
     Picture *picBg = new Picture;
-    picBg->create( sps0.getChromaFormatIdc(), Size( pps0.getPicWidthInLumaSamples(), pps0.getPicHeightInLumaSamples() ), sps0.getMaxCUWidth(), sps0.getMaxCUWidth() + 16, false, m_layerId );
+    picBg->create( sps0.getChromaFormatIdc(), Size( pps0.getPicWidthInLumaSamples(), pps0.getPicHeightInLumaSamples() ), sps0.getMaxCUWidth(), Picture::getPicMargin( sps0 ), false, m_layerId );
     picBg->getRecoBuf().fill(0);
     picBg->finalInit( m_vps, sps0, pps0, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
     picBg->allocateNewSlice();
     picBg->createSpliceIdx(pps0.pcv->sizeInCtus);
     m_cGOPEncoder.setPicBg(picBg);
     Picture *picOrig = new Picture;
-    picOrig->create( sps0.getChromaFormatIdc(), Size( pps0.getPicWidthInLumaSamples(), pps0.getPicHeightInLumaSamples() ), sps0.getMaxCUWidth(), sps0.getMaxCUWidth() + 16, false, m_layerId );
+    picOrig->create( sps0.getChromaFormatIdc(), Size( pps0.getPicWidthInLumaSamples(), pps0.getPicHeightInLumaSamples() ), sps0.getMaxCUWidth(), Picture::getPicMargin( sps0 ), false, m_layerId );
     picOrig->getOrigBuf().fill(0);
     m_cGOPEncoder.setPicOrig(picOrig);
   }
@@ -679,9 +700,9 @@ bool EncLib::encodePrep( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYu
       std::pair<int, int> scalingRatio = std::pair<int, int>( xScale, yScale );
 
       Picture::rescalePicture( scalingRatio, *pcPicYuvOrg, refPPS->getScalingWindow(), pcPicCurr->getOrigBuf(), pPPS->getScalingWindow(), chromaFormatIDC, pSPS->getBitDepths(), true, true,
-        pSPS->getHorCollocatedChromaFlag(), pSPS->getVerCollocatedChromaFlag() );
+        pSPS->getHorCollocatedChromaFlag(), pSPS->getVerCollocatedChromaFlag(), m_rprThreads );
       Picture::rescalePicture( scalingRatio, *cPicYuvTrueOrg, refPPS->getScalingWindow(), pcPicCurr->getTrueOrigBuf(), pPPS->getScalingWindow(), chromaFormatIDC, pSPS->getBitDepths(), true, true,
-        pSPS->getHorCollocatedChromaFlag(), pSPS->getVerCollocatedChromaFlag() );
+        pSPS->getHorCollocatedChromaFlag(), pSPS->getVerCollocatedChromaFlag(), m_rprThreads );
     }
     else
     {
@@ -698,6 +719,10 @@ bool EncLib::encodePrep( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYu
     {
       AQpPreanalyzer::preanalyze( pcPicCurr );
     }
+    if( m_lookAhead )
+    {
+      m_cLookahead.addPicture( *pcPicCurr );
+    }
   }
 
   if( ( m_iNumPicRcvd == 0 ) || ( !flush && ( m_iPOCLast != 0 ) && ( m_iNumPicRcvd != m_iGOPSize ) && ( m_iGOPSize != 0 ) ) )
@@ -708,7 +733,9 @@ bool EncLib::encodePrep( bool flush, PelStorage* pcPicYuvOrg, PelStorage* cPicYu
 
   if( m_RCEnableRateControl )
   {
-    m_cRateCtrl.initRCGOP( m_iNumPicRcvd );
+    const int pocStep = m_compositeRefEnabled ? 2 : 1;
+    const double complexityRatio = m_lookAhead ? m_cLookahead.getComplexityRatio( m_iPOCLast - ( m_iNumPicRcvd - 1 ) * pocStep, m_iPOCLast ) : 1.0;
+    m_cRateCtrl.initRCGOP( m_iNumPicRcvd, complexityRatio );
   }
 
   m_picIdInGOP = 0;
@@ -946,7 +973,7 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
   if (rpcPic==0)
   {
     rpcPic = new Picture;
-    rpcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, false, m_layerId );
+    rpcPic->create( sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), Picture::getPicMargin( sps ), false, m_layerId );
     if (m_resChangeInClvsEnabled)
     {
       const PPS &pps0 = *m_ppsMap.getPS(0);
@@ -969,7 +996,7 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
   rpcPic->setBorderExtension( false );
   rpcPic->reconstructed = false;
   rpcPic->referenced = true;
-  rpcPic->getHashMap()->clearAll();
+  rpcPic->getHashMap()->reset();
 
   m_iPOCLast += (m_compositeRefEnabled ? 2 : 1);
   m_iNumPicRcvd++;
@@ -57,6 +57,8 @@
 #include "EncReshape.h"
 #include "EncAdaptiveLoopFilter.h"
 #include "RateCtrl.h"
+#include "EncLookahead.h"
+#include "EncHierarchicalME.h"
 
 class EncLibCommon;
 
@@ -131,6 +133,8 @@ private:
 #endif
   // quality control
   RateCtrl                  m_cRateCtrl;                          ///< Rate control class
+  EncLookahead              m_cLookahead;                         ///< look-ahead analysis of the buffered pictures
+  EncHierarchicalME         m_cHierarchicalME;                    ///< motion estimation pre-pass of the inter pictures
 
   AUWriterIf*               m_AUWriterIf;
 
@@ -227,6 +231,8 @@ public:
   CtxCache*               getCtxCache           ()              { return  &m_CtxCache;             }
 #endif
   RateCtrl*               getRateCtrl           ()              { return  &m_cRateCtrl;            }
+  EncLookahead*           getLookahead          ()              { return  &m_cLookahead;           }
+  EncHierarchicalME*      getHierarchicalME     ()              { return  &m_cHierarchicalME;      }
 
 
   void                    getActiveRefPicListNumForPOC(const SPS *sps, int POCCurr, int GOPid, uint32_t *activeL0, uint32_t *activeL1);
@@ -0,0 +1,331 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncLookahead.cpp
+    \brief    look-ahead analysis of the input pictures
+*/
+
+#include "EncLookahead.h"
+
+#include <algorithm>
+
+//! \ingroup EncoderLib
+//! \{
+
+EncLookahead::EncLookahead()
+  : m_sceneCutThreshold ( 0 )
+  , m_maxNumPics        ( 2 )
+  , m_sumCost           ( 0 )
+  , m_numCost           ( 0 )
+{
+}
+
+void EncLookahead::init( int sceneCutThreshold, int maxNumPics )
+{
+  destroy();
+  m_sceneCutThreshold = sceneCutThreshold;
+  m_maxNumPics        = std::max( maxNumPics, 2 );
+  m_sumCost           = 0;
+  m_numCost           = 0;
+}
+
+void EncLookahead::destroy()
+{
+  for( auto& pic : m_pics )
+  {
+    pic.analysis.wait();
+  }
+  m_pics.clear();
+}
+
+void EncLookahead::addPicture( const Picture& pic )
+{
+  const CPelBuf org = pic.getOrigBuf( pic.blocks[COMPONENT_Y] );
+
+  // the analysis of the previous picture has to be finished before it can be used as reference
+  LowresPic* prev = nullptr;
+  if( !m_pics.empty() )
+  {
+    m_pics.back().analysis.wait();
+    xCountPic( m_pics.back() );
+    prev = &m_pics.back();
+  }
+  while( int( m_pics.size() ) >= m_maxNumPics )
+  {
+    m_pics.pop_front();
+  }
+
+  m_pics.emplace_back();
+  LowresPic& cur = m_pics.back();
+  cur.poc       = pic.getPOC();
+  cur.width     = org.width  >> 1;
+  cur.height    = org.height >> 1;
+  cur.intraCost = 0;
+  cur.interCost = 0;
+  cur.hasRef    = prev && prev->width == cur.width && prev->height == cur.height;
+  cur.sceneCut  = false;
+  cur.counted   = false;
+  cur.luma.resize( cur.width * cur.height );
+
+  for( int y = 0; y < cur.height; y++ )
+  {
+    const Pel* src0 = org.bufAt( 0, 2 * y );
+    const Pel* src1 = org.bufAt( 0, 2 * y + 1 );
+    Pel*       dst  = &cur.luma[y * cur.width];
+    for( int x = 0; x < cur.width; x++ )
+    {
+      dst[x] = ( src0[2 * x] + src0[2 * x + 1] + src1[2 * x] + src1[2 * x + 1] + 2 ) >> 2;
+    }
+  }
+
+  const LowresPic* ref = cur.hasRef ? prev : nullptr;
+  cur.analysis = std::async( std::launch::async, [this, &cur, ref]() { xAnalyse( cur, ref ); } );
+}
+
+bool EncLookahead::isSceneCut( int poc )
+{
+  LowresPic* pic = xFindPic( poc );
+  if( pic == nullptr )
+  {
+    return false;
+  }
+  pic->analysis.wait();
+  return pic->sceneCut;
+}
+
+double EncLookahead::getComplexityRatio( int firstPoc, int lastPoc )
+{
+  if( m_pics.empty() )
+  {
+    return 1.0;
+  }
+  m_pics.back().analysis.wait();
+
+  int64_t sumCost = 0;
+  int     numCost = 0;
+  for( auto& pic : m_pics )
+  {
+    xCountPic( pic );
+    if( pic.hasRef && pic.poc >= firstPoc && pic.poc <= lastPoc )
+    {
+      sumCost += pic.interCost;
+      numCost++;
+    }
+  }
+  if( numCost == 0 || m_sumCost == 0 )
+  {
+    return 1.0;
+  }
+  return ( double( sumCost ) / numCost ) / ( double( m_sumCost ) / m_numCost );
+}
+
+EncLookahead::LowresPic* EncLookahead::xFindPic( int poc )
+{
+  for( auto& pic : m_pics )
+  {
+    if( pic.poc == poc )
+    {
+      return &pic;
+    }
+  }
+  return nullptr;
+}
+
+void EncLookahead::xCountPic( LowresPic& pic )
+{
+  if( pic.hasRef && !pic.counted )
+  {
+    m_sumCost += pic.interCost;
+    m_numCost++;
+  }
+  pic.counted = true;
+}
+
+void EncLookahead::xAnalyse( LowresPic& cur, const LowresPic* prev ) const
+{
+  static const int dir[4][2] = { { 0, -1 }, { -1, 0 }, { 1, 0 }, { 0, 1 } };
+
+  const int numBlkX = cur.width  / LOWRES_BLK_SIZE;
+  const int numBlkY = cur.height / LOWRES_BLK_SIZE;
+  std::vector<Mv> mvs( numBlkX * numBlkY );
+
+  int64_t intraCost = 0;
+  int64_t interCost = 0;
+
+  for( int by = 0; by < numBlkY; by++ )
+  {
+    for( int bx = 0; bx < numBlkX; bx++ )
+    {
+      const int x     = bx * LOWRES_BLK_SIZE;
+      const int y     = by * LOWRES_BLK_SIZE;
+      const int intra = xIntraCost( cur, x, y );
+      intraCost += intra;
+      if( prev == nullptr )
+      {
+        interCost += intra;
+        continue;
+      }
+
+      // predictors from the left and above blocks, followed by a diamond search of decreasing step size
+      Mv  best    = Mv( 0, 0 );
+      int bestSad = xBlockSad( cur, *prev, x, y, 0, 0 );
+      const Mv cands[2] = { bx > 0 ? mvs[by * numBlkX + bx - 1] : Mv( 0, 0 ), by > 0 ? mvs[( by - 1 ) * numBlkX + bx] : Mv( 0, 0 ) };
+      for( const Mv& cand : cands )
+      {
+        if( cand != best && x + cand.hor >= 0 && x + cand.hor + LOWRES_BLK_SIZE <= cur.width && y + cand.ver >= 0 && y + cand.ver + LOWRES_BLK_SIZE <= cur.height )
+        {
+          const int sad = xBlockSad( cur, *prev, x, y, cand.hor, cand.ver );
+          if( sad < bestSad )
+          {
+            best    = cand;
+            bestSad = sad;
+          }
+        }
+      }
+      for( int step = 4; step > 0; step >>= 1 )
+      {
+        bool improved = true;
+        for( int iter = 0; improved && iter < 8; iter++ )
+        {
+          improved        = false;
+          const Mv center = best;
+          for( int d = 0; d < 4; d++ )
+          {
+            const int mvX = center.hor + dir[d][0] * step;
+            const int mvY = center.ver + dir[d][1] * step;
+            if( abs( mvX ) > LOWRES_SEARCH || abs( mvY ) > LOWRES_SEARCH || x + mvX < 0 || x + mvX + LOWRES_BLK_SIZE > cur.width
+              || y + mvY < 0 || y + mvY + LOWRES_BLK_SIZE > cur.height )
+            {
+              continue;
+            }
+            const int sad = xBlockSad( cur, *prev, x, y, mvX, mvY );
+            if( sad < bestSad )
+            {
+              best     = Mv( mvX, mvY );
+              bestSad  = sad;
+              improved = true;
+            }
+          }
+        }
+      }
+      mvs[by * numBlkX + bx] = best;
+      interCost += std::min( intra, bestSad );
+    }
+  }
+
+  cur.intraCost = intraCost;
+  cur.interCost = interCost;
+  // a picture following a scene cut is not a cut itself, which avoids two cuts around flashes
+  cur.sceneCut  = m_sceneCutThreshold > 0 && prev != nullptr && !prev->sceneCut && intraCost > 0
+               && interCost * 100 >= intraCost * ( 100 - m_sceneCutThreshold );
+}
+
+int EncLookahead::xIntraCost( const LowresPic& pic, int x, int y ) const
+{
+  const int  stride = pic.width;
+  const Pel* blk    = &pic.luma[y * stride + x];
+  const Pel* above  = y > 0 ? blk - stride : nullptr;
+  const Pel* left   = x > 0 ? blk - 1      : nullptr;
+
+  // DC, vertical and horizontal prediction from the neighbouring samples, the top-left block is predicted by its mean
+  int sumRef = 0;
+  int numRef = 0;
+  for( int i = 0; i < LOWRES_BLK_SIZE; i++ )
+  {
+    if( above )
+    {
+      sumRef += above[i];
+      numRef++;
+    }
+    if( left )
+    {
+      sumRef += left[i * stride];
+      numRef++;
+    }
+  }
+  if( numRef == 0 )
+  {
+    for( int j = 0; j < LOWRES_BLK_SIZE; j++ )
+    {
+      for( int i = 0; i < LOWRES_BLK_SIZE; i++ )
+      {
+        sumRef += blk[j * stride + i];
+      }
+    }
+    numRef = LOWRES_BLK_SIZE * LOWRES_BLK_SIZE;
+  }
+  const int dc = ( sumRef + ( numRef >> 1 ) ) / numRef;
+
+  int sadDC  = 0;
+  int sadVer = 0;
+  int sadHor = 0;
+  for( int j = 0; j < LOWRES_BLK_SIZE; j++ )
+  {
+    for( int i = 0; i < LOWRES_BLK_SIZE; i++ )
+    {
+      const int org = blk[j * stride + i];
+      sadDC  += abs( org - dc );
+      sadVer += above ? abs( org - above[i] )         : 0;
+      sadHor += left  ? abs( org - left[j * stride] ) : 0;
+    }
+  }
+
+  int cost = sadDC;
+  if( above )
+  {
+    cost = std::min( cost, sadVer );
+  }
+  if( left )
+  {
+    cost = std::min( cost, sadHor );
+  }
+  return cost;
+}
+
+int EncLookahead::xBlockSad( const LowresPic& cur, const LowresPic& ref, int x, int y, int mvX, int mvY ) const
+{
+  const Pel* org  = &cur.luma[y * cur.width + x];
+  const Pel* pred = &ref.luma[( y + mvY ) * ref.width + x + mvX];
+
+  int sad = 0;
+  for( int j = 0; j < LOWRES_BLK_SIZE; j++, org += cur.width, pred += ref.width )
+  {
+    for( int i = 0; i < LOWRES_BLK_SIZE; i++ )
+    {
+      sad += abs( org[i] - pred[i] );
+    }
+  }
+  return sad;
+}
+
+//! \}
@@ -0,0 +1,111 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncLookahead.h
+    \brief    look-ahead analysis of the input pictures (header)
+*/
+
+#ifndef __ENCLOOKAHEAD__
+#define __ENCLOOKAHEAD__
+
+#include "CommonLib/Mv.h"
+#include "CommonLib/Picture.h"
+
+#include <deque>
+#include <future>
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// analysis of the pictures buffered ahead of the GOP encoder on half resolution luma. The intra and inter costs of
+/// each picture are estimated on a worker thread, while the encoder continues to read and code pictures. They are
+/// used to detect scene cuts and as complexity estimates for the rate control.
+class EncLookahead
+{
+public:
+  EncLookahead();
+  ~EncLookahead() { destroy(); }
+
+  /// sceneCutThreshold: 0 disables the scene cut detection, otherwise a picture starts a new scene when its inter
+  /// cost exceeds (100 - sceneCutThreshold) percent of its intra cost
+  void    init                ( int sceneCutThreshold, int maxNumPics );
+  void    destroy             ();
+
+  /// downscales the luma of the picture and starts its analysis on the look-ahead thread
+  void    addPicture          ( const Picture& pic );
+
+  /// true when the picture starts a new scene, waits for the analysis of the picture
+  bool    isSceneCut          ( int poc );
+  /// ratio of the mean cost of the pictures with firstPoc <= POC <= lastPoc to the mean cost of all analysed pictures,
+  /// waits for the analysis of all added pictures
+  double  getComplexityRatio  ( int firstPoc, int lastPoc );
+
+private:
+  static const int LOWRES_BLK_SIZE = 8;     ///< block size of the cost estimation, on half resolution
+  static const int LOWRES_SEARCH   = 16;    ///< maximum motion vector component, on half resolution
+
+  struct LowresPic
+  {
+    int               poc;
+    int               width;
+    int               height;
+    std::vector<Pel>  luma;
+    int64_t           intraCost;
+    int64_t           interCost;            ///< minimum of the intra and inter cost of each block
+    bool              hasRef;               ///< interCost was estimated from the previous picture
+    bool              sceneCut;
+    bool              counted;              ///< interCost is contained in m_sumCost
+    std::future<void> analysis;
+  };
+
+  LowresPic*  xFindPic            ( int poc );
+  void        xCountPic           ( LowresPic& pic );
+  void        xAnalyse            ( LowresPic& cur, const LowresPic* prev ) const;
+  int         xIntraCost          ( const LowresPic& pic, int x, int y ) const;
+  int         xBlockSad           ( const LowresPic& cur, const LowresPic& ref, int x, int y, int mvX, int mvY ) const;
+
+  int                   m_sceneCutThreshold;
+  int                   m_maxNumPics;
+  std::deque<LowresPic> m_pics;             ///< in input order, references stay valid while the worker runs
+  int64_t               m_sumCost;
+  int                   m_numCost;
+};
+
+//! \}
+
+#endif // __ENCLOOKAHEAD__
@@ -1064,6 +1064,288 @@ void BestEncInfoCache::touch(const UnitArea &area)
 
 #endif
 
+//////////////////////////////////////////////////////////////////////////
+// FastSplitCtrl
+//////////////////////////////////////////////////////////////////////////
+
+// thresholds of the FastPartition presets 1 to 3, in units of the quantization step size of the block
+static const double g_fastSplitFlatVar  [4] = { 0.0, 0.0625, 0.125, 0.125 };   // variance (squared step) of a flat block
+static const double g_fastSplitStaticSad[4] = { 0.0, 0.0625, 0.125, 0.125 };   // zero motion SAD per sample of a static block
+static const double g_fastSplitHalfMean [4] = { 0.0, 0.125,  0.25,  0.25  };   // mean difference of similar halves
+static const double g_fastSplitDirRatio [4] = { 0.0, 0.0,    0.0,   3.0   };   // gradient ratio of a directional block, 0: not used
+
+void FastSplitCtrl::create( const EncCfg& cfg )
+{
+  m_fastPartition = cfg.getFastPartition();
+  m_refPicSplit   = NULL;
+}
+
+void FastSplitCtrl::init( const Slice &slice )
+{
+  m_refPicSplit = NULL;
+  if( !m_fastPartition || slice.isIntra() )
+  {
+    return;
+  }
+
+  int minDist = MAX_INT;
+  for( int list = 0; list < ( slice.isInterB() ? 2 : 1 ); list++ )
+  {
+    for( int refIdx = 0; refIdx < slice.getNumRefIdx( RefPicList( list ) ); refIdx++ )
+    {
+      const Picture *refPic = slice.getRefPic( RefPicList( list ), refIdx );
+      const int      dist   = abs( slice.getPOC() - refPic->getPOC() );
+      if( dist < minDist && refPic->lumaSize() == slice.getPic()->lumaSize() )
+      {
+        minDist       = dist;
+        m_refPicSplit = refPic;
+      }
+    }
+  }
+}
+
+void FastSplitCtrl::xGetFeatures( SplitFeatures& features, const CodingStructure &cs, const CompArea &area ) const
+{
+  const CPelBuf org    = cs.picture->getTrueOrigBuf( area );
+  const int     width  = area.width;
+  const int     height = area.height;
+
+  // sums and sums of squares of the quadrants
+  int64_t sum[2][2]   = { { 0, 0 }, { 0, 0 } };
+  int64_t sumSq[2][2] = { { 0, 0 }, { 0, 0 } };
+  int64_t gradHor     = 0;
+  int64_t gradVer     = 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    const Pel *line = org.bufAt( 0, y );
+    const Pel *next = y + 1 < height ? org.bufAt( 0, y + 1 ) : line;
+    const int  yh   = y < ( height >> 1 ) ? 0 : 1;
+    for( int x = 0; x < width; x++ )
+    {
+      const int v = line[x];
+      sum  [yh][x < ( width >> 1 ) ? 0 : 1] += v;
+      sumSq[yh][x < ( width >> 1 ) ? 0 : 1] += v * v;
+      gradVer += abs( next[x] - v );
+    }
+    for( int x = 0; x < width - 1; x++ )
+    {
+      gradHor += abs( line[x + 1] - line[x] );
+    }
+  }
+
+  const double numQuarter = 0.25 * width * height;
+  auto variance = [&]( int64_t s, int64_t s2, double num ) { const double mean = s / num; return std::max( 0.0, s2 / num - mean * mean ); };
+
+  features.variance = variance( sum[0][0] + sum[0][1] + sum[1][0] + sum[1][1], sumSq[0][0] + sumSq[0][1] + sumSq[1][0] + sumSq[1][1], 4 * numQuarter );
+  for( int i = 0; i < 2; i++ )
+  {
+    // top/bottom and left/right halves
+    features.meanHalf[0][i] = ( sum[i][0] + sum[i][1] ) / ( 2 * numQuarter );
+    features.varHalf [0][i] = variance( sum[i][0] + sum[i][1], sumSq[i][0] + sumSq[i][1], 2 * numQuarter );
+    features.meanHalf[1][i] = ( sum[0][i] + sum[1][i] ) / ( 2 * numQuarter );
+    features.varHalf [1][i] = variance( sum[0][i] + sum[1][i], sumSq[0][i] + sumSq[1][i], 2 * numQuarter );
+  }
+  features.gradHor = width  > 1 ? gradHor / double( ( width - 1 ) * height ) : 0.0;
+  features.gradVer = height > 1 ? gradVer / double( width * ( height - 1 ) ) : 0.0;
+
+  features.zeroMvSad = -1.0;
+  if( m_refPicSplit )
+  {
+    const CPelBuf ref = m_refPicSplit->getRecoBuf( area );
+    int64_t       sad = 0;
+    for( int y = 0; y < height; y++ )
+    {
+      const Pel *o = org.bufAt( 0, y );
+      const Pel *r = ref.bufAt( 0, y );
+      for( int x = 0; x < width; x++ )
+      {
+        sad += abs( o[x] - r[x] );
+      }
+    }
+    features.zeroMvSad = sad / double( width * height );
+  }
+  features.valid = true;
+}
+
+bool FastSplitCtrl::skipSplit( const PartSplit split, SplitFeatures& features, const CodingStructure &cs, const Partitioner &partitioner, const CodingStructure *bestCS, const CodingUnit *bestCU ) const
+{
+  if( !m_fastPartition || !isLuma( partitioner.chType ) )
+  {
+    return false;
+  }
+
+  const CompArea& area = partitioner.currArea().Y();
+  if( !features.valid )
+  {
+    xGetFeatures( features, cs, area );
+  }
+
+  const int    bitDepth = cs.sps->getBitDepth( CHANNEL_TYPE_LUMA );
+  const double qStep    = pow( 2.0, ( cs.baseQP - 4 ) / 6.0 ) * ( 1 << ( bitDepth - 8 ) );
+  const int    preset   = std::min<int>( m_fastPartition, 3 );
+
+  if( bestCU )
+  {
+    bool noResidual = bestCU->skip || !bestCU->rootCbf;
+    if( CU::isIntra( *bestCU ) )
+    {
+      noResidual = true;
+      for( const TransformUnit *tu : bestCS->tus )
+      {
+        noResidual &= !TU::getCbf( *tu, COMPONENT_Y );
+      }
+    }
+
+    // flat block coded without residual
+    if( noResidual && features.variance < g_fastSplitFlatVar[preset] * qStep * qStep )
+    {
+      return true;
+    }
+    // static block coded in skip mode
+    if( bestCU->skip && features.zeroMvSad >= 0.0 && features.zeroMvSad < g_fastSplitStaticSad[preset] * qStep )
+    {
+      return true;
+    }
+  }
+
+  if( split == CU_QUAD_SPLIT )
+  {
+    return false;
+  }
+
+  const bool isHor = split == CU_HORZ_SPLIT || split == CU_TRIH_SPLIT;
+  const bool isTT  = split == CU_TRIH_SPLIT || split == CU_TRIV_SPLIT;
+
+  // directional content, e.g. vertical structures are not split horizontally
+  const double dirRatio = g_fastSplitDirRatio[preset];
+  if( dirRatio > 0.0 && ( isHor ? features.gradHor > dirRatio * features.gradVer : features.gradVer > dirRatio * features.gradHor ) )
+  {
+    return true;
+  }
+
+  // halves of similar content are not separated by the split
+  if( isTT || preset >= 2 )
+  {
+    const int    dir     = isHor ? 0 : 1;
+    const double meanThr = g_fastSplitHalfMean[preset] * qStep;
+    const double varMin  = std::min( features.varHalf[dir][0], features.varHalf[dir][1] );
+    const double varMax  = std::max( features.varHalf[dir][0], features.varHalf[dir][1] );
+    if( fabs( features.meanHalf[dir][0] - features.meanHalf[dir][1] ) < meanThr && varMax <= 2.0 * varMin + meanThr * meanThr )
+    {
+      return true;
+    }
+  }
+
+  // no split beyond the depth of the left and above CUs
+  if( isTT || preset >= 3 )
+  {
+    const CodingUnit *cuLeft  = cs.getCU( area.pos().offset( -1, 0 ), partitioner.chType );
+    const CodingUnit *cuAbove = cs.getCU( area.pos().offset( 0, -1 ), partitioner.chType );
+    if( cuLeft && cuAbove && cuLeft->depth < partitioner.currDepth && cuAbove->depth < partitioner.currDepth )
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// CuHistoryCtrl
+//////////////////////////////////////////////////////////////////////////
+
+// the decisions are stored per 8x8 luma unit: bit 0 all CUs skipped, bits 1-3 smallest QT depth, bits 4-7 largest depth
+static const int CU_HISTORY_UNIT_LOG2 = 3;
+
+void CuHistoryCtrl::storeCuHistory( Picture &pic )
+{
+  const int unitsX = ( pic.lwidth()  + ( 1 << CU_HISTORY_UNIT_LOG2 ) - 1 ) >> CU_HISTORY_UNIT_LOG2;
+  const int unitsY = ( pic.lheight() + ( 1 << CU_HISTORY_UNIT_LOG2 ) - 1 ) >> CU_HISTORY_UNIT_LOG2;
+  pic.m_cuHistory.assign( unitsX * unitsY, ( 7 << 1 ) | 1 );
+
+  for( const CodingUnit *cu : pic.cs->cus )
+  {
+    if( !cu->Y().valid() )
+    {
+      continue;
+    }
+    const CompArea &area = cu->Y();
+    for( int y = area.y >> CU_HISTORY_UNIT_LOG2; y <= ( area.y + (int)area.height - 1 ) >> CU_HISTORY_UNIT_LOG2; y++ )
+    {
+      for( int x = area.x >> CU_HISTORY_UNIT_LOG2; x <= ( area.x + (int)area.width - 1 ) >> CU_HISTORY_UNIT_LOG2; x++ )
+      {
+        uint8_t       &entry   = pic.m_cuHistory[y * unitsX + x];
+        const unsigned depth   = std::max<unsigned>( entry >> 4,        std::min<unsigned>( cu->depth,   15 ) );
+        const unsigned qtDepth = std::min<unsigned>( ( entry >> 1 ) & 7, std::min<unsigned>( cu->qtDepth, 7 ) );
+        entry = uint8_t( ( depth << 4 ) | ( qtDepth << 1 ) | ( ( entry & 1 ) && cu->skip ? 1 : 0 ) );
+      }
+    }
+  }
+}
+
+void CuHistoryCtrl::create( const EncCfg& cfg )
+{
+  m_temporalCuReuse = cfg.getTemporalCuReuse();
+  m_historyPic      = NULL;
+}
+
+void CuHistoryCtrl::init( const Slice &slice )
+{
+  m_historyPic = NULL;
+  if( !m_temporalCuReuse || slice.isIntra() )
+  {
+    return;
+  }
+
+  const Picture *pic     = slice.getPic();
+  int            minDist = MAX_INT;
+  for( int list = 0; list < ( slice.isInterB() ? 2 : 1 ); list++ )
+  {
+    for( int refIdx = 0; refIdx < slice.getNumRefIdx( RefPicList( list ) ); refIdx++ )
+    {
+      const Picture *refPic = slice.getRefPic( RefPicList( list ), refIdx );
+      const int      dist   = abs( slice.getPOC() - refPic->getPOC() );
+      if( dist < minDist && !refPic->m_cuHistory.empty() && refPic->layerId == pic->layerId
+        && refPic->slices[0]->getTLayer() == slice.getTLayer() && refPic->lumaSize() == pic->lumaSize() )
+      {
+        minDist      = dist;
+        m_historyPic = refPic;
+      }
+    }
+  }
+}
+
+bool CuHistoryCtrl::getCuHistory( const CompArea &area, CuHistoryInfo &info ) const
+{
+  if( !m_historyPic )
+  {
+    return false;
+  }
+
+  const int unitsX = ( m_historyPic->lwidth()  + ( 1 << CU_HISTORY_UNIT_LOG2 ) - 1 ) >> CU_HISTORY_UNIT_LOG2;
+  const int unitsY = ( m_historyPic->lheight() + ( 1 << CU_HISTORY_UNIT_LOG2 ) - 1 ) >> CU_HISTORY_UNIT_LOG2;
+  const int x0     = area.x >> CU_HISTORY_UNIT_LOG2;
+  const int y0     = area.y >> CU_HISTORY_UNIT_LOG2;
+  const int x1     = std::min( unitsX - 1, ( area.x + (int)area.width  - 1 ) >> CU_HISTORY_UNIT_LOG2 );
+  const int y1     = std::min( unitsY - 1, ( area.y + (int)area.height - 1 ) >> CU_HISTORY_UNIT_LOG2 );
+
+  info.maxDepth   = 0;
+  info.minQtDepth = 7;
+  info.allSkip    = true;
+  for( int y = y0; y <= y1; y++ )
+  {
+    for( int x = x0; x <= x1; x++ )
+    {
+      const uint8_t entry = m_historyPic->m_cuHistory[y * unitsX + x];
+      info.maxDepth   = std::max<unsigned>( info.maxDepth,   entry >> 4 );
+      info.minQtDepth = std::min<unsigned>( info.minQtDepth, ( entry >> 1 ) & 7 );
+      info.allSkip   &= ( entry & 1 ) != 0;
+    }
+  }
+  return true;
+}
+
 static bool interHadActive( const ComprCUCtx& ctx )
 {
   return ctx.interHad != 0;
@@ -1080,6 +1362,8 @@ void EncModeCtrlMTnoRQT::create( const EncCfg& cfg )
   BestEncInfoCache::create( cfg.getChromaFormatIdc() );
 #endif
   SaveLoadEncInfoSbt::create();
+  FastSplitCtrl::create( cfg );
+  CuHistoryCtrl::create( cfg );
 }
 
 void EncModeCtrlMTnoRQT::destroy()
@@ -1098,6 +1382,8 @@ void EncModeCtrlMTnoRQT::initCTUEncoding( const Slice &slice )
   BestEncInfoCache::init( slice );
 #endif
   SaveLoadEncInfoSbt::init( slice );
+  FastSplitCtrl::init( slice );
+  CuHistoryCtrl::init( slice );
 
   CHECK( !m_ComprCUCtxList.empty(), "Mode list is not empty at the beginning of a CTU" );
 
@@ -1152,10 +1438,14 @@ void EncModeCtrlMTnoRQT::initCULevel( Partitioner &partitioner, const CodingStru
   const CodingUnit* cuLeft  = cs.getCU( cs.area.blocks[partitioner.chType].pos().offset( -1, 0 ), partitioner.chType );
   const CodingUnit* cuAbove = cs.getCU( cs.area.blocks[partitioner.chType].pos().offset( 0, -1 ), partitioner.chType );
 
+  CuHistoryInfo history;
+  const bool hasHistory = isLuma( partitioner.chType ) && getCuHistory( cs.area.Y(), history );
+
   const bool qtBeforeBt = ( (  cuLeft  &&  cuAbove  && cuLeft ->qtDepth > partitioner.currQtDepth && cuAbove->qtDepth > partitioner.currQtDepth )
                          || (  cuLeft  && !cuAbove  && cuLeft ->qtDepth > partitioner.currQtDepth )
                          || ( !cuLeft  &&  cuAbove  && cuAbove->qtDepth > partitioner.currQtDepth )
-                         || ( !cuAbove && !cuLeft   && cs.area.lwidth() >= ( 32 << cs.slice->getDepth() ) ) )
+                         || ( !cuAbove && !cuLeft   && cs.area.lwidth() >= ( 32 << cs.slice->getDepth() ) )
+                         || ( hasHistory && history.minQtDepth > partitioner.currQtDepth ) )
                          && ( cs.area.lwidth() > ( cs.pcv->getMinQtSize( *cs.slice, partitioner.chType ) << 1 ) );
 
   // set features
@@ -1740,6 +2030,19 @@ bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
       return false;
     }
 
+    if( skipSplit( split, cuECtx.splitFeatures, cs, partitioner, bestCS, bestCS && !isModeSplit( bestMode ) ? bestCU : nullptr ) )
+    {
+      return false;
+    }
+
+    CuHistoryInfo history;
+    if( bestCU && bestCU->skip && !isModeSplit( bestMode ) && isLuma( partitioner.chType ) && getCuHistory( partitioner.currArea().Y(), history )
+      && history.allSkip && history.maxDepth <= partitioner.currDepth )
+    {
+      // static content: the co-located area of the previous picture was skipped without a deeper split
+      return false;
+    }
+
     int featureToSet = -1;
 
     switch( getPartSplit( encTestmode ) )
@@ -169,6 +169,18 @@ inline EncTestMode getCSEncMode( const CodingStructure& cs )
 // EncModeCtrl controls if specific modes should be tested
 //////////////////////////////////////////////////////////////////////////
 
+// luma content features of a block, computed on demand by FastSplitCtrl
+struct SplitFeatures
+{
+  bool   valid;
+  double variance;          ///< sample variance of the block
+  double meanHalf[2][2];    ///< sample mean of the [0: top/bottom, 1: left/right] halves
+  double varHalf [2][2];    ///< sample variance of the [0: top/bottom, 1: left/right] halves
+  double gradHor;           ///< mean absolute difference of horizontally neighbouring samples
+  double gradVer;           ///< mean absolute difference of vertically neighbouring samples
+  double zeroMvSad;         ///< mean absolute difference to the co-located block of the closest reference picture, negative without reference
+};
+
 struct ComprCUCtx
 {
   ComprCUCtx() : testModes(), extraFeatures()
@@ -227,6 +239,8 @@ struct ComprCUCtx
 
     extraFeaturesd.reserve( numExtraFeatures );
     extraFeaturesd.resize ( numExtraFeatures, 0.0 );
+
+    splitFeatures.valid = false;
   }
 
   unsigned                          minDepth;
@@ -262,6 +276,7 @@ struct ComprCUCtx
   uint8_t                           ispMode;
   uint8_t                           ispLfnstIdx;
   bool                              stopNonDCT2Transforms;
+  SplitFeatures                     splitFeatures;
 
   template<typename T> T    get( int ft )       const { return typeid(T) == typeid(double) ? (T&)extraFeaturesd[ft] : T(extraFeatures[ft]); }
   template<typename T> void set( int ft, T val )      { extraFeatures [ft] = int64_t( val ); }
@@ -419,6 +434,60 @@ public:
 #endif
 };
 
+//////////////////////////////////////////////////////////////////////////
+// FastSplitCtrl - content adaptive early termination of the split tests
+//////////////////////////////////////////////////////////////////////////
+
+class FastSplitCtrl
+{
+protected:
+  void create( const EncCfg& cfg );
+  void init  ( const Slice &slice );
+
+  // true if the split is not worth testing, given the block content, the neighbouring CUs and the best non-split CU (NULL if a split is better)
+  bool skipSplit( const PartSplit split, SplitFeatures& features, const CodingStructure &cs, const Partitioner &partitioner, const CodingStructure *bestCS, const CodingUnit *bestCU ) const;
+
+private:
+  void xGetFeatures( SplitFeatures& features, const CodingStructure &cs, const CompArea &area ) const;
+
+  unsigned       m_fastPartition;   // preset, 0: off
+  const Picture *m_refPicSplit;     // closest reference picture of the slice, NULL for intra slices
+
+public:
+  virtual ~FastSplitCtrl() { }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// CuHistoryCtrl - reuse of the CU decisions of the previous picture of the same temporal layer
+//////////////////////////////////////////////////////////////////////////
+
+struct CuHistoryInfo
+{
+  unsigned maxDepth;       ///< largest CU depth in the co-located area
+  unsigned minQtDepth;     ///< smallest QT depth in the co-located area
+  bool     allSkip;        ///< all co-located CUs were coded in skip mode
+};
+
+class CuHistoryCtrl
+{
+public:
+  // stores the final luma CU decisions of a coded picture with the picture
+  static void storeCuHistory( Picture &pic );
+
+protected:
+  void create( const EncCfg& cfg );
+  void init  ( const Slice &slice );
+
+  bool getCuHistory( const CompArea &area, CuHistoryInfo &info ) const;
+
+private:
+  bool           m_temporalCuReuse;
+  const Picture *m_historyPic;      // closest reference picture of the same temporal layer with stored decisions
+
+public:
+  virtual ~CuHistoryCtrl() { }
+};
+
 static const int MAX_STORED_CU_INFO_REFS = 4;
 
 struct CodedCUInfo
@@ -565,6 +634,8 @@ class EncModeCtrlMTnoRQT : public EncModeCtrl, public CacheBlkInfoCtrl
   , public BestEncInfoCache
 #endif
   , public SaveLoadEncInfoSbt
+  , public FastSplitCtrl
+  , public CuHistoryCtrl
 {
   enum ExtraFeatures
   {
@@ -989,6 +989,7 @@ void EncReshape::initLUTfromdQPModel()
     int invSample = m_inputPivot[idxYInv] + ((m_invScaleCoef[idxYInv] * (lumaSample - m_reshapePivot[idxYInv]) + (1 << (FP_PREC - 1))) >> FP_PREC);
     m_invLUT[lumaSample] = Clip3((Pel)0, (Pel)((1 << m_lumaBD) - 1), (Pel)(invSample));
   }
+  updateLutPwl();
 }
 
 void EncReshape::constructReshaperLMCS()
@@ -1081,6 +1082,7 @@ void EncReshape::constructReshaperLMCS()
     int invSample = m_inputPivot[idxYInv] + ((m_invScaleCoef[idxYInv] * (lumaSample - m_reshapePivot[idxYInv]) + (1 << (FP_PREC - 1))) >> FP_PREC);
     m_invLUT[lumaSample] = Clip3((Pel)0, (Pel)((1 << m_lumaBD) - 1), (Pel)(invSample));
   }
+  updateLutPwl();
   for (i = 0; i < PIC_CODE_CW_BINS; i++)
   {
     int start = i*histLenth;
@@ -433,6 +433,10 @@ void EncSlice::initEncSlice(Picture* pcPic, const int pocLast, const int pocCurr
   {
     eSliceType = (pocLast == 0 || pocCurr == 0 || m_pcGOPEncoder->getGOPSize() == 0) ? I_SLICE : eSliceType;
   }
+  if (m_pcLib->getLookahead()->isSceneCut(pocCurr))
+  {
+    eSliceType = I_SLICE;
+  }
 
   rpcSlice->setDepth        ( depth );
   rpcSlice->setSliceType    ( eSliceType );
@@ -600,6 +604,10 @@ void EncSlice::initEncSlice(Picture* pcPic, const int pocLast, const int pocCurr
     {
       eSliceType = (pocLast == 0 || pocCurr == 0 || m_pcGOPEncoder->getGOPSize() == 0) ? I_SLICE : eSliceType;
     }
+    if (m_pcLib->getLookahead()->isSceneCut(pocCurr))
+    {
+      eSliceType = I_SLICE;
+    }
 
     rpcSlice->setSliceType        ( eSliceType );
   }
@@ -692,7 +700,6 @@ void EncSlice::initEncSlice(Picture* pcPic, const int pocLast, const int pocCurr
 
   if( ( m_pcCfg->getIBCHashSearch() && m_pcCfg->getIBCMode() ) || m_pcCfg->getAllowDisFracMMVD() )
   {
-    m_pcCuEncoder->getIbcHashMap().destroy();
     m_pcCuEncoder->getIbcHashMap().init( pcPic->cs->pps->getPicWidthInLumaSamples(), pcPic->cs->pps->getPicHeightInLumaSamples() );
   }
 }
@@ -1507,7 +1514,11 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
   if ( pcSlice->getSPS()->getFpelMmvdEnabledFlag() ||
       (pcSlice->getSPS()->getIBCFlag() && m_pcCuEncoder->getEncCfg()->getIBCHashSearch()))
   {
-    m_pcCuEncoder->getIbcHashMap().rebuildPicHashMap(cs.picture->getTrueOrigBuf());
+    // the map covers the whole original picture, it is built by the first slice only
+    if( !m_pcCuEncoder->getIbcHashMap().isValid() )
+    {
+      m_pcCuEncoder->getIbcHashMap().rebuildPicHashMap( cs.picture->getTrueOrigBuf() );
+    }
     if (m_pcCfg->getIntraPeriod() != -1)
     {
       int hashBlkHitPerc = m_pcCuEncoder->getIbcHashMap().calHashBlkMatchPerc(cs.area.Y());
@@ -1674,8 +1685,19 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
       pcPic->mctsInfo.init( &cs, ctuRsAddr );
     }
 
-  if (pCfg->getSwitchPOC() != pcPic->poc || ctuRsAddr >= pCfg->getDebugCTU())
-    m_pcCuEncoder->compressCtu( cs, ctuArea, ctuRsAddr, prevQP, currQP );
+    if( pCfg->getUseFastResidualRate() )
+    {
+      m_residualRateTable.init( pCABACWriter->getCtx() );
+      pCABACWriter->setResidualRateTable( &m_residualRateTable );
+    }
+
+    if (pCfg->getSwitchPOC() != pcPic->poc || ctuRsAddr >= pCfg->getDebugCTU())
+    {
+      m_pcCuEncoder->compressCtu( cs, ctuArea, ctuRsAddr, prevQP, currQP );
+    }
+
+    // the bits of the final CTU and the context states for the following CTUs are estimated exactly
+    pCABACWriter->setResidualRateTable( nullptr );
 
 #if K0149_BLOCK_STATISTICS
     getAndStoreBlockStatistics(cs, ctuArea);
@@ -1702,6 +1724,10 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
 
     int actualBits = int(cs.fracBits >> SCALE_BITS);
     actualBits    -= (int)m_uiPicTotalBits;
+    if ( pCfg->getRCPass() == 1 )
+    {
+      pRateCtrl->addFirstPassCtuBits( ctuRsAddr, actualBits );
+    }
     if ( pCfg->getUseRateCtrl() )
     {
       int actualQP        = g_RCInvalidQPValue;
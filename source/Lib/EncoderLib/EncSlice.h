@@ -83,6 +83,7 @@ private:
   // RD optimization
   RdCost*                 m_pcRdCost;                           ///< RD cost computation
   CABACWriter*            m_CABACEstimator;
+  ResidualRateTable       m_residualRateTable;              ///< per-CTU residual rates used by the mode decision with FastResidualRate
   uint64_t                  m_uiPicTotalBits;                     ///< total bits for the picture
   uint64_t                  m_uiPicDist;                          ///< total distortion for the picture
   std::vector<double>     m_vdRdPicLambda;                      ///< array of lambda candidates
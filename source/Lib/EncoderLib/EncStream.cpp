@@ -0,0 +1,198 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncStream.cpp
+    \brief    streaming encoder interface around EncLib
+*/
+
+#include "EncStream.h"
+
+#include "AnnexBwrite.h"
+
+#include <sstream>
+
+//! \ingroup EncoderLib
+//! \{
+
+EncStream::EncStream()
+  : m_cEncLib( &m_cEncLibCommon )
+  , m_numEncoded( 0 )
+  , m_numFramesPushed( 0 )
+  , m_created( false )
+  , m_flushed( false )
+{
+}
+
+EncStream::~EncStream()
+{
+  destroy();
+}
+
+void EncStream::create()
+{
+  CHECK( m_created, "Encoder already created" );
+  CHECK( m_cEncLib.getVPS()->getMaxLayers() > 1, "Multi-layer coding is not supported by the streaming encoder" );
+  CHECK( m_cEncLib.getInterlacedSourceFlag(), "Field coding is not supported by the streaming encoder" );
+  CHECK( m_cEncLib.getGopBasedTemporalFilterEnabled(), "The GOP based temporal filter is not supported by the streaming encoder" );
+
+  const UnitArea unitArea( m_cEncLib.getChromaFormatIdc(), Area( 0, 0, m_cEncLib.getSourceWidth(), m_cEncLib.getSourceHeight() ) );
+  m_orgPic.create( unitArea );
+  m_trueOrgPic.create( unitArea );
+
+  m_cEncLib.create( m_cEncLib.getVPS()->getLayerId( 0 ) );
+
+  for( int i = 0; i < m_cEncLib.getGOPSize() + 1; i++ )
+  {
+    m_recBufList.push_back( new PelUnitBuf );
+  }
+
+  m_cEncLib.init( false, this );
+
+  m_numEncoded      = 0;
+  m_numFramesPushed = 0;
+  m_created         = true;
+  m_flushed         = false;
+}
+
+void EncStream::destroy()
+{
+  if( !m_created )
+  {
+    return;
+  }
+
+  m_cEncLib.deletePicBuffer();
+
+  for( auto &p : m_recBufList )
+  {
+    delete p;
+  }
+  m_recBufList.clear();
+
+  m_cEncLib.destroy();
+
+  m_orgPic.destroy();
+  m_trueOrgPic.destroy();
+  m_accessUnits.clear();
+
+  m_created = false;
+}
+
+void EncStream::createInputBuffer( PelStorage& buf ) const
+{
+  buf.create( UnitArea( m_cEncLib.getChromaFormatIdc(), Area( 0, 0, m_cEncLib.getSourceWidth(), m_cEncLib.getSourceHeight() ) ) );
+}
+
+void EncStream::pushFrame( const CPelUnitBuf& org )
+{
+  CHECK( !m_created, "Encoder not created" );
+  CHECK( m_flushed, "Frames cannot be pushed after flush()" );
+  CHECK( org.chromaFormat != m_orgPic.chromaFormat || org.Y().width != m_orgPic.Y().width || org.Y().height != m_orgPic.Y().height, "Frame does not match the source format" );
+
+  m_orgPic.copyFrom( org );
+  m_trueOrgPic.copyFrom( org );
+
+  xEncode( false, &m_orgPic, &m_trueOrgPic );
+}
+
+void EncStream::pushFrame( PelStorage& org )
+{
+  CHECK( !m_created, "Encoder not created" );
+  CHECK( m_flushed, "Frames cannot be pushed after flush()" );
+
+  // with reference picture resampling the input is rescaled into the picture, the swap needs the exact buffer layout
+  if( m_cEncLib.isResChangeInClvsEnabled() || org.chromaFormat != m_orgPic.chromaFormat || org.Y().width != m_orgPic.Y().width
+    || org.Y().height != m_orgPic.Y().height || org.Y().stride != m_orgPic.Y().stride )
+  {
+    pushFrame( CPelUnitBuf( org ) );
+    return;
+  }
+
+  m_trueOrgPic.copyFrom( org );
+
+  xEncode( false, &org, &m_trueOrgPic );
+}
+
+void EncStream::flush()
+{
+  CHECK( !m_created, "Encoder not created" );
+
+  m_cEncLib.setFramesToBeEncoded( m_numFramesPushed );
+  m_flushed = true;
+
+  xEncode( true, nullptr, nullptr );
+}
+
+bool EncStream::pullAccessUnit( std::vector<uint8_t>& accessUnit )
+{
+  if( m_accessUnits.empty() )
+  {
+    return false;
+  }
+
+  accessUnit.swap( m_accessUnits.front() );
+  m_accessUnits.pop_front();
+
+  return true;
+}
+
+void EncStream::outputAU( const AccessUnit& au )
+{
+  std::ostringstream annexB( std::ios::binary );
+  writeAnnexB( annexB, au );
+
+  const std::string& bytes = annexB.str();
+  m_accessUnits.emplace_back( bytes.begin(), bytes.end() );
+}
+
+void EncStream::xEncode( bool flush, PelStorage* org, PelStorage* trueOrg )
+{
+  const InputColourSpaceConversion snrCSC = IPCOLOURSPACE_UNCHANGED;
+
+  if( org )
+  {
+    m_numFramesPushed++;
+  }
+
+  // frames are collected until a GOP is complete
+  if( m_cEncLib.encodePrep( flush, org, trueOrg, snrCSC, m_recBufList, m_numEncoded ) )
+  {
+    return;
+  }
+
+  while( m_cEncLib.encode( snrCSC, m_recBufList, m_numEncoded ) )
+  {
+  }
+}
+
+//! \}
@@ -0,0 +1,109 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     EncStream.h
+    \brief    streaming encoder interface around EncLib (header)
+*/
+
+#ifndef __ENCSTREAM__
+#define __ENCSTREAM__
+
+#include "EncLib.h"
+#include "EncLibCommon.h"
+
+#include <deque>
+#include <list>
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/**
+  Memory based single layer encoder.
+  The encoder is configured through getEncLib(), e.g. from a parsed encoder configuration with
+  EncAppCfg::initEncLibCfg() as done by EncApp, then created with create(). Frames are pushed in display order, with the
+  source size and the internal bit depth of the configuration, access units are pulled in Annex B format as soon as
+  their GOP is coded, and flush() codes the pending frames at the end of the sequence. initROM() has to be called once
+  before creating the first encoder. Multi-layer and field coding as well as the GOP based temporal filter of the
+  encoder application are not supported.
+*/
+class EncStream : public AUWriterIf
+{
+public:
+  EncStream();
+  virtual ~EncStream();
+
+  EncCfg&     getCfg()                                 { return m_cEncLib; }
+  VPS*        getVPS()                                 { return m_cEncLib.getVPS(); }
+  EncLib&     getEncLib()                              { return m_cEncLib; }
+
+  void        create              ();
+  void        destroy             ();
+
+  /// allocates a buffer which can be pushed without copying the picture into the encoder
+  void        createInputBuffer   ( PelStorage& buf ) const;
+
+  void        pushFrame           ( const CPelUnitBuf& org );   ///< copies the frame into the encoder
+  void        pushFrame           ( PelStorage& org );          ///< exchanges the storage with a free picture buffer when the size allows it
+  void        flush               ();                           ///< codes the pending frames of an incomplete GOP, ends the sequence
+
+  bool        pullAccessUnit      ( std::vector<uint8_t>& accessUnit );
+  size_t      getNumAccessUnits   () const                     { return m_accessUnits.size(); }
+  int         getNumFramesPushed  () const                     { return m_numFramesPushed; }
+
+  void        printSummary        ()                           { m_cEncLib.printSummary( false ); }
+
+  void        outputAU            ( const AccessUnit& au );
+
+private:
+  void        xEncode             ( bool flush, PelStorage* org, PelStorage* trueOrg );
+
+  EncLibCommon                     m_cEncLibCommon;
+  EncLib                           m_cEncLib;
+  PelStorage                       m_orgPic;
+  PelStorage                       m_trueOrgPic;
+  std::list<PelUnitBuf*>           m_recBufList;
+  int                              m_numEncoded;
+  int                              m_numFramesPushed;
+  bool                             m_created;
+  bool                             m_flushed;       ///< the number of frames to be encoded has been fixed by flush()
+  std::deque<std::vector<uint8_t>> m_accessUnits;   ///< coded access units in Annex B format, in coding order
+};
+
+//! \}
+
+#endif // __ENCSTREAM__
@@ -36,6 +36,7 @@
 */
 
 #include "EncTemporalFilter.h"
+#include "CommonLib/StageProfiler.h"
 #include <math.h>
 
 
@@ -132,6 +133,8 @@ void EncTemporalFilter::init(const int frameSkip,
 
 bool EncTemporalFilter::filter(PelStorage *orgPic, int receivedPoc)
 {
+  PROFILE_STAGE( PROF_TEMPORAL_FILTER );
+
   bool isFilterThisFrame = false;
   if (m_QP >= 17)  // disable filter for QP < 17
   {
@@ -45,9 +45,11 @@
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/dtrace_next.h"
 #include "CommonLib/dtrace_buffer.h"
+#include "CommonLib/StageProfiler.h"
 #include "CommonLib/MCTS.h"
 
 #include "EncModeCtrl.h"
+#include "EncHierarchicalME.h"
 #include "EncLib.h"
 
 #include <math.h>
@@ -86,6 +88,7 @@ static const Mv s_acMvRefineQ[9] =
 
 InterSearch::InterSearch()
   : m_modeCtrl                    (nullptr)
+  , m_hierarchicalME              (nullptr)
   , m_pSplitCS                    (nullptr)
   , m_pFullCS                     (nullptr)
   , m_pcEncCfg                    (nullptr)
@@ -3298,6 +3301,8 @@ Distortion InterSearch::xGetAffineTemplateCost( PredictionUnit& pu, PelUnitBuf&
 
 void InterSearch::xMotionEstimation(PredictionUnit& pu, PelUnitBuf& origBuf, RefPicList eRefPicList, Mv& rcMvPred, int iRefIdxPred, Mv& rcMv, int& riMVPIdx, uint32_t& ruiBits, Distortion& ruiCost, const AMVPInfo& amvpInfo, bool bBi)
 {
+  PROFILE_STAGE( PROF_INTER_ME );
+
   if( pu.cu->cs->sps->getUseBcw() && pu.cu->BcwIdx != BCW_DEFAULT && !bBi && xReadBufferedUniMv(pu, eRefPicList, iRefIdxPred, rcMvPred, rcMv, ruiBits, ruiCost) )
   {
     return;
@@ -3763,11 +3768,17 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
     }
   }
 
+  if( xTZSearchHierarchicalMv( pu, eRefPicList, iRefIdxPred, cStruct ) )
+  {
+    // the start point agrees with the motion of the surrounding area, the search is restricted to its neighbourhood
+    iSearchRange = std::min( iSearchRange, std::max( m_iSearchRange >> 2, 8 ) );
+  }
+
   {
     // set search range
     Mv currBestMv(cStruct.iBestX, cStruct.iBestY );
     currBestMv <<= MV_FRACTIONAL_BITS_INTERNAL;
-    xSetSearchRange(pu, currBestMv, m_iSearchRange >> (bFastSettings ? 1 : 0), sr, cStruct);
+    xSetSearchRange(pu, currBestMv, std::min( iSearchRange, m_iSearchRange >> (bFastSettings ? 1 : 0) ), sr, cStruct);
   }
   if (m_pcEncCfg->getUseHashME() && (m_currRefPicList == 0 || pu.cu->slice->getList1IdxToList0Idx(m_currRefPicIndex) < 0))
   {
@@ -3991,7 +4002,7 @@ void InterSearch::xTZSearchSelective( const PredictionUnit& pu,
   const bool bStarRefinementDiamond   = true;   // 1 = xTZ8PointDiamondSearch   0 = xTZ8PointSquareSearch
   const bool bStarRefinementStop      = false;
   const uint32_t uiStarRefinementRounds   = 2;  // star refinement stop X rounds after best match (must be >=1)
-  const int  iSearchRange             = m_iSearchRange;
+  int        iSearchRange             = m_iSearchRange;
   const int  iSearchRangeInitial      = m_iSearchRange >> 2;
   const int  uiSearchStep             = 4;
   const int  iMVDistThresh            = 8;
@@ -4068,11 +4079,16 @@ void InterSearch::xTZSearchSelective( const PredictionUnit& pu,
     }
   }
 
+  if( xTZSearchHierarchicalMv( pu, eRefPicList, iRefIdxPred, cStruct ) )
+  {
+    iSearchRange = std::min( iSearchRange, std::max( m_iSearchRange >> 2, 8 ) );
+  }
+
   {
     // set search range
     Mv currBestMv(cStruct.iBestX, cStruct.iBestY );
     currBestMv <<= 2;
-    xSetSearchRange( pu, currBestMv, m_iSearchRange, sr, cStruct );
+    xSetSearchRange( pu, currBestMv, iSearchRange, sr, cStruct );
   }
   if (m_pcEncCfg->getUseHashME() && (m_currRefPicList == 0 || pu.cu->slice->getList1IdxToList0Idx(m_currRefPicIndex) < 0))
   {
@@ -4169,6 +4185,35 @@ void InterSearch::xTZSearchSelective( const PredictionUnit& pu,
   ruiSAD = cStruct.uiBestSad - m_pcRdCost->getCostOfVectorWithPredictor( cStruct.iBestX, cStruct.iBestY, cStruct.imvShift );
 }
 
+/** tests the motion vector of the hierarchical motion estimation pre-pass as start point of the TZ search
+    \returns true if the best start point is within one sample of the motion vector of the pre-pass
+ */
+bool InterSearch::xTZSearchHierarchicalMv( const PredictionUnit& pu, RefPicList eRefPicList, int iRefIdxPred, IntTZSearchStruct& cStruct )
+{
+  Mv cHmeMv;
+  if( m_hierarchicalME == nullptr || cStruct.inCtuSearch || !m_hierarchicalME->getMv( *pu.cs->slice, eRefPicList, iRefIdxPred, pu.Y(), cHmeMv ) )
+  {
+    return false;
+  }
+
+  cHmeMv.changePrecision( MV_PRECISION_INT, MV_PRECISION_INTERNAL );
+  if( m_pcEncCfg->getMCTSEncConstraint() )
+  {
+    MCTSHelper::clipMvToArea( cHmeMv, pu.Y(), pu.cs->picture->mctsInfo.getTileArea(), *pu.cs->sps );
+  }
+  else
+  {
+    clipMv( cHmeMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->sps, *pu.cs->pps );
+  }
+  cHmeMv.changePrecision( MV_PRECISION_INTERNAL, MV_PRECISION_INT );
+
+  if( cHmeMv.getHor() != cStruct.iBestX || cHmeMv.getVer() != cStruct.iBestY )
+  {
+    xTZSearchHelp( cStruct, cHmeMv.getHor(), cHmeMv.getVer(), 0, 0 );
+  }
+  return abs( cHmeMv.getHor() - cStruct.iBestX ) <= 1 && abs( cHmeMv.getVer() - cStruct.iBestY ) <= 1;
+}
+
 void InterSearch::xPatternSearchIntRefine(PredictionUnit& pu, IntTZSearchStruct&  cStruct, Mv& rcMv, Mv& rcMvPred, int& riMVPIdx, uint32_t& ruiBits, Distortion& ruiCost, const AMVPInfo& amvpInfo, double fWeight)
 {
 
@@ -5349,6 +5394,8 @@ void InterSearch::xAffineMotionEstimation( PredictionUnit& pu,
                                            const AffineAMVPInfo& aamvpi,
                                            bool            bBi)
 {
+  PROFILE_STAGE( PROF_AFFINE_ME );
+
   if( pu.cu->cs->sps->getUseBcw() && pu.cu->BcwIdx != BCW_DEFAULT && !bBi && xReadBufferedAffineUniMv(pu, eRefPicList, iRefIdxPred, acMvPred, acMv, ruiBits, ruiCost
       , mvpIdx, aamvpi
   ) )
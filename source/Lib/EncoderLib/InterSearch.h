@@ -71,6 +71,7 @@ struct BlkRecord
   std::unordered_map<Mv, Distortion> bvRecord;
 };
 class EncModeCtrl;
+class EncHierarchicalME;
 
 struct AffineMVInfo
 {
@@ -101,6 +102,7 @@ class InterSearch : public InterPrediction, AffineGradientSearch
 {
 private:
   EncModeCtrl     *m_modeCtrl;
+  const EncHierarchicalME *m_hierarchicalME;
 
   PelStorage      m_tmpPredStorage              [NUM_REF_PIC_LIST_01];
   PelStorage      m_tmpStorageLCU;
@@ -363,6 +365,7 @@ public:
   /// encoder estimation - inter prediction (non-skip)
 
   void setModeCtrl( EncModeCtrl *modeCtrl ) { m_modeCtrl = modeCtrl;}
+  void setHierarchicalME( const EncHierarchicalME *hierarchicalME ) { m_hierarchicalME = hierarchicalME; }
 
   void predInterSearch(CodingUnit& cu, Partitioner& partitioner );
 
@@ -469,6 +472,12 @@ protected:
                                     const Mv* const       pIntegerMv2Nx2NPred
                                   );
 
+  bool xTZSearchHierarchicalMv    ( const PredictionUnit& pu,
+                                    RefPicList            eRefPicList,
+                                    int                   iRefIdxPred,
+                                    IntTZSearchStruct&    cStruct
+                                  );
+
   void xSetSearchRange            ( const PredictionUnit& pu,
                                     const Mv&             cMvPred,
                                     const int             iSrchRng,
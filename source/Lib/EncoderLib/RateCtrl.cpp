@@ -38,6 +38,7 @@
 #include "../CommonLib/ChromaFormat.h"
 
 #include <cmath>
+#include <cstring>
 
 #define LAMBDA_PREC                                           1000000
 
@@ -315,10 +316,10 @@ EncRCGOP::~EncRCGOP()
   destroy();
 }
 
-void EncRCGOP::create( EncRCSeq* encRCSeq, int numPic )
+void EncRCGOP::create( EncRCSeq* encRCSeq, int numPic, double complexityRatio )
 {
   destroy();
-  int targetBits = xEstGOPTargetBits( encRCSeq, numPic );
+  int targetBits = xEstGOPTargetBits( encRCSeq, numPic, complexityRatio );
   int bitdepth_luma_scale =
     2 * (encRCSeq->getbitDepth() - 8
       - DISTORTION_PRECISION_ADJUSTMENT(encRCSeq->getbitDepth()));
@@ -579,13 +580,19 @@ void EncRCGOP::updateAfterPicture( int bitsCost )
   m_picLeft--;
 }
 
-int EncRCGOP::xEstGOPTargetBits( EncRCSeq* encRCSeq, int GOPSize )
+int EncRCGOP::xEstGOPTargetBits( EncRCSeq* encRCSeq, int GOPSize, double complexityRatio )
 {
   int realInfluencePicture = min( g_RCSmoothWindowSize, encRCSeq->getFramesLeft() );
   int averageTargetBitsPerPic = (int)( encRCSeq->getTargetBits() / encRCSeq->getTotalFrames() );
   int currentTargetBitsPerPic = (int)( ( encRCSeq->getBitsLeft() - averageTargetBitsPerPic * (encRCSeq->getFramesLeft() - realInfluencePicture) ) / realInfluencePicture );
   int targetBits = currentTargetBitsPerPic * GOPSize;
 
+  // the look-ahead complexity moves bits towards GOPs that are harder to code, the smoothing window compensates
+  if ( complexityRatio != 1.0 )
+  {
+    targetBits = (int)( targetBits * pow( Clip3( g_RCMinComplexityRatio, g_RCMaxComplexityRatio, complexityRatio ), g_RCComplexityExponent ) );
+  }
+
   if ( targetBits < 200 )
   {
     targetBits = 200;   // at least allocate 200 bits for one GOP
@@ -619,6 +626,7 @@ EncRCPic::EncRCPic()
   m_picLambda           = 0.0;
   m_picMSE              = 0.0;
   m_validPixelsInPic    = 0;
+  m_firstPassCtuBits    = NULL;
 }
 
 EncRCPic::~EncRCPic()
@@ -792,6 +800,7 @@ void EncRCPic::create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, l
   m_picQP               = 0;
   m_picLambda           = 0.0;
   m_validPixelsInPic    = 0;
+  m_firstPassCtuBits    = NULL;
   m_picMSE              = 0.0;
 }
 
@@ -901,7 +910,14 @@ double EncRCPic::estimatePicLambda( list<EncRCPic*>& listPreviousPictures, bool
       betaLCU  = m_encRCSeq->getPicPara( m_frameLevel ).m_beta;
     }
 
-    m_LCUs[i].m_bitWeight =  m_LCUs[i].m_numberOfPixel * pow( estLambda/alphaLCU, 1.0/betaLCU );
+    if ( m_firstPassCtuBits != NULL )
+    {
+      m_LCUs[i].m_bitWeight = (double)( *m_firstPassCtuBits )[i];
+    }
+    else
+    {
+      m_LCUs[i].m_bitWeight = m_LCUs[i].m_numberOfPixel * pow( estLambda/alphaLCU, 1.0/betaLCU );
+    }
 
     if ( m_LCUs[i].m_bitWeight < 0.01 )
     {
@@ -1390,6 +1406,14 @@ double EncRCPic::clipRcBeta(const double beta)
   return Clip3(g_RCBetaMinValue, g_RCBetaMaxValue, beta);
 }
 
+void EncRCPic::setFirstPassStats( int targetBits, const std::vector<uint32_t>* ctuBits )
+{
+  CHECK( ctuBits->size() != m_numberOfLCU, "Number of CTUs in the first pass statistics does not match" );
+  m_targetBits       = std::max( targetBits, m_estHeaderBits + 100 );
+  m_bitsLeft         = m_targetBits - m_estHeaderBits;
+  m_firstPassCtuBits = ctuBits;
+}
+
 int EncRCPic::getRefineBitsForIntra( int orgBits )
 {
   double alpha=0.25, beta=0.5582;
@@ -1491,11 +1515,14 @@ RateCtrl::RateCtrl()
   m_encRCSeq = NULL;
   m_encRCGOP = NULL;
   m_encRCPic = NULL;
+  m_pass     = 0;
+  m_firstPassBitsLeft = 0;
 }
 
 RateCtrl::~RateCtrl()
 {
   destroy();
+  destroyFirstPass();
 }
 
 void RateCtrl::destroy()
@@ -1904,16 +1931,26 @@ void RateCtrl::init(int totalFrames, int targetBitrate, int frameRate, int GOPSi
   delete[] GOPID2Level;
 }
 
-void RateCtrl::initRCPic( int frameLevel )
+void RateCtrl::initRCPic( int frameLevel, int poc )
 {
   m_encRCPic = new EncRCPic;
   m_encRCPic->create( m_encRCSeq, m_encRCGOP, frameLevel, m_listRCPictures );
+
+  std::map<int, FirstPassPicture>::const_iterator it = m_firstPassPictures.find( poc );
+  if ( m_pass == 2 && it != m_firstPassPictures.end() )
+  {
+    // the remaining budget is shared in proportion to the first pass bits of the remaining pictures
+    const FirstPassPicture& stats = it->second;
+    int64_t targetBits = m_firstPassBitsLeft > 0 ? m_encRCSeq->getBitsLeft() * stats.bits / m_firstPassBitsLeft : 0;
+    m_encRCPic->setFirstPassStats( (int)Clip3<int64_t>( 0, MAX_INT, targetBits ), &stats.ctuBits );
+    m_firstPassBitsLeft -= stats.bits;
+  }
 }
 
-void RateCtrl::initRCGOP( int numberOfPictures )
+void RateCtrl::initRCGOP( int numberOfPictures, double complexityRatio )
 {
   m_encRCGOP = new EncRCGOP;
-  m_encRCGOP->create( m_encRCSeq, numberOfPictures );
+  m_encRCGOP->create( m_encRCSeq, numberOfPictures, complexityRatio );
 }
 
 #if U0132_TARGET_BITS_SATURATION
@@ -1951,3 +1988,111 @@ void RateCtrl::destroyRCGOP()
   delete m_encRCGOP;
   m_encRCGOP = NULL;
 }
+
+static const char    g_RCStatsMagic[4] = { 'V', 'R', 'C', 'S' };
+static const uint32_t g_RCStatsVersion = 1;
+
+void RateCtrl::initFirstPass( int pass, const std::string& fileName, int numCtus )
+{
+  destroyFirstPass();
+  m_pass          = pass;
+  m_statsFileName = fileName;
+  if ( m_pass == 1 )
+  {
+    m_statsFile.open( fileName, std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( !m_statsFile.is_open() )
+    {
+      EXIT( "Unable to open rate control statistics file " << fileName << " for writing" );
+    }
+    const uint32_t header[2] = { g_RCStatsVersion, (uint32_t)numCtus };
+    m_statsFile.write( g_RCStatsMagic, sizeof( g_RCStatsMagic ) );
+    m_statsFile.write( (const char*)header, sizeof( header ) );
+    if ( !m_statsFile )
+    {
+      EXIT( "Failed to write rate control statistics file " << fileName );
+    }
+    m_firstPassCtuBits.assign( numCtus, 0 );
+  }
+  else if ( m_pass == 2 )
+  {
+    m_statsFile.open( fileName, std::ios::in | std::ios::binary );
+    if ( !m_statsFile.is_open() )
+    {
+      EXIT( "Unable to open rate control statistics file " << fileName << " for reading" );
+    }
+    char     magic[4];
+    uint32_t header[2];
+    m_statsFile.read( magic, sizeof( magic ) );
+    m_statsFile.read( (char*)header, sizeof( header ) );
+    if ( !m_statsFile || memcmp( magic, g_RCStatsMagic, sizeof( magic ) ) || header[0] != g_RCStatsVersion )
+    {
+      EXIT( "Invalid rate control statistics file " << fileName );
+    }
+    if ( header[1] != (uint32_t)numCtus )
+    {
+      EXIT( "Rate control statistics file " << fileName << " was written for " << header[1] << " CTUs per picture instead of " << numCtus );
+    }
+
+    // picture records: POC, QP, slice type, bits, followed by the bits of each CTU
+    int32_t record[4];
+    while ( m_statsFile.read( (char*)record, sizeof( record ) ) )
+    {
+      FirstPassPicture& stats = m_firstPassPictures[record[0]];
+      stats.qp        = record[1];
+      stats.sliceType = (SliceType)record[2];
+      stats.bits      = (uint32_t)record[3];
+      stats.ctuBits.resize( numCtus );
+      if ( !m_statsFile.read( (char*)stats.ctuBits.data(), numCtus * sizeof( uint32_t ) ) )
+      {
+        EXIT( "Truncated rate control statistics file " << fileName );
+      }
+    }
+    // the loop ends at the end of the file, a partially read record header means the file is truncated
+    if ( m_statsFile.bad() )
+    {
+      EXIT( "Failed to read rate control statistics file " << fileName );
+    }
+    if ( m_statsFile.gcount() != 0 )
+    {
+      EXIT( "Truncated rate control statistics file " << fileName );
+    }
+    m_statsFile.close();
+
+    const int totalFrames = m_encRCSeq != NULL ? m_encRCSeq->getTotalFrames() : MAX_INT;
+    m_firstPassBitsLeft   = 0;
+    for ( std::map<int, FirstPassPicture>::const_iterator it = m_firstPassPictures.begin(); it != m_firstPassPictures.end(); it++ )
+    {
+      if ( it->first < totalFrames )
+      {
+        m_firstPassBitsLeft += it->second.bits;
+      }
+    }
+    msg( NOTICE, "\nRate control: read first pass statistics of %d pictures from %s\n", (int)m_firstPassPictures.size(), fileName.c_str() );
+  }
+}
+
+void RateCtrl::destroyFirstPass()
+{
+  if ( m_statsFile.is_open() )
+  {
+    m_statsFile.close();
+  }
+  m_firstPassCtuBits.clear();
+  m_firstPassPictures.clear();
+  m_firstPassBitsLeft = 0;
+  m_pass = 0;
+}
+
+void RateCtrl::addFirstPassPicture( int poc, int qp, SliceType sliceType, int bits )
+{
+  CHECK( m_pass != 1, "Rate control statistics are only written in the first pass" );
+  const int32_t record[4] = { poc, qp, (int32_t)sliceType, std::max( bits, 0 ) };
+  m_statsFile.write( (const char*)record, sizeof( record ) );
+  m_statsFile.write( (const char*)m_firstPassCtuBits.data(), m_firstPassCtuBits.size() * sizeof( uint32_t ) );
+  m_statsFile.flush();
+  if ( !m_statsFile )
+  {
+    EXIT( "Failed to write rate control statistics file " << m_statsFileName );
+  }
+  std::fill( m_firstPassCtuBits.begin(), m_firstPassCtuBits.end(), 0 );
+}
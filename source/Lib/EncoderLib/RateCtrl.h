@@ -47,6 +47,9 @@
 
 #include <vector>
 #include <algorithm>
+#include <fstream>
+#include <map>
+#include <string>
 
 using namespace std;
 
@@ -69,6 +72,9 @@ const double g_RCAlphaMinValue = 0.05;
 const double g_RCAlphaMaxValue = 500.0;
 const double g_RCBetaMinValue  = -3.0;
 const double g_RCBetaMaxValue  = -0.1;
+const double g_RCMinComplexityRatio   = 0.5;    // clipping of the look-ahead complexity ratio of a GOP
+const double g_RCMaxComplexityRatio   = 2.0;
+const double g_RCComplexityExponent   = 0.4;    // GOP target bits scale with the complexity ratio to this power
 
 #define ALPHA     6.7542;
 #define BETA1     1.2517
@@ -193,12 +199,12 @@ public:
   ~EncRCGOP();
 
 public:
-  void create( EncRCSeq* encRCSeq, int numPic );
+  void create( EncRCSeq* encRCSeq, int numPic, double complexityRatio = 1.0 );
   void destroy();
   void updateAfterPicture( int bitsCost );
 
 private:
-  int  xEstGOPTargetBits( EncRCSeq* encRCSeq, int GOPSize );
+  int  xEstGOPTargetBits( EncRCSeq* encRCSeq, int GOPSize, double complexityRatio );
   void   xCalEquaCoeff( EncRCSeq* encRCSeq, double* lambdaRatio, double* equaCoeffA, double* equaCoeffB, int GOPSize );
   double xSolveEqua(EncRCSeq* encRCSeq, double targetBpp, double* equaCoeffA, double* equaCoeffB, int GOPSize);
 
@@ -285,6 +291,8 @@ public:
   void setBitLeft(int bits)                               { m_bitsLeft = bits; }
 #endif
   void setTargetBits( int bits )                          { m_targetBits = bits; m_bitsLeft = bits;}
+  void setFirstPassStats( int targetBits, const std::vector<uint32_t>* ctuBits );
+  bool hasFirstPassStats()                                { return m_firstPassCtuBits != NULL; }
   void setTotalIntraCost(double cost)                     { m_totalCostIntra = cost; }
   void getLCUInitTargetBits();
 
@@ -326,6 +334,7 @@ private:
   double m_picLambda;
   double m_picMSE;
   int m_validPixelsInPic;
+  const std::vector<uint32_t>* m_firstPassCtuBits;   // CTU bits of the first pass, replace the model based CTU weights
 };
 
 class RateCtrl
@@ -337,10 +346,16 @@ public:
 public:
   void init(int totalFrames, int targetBitrate, int frameRate, int GOPSize, int picWidth, int picHeight, int LCUWidth, int LCUHeight, int bitDepth, int keepHierBits, bool useLCUSeparateModel, GOPEntry GOPList[MAX_GOP]);
   void destroy();
-  void initRCPic( int frameLevel );
-  void initRCGOP( int numberOfPictures );
+  void initRCPic( int frameLevel, int poc = -1 );
+  void initRCGOP( int numberOfPictures, double complexityRatio = 1.0 );
   void destroyRCGOP();
 
+  void initFirstPass( int pass, const std::string& fileName, int numCtus );
+  void destroyFirstPass();
+  int  getRCPass() const                      { return m_pass; }
+  void addFirstPassCtuBits( int ctuRsAddr, int bits ) { m_firstPassCtuBits[ctuRsAddr] = (uint32_t)std::max( bits, 0 ); }
+  void addFirstPassPicture( int poc, int qp, SliceType sliceType, int bits );
+
 public:
   void       setRCQP ( int QP ) { m_RCQP = QP;   }
   int        getRCQP () const   { return m_RCQP; }
@@ -369,6 +384,20 @@ private:
   uint32_t       m_cpbSize;                 // CPB size
   uint32_t       m_bufferingRate;           // Buffering rate
 #endif
+
+  struct FirstPassPicture
+  {
+    int                   qp;
+    SliceType             sliceType;
+    uint32_t              bits;
+    std::vector<uint32_t> ctuBits;
+  };
+  int        m_pass;                    // 0: single pass; 1: writing statistics; 2: reading statistics
+  std::fstream m_statsFile;
+  std::string  m_statsFileName;
+  std::vector<uint32_t> m_firstPassCtuBits;             // first pass: CTU bits of the current picture
+  std::map<int, FirstPassPicture> m_firstPassPictures;  // second pass: statistics by POC
+  int64_t    m_firstPassBitsLeft;       // second pass: first pass bits of the pictures not coded yet
 };
 
 #endif
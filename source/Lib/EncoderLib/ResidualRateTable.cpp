@@ -0,0 +1,242 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ResidualRateTable.cpp
+    \brief    residual rate estimation from per-CTU snapshots of the context states
+*/
+
+#include "ResidualRateTable.h"
+
+#include "CommonLib/Rom.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+ResidualRateTable::ResidualRateTable()
+  : m_ctxBits( ContextSetCfg::NumberOfContexts )
+{
+  for( unsigned goRicePar = 0; goRicePar <= MAX_GO_RICE_PAR; goRicePar++ )
+  {
+    for( unsigned rem = 0; rem < ( COEF_REMAIN_BIN_REDUCTION << goRicePar ); rem++ )
+    {
+      m_remAbsBits[goRicePar][rem] = BinProbModelBase::estFracBitsEP( ( rem >> goRicePar ) + 1 + goRicePar );
+    }
+  }
+}
+
+void ResidualRateTable::init( const Ctx& ctx )
+{
+  const FracBitsAccess& fracBits = ctx.getFracBitsAcess();
+
+  auto initSet = [&]( const CtxSet& ctxSet )
+  {
+    for( unsigned ctxId = ctxSet.Offset; ctxId < ctxSet.Offset + ctxSet.Size; ctxId++ )
+    {
+      m_ctxBits[ctxId] = fracBits.getFracBitsArray( ctxId );
+    }
+  };
+
+  for( int chType = 0; chType < MAX_NUM_CHANNEL_TYPE; chType++ )
+  {
+    initSet( Ctx::SigCoeffGroup[chType] );
+    initSet( Ctx::LastX        [chType] );
+    initSet( Ctx::LastY        [chType] );
+    initSet( Ctx::ParFlag      [chType] );
+  }
+  for( int setId = 0; setId < 6; setId++ )
+  {
+    initSet( Ctx::SigFlag[setId] );
+  }
+  for( int setId = 0; setId < 4; setId++ )
+  {
+    initSet( Ctx::GtxFlag[setId] );
+  }
+}
+
+uint32_t ResidualRateTable::xRemAbsBits( unsigned rem, unsigned goRicePar, int maxLog2TrDynamicRange )
+{
+  // same code lengths as BinEncoderBase::encodeRemAbsEP()
+  const unsigned cutoff          = COEF_REMAIN_BIN_REDUCTION;
+  const unsigned maxPrefixLength = 32 - cutoff - maxLog2TrDynamicRange;
+  const unsigned codeValue       = ( rem >> goRicePar ) - cutoff;
+  unsigned       prefixLength    = 0;
+  unsigned       suffixLength;
+  if( codeValue >= ( ( 1 << maxPrefixLength ) - 1 ) )
+  {
+    prefixLength = maxPrefixLength;
+    suffixLength = maxLog2TrDynamicRange;
+  }
+  else
+  {
+    while( codeValue > ( ( 2 << prefixLength ) - 2 ) )
+    {
+      prefixLength++;
+    }
+    suffixLength = prefixLength + goRicePar + 1;
+  }
+  return BinProbModelBase::estFracBitsEP( prefixLength + cutoff + suffixLength );
+}
+
+uint64_t ResidualRateTable::lastPosBits( const CoeffCodingContext& cctx, unsigned posX, unsigned posY, unsigned maxLastPosX, unsigned maxLastPosY ) const
+{
+  const unsigned groupIdxX = g_uiGroupIdx[posX];
+  const unsigned groupIdxY = g_uiGroupIdx[posY];
+  uint64_t       fracBits  = 0;
+
+  for( unsigned ctxLast = 0; ctxLast < groupIdxX; ctxLast++ )
+  {
+    fracBits += ctxBits( cctx.lastXCtxId( ctxLast ), 1 );
+  }
+  if( groupIdxX < maxLastPosX )
+  {
+    fracBits += ctxBits( cctx.lastXCtxId( groupIdxX ), 0 );
+  }
+  for( unsigned ctxLast = 0; ctxLast < groupIdxY; ctxLast++ )
+  {
+    fracBits += ctxBits( cctx.lastYCtxId( ctxLast ), 1 );
+  }
+  if( groupIdxY < maxLastPosY )
+  {
+    fracBits += ctxBits( cctx.lastYCtxId( groupIdxY ), 0 );
+  }
+  if( groupIdxX > 3 )
+  {
+    fracBits += BinProbModelBase::estFracBitsEP( ( groupIdxX - 2 ) >> 1 );
+  }
+  if( groupIdxY > 3 )
+  {
+    fracBits += BinProbModelBase::estFracBitsEP( ( groupIdxY - 2 ) >> 1 );
+  }
+  return fracBits;
+}
+
+uint64_t ResidualRateTable::subblockBits( CoeffCodingContext& cctx, const TCoeff* coeff, const int stateTransTable, int& state ) const
+{
+  //===== init =====
+  const int   minSubPos   = cctx.minSubPos();
+  const bool  isLast      = cctx.isLast();
+  int         firstSigPos = ( isLast ? cctx.scanPosLast() : cctx.maxSubPos() );
+  int         nextSigPos  = firstSigPos;
+  uint64_t    fracBits    = 0;
+
+  //===== significant_coeffgroup_flag =====
+  if( !isLast && cctx.isNotFirst() )
+  {
+    fracBits += ctxBits( cctx.sigGroupCtxId(), cctx.isSigGroup() ? 1 : 0 );
+    if( !cctx.isSigGroup() )
+    {
+      return fracBits;
+    }
+  }
+
+  //===== absolute values =====
+  const int inferSigPos   = nextSigPos != cctx.scanPosLast() ? ( cctx.isNotFirst() ? minSubPos : -1 ) : nextSigPos;
+  int       firstNZPos    = nextSigPos;
+  int       lastNZPos     = -1;
+  int       numNonZero    =  0;
+  int       remRegBins    = cctx.regBinLimit;
+
+  for( ; nextSigPos >= minSubPos && remRegBins >= 4; nextSigPos-- )
+  {
+    const TCoeff   coef    = coeff[cctx.blockPos( nextSigPos )];
+    const unsigned sigFlag = ( coef != 0 );
+    if( numNonZero || nextSigPos != inferSigPos )
+    {
+      fracBits += ctxBits( cctx.sigCtxIdAbs( nextSigPos, coeff, state ), sigFlag );
+      remRegBins--;
+    }
+    else if( nextSigPos != cctx.scanPosLast() )
+    {
+      cctx.sigCtxIdAbs( nextSigPos, coeff, state ); // required for setting variables that are needed for gtx/par context selection
+    }
+
+    if( sigFlag )
+    {
+      const uint8_t ctxOff      = cctx.ctxOffsetAbs();
+      int           remAbsLevel = abs( coef ) - 1;
+      numNonZero++;
+      firstNZPos = nextSigPos;
+      lastNZPos  = std::max<int>( lastNZPos, nextSigPos );
+
+      fracBits += ctxBits( cctx.greater1CtxIdAbs( ctxOff ), remAbsLevel ? 1 : 0 );
+      remRegBins--;
+
+      if( remAbsLevel )
+      {
+        remAbsLevel -= 1;
+        fracBits    += ctxBits( cctx.parityCtxIdAbs( ctxOff ), remAbsLevel & 1 );
+        remAbsLevel >>= 1;
+        fracBits    += ctxBits( cctx.greater2CtxIdAbs( ctxOff ), remAbsLevel ? 1 : 0 );
+        remRegBins  -= 2;
+      }
+    }
+
+    state = ( stateTransTable >> ( ( state << 2 ) + ( ( coef & 1 ) << 1 ) ) ) & 3;
+  }
+  const int firstPosMode2 = nextSigPos;
+  cctx.regBinLimit = remRegBins;
+
+  //===== Golomb-Rice codes =====
+  for( int scanPos = firstSigPos; scanPos > firstPosMode2; scanPos-- )
+  {
+    const unsigned absLevel = abs( coeff[cctx.blockPos( scanPos )] );
+    if( absLevel >= 4 )
+    {
+      const unsigned ricePar = g_auiGoRiceParsCoeff[cctx.templateAbsSum( scanPos, coeff, 4 )];
+      fracBits += remAbsBits( ( absLevel - 4 ) >> 1, ricePar, cctx.maxLog2TrDRange() );
+    }
+  }
+
+  //===== bypass coded levels =====
+  for( int scanPos = firstPosMode2; scanPos >= minSubPos; scanPos-- )
+  {
+    const unsigned absLevel = abs( coeff[cctx.blockPos( scanPos )] );
+    const unsigned rice     = g_auiGoRiceParsCoeff[cctx.templateAbsSum( scanPos, coeff, 0 )];
+    const unsigned pos0     = g_auiGoRicePosCoeff0( state, rice );
+    const unsigned rem      = ( absLevel == 0 ? pos0 : absLevel <= pos0 ? absLevel - 1 : absLevel );
+    fracBits += remAbsBits( rem, rice, cctx.maxLog2TrDRange() );
+    state = ( stateTransTable >> ( ( state << 2 ) + ( ( absLevel & 1 ) << 1 ) ) ) & 3;
+    if( absLevel )
+    {
+      numNonZero++;
+      firstNZPos = scanPos;
+      lastNZPos  = std::max<int>( lastNZPos, scanPos );
+    }
+  }
+
+  //===== signs =====
+  const unsigned numSigns = numNonZero - ( cctx.hideSign( firstNZPos, lastNZPos ) ? 1 : 0 );
+  return fracBits + BinProbModelBase::estFracBitsEP( numSigns );
+}
+
+//! \}
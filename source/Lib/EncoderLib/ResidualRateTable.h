@@ -0,0 +1,80 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2020, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ResidualRateTable.h
+    \brief    residual rate estimation from per-CTU snapshots of the context states (header)
+*/
+
+#ifndef __RESIDUALRATETABLE__
+#define __RESIDUALRATETABLE__
+
+#include "CommonLib/ContextModelling.h"
+
+#include <vector>
+
+//! \ingroup EncoderLib
+//! \{
+
+/// fractional bits of the regular residual coding bins, taken from the context states at the start of a CTU.
+/// The estimates follow the syntax of residual_coding(), but the context states are not updated while estimating.
+class ResidualRateTable
+{
+public:
+  ResidualRateTable();
+
+  /// takes a snapshot of the contexts of the regular residual coding
+  void      init              ( const Ctx& ctx );
+
+  uint32_t  ctxBits           ( unsigned ctxId, unsigned bin )  const { return m_ctxBits[ctxId].intBits[bin]; }
+  uint32_t  remAbsBits        ( unsigned rem, unsigned goRicePar, int maxLog2TrDynamicRange ) const
+  {
+    return rem < ( COEF_REMAIN_BIN_REDUCTION << goRicePar ) ? m_remAbsBits[goRicePar][rem] : xRemAbsBits( rem, goRicePar, maxLog2TrDynamicRange );
+  }
+
+  /// bits of last_sig_coeff_x/y_prefix and _suffix
+  uint64_t  lastPosBits       ( const CoeffCodingContext& cctx, unsigned posX, unsigned posY, unsigned maxLastPosX, unsigned maxLastPosY ) const;
+  /// bits of a subblock as coded by CABACWriter::residual_coding_subblock(), updates the dependent quantization state and cctx
+  uint64_t  subblockBits      ( CoeffCodingContext& cctx, const TCoeff* coeff, const int stateTransTable, int& state ) const;
+
+private:
+  static uint32_t xRemAbsBits ( unsigned rem, unsigned goRicePar, int maxLog2TrDynamicRange );
+
+  static const int MAX_GO_RICE_PAR = 3;
+
+  std::vector<BinFracBits> m_ctxBits;   ///< indexed by the absolute context id, only the residual contexts are valid
+  uint32_t                 m_remAbsBits[MAX_GO_RICE_PAR + 1][COEF_REMAIN_BIN_REDUCTION << MAX_GO_RICE_PAR];
+};
+
+//! \}
+
+#endif // __RESIDUALRATETABLE__
@@ -45,6 +45,7 @@
 #include "CommonLib/Rom.h"
 #include "VideoIOYuv.h"
 #include "CommonLib/Unit.h"
+#include "CommonLib/StageProfiler.h"
 
 using namespace std;
 
@@ -870,6 +871,8 @@ static bool writeField(ostream& fd, const Pel* top, const Pel* bottom,
  */
 bool VideoIOYuv::read ( PelUnitBuf& pic, PelUnitBuf& picOrg, const InputColourSpaceConversion ipcsc, int aiPad[2], ChromaFormat format, const bool bClipToRec709 )
 {
+  PROFILE_STAGE( PROF_INPUT );
+
   // check end-of-file
   if ( isEof() )
   {
@@ -966,6 +969,8 @@ bool VideoIOYuv::write( uint32_t orgWidth, uint32_t orgHeight, const CPelUnitBuf
                         const bool bPackedYUVOutputMode,
                         int confLeft, int confRight, int confTop, int confBottom, ChromaFormat format, const bool bClipToRec709, const bool subtractConfWindowOffsets )
 {
+  PROFILE_STAGE( PROF_OUTPUT );
+
   PelStorage interm;
 
   if (ipCSC!=IPCOLOURSPACE_UNCHANGED)
@@ -1057,6 +1062,8 @@ bool VideoIOYuv::write( const CPelUnitBuf& picTop, const CPelUnitBuf& picBottom,
                         const bool bPackedYUVOutputMode,
                         int confLeft, int confRight, int confTop, int confBottom, ChromaFormat format, const bool isTff, const bool bClipToRec709 )
 {
+  PROFILE_STAGE( PROF_OUTPUT );
+
   PelStorage intermTop;
   PelStorage intermBottom;
 